@@ -96,7 +96,7 @@ void ChaseAI::Update(float deltaTime)
             FVector2D pos = rigidBody->GetPosition();
             pos.x += dir.x * (m_nDesiredSpeed * deltaTime);
             pos.y += dir.y * (m_nDesiredSpeed * deltaTime);
-            rigidBody->m_transform.Position = pos;
+            rigidBody->SetPosition(pos);
         }
     }
 
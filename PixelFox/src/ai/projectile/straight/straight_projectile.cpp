@@ -128,7 +128,7 @@ void StraightProjectile::Deactivate()
 	if (auto* rb = m_pBody->GetRigidBody2D())
 	{
 		rb->SetVelocity({ 0.f, 0.f });
-		rb->m_transform.Position = { -100000.f, -100000.f };
+		rb->SetPosition({ -100000.f, -100000.f });
 	}
 
 	m_pBody->SetVisible(false);
@@ -172,7 +172,7 @@ _Use_decl_annotations_
 void StraightProjectile::SetPosition(const FVector2D& pos)
 {
 	if (auto* rb = m_pBody->GetRigidBody2D())
-		rb->m_transform.Position = pos;
+		rb->SetPosition(pos);
 }
 
 _Use_decl_annotations_
@@ -247,12 +247,23 @@ void StraightProjectile::OnHit(pixel_engine::BoxCollider* collider)
 
 void pixel_game::StraightProjectile::AddHitTag(const std::string& tag)
 {
+	if (HasHitTag(tag)) return;
+
 	m_ppszTags.push_back(tag);
+	m_hitTagMask |= pixel_engine::PECollisionLayers::Instance().Intern(tag);
 }
 
 void pixel_game::StraightProjectile::RemoveHitTag(const std::string& tag)
 {
-	// TODO: Add Key removal in fox::vector m_ppszTags;
+	for (size_t i = 0; i < m_ppszTags.size(); ++i)
+	{
+		if (m_ppszTags[i] != tag) continue;
+
+		m_ppszTags[i] = m_ppszTags.back();
+		m_ppszTags.pop_back();
+		m_hitTagMask &= ~pixel_engine::PECollisionLayers::Instance().Find(tag);
+		return;
+	}
 }
 
 bool pixel_game::StraightProjectile::HasHitTag(const std::string& tag) const
@@ -280,15 +291,11 @@ void pixel_game::StraightProjectile::SetCallback()
 		{
 			if (!other) return;
 
-			for (auto& tag : m_ppszTags)
+			if (other->HasTag(m_hitTagMask))
 			{
-				if (other->HasTag(tag))
+				if (m_fnOnHit) 
 				{
-					if (m_fnOnHit) 
-					{
-						m_fnOnHit(this, other);
-					}
-					return;
+					m_fnOnHit(this, other);
 				}
 			}
 		});
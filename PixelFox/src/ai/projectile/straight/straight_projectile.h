@@ -99,6 +99,7 @@ namespace pixel_game
 
 	private:
 		fox::vector<std::string> m_ppszTags{};
+		pixel_engine::TagMask	 m_hitTagMask{ 0u }; // m_ppszTags interned
 		pixel_engine::PEISprite* m_pOwner{ nullptr };
 		std::unique_ptr<pixel_engine::QuadObject> m_pBody{ nullptr };
 
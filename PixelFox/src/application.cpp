@@ -8,6 +8,7 @@
 
 #include "pixel_engine/render_manager/components/font/font_allocator.h"
 #include "pixel_engine/physics_manager/physics_queue.h"
+#include "pixel_engine/physics_manager/physics_api/collider/collision_layers.h"
 
 #include "enemy/define_enemy.h"
 
@@ -23,6 +24,9 @@ pixel_game::Application::~Application()
 _Use_decl_annotations_
 bool pixel_game::Application::InitApplication(pixel_engine::PIXEL_ENGINE_INIT_DESC const* desc)
 {
+	//~ enemies walk over trees, stones and water
+	auto& layers = pixel_engine::PECollisionLayers::Instance();
+	layers.SetCollides(layers.Intern("Enemy"), pixel_engine::PECollisionLayers::kStaticLayer, false);
 	return true;
 }
 
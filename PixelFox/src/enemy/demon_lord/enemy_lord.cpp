@@ -255,12 +255,15 @@ void pixel_game::DemonLord::SetOnCollisionEnter()
     if (!collider) return;
 
     //~ Add Specific to player
-    collider->SetOnHitEnterCallback([&](pixel_engine::BoxCollider* collider)
+    const pixel_engine::TagMask playerTag = PlayerTag();
+    const pixel_engine::TagMask attackTag = PlayerAttackTag();
+
+    collider->SetOnHitEnterCallback([&, playerTag, attackTag](pixel_engine::BoxCollider* collider)
         {
             if (!collider) return;
 
             //~ Player in touch attack him!
-            if (collider->HasTag("Player"))
+            if (collider->HasTag(playerTag))
             {
                 //~ TODO: Play attack animation
                 pixel_engine::logger::debug("Enemy Should Attack Player now");
@@ -275,7 +278,7 @@ void pixel_game::DemonLord::SetOnCollisionEnter()
 
             }
 
-            if (collider->HasTag("Player_Attack"))
+            if (collider->HasTag(attackTag))
             {
                 //~ TODO: Play attack animation
                 pixel_engine::logger::debug("Enemy Should Get Hit");
@@ -289,17 +292,20 @@ void pixel_game::DemonLord::SetOnCollisionExit()
     if (!collider) return;
 
     //~ Add Specific to player
-    collider->SetOnHitExitCallback([&](pixel_engine::BoxCollider* collider)
+    const pixel_engine::TagMask playerTag = PlayerTag();
+    const pixel_engine::TagMask attackTag = PlayerAttackTag();
+
+    collider->SetOnHitExitCallback([&, playerTag, attackTag](pixel_engine::BoxCollider* collider)
         {
             if (!collider) return;
 
-            if (collider->HasTag("Player"))
+            if (collider->HasTag(playerTag))
             {
                 //~ TODO: Play attack animation
                 pixel_engine::logger::debug("Enemy Should stop Attacking Player now");
             }
 
-            if (collider->HasTag("Player_Attack"))
+            if (collider->HasTag(attackTag))
             {
                 //~ TODO: Play attack animation
                 pixel_engine::logger::debug("Enemy Should stop Getting Hit");
@@ -6,6 +6,7 @@
 #include "pixel_engine/utilities/logger/logger.h"
 #include "pixel_engine/render_manager/objects/quad/quad.h"
 #include "pixel_engine/render_manager/components/animator/anim_state.h"
+#include "pixel_engine/physics_manager/physics_api/collider/collision_layers.h"
 
 namespace pixel_game
 {
@@ -85,6 +86,21 @@ namespace pixel_game
 		virtual void UpdateAnimState   (_In_ float deltaTime) = 0;
 		virtual void UpdateAIController(_In_ float deltaTime) = 0;
 
+		//~ tags every enemy reacts to, interned on first use and shared by all of them
+		_NODISCARD _Check_return_
+		static pixel_engine::TagMask PlayerTag()
+		{
+			static const pixel_engine::TagMask tag = pixel_engine::PECollisionLayers::Instance().Intern("Player");
+			return tag;
+		}
+
+		_NODISCARD _Check_return_
+		static pixel_engine::TagMask PlayerAttackTag()
+		{
+			static const pixel_engine::TagMask tag = pixel_engine::PECollisionLayers::Instance().Intern("Player_Attack");
+			return tag;
+		}
+
 	protected:
 		bool m_bRangedEnemy{ false };
 	};
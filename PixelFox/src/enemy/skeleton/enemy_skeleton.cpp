@@ -270,12 +270,15 @@ void pixel_game::EnemySkeleton::SetOnCollisionEnter()
     if (!collider) return;
 
     //~ Add Specific to player
-    collider->SetOnHitEnterCallback([&](pixel_engine::BoxCollider* collider)
+    const pixel_engine::TagMask playerTag = PlayerTag();
+    const pixel_engine::TagMask attackTag = PlayerAttackTag();
+
+    collider->SetOnHitEnterCallback([&, playerTag, attackTag](pixel_engine::BoxCollider* collider)
         {
             if (!collider) return;
 
             //~ Player in touch attack him!
-            if (collider->HasTag("Player"))
+            if (collider->HasTag(playerTag))
             {
                 //~ TODO: Play attack animation
                 pixel_engine::logger::debug("Enemy Should Attack Player now");
@@ -290,7 +293,7 @@ void pixel_game::EnemySkeleton::SetOnCollisionEnter()
 
             }
 
-            if (collider->HasTag("Player_Attack"))
+            if (collider->HasTag(attackTag))
             {
                 //~ TODO: Play attack animation
                 pixel_engine::logger::debug("Enemy Should Get Hit");
@@ -304,17 +307,20 @@ void pixel_game::EnemySkeleton::SetOnCollisionExit()
     if (!collider) return;
 
     //~ Add Specific to player
-    collider->SetOnHitExitCallback([&](pixel_engine::BoxCollider* collider)
+    const pixel_engine::TagMask playerTag = PlayerTag();
+    const pixel_engine::TagMask attackTag = PlayerAttackTag();
+
+    collider->SetOnHitExitCallback([&, playerTag, attackTag](pixel_engine::BoxCollider* collider)
         {
             if (!collider) return;
 
-            if (collider->HasTag("Player"))
+            if (collider->HasTag(playerTag))
             {
                 //~ TODO: Play attack animation
                 pixel_engine::logger::debug("Enemy Should stop Attacking Player now");
             }
 
-            if (collider->HasTag("Player_Attack"))
+            if (collider->HasTag(attackTag))
             {
                 //~ TODO: Play attack animation
                 pixel_engine::logger::debug("Enemy Should stop Getting Hit");
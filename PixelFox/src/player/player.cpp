@@ -2,6 +2,7 @@
 
 #include "pixel_engine/utilities/logger/logger.h"
 #include "pixel_engine/physics_manager/physics_queue.h"
+#include "pixel_engine/physics_manager/physics_api/collider/collision_layers.h"
 #include "pixel_engine/render_manager/render_queue/render_queue.h"
 
 #include "world/state/character_state.h"
@@ -80,12 +81,14 @@ bool PlayerCharacter::Initialize()
     m_pBasicAttack->AddHitTag("enemy");
 
     m_pSpecialAttack = std::make_unique<StraightProjectile>();
+    const pixel_engine::TagMask enemyTag =
+        pixel_engine::PECollisionLayers::Instance().Intern("Enemy");
     desc.OnHit =
-        [&](IProjectile* projectile, pixel_engine::BoxCollider* collider)
+        [&, enemyTag](IProjectile* projectile, pixel_engine::BoxCollider* collider)
         {
             if (!collider) return;
             if (collider == m_pBody->GetCollider()) return;
-            if (!collider->HasTag("Enemy")) return;
+            if (!collider->HasTag(enemyTag)) return;
             m_aoeVictims[collider] = true;
         };
 
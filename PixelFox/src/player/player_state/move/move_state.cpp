@@ -29,7 +29,7 @@ EPlayerStateId pixel_game::PlayerStateMove::Tick(PlayerContext& ctx)
     if (auto* rb = ctx.self->GetPlayerBody()->GetRigidBody2D())
     {
         const FVector2D v = ctx.dir * ctx.movementSpeed * ctx.dt;
-        rb->m_transform.Position += v;
+        rb->AddPosition(v);
     }
 
     ctx.lastNonZeroDir = ctx.dir;
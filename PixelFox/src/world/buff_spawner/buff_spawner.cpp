@@ -132,11 +132,14 @@ void BuffSpawner::WireColliderForIndex(int idx)
 
     if (auto* col = obs->GetCollider())
     {
+        const pixel_engine::TagMask playerTag =
+            pixel_engine::PECollisionLayers::Instance().Intern("player");
+
         col->SetOnHitEnterCallback(
-            [this, idx](pixel_engine::BoxCollider* other)
+            [this, idx, playerTag](pixel_engine::BoxCollider* other)
             {
                 if (!other) return;
-                if (!other->HasTag("player")) return;
+                if (!other->HasTag(playerTag)) return;
 
                 PostBuffEventForIndex(other);
                 Deactivate(idx);
@@ -1,5 +1,6 @@
 ﻿#include "finite_map.h"
 #include "pixel_engine/utilities/logger/logger.h"
+#include "pixel_engine/physics_manager/physics_queue.h"
 
 #include <random>
 #include <fstream>
@@ -84,6 +85,7 @@ void pixel_game::FiniteMap::Initialize(const MAP_INIT_DESC& desc)
     }
 
     BuildMapObjects(desc.LoadScreen);
+    RegisterStaticColliders_();
 
     if (desc.LoadScreen.pLoadTitle != nullptr)
     {
@@ -353,6 +355,7 @@ void pixel_game::FiniteMap::RebuildLevel_()
     }
 
     HideUnused_(); 
+    RegisterStaticColliders_();
 }
 
 _Use_decl_annotations_
@@ -787,6 +790,25 @@ void pixel_game::FiniteMap::HideUnused_()
     }
 }
 
+void pixel_game::FiniteMap::RegisterStaticColliders_()
+{
+    //~ trees, stones and water never move, the physics queue keeps them
+    //~ in a grid until the next level instead of pairing them every frame
+    fox::vector<pixel_engine::PEISprite*> statics{};
+    for (const auto& [type, vec] : m_ppObsticle)
+    {
+        const int live = m_liveCount[type];
+        for (int i = 0; i < live; ++i)
+        {
+            if (!vec[i]) continue;
+
+            auto* col = vec[i]->GetCollider();
+            if (col && col->IsStatic()) statics.push_back(vec[i]->GetSpirte());
+        }
+    }
+    pixel_engine::PhysicsQueue::Instance().SetStaticColliders(statics);
+}
+
 Obsticle* pixel_game::FiniteMap::AcquireObsticle_(char type, 
     const INIT_OBSTICLE_DESC& desc,
     bool trigger)
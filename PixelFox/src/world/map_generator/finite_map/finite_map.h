@@ -88,6 +88,7 @@ namespace pixel_game
 		//~ cache
 		void BeginReuseFrame_();
 		void HideUnused_	 ();
+		void RegisterStaticColliders_();
 		Obsticle* AcquireObsticle_(
 			char type,
 			const INIT_OBSTICLE_DESC& desc,
@@ -0,0 +1,30 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <format>
+#include <string>
+#include <utility>
+
+namespace pixel_bench
+{
+	//~ one result line on stdout, the engine logger is compiled out of release builds
+	template<class... Args>
+	void Report(const std::format_string<Args...> fmt, Args&&... args)
+	{
+		const std::string line = std::format(fmt, std::forward<Args>(args)...);
+		std::fwrite(line.data(), 1u, line.size(), stdout);
+		std::fputc('\n', stdout);
+		std::fflush(stdout);
+	}
+} // namespace pixel_bench
@@ -0,0 +1,472 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "frame_bench.h"
+#include "bench_report.h"
+
+#include "pixel_engine/render_manager/api/raster/raster.h"
+#include "pixel_engine/render_manager/api/present/headless_present.h"
+#include "pixel_engine/render_manager/render_queue/sampler/bilinear/bilinear_sampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+
+using namespace pixel_engine;
+using namespace pixel_bench;
+
+namespace
+{
+	using bench_clock = std::chrono::steady_clock;
+
+	constexpr PFE_FORMAT_R8G8B8_UINT CLEAR_COLOR{ 255u, 0u, 255u };
+
+	constexpr int SPRITE_SIZE  = 32;
+	constexpr int FLOOD_SIZE   = 64;
+	constexpr int GLYPH_WIDTH  = 8;
+	constexpr int GLYPH_HEIGHT = 12;
+	constexpr int GLYPH_COUNT  = 95; // printable ascii
+	constexpr int LINE_HEIGHT  = GLYPH_HEIGHT + 2;
+
+	typedef struct _FRAME_QUAD
+	{
+		FVector2D start{};
+		FVector2D axisU{ 1.0f, 0.0f };
+		FVector2D axisV{ 0.0f, 1.0f };
+		float	  phase{ 0.0f };
+		uint32_t  glyph{ 0u };
+	} FRAME_QUAD;
+
+	std::unique_ptr<Texture> MakeTexture(const char* name, int width, int height, fox::vector<unsigned char>&& data)
+	{
+		auto texture = std::make_unique<Texture>(
+			name,
+			static_cast<uint32_t>(width),
+			static_cast<uint32_t>(height),
+			TextureFormat::RGBA8,
+			ColorSpace::sRGB,
+			std::move(data));
+		texture->BuildCoverage();
+		return texture;
+	}
+
+	//~ every texel opaque, what the level ground tiles look like
+	std::unique_ptr<Texture> MakeGroundTexture(int size, std::mt19937& rng)
+	{
+		std::uniform_int_distribution<int> channel(11, 250);
+
+		fox::vector<unsigned char> data{};
+		data.resize(static_cast<size_t>(size) * size * 4u);
+		for (size_t i = 0; i < data.size(); i += 4u)
+		{
+			data[i + 0] = static_cast<unsigned char>(channel(rng));
+			data[i + 1] = static_cast<unsigned char>(channel(rng));
+			data[i + 2] = static_cast<unsigned char>(channel(rng));
+			data[i + 3] = 255u;
+		}
+		return MakeTexture("frame_bench_ground", size, size, std::move(data));
+	}
+
+	//~ a disc of colour on black (keyed), what the characters look like
+	std::unique_ptr<Texture> MakeSpriteTexture(int size, std::mt19937& rng)
+	{
+		std::uniform_int_distribution<int> channel(11, 250);
+
+		fox::vector<unsigned char> data{};
+		data.resize(static_cast<size_t>(size) * size * 4u);
+
+		const float centre = 0.5f * static_cast<float>(size - 1);
+		const float radius = 0.45f * static_cast<float>(size);
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				const float dx	   = static_cast<float>(x) - centre;
+				const float dy	   = static_cast<float>(y) - centre;
+				const bool outside = dx * dx + dy * dy > radius * radius;
+
+				const size_t i = (static_cast<size_t>(y) * size + x) * 4u;
+				data[i + 0] = outside ? 0u : static_cast<unsigned char>(channel(rng));
+				data[i + 1] = outside ? 0u : static_cast<unsigned char>(channel(rng));
+				data[i + 2] = outside ? 0u : static_cast<unsigned char>(channel(rng));
+				data[i + 3] = 255u;
+			}
+		}
+		return MakeTexture("frame_bench_sprite", size, size, std::move(data));
+	}
+
+	//~ white ink on black, about half the cell inked like a bitmap font
+	std::unique_ptr<Texture> MakeGlyphTexture(std::mt19937& rng)
+	{
+		std::bernoulli_distribution ink(0.5);
+
+		fox::vector<unsigned char> data{};
+		data.resize(static_cast<size_t>(GLYPH_WIDTH) * GLYPH_HEIGHT * 4u);
+		for (int y = 0; y < GLYPH_HEIGHT; ++y)
+		{
+			for (int x = 0; x < GLYPH_WIDTH; ++x)
+			{
+				const bool border = x == 0 || y == 0 || x == GLYPH_WIDTH - 1 || y == GLYPH_HEIGHT - 1;
+				const unsigned char value = (!border && ink(rng)) ? 255u : 0u;
+
+				const size_t i = (static_cast<size_t>(y) * GLYPH_WIDTH + x) * 4u;
+				data[i + 0] = value;
+				data[i + 1] = value;
+				data[i + 2] = value;
+				data[i + 3] = 255u;
+			}
+		}
+		return MakeTexture("frame_bench_glyph", GLYPH_WIDTH, GLYPH_HEIGHT, std::move(data));
+	}
+
+	fox::vector<FRAME_QUAD> MakeScattered(const PFE_FRAME_BENCH_DESC& desc, std::mt19937& rng)
+	{
+		const float half = 0.5f * static_cast<float>(SPRITE_SIZE);
+		std::uniform_real_distribution<float> px   (-half, static_cast<float>(desc.TargetWidth ) - half);
+		std::uniform_real_distribution<float> py   (-half, static_cast<float>(desc.TargetHeight) - half);
+		std::uniform_real_distribution<float> phase(0.0f, 6.2831853f);
+
+		fox::vector<FRAME_QUAD> quads{};
+		quads.reserve(static_cast<size_t>(desc.ItemCount));
+		for (int i = 0; i < desc.ItemCount; ++i)
+		{
+			FRAME_QUAD quad{};
+			quad.start = { std::floor(px(rng)), std::floor(py(rng)) };
+			quad.phase = phase(rng);
+			quads.push_back(quad);
+		}
+		return quads;
+	}
+
+	//~ text lines from the top left corner, wrapped at the right edge
+	fox::vector<FRAME_QUAD> MakeHud(const PFE_FRAME_BENCH_DESC& desc, std::mt19937& rng)
+	{
+		std::uniform_int_distribution<uint32_t> glyph(0u, GLYPH_COUNT - 1u);
+
+		const float right  = static_cast<float>(desc.TargetWidth)  - static_cast<float>(GLYPH_WIDTH);
+		const float bottom = static_cast<float>(desc.TargetHeight) - static_cast<float>(GLYPH_HEIGHT);
+
+		fox::vector<FRAME_QUAD> quads{};
+		quads.reserve(static_cast<size_t>(desc.ItemCount));
+
+		FVector2D pen{ 4.0f, 4.0f };
+		for (int i = 0; i < desc.ItemCount; ++i)
+		{
+			if (pen.x > right)
+			{
+				pen.x  = 4.0f;
+				pen.y += static_cast<float>(LINE_HEIGHT);
+			}
+			if (pen.y > bottom) pen.y = 4.0f; // more text than screen, stack it
+
+			FRAME_QUAD quad{};
+			quad.start = pen;
+			quad.glyph = glyph(rng);
+			quads.push_back(quad);
+
+			pen.x += static_cast<float>(GLYPH_WIDTH);
+		}
+		return quads;
+	}
+
+	void SubmitQuad(PERaster2D& raster, const FRAME_QUAD& quad, const Texture& texture, bool background)
+	{
+		const int width	 = static_cast<int>(texture.GetWidth ());
+		const int height = static_cast<int>(texture.GetHeight());
+
+		PFE_RASTER_DRAW_CMD cmd
+		{
+			.startBase		 = quad.start,
+			.deltaAxisU		 = quad.axisU,
+			.deltaAxisV		 = quad.axisV,
+			.columnStartFrom = 0,
+			.columneEndAt	 = width,
+			.rowStartFrom	 = 0,
+			.rowEndAt		 = height,
+			.totalColumns	 = width,
+			.totalRows		 = height,
+			.sampledTexture	 = &texture,
+			.color			 = CLEAR_COLOR,
+		};
+
+		if (background) raster.DrawQuadBackground(cmd);
+		else			raster.SubmitQuadTile(cmd);
+	}
+} // namespace
+
+_Use_decl_annotations_
+const char* PEFrameBench::ToString(EFrameWorkload workload) noexcept
+{
+	switch (workload)
+	{
+	case EFrameWorkload::Tiles:			  return "tiles";
+	case EFrameWorkload::RotatedSprites:  return "rotated sprites";
+	case EFrameWorkload::FontHud:		  return "font hud";
+	case EFrameWorkload::BackgroundFlood: return "background flood";
+	default:							  return "unknown";
+	}
+}
+
+_Use_decl_annotations_
+PFE_FRAME_BENCH_RESULT PEFrameBench::RunWorkload(const PFE_FRAME_BENCH_DESC& desc)
+{
+	PFE_FRAME_BENCH_RESULT result{};
+	if (desc.ItemCount <= 0 || desc.Frames <= 0 || desc.TargetWidth == 0u || desc.TargetHeight == 0u) return result;
+
+	PFE_RASTER_CONSTRUCT_DESC construct{};
+	construct.Viewport		   = { 0u, 0u, desc.TargetWidth, desc.TargetHeight };
+	construct.EnableBoundCheck = true;
+	construct.TargetFormat	   = desc.TargetFormat;
+	construct.ClearColor	   = CLEAR_COLOR;
+
+	PERaster2D raster{ &construct };
+
+	PFE_RASTER_INIT_DESC init{};
+	init.WorkerCount		  = std::max(1u, desc.WorkerCount);
+	init.EnableTileBinning	  = true;
+	init.EnableDamageTracking = false;
+	init.EnableLayerCache	  = false;
+	if (!raster.Init(&init)) return result;
+
+	std::mt19937 rng{ desc.Seed };
+
+	fox::vector<std::unique_ptr<Texture>> textures{};
+	fox::vector<FRAME_QUAD>				  quads{};
+
+	switch (desc.Workload)
+	{
+	case EFrameWorkload::Tiles:
+		textures.push_back(MakeGroundTexture(SPRITE_SIZE, rng));
+		quads = MakeScattered(desc, rng);
+		break;
+
+	case EFrameWorkload::RotatedSprites:
+		textures.push_back(MakeSpriteTexture(SPRITE_SIZE, rng));
+		quads = MakeScattered(desc, rng);
+		break;
+
+	case EFrameWorkload::FontHud:
+		for (int i = 0; i < GLYPH_COUNT; ++i) textures.push_back(MakeGlyphTexture(rng));
+		quads = MakeHud(desc, rng);
+		break;
+
+	case EFrameWorkload::BackgroundFlood:
+		textures.push_back(MakeGroundTexture(FLOOD_SIZE, rng));
+
+		//~ every layer covers the screen, shifted so the layers overlap
+		for (int layer = 0; layer < desc.ItemCount; ++layer)
+		{
+			const int shift = (layer * 13) % FLOOD_SIZE;
+			for (int y = -shift; y < static_cast<int>(desc.TargetHeight); y += FLOOD_SIZE)
+			{
+				for (int x = -shift; x < static_cast<int>(desc.TargetWidth); x += FLOOD_SIZE)
+				{
+					FRAME_QUAD quad{};
+					quad.start = { static_cast<float>(x), static_cast<float>(y) };
+					quads.push_back(quad);
+				}
+			}
+		}
+		break;
+
+	default:
+		return result;
+	}
+
+	const bool background = desc.Workload == EFrameWorkload::BackgroundFlood;
+	const bool rotating	  = desc.Workload == EFrameWorkload::RotatedSprites;
+
+	PEHeadlessPresentTarget target{};
+	const auto drawFrame = [&](int frame)
+	{
+		if (rotating)
+		{
+			const float half = 0.5f * static_cast<float>(SPRITE_SIZE - 1);
+			for (auto& quad : quads)
+			{
+				const FVector2D centre
+				{
+					quad.start.x + (quad.axisU.x + quad.axisV.x) * half,
+					quad.start.y + (quad.axisU.y + quad.axisV.y) * half
+				};
+				const float angle = quad.phase + 0.02f * static_cast<float>(frame);
+				quad.axisU = {  std::cos(angle), std::sin(angle) };
+				quad.axisV = { -quad.axisU.y,	 quad.axisU.x	 };
+				quad.start = { centre.x - (quad.axisU.x + quad.axisV.x) * half,
+							   centre.y - (quad.axisU.y + quad.axisV.y) * half };
+			}
+		}
+
+		raster.Clear(CLEAR_COLOR);
+		if (!background) raster.BeginTileBinning();
+		for (const auto& quad : quads)
+		{
+			SubmitQuad(raster, quad, *textures[std::min<size_t>(quad.glyph, textures.size() - 1u)], background);
+		}
+		if (!background) raster.FlushTileBins();
+		raster.Present(&target);
+	};
+
+	for (int frame = 0; frame < desc.WarmupFrames; ++frame) drawFrame(frame);
+
+	double totalMs = 0.0;
+	result.MinFrameMs = std::numeric_limits<double>::max();
+	for (int frame = 0; frame < desc.Frames; ++frame)
+	{
+		const auto begin = bench_clock::now();
+		drawFrame(desc.WarmupFrames + frame);
+		const double ms = std::chrono::duration<double, std::milli>(bench_clock::now() - begin).count();
+
+		totalMs			 += ms;
+		result.MinFrameMs = std::min(result.MinFrameMs, ms);
+		result.MaxFrameMs = std::max(result.MaxFrameMs, ms);
+	}
+
+	const double pixels = static_cast<double>(desc.TargetWidth) * static_cast<double>(desc.TargetHeight);
+	result.AverageFrameMs  = totalMs / static_cast<double>(desc.Frames);
+	result.NsPerPixel	   = result.AverageFrameMs * 1.0e6 / pixels;
+	result.FramesPerSecond = result.AverageFrameMs > 0.0 ? 1000.0 / result.AverageFrameMs : 0.0;
+	return result;
+}
+
+_Use_decl_annotations_
+PFE_SAMPLER_BENCH_RESULT PEFrameBench::RunSampler(const PFE_SAMPLER_BENCH_DESC& desc)
+{
+	PFE_SAMPLER_BENCH_RESULT result{};
+	if (desc.SourceSize == 0u || desc.OutputSize == 0u || desc.Iterations <= 0) return result;
+
+	std::mt19937 rng{ desc.Seed };
+	auto source = MakeSpriteTexture(static_cast<int>(desc.SourceSize), rng);
+
+	BilinearSampler& sampler = BilinearSampler::Instance();
+	const ESampleKernel kernel = sampler.GetKernel();
+	sampler.SetParallelTexels(desc.ParallelTexels);
+
+	const double texels = static_cast<double>(desc.OutputSize) * static_cast<double>(desc.OutputSize);
+
+	constexpr ESampleKernel kernels[] = { ESampleKernel::FloatPerPixel, ESampleKernel::FixedPoint };
+	std::unique_ptr<Texture> samples[2]{};
+	for (size_t k = 0; k < 2u; ++k)
+	{
+		sampler.SetKernel(kernels[k]);
+		samples[k] = sampler.SampleToSize(source.get(), desc.OutputSize, desc.OutputSize);
+
+		const auto begin = bench_clock::now();
+		for (int it = 0; it < desc.Iterations; ++it)
+		{
+			auto sampled = sampler.SampleToSize(source.get(), desc.OutputSize, desc.OutputSize);
+		}
+		const double ms = std::chrono::duration<double, std::milli>(bench_clock::now() - begin).count();
+
+		result.MsPerTexture[k] = ms / static_cast<double>(desc.Iterations);
+		result.NsPerPixel  [k] = result.MsPerTexture[k] * 1.0e6 / texels;
+	}
+	sampler.SetKernel(kernel);
+
+	if (samples[0] && samples[1])
+	{
+		const auto a = samples[0]->Data();
+		const auto b = samples[1]->Data();
+		const size_t bytes = static_cast<size_t>(samples[0]->GetRowStride()) * samples[0]->GetHeight();
+		for (size_t i = 0; i < bytes; ++i)
+		{
+			result.MaxDifference = std::max(result.MaxDifference, std::abs(int(a.data[i]) - int(b.data[i])));
+		}
+	}
+
+	result.Speedup = result.MsPerTexture[1] > 0.0 ? result.MsPerTexture[0] / result.MsPerTexture[1] : 0.0;
+	return result;
+}
+
+void PEFrameBench::RunDefaultSuite()
+{
+	struct Resolution { const char* name; UINT width; UINT height; };
+	constexpr Resolution resolutions[] =
+	{
+		{ "720p",  1280u, 720u	},
+		{ "1080p", 1920u, 1080u },
+		{ "1440p", 2560u, 1440u },
+	};
+
+	struct Workload { EFrameWorkload workload; int items; };
+	constexpr Workload workloads[] =
+	{
+		{ EFrameWorkload::Tiles,		   100	},
+		{ EFrameWorkload::Tiles,		   1000 },
+		{ EFrameWorkload::Tiles,		   5000 },
+		{ EFrameWorkload::RotatedSprites,  1000 },
+		{ EFrameWorkload::FontHud,		   4000 },
+		{ EFrameWorkload::BackgroundFlood, 3	},
+	};
+
+	//~ 1, 2, 4 ... up to the machine, then the machine itself if it is not a power of two
+	fox::vector<unsigned> workers{};
+	const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned count = 1u; count < hardware; count *= 2u) workers.push_back(count);
+	workers.push_back(hardware);
+
+	for (const auto& resolution : resolutions)
+	{
+		for (const auto& workload : workloads)
+		{
+			double singleMs = 0.0;
+			for (const unsigned count : workers)
+			{
+				PFE_FRAME_BENCH_DESC desc{};
+				desc.TargetWidth  = resolution.width;
+				desc.TargetHeight = resolution.height;
+				desc.Workload	  = workload.workload;
+				desc.ItemCount	  = workload.items;
+				desc.WorkerCount  = count;
+
+				const auto result = RunWorkload(desc);
+				if (count == 1u) singleMs = result.AverageFrameMs;
+
+				Report(
+					"[FrameBench] {} {} x{} on {} workers: {:.3f} ms ({:.3f} - {:.3f}), {:.2f} ns/px, {:.1f} fps, x{:.2f} over one worker",
+					resolution.name,
+					ToString(workload.workload),
+					workload.items,
+					count,
+					result.AverageFrameMs,
+					result.MinFrameMs,
+					result.MaxFrameMs,
+					result.NsPerPixel,
+					result.FramesPerSecond,
+					result.AverageFrameMs > 0.0 ? singleMs / result.AverageFrameMs : 0.0);
+			}
+		}
+	}
+
+	constexpr uint32_t outputs[] = { 32u, 64u, 128u, 512u };
+	for (const uint32_t output : outputs)
+	{
+		PFE_SAMPLER_BENCH_DESC desc{};
+		desc.OutputSize = output;
+		desc.Iterations = output >= 512u ? 20 : 200;
+
+		const auto sampler = RunSampler(desc);
+		Report(
+			"[FrameBench] bilinear 32px -> {}px: float {:.3f} ms ({:.2f} ns/px), fixed {:.3f} ms ({:.2f} ns/px), x{:.2f}, max diff {}",
+			output,
+			sampler.MsPerTexture[0],
+			sampler.NsPerPixel	[0],
+			sampler.MsPerTexture[1],
+			sampler.NsPerPixel	[1],
+			sampler.Speedup,
+			sampler.MaxDifference);
+	}
+}
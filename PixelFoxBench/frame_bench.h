@@ -0,0 +1,101 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "pixel_engine/core/types.h"
+
+#include <cstdint>
+#include <windows.h>
+
+namespace pixel_bench
+{
+	using pixel_engine::EPixelFormat;
+
+	enum class EFrameWorkload : uint8_t
+	{
+		Tiles,			// 32px opaque ground tiles scattered over the screen
+		RotatedSprites, // 32px keyed sprites turning a little every frame
+		FontHud,		// rows of 8x12 glyphs drawn 1:1 like RenderFont
+		BackgroundFlood, // full screen layers of 64px background quads
+		Count
+	};
+
+	typedef struct _PFE_FRAME_BENCH_DESC
+	{
+		_In_ UINT			TargetWidth { 1280u };
+		_In_ UINT			TargetHeight{ 720u	};
+		_In_ EFrameWorkload Workload	{ EFrameWorkload::Tiles };
+		_In_ int			ItemCount	{ 1000 }; // tiles, sprites, glyphs or flood layers
+		_In_ unsigned		WorkerCount { 4u   };
+		_In_ int			Frames		{ 30   };
+		_In_ int			WarmupFrames{ 3	   }; // not timed, first touch of the target
+		_In_ uint32_t		Seed		{ 1337u };
+
+		_In_ EPixelFormat TargetFormat{ EPixelFormat::R8G8B8A8 };
+	} PFE_FRAME_BENCH_DESC;
+
+	typedef struct _PFE_FRAME_BENCH_RESULT
+	{
+		//~ clear + binned draws + flush + present into a headless target
+		double AverageFrameMs{ 0.0 };
+		double MinFrameMs	 { 0.0 };
+		double MaxFrameMs	 { 0.0 };
+
+		double NsPerPixel	  { 0.0 }; // average frame over the target pixels
+		double FramesPerSecond{ 0.0 };
+	} PFE_FRAME_BENCH_RESULT;
+
+	typedef struct _PFE_SAMPLER_BENCH_DESC
+	{
+		_In_ uint32_t SourceSize	 { 32u	};
+		_In_ uint32_t OutputSize	 { 128u };
+		_In_ int	  Iterations	 { 200	};
+		_In_ uint32_t ParallelTexels { 128u * 128u }; // BilinearSampler::SetParallelTexels
+		_In_ uint32_t Seed			 { 1337u };
+	} PFE_SAMPLER_BENCH_DESC;
+
+	typedef struct _PFE_SAMPLER_BENCH_RESULT
+	{
+		//~ per output texel, indexed by ESampleKernel
+		double NsPerPixel  [2]{};
+		double MsPerTexture[2]{};
+		double Speedup		  { 0.0 }; // float per pixel over fixed point
+
+		//~ largest channel difference between the two kernels
+		int MaxDifference{ 0 };
+	} PFE_SAMPLER_BENCH_RESULT;
+
+	/// <summary>
+	/// Whole frame timings of the raster at game resolutions. Every frame
+	/// is redrawn in full through the binned path on the raster workers,
+	/// so the numbers show the hot path and how it scales with workers.
+	/// </summary>
+	class PEFrameBench
+	{
+	public:
+		_NODISCARD _Check_return_
+		static PFE_FRAME_BENCH_RESULT RunWorkload(_In_ const PFE_FRAME_BENCH_DESC& desc);
+
+		//~ BilinearSampler::SampleToSize with both kernels, the texture build
+		//~ done whenever a sprite scale changes
+		_NODISCARD _Check_return_
+		static PFE_SAMPLER_BENCH_RESULT RunSampler(_In_ const PFE_SAMPLER_BENCH_DESC& desc);
+
+		//~ 720p, 1080p and 1440p with 100 to 5000 tiles, rotated sprites,
+		//~ a font heavy hud and background floods, each at 1 to N workers,
+		//~ reports ns per pixel, fps and the speedup over one worker
+		static void RunDefaultSuite();
+
+		_NODISCARD _Check_return_
+		static const char* ToString(_In_ EFrameWorkload workload) noexcept;
+	};
+} // namespace pixel_bench
@@ -0,0 +1,44 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "bench_report.h"
+#include "frame_bench.h"
+#include "raster_bench.h"
+
+#include <cstdlib>
+#include <string_view>
+
+//~ PixelFoxBench.exe [raster|frame], runs every suite when no name is given
+int main(int argc, char** argv)
+{
+	const std::string_view suite = argc > 1 ? argv[1] : "all";
+	const bool all = suite == "all";
+
+	bool ran = false;
+	if (all || suite == "raster")
+	{
+		pixel_bench::PERasterBench::RunDefaultSuite();
+		ran = true;
+	}
+
+	if (all || suite == "frame")
+	{
+		pixel_bench::PEFrameBench::RunDefaultSuite();
+		ran = true;
+	}
+
+	if (!ran)
+	{
+		pixel_bench::Report("unknown suite '{}', expected raster, frame or all", suite);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
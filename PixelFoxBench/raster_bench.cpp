@@ -0,0 +1,742 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "raster_bench.h"
+#include "bench_report.h"
+
+#include "pixel_engine/render_manager/api/raster/raster.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+
+using namespace pixel_engine;
+using namespace pixel_bench;
+
+namespace
+{
+	using bench_clock = std::chrono::steady_clock;
+
+	//~ never produced by the bench textures, anything else was drawn
+	constexpr PFE_FORMAT_R8G8B8_UINT CLEAR_COLOR{ 255u, 0u, 255u };
+
+	//~ scheduler bench ground tile side, many small quads to stress submission
+	constexpr int SCHEDULER_TILE = 64;
+
+	//~ layer cache bench, ground tile side and camera pixels per frame
+	constexpr int GROUND_SIZE  = 256;
+	constexpr int SCROLL_SPEED = 3;
+
+	typedef struct _BENCH_SPRITE
+	{
+		FVector2D start{};
+		FVector2D axisU{};
+		FVector2D axisV{};
+	} BENCH_SPRITE;
+
+	//~ sprite like texture, a disc of colour on a black (keyed) background
+	std::unique_ptr<Texture> MakeTexture(int size, std::mt19937& rng)
+	{
+		std::uniform_int_distribution<int> channel(11, 250);
+		std::uniform_int_distribution<int> holes  (0, 15);
+
+		fox::vector<unsigned char> data{};
+		data.resize(static_cast<size_t>(size) * size * 4u);
+
+		const float centre = 0.5f * static_cast<float>(size - 1);
+		const float radius = 0.45f * static_cast<float>(size);
+
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				const float dx = static_cast<float>(x) - centre;
+				const float dy = static_cast<float>(y) - centre;
+				const bool transparent = (dx * dx + dy * dy > radius * radius) || holes(rng) == 0;
+
+				const size_t i = (static_cast<size_t>(y) * size + x) * 4u;
+				data[i + 0] = transparent ? 0u : static_cast<unsigned char>(channel(rng));
+				data[i + 1] = transparent ? 0u : static_cast<unsigned char>(channel(rng));
+				data[i + 2] = transparent ? 0u : static_cast<unsigned char>(channel(rng));
+				data[i + 3] = 255u;
+			}
+		}
+
+		return std::make_unique<Texture>(
+			"raster_bench",
+			static_cast<uint32_t>(size),
+			static_cast<uint32_t>(size),
+			TextureFormat::RGBA8,
+			ColorSpace::sRGB,
+			std::move(data));
+	}
+
+	//~ ground like texture, every texel opaque
+	std::unique_ptr<Texture> MakeGroundTexture(int size, std::mt19937& rng)
+	{
+		std::uniform_int_distribution<int> channel(11, 250);
+
+		fox::vector<unsigned char> data{};
+		data.resize(static_cast<size_t>(size) * size * 4u);
+		for (size_t i = 0; i < data.size(); i += 4u)
+		{
+			data[i + 0] = static_cast<unsigned char>(channel(rng));
+			data[i + 1] = static_cast<unsigned char>(channel(rng));
+			data[i + 2] = static_cast<unsigned char>(channel(rng));
+			data[i + 3] = 255u;
+		}
+
+		return std::make_unique<Texture>(
+			"raster_bench_ground",
+			static_cast<uint32_t>(size),
+			static_cast<uint32_t>(size),
+			TextureFormat::RGBA8,
+			ColorSpace::sRGB,
+			std::move(data));
+	}
+
+	fox::vector<BENCH_SPRITE> MakeSprites(const PFE_RASTER_BENCH_DESC& desc, std::mt19937& rng)
+	{
+		const float c	 = std::cos(desc.Rotation) * desc.Scale;
+		const float s	 = std::sin(desc.Rotation) * desc.Scale;
+		const float half = 0.5f * static_cast<float>(desc.SpriteSize) * desc.Scale;
+
+		std::uniform_real_distribution<float> px(-half, static_cast<float>(desc.TargetWidth ) + half);
+		std::uniform_real_distribution<float> py(-half, static_cast<float>(desc.TargetHeight) + half);
+
+		fox::vector<BENCH_SPRITE> sprites{};
+		sprites.reserve(static_cast<size_t>(desc.SpriteCount));
+		for (int i = 0; i < desc.SpriteCount; ++i)
+		{
+			BENCH_SPRITE sprite{};
+			sprite.axisU = { c,  s };
+			sprite.axisV = { -s, c };
+			sprite.start = { px(rng), py(rng) };
+			sprites.push_back(sprite);
+		}
+		return sprites;
+	}
+
+	//~ texel footprint of the sprite plus a pixel of slack, as the render queue marks it
+	PFE_AABB2D SpriteBounds(const BENCH_SPRITE& sprite, int size)
+	{
+		const float n = static_cast<float>(size);
+		const FVector2D a{ sprite.start.x - 0.5f * (sprite.axisU.x + sprite.axisV.x),
+						   sprite.start.y - 0.5f * (sprite.axisU.y + sprite.axisV.y) };
+		const FVector2D b{ a.x + sprite.axisU.x * n, a.y + sprite.axisU.y * n };
+		const FVector2D c{ a.x + sprite.axisV.x * n, a.y + sprite.axisV.y * n };
+		const FVector2D d{ b.x + sprite.axisV.x * n, b.y + sprite.axisV.y * n };
+
+		PFE_AABB2D box{};
+		box.minX = std::min(std::min(a.x, b.x), std::min(c.x, d.x)) - 1.0f;
+		box.maxX = std::max(std::max(a.x, b.x), std::max(c.x, d.x)) + 1.0f;
+		box.minY = std::min(std::min(a.y, b.y), std::min(c.y, d.y)) - 1.0f;
+		box.maxY = std::max(std::max(a.y, b.y), std::max(c.y, d.y)) + 1.0f;
+		return box;
+	}
+
+	void DrawBinned(PERaster2D& raster, const fox::vector<BENCH_SPRITE>& sprites, const Texture& texture)
+	{
+		const int size = static_cast<int>(texture.GetWidth());
+		raster.BeginTileBinning();
+		for (const auto& sprite : sprites)
+		{
+			PFE_RASTER_DRAW_CMD cmd
+			{
+				.startBase		 = sprite.start,
+				.deltaAxisU		 = sprite.axisU,
+				.deltaAxisV		 = sprite.axisV,
+				.columnStartFrom = 0,
+				.columneEndAt	 = size,
+				.rowStartFrom	 = 0,
+				.rowEndAt		 = size,
+				.totalColumns	 = size,
+				.totalRows		 = size,
+				.sampledTexture	 = &texture,
+				.color			 = CLEAR_COLOR,
+			};
+			raster.SubmitQuadTile(cmd);
+		}
+		raster.FlushTileBins();
+	}
+
+	//~ one render queue style frame, damage then clear then the binned draws
+	void DrawDamagedFrame(
+		PERaster2D&						  raster,
+		const fox::vector<BENCH_SPRITE>& sprites,
+		const Texture&					  texture,
+		bool							  fullRedraw,
+		const PFE_AABB2D*				  damage,
+		size_t							  damageCount)
+	{
+		raster.BeginDamage(fullRedraw);
+		for (size_t i = 0; i < damageCount; ++i) raster.AddDamage(damage[i]);
+		raster.EndDamage();
+		raster.ClearDamage();
+
+		DrawBinned(raster, sprites, texture);
+	}
+
+	uint64_t CountCoverage(const PEImageBuffer& target)
+	{
+		uint64_t covered = 0u;
+		for (UINT y = 0; y < target.Height(); ++y)
+		{
+			const unsigned char* row = target.Data() + static_cast<size_t>(y) * target.RowPitch();
+			for (UINT x = 0; x < target.Width(); ++x, row += target.PixelSize())
+			{
+				if (row[0] != CLEAR_COLOR.R.Value ||
+					row[1] != CLEAR_COLOR.G.Value ||
+					row[2] != CLEAR_COLOR.B.Value) ++covered;
+			}
+		}
+		return covered;
+	}
+
+	void DrawAll(PERaster2D& raster, const fox::vector<BENCH_SPRITE>& sprites, const Texture& texture)
+	{
+		const int size = static_cast<int>(texture.GetWidth());
+		for (const auto& sprite : sprites)
+		{
+			PFE_RASTER_DRAW_CMD cmd
+			{
+				.startBase		 = sprite.start,
+				.deltaAxisU		 = sprite.axisU,
+				.deltaAxisV		 = sprite.axisV,
+				.columnStartFrom = 0,
+				.columneEndAt	 = size,
+				.rowStartFrom	 = 0,
+				.rowEndAt		 = size,
+				.totalColumns	 = size,
+				.totalRows		 = size,
+				.sampledTexture	 = &texture,
+				.color			 = CLEAR_COLOR,
+			};
+			raster.DrawQuadTile(cmd);
+		}
+	}
+
+	double TimeKernel(
+		PERaster2D&						  raster,
+		ERasterKernel					  kernel,
+		const fox::vector<BENCH_SPRITE>& sprites,
+		const Texture&					  texture,
+		int								  iterations,
+		uint64_t&						  coverage)
+	{
+		raster.SetQuadKernel(kernel);
+
+		//~ warm up pass doubles as the coverage sample
+		raster.Clear(CLEAR_COLOR);
+		DrawAll(raster, sprites, texture);
+		coverage = CountCoverage(*raster.GetRenderTarget());
+
+		double totalMs = 0.0;
+		for (int it = 0; it < iterations; ++it)
+		{
+			raster.Clear(CLEAR_COLOR);
+
+			const auto begin = bench_clock::now();
+			DrawAll(raster, sprites, texture);
+			const auto end	 = bench_clock::now();
+
+			totalMs += std::chrono::duration<double, std::milli>(end - begin).count();
+		}
+		return totalMs / static_cast<double>(std::max(1, iterations));
+	}
+
+	using blit_call = void(*)(EBlitPath, uint8_t*, const uint8_t*, int) noexcept;
+
+	double TimeBlit(
+		blit_call					 blit,
+		EBlitPath					 path,
+		fox::vector<uint8_t>&		 dst,
+		const fox::vector<uint8_t>& src,
+		const PFE_BLIT_BENCH_DESC&	 desc)
+	{
+		const size_t dstRow = static_cast<size_t>(desc.RowPixels) * PixelFormatSize(desc.TargetFormat);
+		const size_t srcRow = static_cast<size_t>(desc.RowPixels) * 4u;
+
+		const auto begin = bench_clock::now();
+		for (int it = 0; it < desc.Iterations; ++it)
+		{
+			for (int row = 0; row < desc.Rows; ++row)
+			{
+				blit(path, dst.data() + dstRow * row, src.data() + srcRow * row, desc.RowPixels);
+			}
+		}
+		const auto end = bench_clock::now();
+
+		const double seconds = std::chrono::duration<double>(end - begin).count();
+		const double pixels	 = static_cast<double>(desc.RowPixels) * desc.Rows * desc.Iterations;
+		return seconds > 0.0 ? pixels / seconds : 0.0;
+	}
+
+	void BlendFullOpacity(EBlitPath path, uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		PEBlitKernels::BlendPremultipliedRGBA(path, dst, src, count, 255u);
+	}
+
+	void BlendFullOpacity32(EBlitPath path, uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		PEBlitKernels::BlendPremultipliedRGBA32(path, dst, src, count, 255u);
+	}
+
+	double TimeClear(PERaster2D& raster, int iterations)
+	{
+		const auto begin = bench_clock::now();
+		for (int it = 0; it < iterations; ++it)
+		{
+			raster.Clear(CLEAR_COLOR);
+		}
+		const auto end = bench_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - begin).count() /
+			   static_cast<double>(std::max(1, iterations));
+	}
+} // namespace
+
+_Use_decl_annotations_
+PFE_RASTER_BENCH_RESULT PERasterBench::RunQuadKernels(const PFE_RASTER_BENCH_DESC& desc)
+{
+	PFE_RASTER_BENCH_RESULT result{};
+	if (desc.SpriteSize <= 0 || desc.SpriteCount <= 0) return result;
+
+	PFE_RASTER_CONSTRUCT_DESC construct{};
+	construct.Viewport		   = { 0u, 0u, desc.TargetWidth, desc.TargetHeight };
+	construct.EnableBoundCheck = true;
+	construct.TargetFormat	   = desc.TargetFormat;
+
+	PERaster2D raster{ &construct };
+
+	PFE_RASTER_INIT_DESC init{};
+	init.WorkerCount	   = 1u;
+	init.EnableTileBinning = false;
+	if (!raster.Init(&init)) return result;
+
+	std::mt19937 rng{ desc.Seed };
+	auto texture = MakeTexture(desc.SpriteSize, rng);
+	const auto sprites = MakeSprites(desc, rng);
+
+	result.ForwardMs = TimeKernel(
+		raster, ERasterKernel::ForwardMapped, sprites, *texture,
+		desc.Iterations, result.ForwardCoverage);
+
+	result.SpanMs = TimeKernel(
+		raster, ERasterKernel::InverseSpan, sprites, *texture,
+		desc.Iterations, result.SpanCoverage);
+
+	//~ same kernel once the texture carries its run length coverage
+	uint64_t coveredPixels = 0u;
+	texture->BuildCoverage();
+	result.SpanWithRunsMs = TimeKernel(
+		raster, ERasterKernel::InverseSpan, sprites, *texture,
+		desc.Iterations, coveredPixels);
+
+	result.ClearMs = TimeClear(raster, desc.Iterations);
+	result.Speedup = result.SpanMs > 0.0 ? result.ForwardMs / result.SpanMs : 0.0;
+	return result;
+}
+
+_Use_decl_annotations_
+PFE_DAMAGE_BENCH_RESULT PERasterBench::RunDamageFrames(const PFE_RASTER_BENCH_DESC& desc)
+{
+	PFE_DAMAGE_BENCH_RESULT result{};
+	if (desc.SpriteSize <= 0 || desc.SpriteCount <= 0) return result;
+
+	PFE_RASTER_CONSTRUCT_DESC construct{};
+	construct.Viewport		   = { 0u, 0u, desc.TargetWidth, desc.TargetHeight };
+	construct.EnableBoundCheck = true;
+	construct.TargetFormat	   = desc.TargetFormat;
+	construct.ClearColor	   = CLEAR_COLOR;
+
+	PERaster2D raster{ &construct };
+
+	PFE_RASTER_INIT_DESC init{};
+	init.WorkerCount		  = 1u;
+	init.EnableTileBinning	  = true;
+	init.EnableDamageTracking = true;
+	if (!raster.Init(&init)) return result;
+
+	std::mt19937 rng{ desc.Seed };
+	auto texture = MakeTexture(desc.SpriteSize, rng);
+	texture->BuildCoverage();
+	auto sprites = MakeSprites(desc, rng);
+
+	const int  iterations = std::max(1, desc.Iterations);
+	const auto timeFrames = [&](auto&& frame)
+	{
+		const auto begin = bench_clock::now();
+		for (int it = 0; it < iterations; ++it) frame(it);
+		const auto end	 = bench_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / static_cast<double>(iterations);
+	};
+
+	result.FullFrameMs = timeFrames([&](int)
+	{
+		DrawDamagedFrame(raster, sprites, *texture, true, nullptr, 0u);
+	});
+
+	//~ the last sprite steps back and forth by a pixel
+	BENCH_SPRITE& moving = sprites.back();
+	result.OneSpriteMs = timeFrames([&](int it)
+	{
+		PFE_AABB2D damage[2]{};
+		damage[0] = SpriteBounds(moving, desc.SpriteSize);
+		moving.start.x += (it & 1) ? -1.0f : 1.0f;
+		damage[1] = SpriteBounds(moving, desc.SpriteSize);
+
+		DrawDamagedFrame(raster, sprites, *texture, false, damage, 2u);
+	});
+	result.OneSpriteTiles = 0u;
+	for (const auto& rect : raster.GetDamageRects())
+	{
+		const int tile = std::max(1, init.BinTileSize);
+		result.OneSpriteTiles += static_cast<size_t>((rect.maxX - rect.minX + tile - 1) / tile) *
+								 static_cast<size_t>((rect.maxY - rect.minY + tile - 1) / tile);
+	}
+
+	result.StaticFrameMs = timeFrames([&](int)
+	{
+		DrawDamagedFrame(raster, sprites, *texture, false, nullptr, 0u);
+	});
+	return result;
+}
+
+_Use_decl_annotations_
+PFE_SCHEDULER_BENCH_RESULT PERasterBench::RunSchedulers(const PFE_RASTER_BENCH_DESC& desc)
+{
+	PFE_SCHEDULER_BENCH_RESULT result{};
+	if (desc.SpriteSize <= 0 || desc.SpriteCount <= 0) return result;
+
+	std::mt19937 rng{ desc.Seed };
+	auto ground	 = MakeGroundTexture(SCHEDULER_TILE, rng);
+	auto texture = MakeTexture(desc.SpriteSize, rng);
+	texture->BuildCoverage();
+	auto sprites = MakeSprites(desc, rng);
+
+	const auto timeScheduler = [&](ERasterScheduler scheduler)
+	{
+		PFE_RASTER_CONSTRUCT_DESC construct{};
+		construct.Viewport		   = { 0u, 0u, desc.TargetWidth, desc.TargetHeight };
+		construct.EnableBoundCheck = true;
+		construct.TargetFormat	   = desc.TargetFormat;
+		construct.ClearColor	   = CLEAR_COLOR;
+
+		PERaster2D raster{ &construct };
+
+		PFE_RASTER_INIT_DESC init{};
+		init.EnableTileBinning	  = true;
+		init.EnableDamageTracking = false;
+		init.EnableLayerCache	  = false;
+		init.Scheduler			  = scheduler;
+		if (!raster.Init(&init)) return 0.0;
+
+		const int iterations = std::max(1, desc.Iterations);
+		const auto begin = bench_clock::now();
+		for (int it = 0; it < iterations; ++it)
+		{
+			raster.Clear(CLEAR_COLOR);
+
+			for (UINT y = 0; y < desc.TargetHeight; y += SCHEDULER_TILE)
+			{
+				for (UINT x = 0; x < desc.TargetWidth; x += SCHEDULER_TILE)
+				{
+					const FVector2D start{ static_cast<float>(x), static_cast<float>(y) };
+					const FVector2D axisU{ 1.0f, 0.0f };
+					const FVector2D axisV{ 0.0f, 1.0f };
+
+					PFE_RASTER_DRAW_CMD cmd
+					{
+						.startBase		 = start,
+						.deltaAxisU		 = axisU,
+						.deltaAxisV		 = axisV,
+						.columnStartFrom = 0,
+						.columneEndAt	 = SCHEDULER_TILE,
+						.rowStartFrom	 = 0,
+						.rowEndAt		 = SCHEDULER_TILE,
+						.totalColumns	 = SCHEDULER_TILE,
+						.totalRows		 = SCHEDULER_TILE,
+						.sampledTexture	 = ground.get(),
+						.color			 = CLEAR_COLOR,
+					};
+					raster.DrawQuadBackground(cmd);
+				}
+			}
+
+			DrawBinned(raster, sprites, *texture);
+		}
+		const auto end = bench_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - begin).count() / static_cast<double>(iterations);
+	};
+
+	result.SharedQueueMs  = timeScheduler(ERasterScheduler::SharedQueue);
+	result.WorkStealingMs = timeScheduler(ERasterScheduler::WorkStealing);
+	return result;
+}
+
+_Use_decl_annotations_
+PFE_LAYER_BENCH_RESULT PERasterBench::RunLayerCache(const PFE_RASTER_BENCH_DESC& desc)
+{
+	PFE_LAYER_BENCH_RESULT result{};
+	if (desc.SpriteSize <= 0 || desc.SpriteCount <= 0) return result;
+
+	PE_IMAGE_BUFFER_DESC targetDesc{};
+	targetDesc.Width  = desc.TargetWidth;
+	targetDesc.Height = desc.TargetHeight;
+	targetDesc.Format = desc.TargetFormat;
+	PEImageBuffer target{ targetDesc };
+
+	std::mt19937 rng{ desc.Seed };
+	auto ground	  = MakeGroundTexture(GROUND_SIZE, rng);
+	auto obstacle = MakeTexture(desc.SpriteSize, rng);
+	obstacle->BuildCoverage();
+
+	const int iterations = std::max(1, desc.Iterations);
+	const int width		 = static_cast<int>(desc.TargetWidth);
+	const int height	 = static_cast<int>(desc.TargetHeight);
+	const int travel	 = iterations * SCROLL_SPEED;
+
+	//~ ground under everything the camera passes over, obstacles on top
+	fox::vector<PFE_LAYER_QUAD> quads{};
+	for (int y = -GROUND_SIZE; y < height + GROUND_SIZE; y += GROUND_SIZE)
+	{
+		for (int x = -GROUND_SIZE; x < width + travel + GROUND_SIZE; x += GROUND_SIZE)
+		{
+			PFE_LAYER_QUAD quad{};
+			quad.startBase		= { static_cast<float>(x), static_cast<float>(y) };
+			quad.deltaAxisU		= { 1.0f, 0.0f };
+			quad.deltaAxisV		= { 0.0f, 1.0f };
+			quad.totalColumns	= GROUND_SIZE;
+			quad.totalRows		= GROUND_SIZE;
+			quad.sampledTexture = ground.get();
+			quad.opaque			= true;
+			quads.push_back(quad);
+		}
+	}
+
+	std::uniform_real_distribution<float> px(0.0f, static_cast<float>(width + travel));
+	std::uniform_real_distribution<float> py(0.0f, static_cast<float>(height));
+	for (int i = 0; i < desc.SpriteCount / 4; ++i)
+	{
+		PFE_LAYER_QUAD quad{};
+		quad.startBase		= { px(rng), py(rng) };
+		quad.deltaAxisU		= { desc.Scale, 0.0f };
+		quad.deltaAxisV		= { 0.0f, desc.Scale };
+		quad.totalColumns	= desc.SpriteSize;
+		quad.totalRows		= desc.SpriteSize;
+		quad.sampledTexture = obstacle.get();
+		quads.push_back(quad);
+	}
+
+	const PFE_SPAN_CLIP clip{ 0, 0, width, height };
+	const auto timeFrames = [&](auto&& frame)
+	{
+		const auto begin = bench_clock::now();
+		for (int it = 0; it < iterations; ++it) frame(it);
+		const auto end	 = bench_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / static_cast<double>(iterations);
+	};
+
+	result.DirectMs = timeFrames([&](int it)
+	{
+		target.ClearImageBuffer(CLEAR_COLOR);
+
+		const float scroll = static_cast<float>(it * SCROLL_SPEED);
+		for (const auto& quad : quads)
+		{
+			const FVector2D start{ quad.startBase.x - scroll, quad.startBase.y };
+
+			PFE_SPAN_QUAD span{};
+			if (!PESpanRasterizer::Setup(start, quad.deltaAxisU, quad.deltaAxisV, quad.totalColumns, quad.totalRows, span)) continue;
+
+			if (quad.opaque) PESpanRasterizer::DrawTextureOpaque(target, span, *quad.sampledTexture, clip);
+			else			 PESpanRasterizer::DrawTexture		(target, span, *quad.sampledTexture, clip);
+		}
+	});
+
+	PFE_LAYER_CACHE_DESC cacheDesc{};
+	cacheDesc.ViewWidth	 = desc.TargetWidth;
+	cacheDesc.ViewHeight = desc.TargetHeight;
+	cacheDesc.Format	 = desc.TargetFormat;
+	cacheDesc.ClearColor = CLEAR_COLOR;
+
+	PELayerCache cache{};
+	cache.Init(cacheDesc);
+	cache.SetQuads(quads);
+
+	size_t redrawn = 0u;
+	result.CachedMs = timeFrames([&](int it)
+	{
+		cache.Composite(target, -it * SCROLL_SPEED, 0, &clip, 1u);
+		redrawn += cache.GetRedrawnPixels();
+	});
+	result.RedrawnPixels = static_cast<double>(redrawn) / static_cast<double>(iterations);
+	return result;
+}
+
+_Use_decl_annotations_
+PFE_BLIT_BENCH_RESULT PERasterBench::RunBlitKernels(const PFE_BLIT_BENCH_DESC& desc)
+{
+	PFE_BLIT_BENCH_RESULT result{};
+	if (desc.RowPixels <= 0 || desc.Rows <= 0 || desc.Iterations <= 0) return result;
+
+	const size_t pixels = static_cast<size_t>(desc.RowPixels) * desc.Rows;
+
+	fox::vector<uint8_t> src{};
+	fox::vector<uint8_t> blend{};
+	fox::vector<uint8_t> dst{};
+	src.resize(pixels * 4u);
+	blend.resize(pixels * 4u);
+	dst.resize(pixels * PixelFormatSize(desc.TargetFormat), 0u);
+
+	std::mt19937 rng{ desc.Seed };
+	std::uniform_int_distribution<int>	   channel(11, 250);
+	std::uniform_real_distribution<float> keyed	 (0.0f, 1.0f);
+
+	for (size_t i = 0; i < pixels; ++i)
+	{
+		const bool black = keyed(rng) < desc.KeyedRatio;
+		src[i * 4u + 0u] = black ? 0u : static_cast<uint8_t>(channel(rng));
+		src[i * 4u + 1u] = black ? 0u : static_cast<uint8_t>(channel(rng));
+		src[i * 4u + 2u] = black ? 0u : static_cast<uint8_t>(channel(rng));
+		src[i * 4u + 3u] = 255u;
+
+		//~ same texels premultiplied by a random alpha, black ones fully transparent
+		const uint32_t alpha = black ? 0u : static_cast<uint32_t>(channel(rng));
+		for (size_t c = 0; c < 3u; ++c)
+		{
+			blend[i * 4u + c] = static_cast<uint8_t>((src[i * 4u + c] * alpha + 127u) / 255u);
+		}
+		blend[i * 4u + 3u] = static_cast<uint8_t>(alpha);
+	}
+
+	blit_call keyedBlit	 = &PEBlitKernels::BlitKeyedRGBA;
+	blit_call opaqueBlit = &PEBlitKernels::BlitOpaqueRGBA;
+	blit_call blendBlit	 = &BlendFullOpacity;
+	if (desc.TargetFormat == EPixelFormat::R8G8B8A8)
+	{
+		keyedBlit  = &PEBlitKernels::BlitKeyedRGBA32;
+		opaqueBlit = &PEBlitKernels::BlitOpaqueRGBA32;
+		blendBlit  = &BlendFullOpacity32;
+	}
+
+	for (size_t p = 0; p < static_cast<size_t>(EBlitPath::Count); ++p)
+	{
+		const auto path = static_cast<EBlitPath>(p);
+		if (!PEBlitKernels::IsSupported(path)) continue;
+
+		result.KeyedPixelsPerSec [p] = TimeBlit(keyedBlit,	path, dst, src,	  desc);
+		result.OpaquePixelsPerSec[p] = TimeBlit(opaqueBlit, path, dst, src,	  desc);
+		result.BlendPixelsPerSec [p] = TimeBlit(blendBlit,	path, dst, blend, desc);
+	}
+	return result;
+}
+
+void PERasterBench::RunDefaultSuite()
+{
+	struct BenchCase { const char* name; float scale; float rotation; };
+	constexpr BenchCase cases[] =
+	{
+		{ "32px axis aligned", 1.0f, 0.0f	},
+		{ "32px rotated 30deg", 1.0f, 0.5236f },
+		{ "32px magnified x2",	2.0f, 0.0f	},
+	};
+
+	//~ the 24 bit target stays around to compare against the 32 bit one
+	constexpr EPixelFormat formats[] = { EPixelFormat::R8G8B8, EPixelFormat::R8G8B8A8 };
+
+	for (const EPixelFormat format : formats)
+	{
+		const size_t bits = PixelFormatSize(format) * 8u;
+
+		for (const auto& bench : cases)
+		{
+			PFE_RASTER_BENCH_DESC desc{};
+			desc.Scale		  = bench.scale;
+			desc.Rotation	  = bench.rotation;
+			desc.TargetFormat = format;
+
+			const auto result = RunQuadKernels(desc);
+			Report(
+				"[RasterBench] {} bit {}: forward {:.3f} ms, span {:.3f} ms (x{:.2f}), span + runs {:.3f} ms, coverage {} -> {}",
+				bits,
+				bench.name,
+				result.ForwardMs,
+				result.SpanMs,
+				result.Speedup,
+				result.SpanWithRunsMs,
+				result.ForwardCoverage,
+				result.SpanCoverage);
+		}
+
+		PFE_RASTER_BENCH_DESC damageDesc{};
+		damageDesc.TargetFormat = format;
+
+		const auto damage = RunDamageFrames(damageDesc);
+		Report(
+			"[RasterBench] {} bit damage: full {:.3f} ms, one sprite moved {:.3f} ms ({} tiles), static {:.3f} ms",
+			bits,
+			damage.FullFrameMs,
+			damage.OneSpriteMs,
+			damage.OneSpriteTiles,
+			damage.StaticFrameMs);
+
+		PFE_RASTER_BENCH_DESC schedulerDesc{};
+		schedulerDesc.TargetFormat = format;
+
+		const auto schedulers = RunSchedulers(schedulerDesc);
+		Report(
+			"[RasterBench] {} bit schedulers: shared queue {:.3f} ms, work stealing {:.3f} ms",
+			bits,
+			schedulers.SharedQueueMs,
+			schedulers.WorkStealingMs);
+
+		PFE_RASTER_BENCH_DESC layerDesc{};
+		layerDesc.Iterations   = 200;
+		layerDesc.TargetFormat = format;
+
+		const auto layer = RunLayerCache(layerDesc);
+		Report(
+			"[RasterBench] {} bit layer cache: direct {:.3f} ms, cached {:.3f} ms, {:.0f} px redrawn per frame",
+			bits,
+			layer.DirectMs,
+			layer.CachedMs,
+			layer.RedrawnPixels);
+
+		PFE_RASTER_BENCH_DESC clearDesc{};
+		clearDesc.SpriteCount  = 1;
+		clearDesc.TargetFormat = format;
+		Report("[RasterBench] {} bit clear: {:.3f} ms", bits, RunQuadKernels(clearDesc).ClearMs);
+
+		PFE_BLIT_BENCH_DESC blitDesc{};
+		blitDesc.TargetFormat = format;
+
+		const auto blit = RunBlitKernels(blitDesc);
+		for (size_t p = 0; p < static_cast<size_t>(EBlitPath::Count); ++p)
+		{
+			const auto path = static_cast<EBlitPath>(p);
+			if (!PEBlitKernels::IsSupported(path)) continue;
+
+			Report(
+				"[RasterBench] {} bit blit {}: keyed {:.1f} Mpx/s, opaque {:.1f} Mpx/s, blend {:.1f} Mpx/s",
+				bits,
+				PEBlitKernels::ToString(path),
+				blit.KeyedPixelsPerSec [p] / 1.0e6,
+				blit.OpaquePixelsPerSec[p] / 1.0e6,
+				blit.BlendPixelsPerSec [p] / 1.0e6);
+		}
+	}
+	Report("[RasterBench] active blit path: {}", PEBlitKernels::ToString(PEBlitKernels::GetActivePath()));
+}
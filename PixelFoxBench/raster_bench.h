@@ -0,0 +1,139 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "pixel_engine/core/types.h"
+#include "pixel_engine/render_manager/api/raster/blit/blit_kernels.h"
+
+#include <cstdint>
+#include <windows.h>
+
+namespace pixel_bench
+{
+	using pixel_engine::EBlitPath;
+	using pixel_engine::EPixelFormat;
+
+	typedef struct _PFE_RASTER_BENCH_DESC
+	{
+		_In_ UINT	  TargetWidth { 1280u };
+		_In_ UINT	  TargetHeight{ 720u  };
+		_In_ int	  SpriteSize  { 32	  }; // texels per side, same as the game tiles
+		_In_ int	  SpriteCount { 2000  };
+		_In_ int	  Iterations  { 50	  };
+		_In_ float	  Scale		  { 1.0f  }; // screen pixels per texel
+		_In_ float	  Rotation	  { 0.0f  }; // radians, applied to every sprite
+		_In_ uint32_t Seed		  { 1337u };
+
+		_In_ EPixelFormat TargetFormat{ EPixelFormat::R8G8B8A8 };
+	} PFE_RASTER_BENCH_DESC;
+
+	typedef struct _PFE_RASTER_BENCH_RESULT
+	{
+		//~ average milliseconds for drawing every sprite once
+		double ForwardMs{ 0.0 };
+		double SpanMs	{ 0.0 };
+		double Speedup	{ 0.0 };
+
+		//~ span kernel after Texture::BuildCoverage
+		double SpanWithRunsMs{ 0.0 };
+
+		//~ average milliseconds for one full target clear
+		double ClearMs{ 0.0 };
+
+		//~ pixels left untouched by the clear after one pass, shows holes
+		uint64_t ForwardCoverage{ 0u };
+		uint64_t SpanCoverage	{ 0u };
+	} PFE_RASTER_BENCH_RESULT;
+
+	typedef struct _PFE_DAMAGE_BENCH_RESULT
+	{
+		//~ average milliseconds for damage + clear + binned draw + flush
+		double FullFrameMs	{ 0.0 }; // everything redrawn
+		double OneSpriteMs	{ 0.0 }; // a single sprite moved
+		double StaticFrameMs{ 0.0 }; // nothing changed
+
+		//~ tiles redrawn when one sprite moved
+		size_t OneSpriteTiles{ 0u };
+	} PFE_DAMAGE_BENCH_RESULT;
+
+	typedef struct _PFE_SCHEDULER_BENCH_RESULT
+	{
+		//~ average milliseconds per frame of queued backgrounds plus binned sprites
+		double SharedQueueMs { 0.0 };
+		double WorkStealingMs{ 0.0 };
+	} PFE_SCHEDULER_BENCH_RESULT;
+
+	typedef struct _PFE_LAYER_BENCH_RESULT
+	{
+		//~ average milliseconds per frame while the camera scrolls
+		double DirectMs{ 0.0 }; // clear and draw every static quad
+		double CachedMs{ 0.0 }; // PELayerCache composite
+
+		//~ average layer pixels redrawn per cached frame
+		double RedrawnPixels{ 0.0 };
+	} PFE_LAYER_BENCH_RESULT;
+
+	typedef struct _PFE_BLIT_BENCH_DESC
+	{
+		_In_ int	  RowPixels	 { 32	 }; // span length handed to the blit
+		_In_ int	  Rows		 { 4096	 };
+		_In_ int	  Iterations { 200	 };
+		_In_ float	  KeyedRatio { 0.25f }; // share of black (transparent) texels
+		_In_ uint32_t Seed		 { 1337u };
+
+		_In_ EPixelFormat TargetFormat{ EPixelFormat::R8G8B8A8 };
+	} PFE_BLIT_BENCH_DESC;
+
+	typedef struct _PFE_BLIT_BENCH_RESULT
+	{
+		//~ indexed by EBlitPath, zero when the CPU lacks the path
+		double KeyedPixelsPerSec [static_cast<size_t>(EBlitPath::Count)]{};
+		double OpaquePixelsPerSec[static_cast<size_t>(EBlitPath::Count)]{};
+
+		//~ premultiplied source over, every visible texel is translucent
+		double BlendPixelsPerSec [static_cast<size_t>(EBlitPath::Count)]{};
+	} PFE_BLIT_BENCH_RESULT;
+
+	/// <summary>
+	/// Offline timing of the quad kernels on a private render target.
+	/// Runs single threaded with tile binning off so only the per pixel
+	/// kernel cost is measured.
+	/// </summary>
+	class PERasterBench
+	{
+	public:
+		_NODISCARD _Check_return_
+		static PFE_RASTER_BENCH_RESULT RunQuadKernels(_In_ const PFE_RASTER_BENCH_DESC& desc);
+
+		//~ binned frames with damage tracking, one worker
+		_NODISCARD _Check_return_
+		static PFE_DAMAGE_BENCH_RESULT RunDamageFrames(_In_ const PFE_RASTER_BENCH_DESC& desc);
+
+		//~ a screen of small ground tiles then the binned sprites, once per
+		//~ raster scheduler with the same worker count
+		_NODISCARD _Check_return_
+		static PFE_SCHEDULER_BENCH_RESULT RunSchedulers(_In_ const PFE_RASTER_BENCH_DESC& desc);
+
+		//~ opaque ground tiles plus keyed obstacles scrolled a few pixels a
+		//~ frame, drawn directly and through the layer cache
+		_NODISCARD _Check_return_
+		static PFE_LAYER_BENCH_RESULT RunLayerCache(_In_ const PFE_RASTER_BENCH_DESC& desc);
+
+		//~ pixels per second of every blit path the CPU supports
+		_NODISCARD _Check_return_
+		static PFE_BLIT_BENCH_RESULT RunBlitKernels(_In_ const PFE_BLIT_BENCH_DESC& desc);
+
+		//~ quad kernels on 32px sprites, damage tracked frames, the schedulers, the layer cache and the blit
+		//~ paths for the 24 and 32 bit targets, logs every case
+		static void RunDefaultSuite();
+	};
+} // namespace pixel_bench
@@ -82,7 +82,7 @@ namespace pixel_engine
 		virtual void SetTransform(_In_ const FTransform2D& t) = 0;
 		
 		_NODISCARD _Check_return_
-		virtual const FTransform2D& GetTransform() const = 0;
+		virtual FTransform2D GetTransform() const = 0;
 
 		_NODISCARD _Check_return_
 		virtual FMatrix2DAffine GetAffineMatrix () const = 0;
@@ -139,6 +139,12 @@ namespace pixel_engine
 			m_bResampleNeeded = false;
 		}
 
+		//~ drawn while the sampled texture builds, the resample stays requested
+		void AssignPlaceholderTexture(_In_opt_ Texture* texture)
+		{
+			m_pSampledTexture = texture;
+		}
+
 		RigidBody2D* GetRigidBody2D() const
 		{
 			return m_pRigidBody2D.get();
@@ -149,16 +155,37 @@ namespace pixel_engine
 			return m_pCollider.get();
 		}
 
+		//~ where the transform, motion and collider box live in the store
+		_NODISCARD _Check_return_
+		TransformHandle GetTransformHandle() const noexcept
+		{
+			return m_pRigidBody2D->GetHandle();
+		}
+
 		_NODISCARD _Check_return_
 		Texture* GetSampledTexture() const { return m_pSampledTexture; }
 
+		//~ how the sampled texture is composited, color key unless asked otherwise
+		void SetBlendMode(_In_ EBlendMode mode) noexcept { m_eBlendMode = mode; }
+
+		_NODISCARD _Check_return_
+		EBlendMode GetBlendMode() const noexcept { return m_eBlendMode; }
+
+		//~ 0..255, only used by EBlendMode::PremultipliedAlpha (fades, flashes)
+		void SetOpacity(_In_ uint8_t opacity) noexcept { m_nOpacity = opacity; }
+
+		_NODISCARD _Check_return_
+		uint8_t GetOpacity() const noexcept { return m_nOpacity; }
+
 	protected:
 		bool					     m_bResampleNeeded{ true };
 		std::unique_ptr<RigidBody2D> m_pRigidBody2D{ nullptr };
 		std::unique_ptr<BoxCollider> m_pCollider  { nullptr };
 
 	private:
-		Texture* m_pSampledTexture{ nullptr };
+		Texture*   m_pSampledTexture{ nullptr };
+		EBlendMode m_eBlendMode		{ EBlendMode::ColorKey };
+		uint8_t	   m_nOpacity		{ 255u };
 
 		mutable bool m_bDirty{ true };
 		AllocatedID  m_idAllocated;
@@ -0,0 +1,23 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+namespace pixel_engine
+{
+	//~ one unit of work for the job pool, the context must outlive the
+	//~ batch it was enqueued in and a job must not wait on its own pool
+	typedef struct _PFE_JOB
+	{
+		_In_ void (*Execute)(void*) = nullptr;
+		_In_ void*	Context			= nullptr;
+	} PFE_JOB;
+} // namespace pixel_engine
@@ -0,0 +1,218 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "job_pool.h"
+
+#include <algorithm>
+
+using namespace pixel_engine;
+
+namespace
+{
+    constexpr std::uint64_t kCallerShare = std::uint64_t{ 1u } << 31;
+    constexpr std::uint64_t kCountMask   = kCallerShare - 1u;
+}
+
+PEJobPool::~PEJobPool()
+{
+    Shutdown();
+}
+
+_Use_decl_annotations_
+void PEJobPool::Initialize(std::uint32_t workerCount)
+{
+    Shutdown();
+
+    if (workerCount == 0)
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_stop.store(false, std::memory_order_relaxed);
+
+    //~ one deque per worker plus one for the thread calling Dispatch
+    m_deques.clear();
+    for (std::uint32_t i = 0; i <= workerCount; ++i)
+    {
+        m_deques.push_back(std::make_unique<PEWorkStealDeque<std::uint32_t>>());
+    }
+
+    //~ read before the threads start, a late starting worker would
+    //~ otherwise take the first batch for the one it already ran
+    const std::uint64_t seen = m_batch.load(std::memory_order_relaxed);
+
+    m_workerThreads.reserve(workerCount);
+    for (std::uint32_t i = 0; i < workerCount; ++i)
+    {
+        m_workerThreads.emplace_back([this, i, seen]()
+            {
+                WorkerLoop(i, seen);
+            });
+    }
+}
+
+void PEJobPool::Shutdown()
+{
+    if (m_workerThreads.empty()) return;
+
+    Wait();
+
+    m_stop.store(true, std::memory_order_release);
+    m_batch.fetch_add(std::uint64_t{ 1u } << 32, std::memory_order_release);
+    m_batch.notify_all();
+
+    for (auto& t : m_workerThreads)
+    {
+        if (t.joinable())
+            t.join();
+    }
+
+    m_workerThreads.clear();
+    m_pending.clear();
+    m_jobs.clear();
+}
+
+_Use_decl_annotations_
+void PEJobPool::Enqueue(const PFE_JOB& job)
+{
+    if (job.Execute) m_pending.push_back(job);
+}
+
+void PEJobPool::Dispatch()
+{
+    Publish(true);
+}
+
+void PEJobPool::Submit()
+{
+    Publish(false);
+}
+
+void PEJobPool::Wait()
+{
+    if (!m_bRunning) return;
+
+    //~ nothing left to steal once a dispatched batch returns, only a
+    //~ submitted one can still have queued jobs here
+    DrainBatch(static_cast<std::uint32_t>(m_workerThreads.size()), m_batch.load(std::memory_order_relaxed));
+
+    std::uint32_t left = m_remaining.load(std::memory_order_acquire);
+    while (left != 0u)
+    {
+        m_remaining.wait(left, std::memory_order_acquire);
+        left = m_remaining.load(std::memory_order_acquire);
+    }
+    m_bRunning = false;
+}
+
+_Use_decl_annotations_
+void PEJobPool::Publish(bool callerShare)
+{
+    if (m_bRunning) Wait();
+    if (m_pending.empty()) return;
+
+    //~ swapped so both vectors keep their capacity from frame to frame
+    m_jobs.swap(m_pending);
+    m_pending.clear();
+
+    const auto count = static_cast<std::uint32_t>(m_jobs.size());
+
+    if (m_workerThreads.empty())
+    {
+        for (const auto& job : m_jobs) job.Execute(job.Context);
+        return;
+    }
+
+    m_remaining.store(count, std::memory_order_relaxed);
+    m_bRunning = true;
+
+    //~ the release orders the batch before any worker reads it
+    const std::uint64_t epoch = (m_batch.load(std::memory_order_relaxed) >> 32) + 1u;
+    const std::uint64_t batch = (epoch << 32) | (callerShare ? kCallerShare : 0u) | count;
+    m_batch.store(batch, std::memory_order_release);
+    m_batch.notify_all();
+
+    if (callerShare) RunBatch(static_cast<std::uint32_t>(m_workerThreads.size()), batch);
+}
+
+_Use_decl_annotations_
+void PEJobPool::WorkerLoop(std::uint32_t workerIndex, std::uint64_t seen)
+{
+    //~ a batch cannot finish before every non empty share was pushed, so
+    //~ a worker only ever skips batches that gave it nothing to push
+    for (;;)
+    {
+        m_batch.wait(seen, std::memory_order_acquire);
+        seen = m_batch.load(std::memory_order_acquire);
+
+        if (m_stop.load(std::memory_order_acquire))
+            return;
+
+        RunBatch(workerIndex, seen);
+    }
+}
+
+_Use_decl_annotations_
+void PEJobPool::RunBatch(std::uint32_t participant, std::uint64_t batch)
+{
+    const std::uint64_t count = batch & kCountMask;
+    const std::uint64_t parts = (batch & kCallerShare) ? m_deques.size() : m_deques.size() - 1u;
+
+    //~ contiguous share, pushed back to front so the owner runs it in order
+    if (participant < parts)
+    {
+        const auto begin = static_cast<std::uint32_t>(count * participant       / parts);
+        const auto end   = static_cast<std::uint32_t>(count * (participant + 1) / parts);
+
+        auto& own = *m_deques[participant];
+        for (std::uint32_t i = end; i > begin; --i) own.Push(i - 1u);
+    }
+
+    DrainBatch(participant, batch);
+}
+
+_Use_decl_annotations_
+void PEJobPool::DrainBatch(std::uint32_t participant, std::uint64_t batch)
+{
+    auto& own = *m_deques[participant];
+
+    //~ a newer batch means this one is done, a worker that had nothing to
+    //~ push must go back and push its share of the new one
+    std::uint32_t index = 0u;
+    while (m_remaining.load(std::memory_order_acquire) != 0u &&
+           m_batch    .load(std::memory_order_acquire) == batch)
+    {
+        if (!own.Pop(index) && !StealJob(participant, index))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const PFE_JOB& job = m_jobs[index];
+        job.Execute(job.Context);
+
+        if (m_remaining.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        {
+            m_remaining.notify_all();
+        }
+    }
+}
+
+_Use_decl_annotations_
+bool PEJobPool::StealJob(std::uint32_t participant, std::uint32_t& jobIndex)
+{
+    const auto parts = static_cast<std::uint32_t>(m_deques.size());
+    for (std::uint32_t k = 1; k < parts; ++k)
+    {
+        const std::uint32_t victim = (participant + k) % parts;
+        if (m_deques[victim]->Steal(jobIndex)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,100 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+#include "job.h"
+#include "work_steal_deque.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace pixel_engine
+{
+	/// <summary>
+	/// Lock free batch pool. Enqueue only appends to the pending batch,
+	/// Dispatch publishes it with one epoch bump and every participant (the
+	/// workers plus the calling thread) pushes its share into its own deque,
+	/// runs it newest first and steals from the others once it runs dry.
+	/// Wait blocks on a completion counter instead of a shared condition.
+	/// One thread drives a pool, the workers only ever run its jobs.
+	/// </summary>
+	class PFE_API PEJobPool
+	{
+	public:
+		PEJobPool() noexcept = default;
+		~PEJobPool();
+
+		PEJobPool(_In_ const PEJobPool&)			= delete;
+		PEJobPool& operator=(_In_ const PEJobPool&) = delete;
+
+		//~ 0 workers uses every hardware thread
+		void Initialize(_In_ std::uint32_t workerCount);
+		void Shutdown  ();
+
+		_NODISCARD _Check_return_
+		std::uint32_t GetWorkerCount() const noexcept
+		{
+			return static_cast<std::uint32_t>(m_workerThreads.size());
+		}
+
+		//~ not visible to the workers until Dispatch
+		void Enqueue(_In_ const PFE_JOB& job);
+
+		//~ waits for a batch still running before publishing the next one
+		void Dispatch();
+		void Submit	 ();
+
+		//~ the caller steals from the workers until the batch is done
+		void Wait	 ();
+
+	private:
+		//~ the caller takes a share only when it runs the batch right away
+		void Publish(_In_ bool callerShare);
+
+		void WorkerLoop(
+			_In_ std::uint32_t workerIndex,
+			_In_ std::uint64_t seen);
+
+		//~ pushes the participant share of the batch then runs jobs until
+		//~ the whole batch is done
+		void RunBatch(
+			_In_ std::uint32_t participant,
+			_In_ std::uint64_t batch);
+
+		void DrainBatch(
+			_In_ std::uint32_t participant,
+			_In_ std::uint64_t batch);
+
+		_NODISCARD _Check_return_
+		bool StealJob(
+			_In_  std::uint32_t	 participant,
+			_Out_ std::uint32_t& jobIndex);
+
+	private:
+		std::vector<std::thread>									m_workerThreads{};
+		std::vector<std::unique_ptr<PEWorkStealDeque<std::uint32_t>>> m_deques	 {}; // workers then the caller
+
+		std::vector<PFE_JOB> m_pending{}; // filled by Enqueue
+		std::vector<PFE_JOB> m_jobs	  {}; // running batch, read only while it runs
+
+		//~ epoch << 32 | caller share bit | batch size, one word so a late
+		//~ worker never pairs an epoch with the size of another batch
+		std::atomic<std::uint64_t> m_batch	  { 0u };
+		std::atomic<std::uint32_t> m_remaining{ 0u }; // completion latch
+		std::atomic<bool>		   m_stop	  { false };
+		bool					   m_bRunning { false };
+	};
+} // namespace pixel_engine
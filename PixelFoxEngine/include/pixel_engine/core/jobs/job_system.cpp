@@ -0,0 +1,87 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "job_system.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace pixel_engine;
+
+namespace
+{
+    //~ set while this thread drives the pool, a job calling Run again must
+    //~ not try the mutex its own thread already holds
+    thread_local bool t_bDriving = false;
+}
+
+PEJobSystem::~PEJobSystem()
+{
+    Shutdown();
+}
+
+_Use_decl_annotations_
+void PEJobSystem::Run(const PFE_JOB* jobs, std::uint32_t count)
+{
+    if (!jobs || count == 0u) return;
+
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (count > 1u && !t_bDriving) (void)lock.try_lock();
+
+    if (!lock.owns_lock() || !Start())
+    {
+        RunInline(jobs, count);
+        return;
+    }
+
+    t_bDriving = true;
+    for (std::uint32_t i = 0; i < count; ++i) m_pool.Enqueue(jobs[i]);
+    m_pool.Dispatch();
+    m_pool.Wait    ();
+    t_bDriving = false;
+}
+
+void PEJobSystem::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pool.Shutdown();
+    m_bStarted = false;
+}
+
+bool PEJobSystem::Start()
+{
+    if (m_bStarted) return true;
+    if (m_bFailed)  return false;
+
+    const std::uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    try
+    {
+        m_pool.Initialize(std::max(1u, hardware / 2u));
+        m_bStarted = true;
+    }
+    catch (...)
+    {
+        //~ no threads, every Run stays on its caller from now on
+        m_pool.Shutdown();
+        m_bFailed = true;
+    }
+    return m_bStarted;
+}
+
+_Use_decl_annotations_
+void PEJobSystem::RunInline(const PFE_JOB* jobs, std::uint32_t count)
+{
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        if (jobs[i].Execute) jobs[i].Execute(jobs[i].Context);
+    }
+}
@@ -0,0 +1,61 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/core/interface/interface_singleton.h"
+#include "job_pool.h"
+
+#include <cstdint>
+#include <mutex>
+
+namespace pixel_engine
+{
+	/// <summary>
+	/// The engine wide job pool for work off the render thread (sampler
+	/// rows, narrowphase chunks). Workers start on the first Run, half the
+	/// machine so the raster workers keep room for the frame. One Run uses
+	/// the pool at a time, any other caller runs its jobs itself.
+	/// </summary>
+	class PFE_API PEJobSystem final : public ISingleton<PEJobSystem>
+	{
+		friend class ISingleton<PEJobSystem>;
+	public:
+		PEJobSystem() = default;
+		~PEJobSystem();
+
+		//~ returns once every job finished, the caller runs a share; jobs run
+		//~ inline when the pool is busy, failed to start or Run is nested
+		void Run(
+			_In_reads_(count) const PFE_JOB* jobs,
+			_In_			  std::uint32_t	 count);
+
+		//~ joins the workers, called on engine release, a later Run starts them again
+		void Shutdown();
+
+	private:
+		//~ under m_mutex, false once starting the workers failed
+		_NODISCARD _Check_return_
+		bool Start();
+
+		static void RunInline(
+			_In_reads_(count) const PFE_JOB* jobs,
+			_In_			  std::uint32_t	 count);
+
+	private:
+		std::mutex m_mutex	{};
+		PEJobPool  m_pool	{};
+		bool	   m_bStarted{ false };
+		bool	   m_bFailed { false };
+	};
+} // namespace pixel_engine
@@ -0,0 +1,147 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace pixel_engine
+{
+	/// <summary>
+	/// Chase-Lev work stealing deque (Le et al., C11 memory model version).
+	/// The owning thread pushes and pops at the bottom, any other thread
+	/// steals from the top. Only the owner grows the ring, retired rings
+	/// stay alive until the deque is destroyed since a thief may still be
+	/// reading one.
+	/// </summary>
+	template<typename T>
+	class PEWorkStealDeque
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "deque slots are read and written atomically");
+
+	public:
+		explicit PEWorkStealDeque(_In_ int64_t capacity = 256)
+		{
+			int64_t size = 1;
+			while (size < capacity) size <<= 1;
+
+			m_rings.push_back(std::make_unique<Ring>(size));
+			m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+		}
+
+		PEWorkStealDeque(_In_ const PEWorkStealDeque&)			  = delete;
+		PEWorkStealDeque& operator=(_In_ const PEWorkStealDeque&) = delete;
+
+		//~ owner only
+		void Push(_In_ T value)
+		{
+			const int64_t b = m_bottom.load(std::memory_order_relaxed);
+			const int64_t t = m_top	  .load(std::memory_order_acquire);
+			Ring* ring = m_ring.load(std::memory_order_relaxed);
+
+			if (b - t > ring->mask)
+			{
+				ring = Grow(ring, t, b);
+			}
+
+			ring->Put(b, value);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+		}
+
+		//~ owner only, newest first
+		_NODISCARD _Check_return_
+		bool Pop(_Out_ T& out)
+		{
+			const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+			Ring* ring = m_ring.load(std::memory_order_relaxed);
+			m_bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t t = m_top.load(std::memory_order_relaxed);
+
+			if (t > b)
+			{
+				m_bottom.store(b + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			out = ring->Get(b);
+			if (t != b) return true;
+
+			//~ last item, race the thieves for it
+			const bool won = m_top.compare_exchange_strong(
+				t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		//~ any thread, oldest first, false when empty or another thief won
+		_NODISCARD _Check_return_
+		bool Steal(_Out_ T& out)
+		{
+			int64_t t = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t b = m_bottom.load(std::memory_order_acquire);
+			if (t >= b) return false;
+
+			Ring* ring = m_ring.load(std::memory_order_acquire);
+			out = ring->Get(t);
+			return m_top.compare_exchange_strong(
+				t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+
+		_NODISCARD _Check_return_
+		bool Empty() const noexcept
+		{
+			const int64_t b = m_bottom.load(std::memory_order_relaxed);
+			const int64_t t = m_top	  .load(std::memory_order_relaxed);
+			return b <= t;
+		}
+
+	private:
+		struct Ring
+		{
+			explicit Ring(int64_t size)
+				: mask(size - 1), slots(std::make_unique<std::atomic<T>[]>(static_cast<size_t>(size)))
+			{}
+
+			T	 Get(int64_t i) const noexcept { return slots[static_cast<size_t>(i & mask)].load(std::memory_order_relaxed); }
+			void Put(int64_t i, T v) noexcept  { slots[static_cast<size_t>(i & mask)].store(v, std::memory_order_relaxed); }
+
+			int64_t							 mask;
+			std::unique_ptr<std::atomic<T>[]> slots;
+		};
+
+		Ring* Grow(Ring* ring, int64_t t, int64_t b)
+		{
+			auto bigger = std::make_unique<Ring>((ring->mask + 1) * 2);
+			for (int64_t i = t; i < b; ++i) bigger->Put(i, ring->Get(i));
+
+			Ring* raw = bigger.get();
+			m_rings.push_back(std::move(bigger));
+			m_ring.store(raw, std::memory_order_release);
+			return raw;
+		}
+
+	private:
+		alignas(64) std::atomic<int64_t> m_top	 { 0 };
+		alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+		alignas(64) std::atomic<Ring*>	 m_ring	 { nullptr };
+
+		std::vector<std::unique_ptr<Ring>> m_rings{}; // owner only
+	};
+} // namespace pixel_engine
@@ -0,0 +1,153 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "cull_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace pixel_engine;
+
+_Use_decl_annotations_
+void PECullGrid::Build(const fox::vector<PFE_AABB2D>& bounds, float cellSize)
+{
+    Clear();
+    if (bounds.empty()) return;
+
+    PFE_AABB2D world
+    {
+         std::numeric_limits<float>::max(),  std::numeric_limits<float>::max(),
+        -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()
+    };
+    for (const PFE_AABB2D& box : bounds)
+    {
+        world.minX = std::min(world.minX, box.minX);
+        world.minY = std::min(world.minY, box.minY);
+        world.maxX = std::max(world.maxX, box.maxX);
+        world.maxY = std::max(world.maxY, box.maxY);
+    }
+
+    //~ huge levels get bigger cells rather than a huge table
+    const float width  = std::max(world.maxX - world.minX, 1.0f);
+    const float height = std::max(world.maxY - world.minY, 1.0f);
+    cellSize = std::max({ cellSize, 1.0f,
+                          width  / static_cast<float>(kMaxCellsPerAxis),
+                          height / static_cast<float>(kMaxCellsPerAxis) });
+
+    m_originX = world.minX;
+    m_originY = world.minY;
+    m_invCell = 1.0f / cellSize;
+    m_nCols   = std::min(kMaxCellsPerAxis, static_cast<int>(width  * m_invCell) + 1);
+    m_nRows   = std::min(kMaxCellsPerAxis, static_cast<int>(height * m_invCell) + 1);
+
+    const size_t cells = static_cast<size_t>(m_nCols) * static_cast<size_t>(m_nRows);
+
+    //~ count into the slot after each cell, prefix sum to cell ends, then
+    //~ fill backwards so every end walks down to its cell start
+    m_cellStart.assign(cells + 1u, 0u);
+    for (const PFE_AABB2D& box : bounds)
+    {
+        int x0, y0, x1, y1;
+        if (!CellRange(box, x0, y0, x1, y1)) continue;
+
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                ++m_cellStart[static_cast<size_t>(y) * m_nCols + x + 1u];
+    }
+    for (size_t c = 0; c < cells; ++c) m_cellStart[c + 1u] += m_cellStart[c];
+
+    m_items.assign(m_cellStart[cells], 0u);
+    for (size_t i = bounds.size(); i-- > 0;)
+    {
+        int x0, y0, x1, y1;
+        if (!CellRange(bounds[i], x0, y0, x1, y1)) continue;
+
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+            {
+                const size_t cell = static_cast<size_t>(y) * m_nCols + x;
+                m_items[--m_cellStart[cell + 1u]] = static_cast<uint32_t>(i);
+            }
+    }
+
+    //~ slot c + 1 now holds the start of cell c, shift them into place
+    for (size_t c = 0; c < cells; ++c) m_cellStart[c] = m_cellStart[c + 1u];
+    m_cellStart[cells] = static_cast<uint32_t>(m_items.size());
+
+    m_stamp.assign(bounds.size(), 0u);
+    m_nQuery = 0u;
+}
+
+void PECullGrid::Clear() noexcept
+{
+    m_cellStart.clear();
+    m_items    .clear();
+    m_stamp    .clear();
+    m_nCols  = 0;
+    m_nRows  = 0;
+    m_nQuery = 0u;
+}
+
+_Use_decl_annotations_
+void PECullGrid::Query(const PFE_AABB2D& rect, fox::vector<uint32_t>& out)
+{
+    out.clear();
+
+    int x0, y0, x1, y1;
+    if (Empty() || !CellRange(rect, x0, y0, x1, y1)) return;
+
+    //~ wrapped stamps could match an old query, start them over
+    if (++m_nQuery == 0u)
+    {
+        for (uint32_t& stamp : m_stamp) stamp = 0u;
+        m_nQuery = 1u;
+    }
+
+    for (int y = y0; y <= y1; ++y)
+    {
+        const size_t row = static_cast<size_t>(y) * m_nCols;
+        for (size_t k = m_cellStart[row + x0]; k < m_cellStart[row + x1 + 1u]; ++k)
+        {
+            const uint32_t item = m_items[k];
+            if (m_stamp[item] == m_nQuery) continue;
+
+            m_stamp[item] = m_nQuery;
+            out.push_back(item);
+        }
+    }
+
+    //~ callers draw in item order
+    std::sort(out.data(), out.data() + out.size());
+}
+
+_Use_decl_annotations_
+bool PECullGrid::CellRange(const PFE_AABB2D& rect, int& x0, int& y0, int& x1, int& y1) const noexcept
+{
+    x0 = y0 = x1 = y1 = 0;
+    if (m_nCols <= 0 || m_nRows <= 0) return false;
+
+    const float fx0 = std::floor((rect.minX - m_originX) * m_invCell);
+    const float fy0 = std::floor((rect.minY - m_originY) * m_invCell);
+    const float fx1 = std::floor((rect.maxX - m_originX) * m_invCell);
+    const float fy1 = std::floor((rect.maxY - m_originY) * m_invCell);
+
+    if (fx1 < 0.0f || fy1 < 0.0f) return false;
+    if (fx0 >= static_cast<float>(m_nCols) || fy0 >= static_cast<float>(m_nRows)) return false;
+
+    //~ clamped as floats, a far off rect must not overflow the cast
+    x0 = static_cast<int>(std::max(fx0, 0.0f));
+    y0 = static_cast<int>(std::max(fy0, 0.0f));
+    x1 = static_cast<int>(std::min(fx1, static_cast<float>(m_nCols - 1)));
+    y1 = static_cast<int>(std::min(fy1, static_cast<float>(m_nRows - 1)));
+    return true;
+}
@@ -0,0 +1,74 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/core/types.h"
+
+#include "core/vector.h"
+
+#include <cstdint>
+
+namespace pixel_engine
+{
+    /// <summary>
+    /// Uniform grid over item bounds, built once and queried with a rect.
+    /// Cells keep item indices in one flat array (offsets per cell), so a
+    /// query only walks the cells the rect covers and never allocates once
+    /// the output has grown to the visible count.
+    /// </summary>
+    class PFE_API PECullGrid
+    {
+    public:
+        PECullGrid() = default;
+
+        //~ item i is bounds[i], the grid covers their union
+        void Build(
+            _In_ const fox::vector<PFE_AABB2D>& bounds,
+            _In_ float                          cellSize);
+
+        void Clear() noexcept;
+
+        //~ items whose cells touch the rect, ascending and without repeats,
+        //~ the caller still tests the exact bounds
+        void Query(
+            _In_  const PFE_AABB2D&      rect,
+            _Out_ fox::vector<uint32_t>& out);
+
+        _NODISCARD _Check_return_
+        bool Empty() const noexcept { return m_stamp.empty(); }
+
+    private:
+        _NODISCARD _Check_return_
+        bool CellRange(
+            _In_  const PFE_AABB2D& rect,
+            _Out_ int&              x0,
+            _Out_ int&              y0,
+            _Out_ int&              x1,
+            _Out_ int&              y1) const noexcept;
+
+    private:
+        static constexpr int kMaxCellsPerAxis = 256;
+
+        float m_originX  { 0.0f };
+        float m_originY  { 0.0f };
+        float m_invCell  { 1.0f };
+        int   m_nCols    { 0 };
+        int   m_nRows    { 0 };
+
+        fox::vector<uint32_t> m_cellStart{}; // cols * rows + 1 offsets into m_items
+        fox::vector<uint32_t> m_items    {};
+        fox::vector<uint32_t> m_stamp    {}; // per item, last query that took it
+        uint32_t              m_nQuery   { 0u };
+    };
+} // namespace pixel_engine
@@ -11,6 +11,7 @@
 
 #pragma once
 #include "PixelFoxEngineAPI.h"
+#include <cstdint>
 #include <type_traits>
 #include <Windows.h>
 
@@ -55,10 +56,22 @@ namespace pixel_engine
 
 	} PFE_FORMAT_R8G8B8_UINT;
 
+	enum class EPixelFormat : uint8_t
+	{
+		R8G8B8,	 // 3 bytes per pixel, rows padded to 4 bytes
+		R8G8B8A8 // 4 bytes per pixel, same layout as DXGI_FORMAT_R8G8B8A8_UNORM
+	};
+
+	inline constexpr size_t PixelFormatSize(EPixelFormat format) noexcept
+	{
+		return format == EPixelFormat::R8G8B8A8 ? 4u : 3u;
+	}
+
 	typedef struct _PE_IMAGE_BUFFER_DESC
 	{
-		UINT Height;
-		UINT Width;
+		UINT		 Height;
+		UINT		 Width;
+		EPixelFormat Format{ EPixelFormat::R8G8B8A8 };
 	} PE_IMAGE_BUFFER_DESC;
 
 	typedef struct _PFE_VIEWPORT
@@ -88,4 +101,10 @@ namespace pixel_engine
 		int cols{ 0 }, rows{ 0 };
 	} PFE_SAMPLE_GRID_2D;
 
+	enum class EBlendMode : uint8_t
+	{
+		ColorKey,			// black texels are skipped, the rest overwrite the target
+		PremultipliedAlpha	// source over with premultiplied RGBA8 texels
+	};
+
 } // namespace pixel_engine
@@ -0,0 +1,235 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "broadphase.h"
+
+#include "pixel_engine/utilities/hash_type.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace pixel_engine;
+
+namespace
+{
+    //~ keeps far away boxes from overflowing the cell coordinates
+    constexpr float kMaxCell = static_cast<float>(1 << 28);
+
+    int CellOf(float v, float invCell) noexcept
+    {
+        const float cell = std::floor(v * invCell);
+        return static_cast<int>(std::clamp(cell, -kMaxCell, kMaxCell));
+    }
+
+    //~ last cell a box reaches into, its max edge is exclusive so a tile
+    //~ aligned box stays in its own cells
+    int LastCellOf(float v, float invCell) noexcept
+    {
+        const float cell = std::ceil(v * invCell) - 1.0f;
+        return static_cast<int>(std::clamp(cell, -kMaxCell, kMaxCell));
+    }
+
+    //~ the same strict test BoxCollider::CheckCollision makes, touching
+    //~ boxes never collide so they need not share a cell either
+    bool Overlaps(const PFE_AABB2D& a, const PFE_AABB2D& b) noexcept
+    {
+        return a.minX < b.maxX && b.minX < a.maxX &&
+               a.minY < b.maxY && b.minY < a.maxY;
+    }
+
+    //~ the layer matrix is symmetric, one side is enough
+    bool Ignored(const PFE_BROADPHASE_FILTER& a, const PFE_BROADPHASE_FILTER& b) noexcept
+    {
+        return (a.ignores & b.layers) != 0u;
+    }
+
+    bool Valid(const PFE_AABB2D& box) noexcept
+    {
+        return box.maxX > box.minX && box.maxY > box.minY;
+    }
+
+    uint32_t BucketOf(int x, int y, uint32_t mask) noexcept
+    {
+        const uint64_t cell = static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 |
+                              static_cast<uint32_t>(y);
+        return static_cast<uint32_t>(HashMix64(cell)) & mask;
+    }
+
+    PFE_BROADPHASE_PAIR MakePair(uint32_t i, uint32_t j) noexcept
+    {
+        return i < j ? PFE_BROADPHASE_PAIR{ i, j } : PFE_BROADPHASE_PAIR{ j, i };
+    }
+} // namespace
+
+_Use_decl_annotations_
+void PEBroadphase::SetCellSize(float cellSize) noexcept
+{
+    m_invCell = 1.0f / std::max(cellSize, 1e-3f);
+}
+
+_Use_decl_annotations_
+void PEBroadphase::FindPairs(
+    const fox::vector<PFE_AABB2D>&            bounds,
+    const fox::vector<PFE_BROADPHASE_FILTER>& filters,
+    fox::vector<PFE_BROADPHASE_PAIR>&         out)
+{
+    out.clear();
+    if (bounds.size() < 2u || filters.size() != bounds.size()) return;
+
+    if (m_eMode == EBroadphase::AllPairs)
+    {
+        FindAllPairs(bounds, filters, out);
+        return;
+    }
+
+    FindHashedPairs(bounds, filters, out);
+    std::sort(out.data(), out.data() + out.size(),
+        [](const PFE_BROADPHASE_PAIR& l, const PFE_BROADPHASE_PAIR& r)
+        {
+            return l.a != r.a ? l.a < r.a : l.b < r.b;
+        });
+}
+
+_Use_decl_annotations_
+void PEBroadphase::FindAllPairs(
+    const fox::vector<PFE_AABB2D>&            bounds,
+    const fox::vector<PFE_BROADPHASE_FILTER>& filters,
+    fox::vector<PFE_BROADPHASE_PAIR>&         out) const
+{
+    const uint32_t count = static_cast<uint32_t>(bounds.size());
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        for (uint32_t j = i + 1u; j < count; ++j)
+        {
+            if (Ignored(filters[i], filters[j])) continue;
+            out.push_back({ i, j });
+        }
+    }
+}
+
+_Use_decl_annotations_
+void PEBroadphase::FindHashedPairs(
+    const fox::vector<PFE_AABB2D>&            bounds,
+    const fox::vector<PFE_BROADPHASE_FILTER>& filters,
+    fox::vector<PFE_BROADPHASE_PAIR>&         out)
+{
+    const uint32_t count = static_cast<uint32_t>(bounds.size());
+
+    //~ cell range of every box, oversized boxes go to their own list
+    m_ranges.assign(count, CELL_RANGE{});
+    m_large .clear();
+
+    size_t entries = 0u;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const PFE_AABB2D& box = bounds[i];
+        if (!Valid(box)) continue;
+
+        CELL_RANGE& range = m_ranges[i];
+        range.x0 = CellOf(box.minX, m_invCell);
+        range.y0 = CellOf(box.minY, m_invCell);
+        range.x1 = std::max(range.x0, LastCellOf(box.maxX, m_invCell));
+        range.y1 = std::max(range.y0, LastCellOf(box.maxY, m_invCell));
+
+        const int64_t cells = (static_cast<int64_t>(range.x1) - range.x0 + 1) *
+                              (static_cast<int64_t>(range.y1) - range.y0 + 1);
+        if (cells > kMaxCellsPerBox)
+        {
+            range.large = true;
+            m_large.push_back(i);
+            continue;
+        }
+        entries += static_cast<size_t>(cells);
+    }
+
+    //~ power of two buckets at twice the entries, counted then filled
+    //~ backwards like PECullGrid so each bucket is one flat run
+    uint32_t buckets = 64u;
+    while (buckets < entries * 2u) buckets <<= 1u;
+    const uint32_t mask = buckets - 1u;
+
+    m_bucketStart.assign(static_cast<size_t>(buckets) + 1u, 0u);
+    m_entries    .assign(entries, CELL_ENTRY{});
+
+    auto hashed = [this](uint32_t i)
+    {
+        const CELL_RANGE& r = m_ranges[i];
+        return r.x1 >= r.x0 && !r.large;
+    };
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (!hashed(i)) continue;
+        const CELL_RANGE& r = m_ranges[i];
+        for (int y = r.y0; y <= r.y1; ++y)
+            for (int x = r.x0; x <= r.x1; ++x)
+                ++m_bucketStart[BucketOf(x, y, mask) + 1u];
+    }
+    for (uint32_t b = 0; b < buckets; ++b) m_bucketStart[b + 1u] += m_bucketStart[b];
+
+    for (uint32_t i = count; i-- > 0u;)
+    {
+        if (!hashed(i)) continue;
+        const CELL_RANGE& r = m_ranges[i];
+        for (int y = r.y0; y <= r.y1; ++y)
+            for (int x = r.x0; x <= r.x1; ++x)
+            {
+                const uint32_t b = BucketOf(x, y, mask);
+                m_entries[--m_bucketStart[b + 1u]] = CELL_ENTRY{ x, y, i };
+            }
+    }
+    //~ slot b + 1 now holds the start of bucket b, shift them into place
+    for (uint32_t b = 0; b < buckets; ++b) m_bucketStart[b] = m_bucketStart[b + 1u];
+    m_bucketStart[buckets] = static_cast<uint32_t>(entries);
+
+    //~ a bucket may hold several cells, only entries of the same cell pair
+    for (uint32_t b = 0; b < buckets; ++b)
+    {
+        const uint32_t begin = m_bucketStart[b];
+        const uint32_t end   = m_bucketStart[b + 1u];
+        for (uint32_t p = begin; p < end; ++p)
+        {
+            const CELL_ENTRY& ep = m_entries[p];
+            for (uint32_t q = p + 1u; q < end; ++q)
+            {
+                const CELL_ENTRY& eq = m_entries[q];
+                if (ep.x != eq.x || ep.y != eq.y) continue;
+                if (Ignored(filters[ep.item], filters[eq.item])) continue;
+
+                //~ owned by the cell holding the top left of the overlap
+                const CELL_RANGE& rp = m_ranges[ep.item];
+                const CELL_RANGE& rq = m_ranges[eq.item];
+                if (ep.x != std::max(rp.x0, rq.x0) || ep.y != std::max(rp.y0, rq.y0)) continue;
+
+                if (!Overlaps(bounds[ep.item], bounds[eq.item])) continue;
+                out.push_back(MakePair(ep.item, eq.item));
+            }
+        }
+    }
+
+    //~ oversized boxes against every other box, each pair once
+    for (size_t k = 0; k < m_large.size(); ++k)
+    {
+        const uint32_t i = m_large[k];
+        for (uint32_t j = 0; j < count; ++j)
+        {
+            if (j == i || !Valid(bounds[j])) continue;
+            if (Ignored(filters[i], filters[j])) continue;
+
+            //~ two large boxes meet once, when the later one is visited
+            if (m_ranges[j].large && j > i) continue;
+
+            if (!Overlaps(bounds[i], bounds[j])) continue;
+            out.push_back(MakePair(i, j));
+        }
+    }
+}
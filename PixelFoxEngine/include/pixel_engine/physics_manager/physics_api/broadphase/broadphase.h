@@ -0,0 +1,112 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/core/types.h"
+#include "pixel_engine/physics_manager/physics_api/collider/collision_layers.h"
+
+#include "core/vector.h"
+
+#include <cstdint>
+
+namespace pixel_engine
+{
+	enum class EBroadphase : uint8_t
+	{
+		AllPairs,	 // every pair the layer matrix allows (old loop)
+		SpatialHash	 // boxes hashed into a uniform grid of world cells
+	};
+
+	//~ a < b, indices into the boxes handed to FindPairs
+	typedef struct _PFE_BROADPHASE_PAIR
+	{
+		uint32_t a{ 0u };
+		uint32_t b{ 0u };
+	} PFE_BROADPHASE_PAIR;
+
+	//~ layers of a box and the layers it never pairs with, taken from
+	//~ BoxCollider::GetLayerMask and PECollisionLayers::GetIgnoredBy
+	typedef struct _PFE_BROADPHASE_FILTER
+	{
+		TagMask layers { 0u };
+		TagMask ignores{ 0u };
+	} PFE_BROADPHASE_FILTER;
+
+	/// <summary>
+	/// Candidate pairs for the narrowphase. Boxes are hashed into world
+	/// cells (one 32px tile by default) and only boxes sharing a cell are
+	/// paired; a pair sharing several cells is only taken in the cell at
+	/// the top left of their overlap, so no set is needed to drop repeats.
+	/// Pairs the collision layer matrix ignores are never generated.
+	/// </summary>
+	class PFE_API PEBroadphase
+	{
+	public:
+		PEBroadphase() = default;
+
+		//~ SpatialHash unless changed, AllPairs kept for comparison
+		void SetMode(_In_ EBroadphase mode) noexcept { m_eMode = mode; }
+
+		_NODISCARD _Check_return_
+		EBroadphase GetMode() const noexcept { return m_eMode; }
+
+		//~ world units, 1 is one tile of the 32px grid
+		void SetCellSize(_In_ float cellSize) noexcept;
+
+		//~ sorted by a then b so the narrowphase sees them in the order the
+		//~ all pairs loop did; the hash keeps only boxes that overlap and never
+		//~ pairs an empty box, filters[i] holds the layers of box i
+		void FindPairs(
+			_In_  const fox::vector<PFE_AABB2D>&			bounds,
+			_In_  const fox::vector<PFE_BROADPHASE_FILTER>& filters,
+			_Out_ fox::vector<PFE_BROADPHASE_PAIR>&			out);
+
+	private:
+		typedef struct _CELL_RANGE
+		{
+			int  x0{ 0 }, y0{ 0 }, x1{ -1 }, y1{ -1 }; // x1 < x0 when the box is skipped
+			bool large{ false }; // over kMaxCellsPerBox, not hashed
+		} CELL_RANGE;
+
+		typedef struct _CELL_ENTRY
+		{
+			int		 x	 { 0 };
+			int		 y	 { 0 };
+			uint32_t item{ 0u };
+		} CELL_ENTRY;
+
+		void FindAllPairs(
+			_In_  const fox::vector<PFE_AABB2D>&			bounds,
+			_In_  const fox::vector<PFE_BROADPHASE_FILTER>& filters,
+			_Out_ fox::vector<PFE_BROADPHASE_PAIR>&			out) const;
+
+		void FindHashedPairs(
+			_In_  const fox::vector<PFE_AABB2D>&			bounds,
+			_In_  const fox::vector<PFE_BROADPHASE_FILTER>& filters,
+			_Out_ fox::vector<PFE_BROADPHASE_PAIR>&			out);
+
+	private:
+		//~ a box over this many cells is tested against every box instead
+		static constexpr int kMaxCellsPerBox = 64;
+
+		EBroadphase m_eMode	 { EBroadphase::SpatialHash };
+		float		m_invCell{ 1.0f };
+
+		//~ kept between frames so a steady scene does not allocate
+		fox::vector<CELL_RANGE> m_ranges	 {};
+		fox::vector<uint32_t>	m_large		 {}; // ascending
+		fox::vector<uint32_t>	m_bucketStart{}; // buckets + 1 offsets into m_entries
+		fox::vector<CELL_ENTRY> m_entries	 {};
+	};
+} // namespace pixel_engine
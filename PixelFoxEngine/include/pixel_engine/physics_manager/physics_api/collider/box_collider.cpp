@@ -47,10 +47,30 @@ void BoxCollider::Update(float deltaTime)
     for (auto& collider : toRemove) m_hitTrack.erase(collider);
 }
 
+bool BoxCollider::HasTrackedHits() const
+{
+    if (!m_hitTrack.empty()) return true;
+
+    for (const auto& [collider, info] : m_collidersTrack)
+    {
+        if (info.ColliderEntered && !info.ColliderExited) return true;
+    }
+    return false;
+}
+
 bool BoxCollider::CheckCollision(BoxCollider* other, Contact& outContact)
 {
     if (!other) return false;
 
+    const bool hit = TestCollision(other, outContact);
+    m_lastContactNormal = hit ? outContact.Normal : FVector2D{ 0.f, 0.f };
+    return hit;
+}
+
+bool BoxCollider::TestCollision(const BoxCollider* other, Contact& outContact) const
+{
+    if (!other) return false;
+
     const FVector2D aCenter = GetWorldCenter();
     const FVector2D bCenter = other->GetWorldCenter();
     const FVector2D aHalf   = GetHalfExtents();
@@ -67,7 +87,6 @@ bool BoxCollider::CheckCollision(BoxCollider* other, Contact& outContact)
 
     if (overlap.x <= 0.0f || overlap.y <= 0.0f) 
     {
-        m_lastContactNormal = { 0.f, 0.f };
         return false;
     }
 
@@ -88,7 +107,6 @@ bool BoxCollider::CheckCollision(BoxCollider* other, Contact& outContact)
         aCenter.y + outContact.Normal.y * (outContact.Penetration * 0.5f)
     };
 
-    m_lastContactNormal = outContact.Normal;
     return true;
 }
 
@@ -147,50 +165,98 @@ void pixel_engine::BoxCollider::AddCallback(const ON_HIT_CALLBACK& callback)
     }
 }
 
-void BoxCollider::SetScale(const FVector2D& scale) { m_scale = scale; }
-FVector2D BoxCollider::GetScale() const { return m_scale; }
+void BoxCollider::SetScale(const FVector2D& scale)
+{
+    if (!m_pRigidBody) return;
+    auto& c = PETransformStore::Instance().Columns();
+    const size_t i = PETransformStore::Instance().Index(m_pRigidBody->GetHandle());
+    c.HalfExtentX[i] = scale.x * 0.5f;
+    c.HalfExtentY[i] = scale.y * 0.5f;
+}
+
+FVector2D BoxCollider::GetScale() const { return GetHalfExtents() * 2.0f; }
+
+void BoxCollider::SetOffset(const FVector2D& offset)
+{
+    if (!m_pRigidBody) return;
+    auto& c = PETransformStore::Instance().Columns();
+    const size_t i = PETransformStore::Instance().Index(m_pRigidBody->GetHandle());
+    c.OffsetX[i] = offset.x;
+    c.OffsetY[i] = offset.y;
+}
+
+FVector2D BoxCollider::GetOffset() const
+{
+    if (!m_pRigidBody) return { 0, 0 };
+    const auto& c = PETransformStore::Instance().Columns();
+    const size_t i = PETransformStore::Instance().Index(m_pRigidBody->GetHandle());
+    return { c.OffsetX[i], c.OffsetY[i] };
+}
 
-void BoxCollider::SetOffset(const FVector2D& offset) { m_offset = offset; }
-FVector2D BoxCollider::GetOffset() const { return m_offset; }
+void BoxCollider::SetColliderType(ColliderType type)
+{
+    if (!m_pRigidBody) return;
+    const size_t i = PETransformStore::Instance().Index(m_pRigidBody->GetHandle());
+    PETransformStore::Instance().Columns().ColliderType[i] = static_cast<uint8_t>(type);
+}
 
-void BoxCollider::SetColliderType(ColliderType type) { m_colliderType = type; }
-ColliderType BoxCollider::GetColliderType() const { return m_colliderType; }
+ColliderType BoxCollider::GetColliderType() const
+{
+    if (!m_pRigidBody) return ColliderType::Static;
+    const size_t i = PETransformStore::Instance().Index(m_pRigidBody->GetHandle());
+    return static_cast<ColliderType>(PETransformStore::Instance().Columns().ColliderType[i]);
+}
 
 FTransform2D BoxCollider::GetTransform2D() const { return m_pRigidBody->GetTransform(); }
 RigidBody2D* BoxCollider::GetRigidBody2D() const { return m_pRigidBody; }
 
-FVector2D BoxCollider::GetMin() const { return { -m_scale.x, -m_scale.y }; }
-FVector2D BoxCollider::GetMax() const { return { m_scale.x,  m_scale.y }; }
+FVector2D BoxCollider::GetMin() const { const FVector2D s = GetScale(); return { -s.x, -s.y }; }
+FVector2D BoxCollider::GetMax() const { return GetScale(); }
 
 FVector2D BoxCollider::GetWorldCenter() const
 {
     if (!m_pRigidBody) return { 0, 0 };
 
-    auto pos = m_pRigidBody->GetPosition();
-    pos += m_offset;
-    
-    return pos;
+    const auto& c = PETransformStore::Instance().Columns();
+    const size_t i = PETransformStore::Instance().Index(m_pRigidBody->GetHandle());
+    return { c.PositionX[i] + c.OffsetX[i], c.PositionY[i] + c.OffsetY[i] };
+}
+
+FVector2D BoxCollider::GetHalfExtents() const
+{
+    if (!m_pRigidBody) return { 0.5f, 0.5f };
+
+    const auto& c = PETransformStore::Instance().Columns();
+    const size_t i = PETransformStore::Instance().Index(m_pRigidBody->GetHandle());
+    return { c.HalfExtentX[i], c.HalfExtentY[i] };
 }
 
-FVector2D BoxCollider::GetHalfExtents() const { return m_scale * 0.5; }
 FVector2D BoxCollider::GetLastContactNormal() const { return m_lastContactNormal; }
 
-bool BoxCollider::IsTrigger() const { return m_colliderType == ColliderType::Trigger; }
-bool BoxCollider::IsDynamic() const { return m_colliderType == ColliderType::Dynamic; }
-bool BoxCollider::IsStatic () const { return m_colliderType == ColliderType::Static; }
+bool BoxCollider::IsTrigger() const { return GetColliderType() == ColliderType::Trigger; }
+bool BoxCollider::IsDynamic() const { return GetColliderType() == ColliderType::Dynamic; }
+bool BoxCollider::IsStatic () const { return GetColliderType() == ColliderType::Static; }
 
-bool pixel_engine::BoxCollider::HasTag(const std::string& tag)
+bool pixel_engine::BoxCollider::HasTag(const std::string& tag) const
 {
-    return m_tags[tag];
+    return HasTag(PECollisionLayers::Instance().Find(tag));
 }
 
 bool pixel_engine::BoxCollider::AttachTag(const std::string& tag)
 {
-    m_tags[tag] = true;
+    const TagMask bit = PECollisionLayers::Instance().Intern(tag);
+    if (!bit) return false;
+
+    m_tagMask |= bit;
     return true;
 }
 
 void pixel_engine::BoxCollider::DetachTag(const std::string& tag)
 {
-    m_tags[tag] = false;
+    m_tagMask &= ~PECollisionLayers::Instance().Find(tag);
+}
+
+TagMask pixel_engine::BoxCollider::GetLayerMask() const
+{
+    return IsStatic() ? (m_tagMask | PECollisionLayers::kStaticLayer) : m_tagMask;
 }
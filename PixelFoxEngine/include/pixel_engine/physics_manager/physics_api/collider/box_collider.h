@@ -7,6 +7,7 @@
 #include "core/unordered_map.h"
 #include "core/vector.h"
 #include "pixel_engine/physics_manager/physics_api/rigid_body/rigid_body.h"
+#include "pixel_engine/physics_manager/physics_api/collider/collision_layers.h"
 
 #include <functional>
 #include <cstdint>
@@ -49,6 +50,7 @@ namespace pixel_engine
 
 		//~ Collision handling
 		bool CheckCollision(BoxCollider* other, Contact& outContact);  // AABB/OBB collision test
+		bool TestCollision (const BoxCollider* other, Contact& outContact) const; // same test, no state, any thread
 		void RegisterCollision(BoxCollider* other, const Contact& contact);
 
 		//~ Callbacks
@@ -81,11 +83,22 @@ namespace pixel_engine
 		bool IsDynamic() const;
 		bool IsStatic() const;
 
-		//~ tag
-		bool HasTag   (const std::string& tag);
+		//~ something entered and has not left yet, Update still owes its exit
+		bool HasTrackedHits() const;
+
+		//~ tag, names are interned by PECollisionLayers, hot paths keep the
+		//~ mask and test that instead of the name
+		bool HasTag   (const std::string& tag) const;
 		bool AttachTag(const std::string& tag);
 		void DetachTag(const std::string& tag);
 
+		//~ any of the tag bits
+		bool HasTag(TagMask tags) const noexcept { return (m_tagMask & tags) != 0u; }
+		TagMask GetTagMask() const noexcept { return m_tagMask; }
+
+		//~ tags plus PECollisionLayers::kStaticLayer while the type is Static
+		TagMask GetLayerMask() const;
+
 	private:
 		//~ helpers
 		float AbsF(float v) const { return v < 0.f ? -v : v; }
@@ -93,12 +106,10 @@ namespace pixel_engine
 
 	private:
 		//~ game tag
-		fox::unordered_map<std::string, bool> m_tags;
+		TagMask m_tagMask{ 0u };
 
-		//~ Internal data
-		FVector2D    m_scale		{ 1.0f, 1.0f };       
-		FVector2D    m_offset		{ 0.0f, 0.0f };
-		ColliderType m_colliderType	{ ColliderType::Static };
+		//~ Internal data, scale offset and type live in the transform store
+		//~ next to the body so the pair tests read one set of columns
 		RigidBody2D* m_pRigidBody	{ nullptr };
 
 		FVector2D m_lastContactNormal{ 0.f, 0.f };
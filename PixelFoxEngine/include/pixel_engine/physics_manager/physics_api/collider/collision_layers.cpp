@@ -0,0 +1,80 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "collision_layers.h"
+
+#include "pixel_engine/utilities/logger/logger.h"
+
+#include <bit>
+
+using namespace pixel_engine;
+
+PECollisionLayers::PECollisionLayers()
+{
+    SetCollides(kStaticLayer, kStaticLayer, false);
+}
+
+_Use_decl_annotations_
+TagMask PECollisionLayers::Intern(const std::string& tag)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (const uint32_t* bit = m_bits.find(tag)) return 1ull << *bit;
+    if (m_nextBit >= kMaxTags)
+    {
+        logger::error("Out of collision layers, tag {} is not interned!", tag);
+        return 0u;
+    }
+
+    const uint32_t bit = m_nextBit++;
+    m_bits[tag] = bit;
+    return 1ull << bit;
+}
+
+_Use_decl_annotations_
+TagMask PECollisionLayers::Find(const std::string& tag) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32_t* bit = m_bits.find(tag);
+    return bit ? (1ull << *bit) : 0u;
+}
+
+_Use_decl_annotations_
+void PECollisionLayers::SetCollides(TagMask a, TagMask b, bool collides) noexcept
+{
+    for (TagMask rest = a; rest; rest &= rest - 1u)
+    {
+        TagMask& row = m_ignores[std::countr_zero(rest)];
+        row = collides ? (row & ~b) : (row | b);
+    }
+    for (TagMask rest = b; rest; rest &= rest - 1u)
+    {
+        TagMask& row = m_ignores[std::countr_zero(rest)];
+        row = collides ? (row & ~a) : (row | a);
+    }
+}
+
+_Use_decl_annotations_
+void PECollisionLayers::SetCollides(const std::string& a, const std::string& b, bool collides)
+{
+    SetCollides(Intern(a), Intern(b), collides);
+}
+
+_Use_decl_annotations_
+TagMask PECollisionLayers::GetIgnoredBy(TagMask layers) const noexcept
+{
+    TagMask ignored = 0u;
+    for (TagMask rest = layers; rest; rest &= rest - 1u)
+    {
+        ignored |= m_ignores[std::countr_zero(rest)];
+    }
+    return ignored;
+}
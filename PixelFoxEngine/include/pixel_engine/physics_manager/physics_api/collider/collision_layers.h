@@ -0,0 +1,79 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/core/interface/interface_singleton.h"
+
+#include "core/unordered_map.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace pixel_engine
+{
+	//~ one bit per interned tag, a collider's layers are its tag bits
+	using TagMask = uint64_t;
+
+	/// <summary>
+	/// Interns collider tags into bits of a 64 bit mask and keeps the
+	/// layer against layer collision matrix. Strings are only hashed when
+	/// a tag is attached or looked up by name, pair filtering in the
+	/// broadphase is one AND of a collider's ignore mask with the layers
+	/// of the other collider. Interning may happen from any thread.
+	/// </summary>
+	class PFE_API PECollisionLayers final : public ISingleton<PECollisionLayers>
+	{
+	public:
+		static constexpr uint32_t kMaxTags = 64u;
+
+		//~ bit 0, reserved for colliders whose type is Static, no tag maps to it
+		static constexpr TagMask kStaticLayer = 1ull;
+
+		//~ static against static is ignored, every other pair collides
+		PECollisionLayers();
+
+		//~ bit of the tag, assigned on first use; logs and returns 0 once
+		//~ all 63 tag bits are taken
+		_NODISCARD _Check_return_
+		TagMask Intern(_In_ const std::string& tag);
+
+		//~ never assigns, 0 for a tag nothing has interned
+		_NODISCARD _Check_return_
+		TagMask Find(_In_ const std::string& tag) const;
+
+		//~ every layer of a against every layer of b, both ways round
+		void SetCollides(_In_ TagMask a, _In_ TagMask b, _In_ bool collides) noexcept;
+		void SetCollides(
+			_In_ const std::string& a,
+			_In_ const std::string& b,
+			_In_ bool				collides);
+
+		//~ layers that a collider on the given layers never pairs with
+		_NODISCARD _Check_return_
+		TagMask GetIgnoredBy(_In_ TagMask layers) const noexcept;
+
+		_NODISCARD _Check_return_
+		bool Collides(_In_ TagMask a, _In_ TagMask b) const noexcept
+		{
+			return (GetIgnoredBy(a) & b) == 0u;
+		}
+
+	private:
+		mutable std::mutex						  m_mutex{}; // guards m_bits and m_nextBit
+		fox::unordered_map<std::string, uint32_t> m_bits{};
+		uint32_t m_nextBit{ 1u }; // bit 0 is kStaticLayer
+		TagMask	 m_ignores[kMaxTags]{}; // symmetric, row i is what bit i ignores
+	};
+} // namespace pixel_engine
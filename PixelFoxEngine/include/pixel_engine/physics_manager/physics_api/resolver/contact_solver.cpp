@@ -0,0 +1,304 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "contact_solver.h"
+
+#include "resolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using namespace pixel_engine;
+
+namespace
+{
+    //~ same slop as CollisionResolver, depth under it is left alone
+    constexpr float kSlop    = 0.01f;
+
+    //~ share of the remaining depth taken out by each position pass between
+    //~ two moving bodies; against a static side the whole depth goes, a
+    //~ body left part way in would sink further into walls every frame
+    constexpr float kPercent = 0.8f;
+
+    //~ a cached impulse carries over only while the pair touches on the
+    //~ same side, the normals are axis aligned so this is same or not
+    constexpr float kMinNormalDot = 0.9f;
+
+    inline float Dot(const FVector2D& a, const FVector2D& b) noexcept
+    {
+        return a.x * b.x + a.y * b.y;
+    }
+} // namespace
+
+_Use_decl_annotations_
+void PEContactSolver::SetIterations(uint32_t velocity, uint32_t position) noexcept
+{
+    m_nVelocityIterations = std::max(velocity, 1u);
+    m_nPositionIterations = std::max(position, 1u);
+}
+
+void PEContactSolver::Reset()
+{
+    m_cache[0].clear();
+    m_cache[1].clear();
+}
+
+_Use_decl_annotations_
+void PEContactSolver::Solve(fox::vector<Contact>& contacts, float deltaTime)
+{
+    if (m_eMode == EContactSolver::SinglePass)
+    {
+        m_nIslands = 0u;
+        CollisionResolver::ResolveContact(contacts, deltaTime);
+        return;
+    }
+
+    BuildContacts(contacts);
+
+    //~ contacts grouped by island, in list order inside each island so a
+    //~ frame solves the same way every run
+    m_order.clear();
+    m_order.reserve(m_contacts.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_contacts.size()); ++i)
+    {
+        SOLVER_CONTACT& contact = m_contacts[i];
+        contact.island = FindRoot(contact.a != kNoBody ? contact.a : contact.b);
+        m_order.push_back(i);
+    }
+    std::sort(m_order.data(), m_order.data() + m_order.size(),
+        [this](uint32_t l, uint32_t r)
+        {
+            const uint32_t il = m_contacts[l].island;
+            const uint32_t ir = m_contacts[r].island;
+            return il != ir ? il < ir : l < r;
+        });
+
+    //~ islands share no moving body, each one is solved on its own
+    m_nIslands = 0u;
+    const uint32_t count = static_cast<uint32_t>(m_order.size());
+    for (uint32_t begin = 0; begin < count;)
+    {
+        const uint32_t island = m_contacts[m_order[begin]].island;
+        uint32_t end = begin + 1u;
+        while (end < count && m_contacts[m_order[end]].island == island) ++end;
+
+        SolveIsland(begin, end);
+        ++m_nIslands;
+        begin = end;
+    }
+
+    for (const SOLVER_BODY& body : m_bodies)
+    {
+        if (body.shift.x != 0.0f || body.shift.y != 0.0f) body.body->AddPosition(body.shift);
+
+        const FVector2D velocity = body.body->GetVelocity();
+        if (velocity.x != body.velocity.x || velocity.y != body.velocity.y)
+        {
+            body.body->SetVelocity(body.velocity);
+        }
+    }
+
+    //~ impulses for the next frame, normals kept in key order
+    ImpulseCache& next = m_cache[m_nCacheWrite];
+    next.clear();
+    for (const SOLVER_CONTACT& contact : m_contacts)
+    {
+        if (contact.impulse <= 0.0f) continue;
+
+        const bool keyOrder = contact.key.a == contact.source;
+        const FVector2D normal = keyOrder ? contact.normal : FVector2D{ -contact.normal.x, -contact.normal.y };
+        next[contact.key] = { normal, contact.impulse };
+    }
+    m_nCacheWrite ^= 1u;
+}
+
+_Use_decl_annotations_
+void PEContactSolver::BuildContacts(const fox::vector<Contact>& contacts)
+{
+    m_bodies   .clear();
+    m_contacts .clear();
+    m_bodyIndex.clear();
+
+    const ImpulseCache& previous = m_cache[m_nCacheWrite ^ 1u];
+
+    for (const Contact& contact : contacts)
+    {
+        BoxCollider* colliderA = contact.A;
+        BoxCollider* colliderB = contact.B;
+        if (!colliderA || !colliderB) continue;
+
+        if (colliderA->IsTrigger() || colliderB->IsTrigger()) continue;
+        if (colliderA->IsStatic()  && colliderB->IsStatic())  continue;
+
+        FVector2D n = contact.Normal;
+        const float nDot = Dot(n, n);
+        if (nDot <= 1e-12f) continue;
+        n *= (1.0f / std::sqrt(nDot));
+
+        const FVector2D ac = colliderA->GetWorldCenter();
+        const FVector2D bc = colliderB->GetWorldCenter();
+        if (Dot({ bc.x - ac.x, bc.y - ac.y }, n) < 0.0f) n = { -n.x, -n.y };
+
+        SOLVER_CONTACT solver{};
+        solver.a = BodyOf(colliderA);
+        solver.b = BodyOf(colliderB);
+
+        const float invA = solver.a != kNoBody ? m_bodies[solver.a].invMass : 0.0f;
+        const float invB = solver.b != kNoBody ? m_bodies[solver.b].invMass : 0.0f;
+        solver.invSum = invA + invB;
+        if (solver.invSum <= 0.0f) continue;
+
+        solver.normal = n;
+        solver.depth  = contact.Penetration;
+        solver.source = colliderA;
+        solver.key    = std::less<const BoxCollider*>{}(colliderA, colliderB)
+                      ? PFE_CONTACT_KEY{ colliderA, colliderB }
+                      : PFE_CONTACT_KEY{ colliderB, colliderA };
+
+        if (solver.a != kNoBody && solver.b != kNoBody)
+        {
+            const uint32_t ra = FindRoot(solver.a);
+            const uint32_t rb = FindRoot(solver.b);
+            if (ra != rb) m_bodies[std::max(ra, rb)].parent = std::min(ra, rb);
+        }
+
+        if (m_bWarmStart)
+        {
+            if (const CACHED_IMPULSE* cached = previous.find(solver.key))
+            {
+                const FVector2D keyNormal = solver.key.a == colliderA ? n : FVector2D{ -n.x, -n.y };
+                if (Dot(cached->normal, keyNormal) >= kMinNormalDot) solver.impulse = cached->impulse;
+            }
+        }
+
+        m_contacts.push_back(solver);
+    }
+}
+
+_Use_decl_annotations_
+uint32_t PEContactSolver::BodyOf(BoxCollider* collider)
+{
+    //~ static colliders and bodies without mass only anchor their contacts
+    RigidBody2D* body = collider->GetRigidBody2D();
+    if (!body || collider->IsStatic()) return kNoBody;
+
+    if (const uint32_t* index = m_bodyIndex.find(body)) return *index;
+
+    const float invMass = body->GetInverseMass();
+    if (invMass <= 0.0f) return kNoBody;
+
+    const uint32_t index = static_cast<uint32_t>(m_bodies.size());
+    m_bodies.push_back({ body, invMass, body->GetVelocity(), { 0.0f, 0.0f }, index });
+    m_bodyIndex[body] = index;
+    return index;
+}
+
+_Use_decl_annotations_
+uint32_t PEContactSolver::FindRoot(uint32_t body) noexcept
+{
+    while (m_bodies[body].parent != body)
+    {
+        m_bodies[body].parent = m_bodies[m_bodies[body].parent].parent;
+        body = m_bodies[body].parent;
+    }
+    return body;
+}
+
+_Use_decl_annotations_
+void PEContactSolver::ApplyImpulse(SOLVER_CONTACT& contact, float impulse) noexcept
+{
+    const FVector2D j{ contact.normal.x * impulse, contact.normal.y * impulse };
+    if (contact.a != kNoBody)
+    {
+        SOLVER_BODY& a = m_bodies[contact.a];
+        a.velocity = { a.velocity.x - j.x * a.invMass, a.velocity.y - j.y * a.invMass };
+    }
+    if (contact.b != kNoBody)
+    {
+        SOLVER_BODY& b = m_bodies[contact.b];
+        b.velocity = { b.velocity.x + j.x * b.invMass, b.velocity.y + j.y * b.invMass };
+    }
+}
+
+_Use_decl_annotations_
+void PEContactSolver::SolveIsland(uint32_t begin, uint32_t end)
+{
+    const FVector2D zero{ 0.0f, 0.0f };
+
+    //~ warm start, last frame's push is applied before the passes
+    for (uint32_t k = begin; k < end; ++k)
+    {
+        SOLVER_CONTACT& contact = m_contacts[m_order[k]];
+        if (contact.impulse > 0.0f) ApplyImpulse(contact, contact.impulse);
+    }
+
+    //~ velocity passes, the accumulated impulse never pulls the pair together
+    for (uint32_t it = 0; it < m_nVelocityIterations; ++it)
+    {
+        for (uint32_t k = begin; k < end; ++k)
+        {
+            SOLVER_CONTACT& contact = m_contacts[m_order[k]];
+            const FVector2D& va = contact.a != kNoBody ? m_bodies[contact.a].velocity : zero;
+            const FVector2D& vb = contact.b != kNoBody ? m_bodies[contact.b].velocity : zero;
+
+            const float vn      = Dot({ vb.x - va.x, vb.y - va.y }, contact.normal);
+            const float total   = std::max(contact.impulse - vn / contact.invSum, 0.0f);
+            const float applied = total - contact.impulse;
+            contact.impulse = total;
+
+            if (applied != 0.0f) ApplyImpulse(contact, applied);
+        }
+    }
+
+    //~ position passes on what is left of each depth after the earlier
+    //~ corrections, so a body squeezed by several contacts settles
+    for (uint32_t it = 0; it < m_nPositionIterations; ++it)
+    {
+        for (uint32_t k = begin; k < end; ++k) PushApart(m_contacts[m_order[k]]);
+    }
+
+    //~ static contacts have the last word, a moving neighbour may have
+    //~ pushed a body back into a wall during the passes
+    for (uint32_t k = begin; k < end; ++k)
+    {
+        const SOLVER_CONTACT& contact = m_contacts[m_order[k]];
+        if (contact.a == kNoBody || contact.b == kNoBody) PushApart(contact);
+    }
+}
+
+_Use_decl_annotations_
+void PEContactSolver::PushApart(const SOLVER_CONTACT& contact) noexcept
+{
+    const FVector2D zero{ 0.0f, 0.0f };
+    const FVector2D& sa = contact.a != kNoBody ? m_bodies[contact.a].shift : zero;
+    const FVector2D& sb = contact.b != kNoBody ? m_bodies[contact.b].shift : zero;
+
+    const float depth = contact.depth - Dot({ sb.x - sa.x, sb.y - sa.y }, contact.normal);
+    const bool  fixed = contact.a == kNoBody || contact.b == kNoBody;
+    const float mag   = fixed ? std::max(depth, 0.0f) / contact.invSum
+                              : std::max(depth - kSlop, 0.0f) * kPercent / contact.invSum;
+    if (mag <= 0.0f) return;
+
+    if (contact.a != kNoBody)
+    {
+        SOLVER_BODY& a = m_bodies[contact.a];
+        a.shift = { a.shift.x - contact.normal.x * mag * a.invMass,
+                    a.shift.y - contact.normal.y * mag * a.invMass };
+    }
+    if (contact.b != kNoBody)
+    {
+        SOLVER_BODY& b = m_bodies[contact.b];
+        b.shift = { b.shift.x + contact.normal.x * mag * b.invMass,
+                    b.shift.y + contact.normal.y * mag * b.invMass };
+    }
+}
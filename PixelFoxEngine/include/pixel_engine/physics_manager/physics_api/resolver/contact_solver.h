@@ -0,0 +1,150 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "core/unordered_map.h"
+#include "core/vector.h"
+#include "fox_math/vector.h"
+
+#include "pixel_engine/utilities/hash_type.h"
+#include "pixel_engine/physics_manager/physics_api/collider/contact.h"
+
+#include <cstdint>
+
+namespace pixel_engine
+{
+	enum class EContactSolver : uint8_t
+	{
+		SinglePass, // CollisionResolver, every contact corrected once in list order
+		Islands		// iterative velocity and position passes per island, warm started
+	};
+
+	//~ a collider pair, a is the lower address so both orders meet
+	typedef struct _PFE_CONTACT_KEY
+	{
+		const BoxCollider* a{ nullptr };
+		const BoxCollider* b{ nullptr };
+
+		bool operator==(const _PFE_CONTACT_KEY&) const noexcept = default;
+	} PFE_CONTACT_KEY;
+
+	struct PFE_CONTACT_KEY_HASH
+	{
+		_NODISCARD
+		size_t operator()(_In_ const PFE_CONTACT_KEY& key) const noexcept
+		{
+			uint64_t hash = HashCombine(0u, reinterpret_cast<uintptr_t>(key.a));
+			hash = HashCombine(hash, reinterpret_cast<uintptr_t>(key.b));
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	/// <summary>
+	/// Contact solver for the frame's contacts. Bodies joined by contacts
+	/// form islands (static colliders never join, they only anchor), and
+	/// each island runs a few sequential impulse passes on the velocities
+	/// followed by a few passes on the positions, so a crowd pressing on a
+	/// wall settles instead of being pushed back one contact at a time.
+	/// Normal impulses are kept per collider pair for one frame and applied
+	/// up front the next frame while the pair is still touching.
+	/// </summary>
+	class PFE_API PEContactSolver
+	{
+	public:
+		PEContactSolver() = default;
+
+		//~ Islands unless changed, SinglePass kept for comparison
+		void SetMode(_In_ EContactSolver mode) noexcept { m_eMode = mode; }
+
+		_NODISCARD _Check_return_
+		EContactSolver GetMode() const noexcept { return m_eMode; }
+
+		//~ passes per island, at least one of each
+		void SetIterations(_In_ uint32_t velocity, _In_ uint32_t position) noexcept;
+
+		void SetWarmStarting(_In_ bool enable) noexcept { m_bWarmStart = enable; }
+
+		_NODISCARD _Check_return_
+		bool IsWarmStarting() const noexcept { return m_bWarmStart; }
+
+		//~ triggers and static against static are skipped as before
+		void Solve(_Inout_ fox::vector<Contact>& contacts, _In_ float deltaTime);
+
+		//~ forgets the cached impulses, for level loads
+		void Reset();
+
+		_NODISCARD _Check_return_
+		uint32_t GetIslandCount() const noexcept { return m_nIslands; }
+
+	private:
+		static constexpr uint32_t kNoBody = ~0u;
+
+		typedef struct _SOLVER_BODY
+		{
+			RigidBody2D* body	  { nullptr };
+			float		 invMass  { 0.0f };
+			FVector2D	 velocity { 0.0f, 0.0f };
+			FVector2D	 shift	  { 0.0f, 0.0f }; // position correction so far
+			uint32_t	 parent	  { 0u };		  // union find
+		} SOLVER_BODY;
+
+		typedef struct _SOLVER_CONTACT
+		{
+			uint32_t		a		{ kNoBody }; // kNoBody for a static side
+			uint32_t		b		{ kNoBody };
+			FVector2D		normal	{ 0.0f, 0.0f }; // unit, a towards b
+			float			depth	{ 0.0f };
+			float			invSum	{ 0.0f };
+			float			impulse { 0.0f };		// accumulated, never negative
+			uint32_t		island	{ 0u };
+			PFE_CONTACT_KEY key		{};
+			const BoxCollider* source{ nullptr }; // Contact::A, normal points away from it
+		} SOLVER_CONTACT;
+
+		typedef struct _CACHED_IMPULSE
+		{
+			FVector2D normal { 0.0f, 0.0f };
+			float	  impulse{ 0.0f };
+		} CACHED_IMPULSE;
+
+		void	 BuildContacts(_In_ const fox::vector<Contact>& contacts);
+		uint32_t BodyOf(_In_ BoxCollider* collider);
+		uint32_t FindRoot(_In_ uint32_t body) noexcept;
+		void	 SolveIsland(_In_ uint32_t begin, _In_ uint32_t end);
+		void	 ApplyImpulse(_Inout_ SOLVER_CONTACT& contact, _In_ float impulse) noexcept;
+
+		//~ shifts the pair apart by what is left of its depth, all of it
+		//~ against a static side and kPercent above the slop otherwise
+		void	 PushApart(_In_ const SOLVER_CONTACT& contact) noexcept;
+
+	private:
+		EContactSolver m_eMode			  { EContactSolver::Islands };
+		uint32_t	   m_nVelocityIterations{ 4u };
+		uint32_t	   m_nPositionIterations{ 4u };
+		bool		   m_bWarmStart		  { true };
+		uint32_t	   m_nIslands		  { 0u };
+
+		//~ per frame, kept so a steady scene does not allocate
+		fox::vector<SOLVER_BODY>					   m_bodies  {};
+		fox::vector<SOLVER_CONTACT>					   m_contacts{};
+		fox::vector<uint32_t>						   m_order	 {}; // contacts grouped by island
+		fox::unordered_map<const RigidBody2D*, uint32_t> m_bodyIndex{};
+
+		//~ impulses by pair, the frames alternate between the two maps: one is
+		//~ read from last frame while the other is cleared and written
+		using ImpulseCache = fox::unordered_map<PFE_CONTACT_KEY, CACHED_IMPULSE, PFE_CONTACT_KEY_HASH>;
+		ImpulseCache m_cache[2]{};
+		uint32_t	 m_nCacheWrite{ 0u };
+	};
+} // namespace pixel_engine
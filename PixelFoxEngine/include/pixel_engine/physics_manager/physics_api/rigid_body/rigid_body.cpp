@@ -4,119 +4,201 @@
 #include <cmath>
 #include <algorithm>
 
+namespace
+{
+	pixel_engine::PFE_TRANSFORM_COLUMNS& Columns()
+	{
+		return pixel_engine::PETransformStore::Instance().Columns();
+	}
+
+	size_t IndexOf(pixel_engine::TransformHandle handle)
+	{
+		return pixel_engine::PETransformStore::Instance().Index(handle);
+	}
+} // namespace
 
 pixel_engine::RigidBody2D::RigidBody2D()
-	: m_inverseMass(1.0f)
-	, m_linearDamping(0.0f)
-	, m_angularDamping(0.0f)
-	, m_velocity(0.0f, 0.0f)
-	, m_acceleration(0.0f, 0.0f)
-	, m_angularVelocity(0.0f)
-	, m_forceAcc(0.0f, 0.0f)
-	, m_torqueAcc(0.0f)
+	: m_handle(PETransformStore::Instance().Create())
+{
+}
+
+pixel_engine::RigidBody2D::~RigidBody2D()
 {
+	PETransformStore::Instance().Destroy(m_handle);
 }
 
 void pixel_engine::RigidBody2D::AddForce(const FVector2D& force)
 {
-	m_forceAcc += force;
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.ForceX[i] += force.x;
+	c.ForceY[i] += force.y;
 }
 
 void pixel_engine::RigidBody2D::AddTorque(float torque)
 {
-	m_torqueAcc += torque;
+	Columns().Torque[IndexOf(m_handle)] += torque;
 }
 
 void pixel_engine::RigidBody2D::Integrate(float deltaTime)
 {
-	if (deltaTime <= 0.0f)
-	{
-		ClearAccumulators();
-		return;
-	}
-
-	FVector2D totalAccel = m_acceleration + m_forceAcc * m_inverseMass;
-	m_velocity += totalAccel * deltaTime;
+	//~ the physics queue integrates every body in one sweep instead
+	PETransformStore::Instance().Integrate(m_handle, deltaTime);
+}
 
-	//~ apply linear damping
-	if (m_linearDamping > 0.0f)
-	{
-		const float damping = std::exp(-m_linearDamping * deltaTime);
-		m_velocity *= damping;
-	}
+//~ getters
+FTransform2D pixel_engine::RigidBody2D::GetTransform() const
+{
+	const auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	return FTransform2D(
+		{ c.PositionX[i], c.PositionY[i] },
+		c.Rotation[i],
+		{ c.ScaleX[i], c.ScaleY[i] },
+		{ c.PivotX[i], c.PivotY[i] });
+}
 
-	m_transform.Position += m_velocity * deltaTime;
+FVector2D pixel_engine::RigidBody2D::GetPosition() const
+{
+	const auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	return { c.PositionX[i], c.PositionY[i] };
+}
 
-	//~ Angular Motion
-	float angularAccel = m_torqueAcc;
-	m_angularVelocity += angularAccel * deltaTime;
+float pixel_engine::RigidBody2D::GetRotation() const { return Columns().Rotation[IndexOf(m_handle)]; }
 
-	if (m_angularDamping > 0.0f)
-	{
-		const float damping = std::exp(-m_angularDamping * deltaTime);
-		m_angularVelocity *= damping;
-	}
+FVector2D pixel_engine::RigidBody2D::GetScale() const
+{
+	const auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	return { c.ScaleX[i], c.ScaleY[i] };
+}
 
-	m_transform.Rotation += m_angularVelocity * deltaTime;
+FVector2D pixel_engine::RigidBody2D::GetPivot() const
+{
+	const auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	return { c.PivotX[i], c.PivotY[i] };
+}
 
-	ClearAccumulators();
+FVector2D pixel_engine::RigidBody2D::GetVelocity() const
+{
+	const auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	return { c.VelocityX[i], c.VelocityY[i] };
 }
 
-//~ getters
-FTransform2D pixel_engine::RigidBody2D::GetTransform() const { return m_transform;		  }
-FVector2D pixel_engine::RigidBody2D::GetPosition	  () const { return m_transform.Position; }
-float pixel_engine::RigidBody2D::GetRotation		  () const { return m_transform.Rotation; }
+FVector2D pixel_engine::RigidBody2D::GetAcceleration() const
+{
+	const auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	return { c.AccelerationX[i], c.AccelerationY[i] };
+}
 
-FVector2D pixel_engine::RigidBody2D::GetVelocity	  () const { return m_velocity;		   }
-FVector2D pixel_engine::RigidBody2D::GetAcceleration() const { return m_acceleration;    }
-float pixel_engine::RigidBody2D::GetAngularVelocity () const { return m_angularVelocity; }
+float pixel_engine::RigidBody2D::GetAngularVelocity() const { return Columns().AngularVelocity[IndexOf(m_handle)]; }
 
 float pixel_engine::RigidBody2D::GetMass() const
 {
-	return (m_inverseMass > 0.0f) ? (1.0f / m_inverseMass) : std::numeric_limits<float>::infinity();
+	const float inverseMass = GetInverseMass();
+	return (inverseMass > 0.0f) ? (1.0f / inverseMass) : std::numeric_limits<float>::infinity();
 }
 
-float pixel_engine::RigidBody2D::GetInverseMass   () const { return m_inverseMass;    }
-float pixel_engine::RigidBody2D::GetLinearDamping () const { return m_linearDamping;  }
-float pixel_engine::RigidBody2D::GetAngularDamping() const { return m_angularDamping; }
+float pixel_engine::RigidBody2D::GetInverseMass   () const { return Columns().InverseMass   [IndexOf(m_handle)]; }
+float pixel_engine::RigidBody2D::GetLinearDamping () const { return Columns().LinearDamping [IndexOf(m_handle)]; }
+float pixel_engine::RigidBody2D::GetAngularDamping() const { return Columns().AngularDamping[IndexOf(m_handle)]; }
 
 //~ setters
-void pixel_engine::RigidBody2D::SetTransform(const FTransform2D& t) { m_transform = t;					  }
-void pixel_engine::RigidBody2D::SetPosition (const FVector2D& p)    { m_transform.Position = p;			  }
-void pixel_engine::RigidBody2D::SetRotation (float radians)	      { m_transform.Rotation = radians;		  }
-void pixel_engine::RigidBody2D::AddRotation (float deltaRadians)    { m_transform.Rotation += deltaRadians; }
+void pixel_engine::RigidBody2D::SetTransform(const FTransform2D& t)
+{
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.PositionX[i] = t.Position.x;
+	c.PositionY[i] = t.Position.y;
+	c.Rotation [i] = t.Rotation;
+	c.ScaleX   [i] = t.Scale.x;
+	c.ScaleY   [i] = t.Scale.y;
+	c.PivotX   [i] = t.Pivot.x;
+	c.PivotY   [i] = t.Pivot.y;
+}
+
+void pixel_engine::RigidBody2D::SetPosition(const FVector2D& p)
+{
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.PositionX[i] = p.x;
+	c.PositionY[i] = p.y;
+}
 
-void pixel_engine::RigidBody2D::SetVelocity(const FVector2D& velocity) { m_velocity = velocity; }
-void pixel_engine::RigidBody2D::AddVelocity(const FVector2D& dv)		 { m_velocity += dv;	  }
+void pixel_engine::RigidBody2D::AddPosition(const FVector2D& delta)
+{
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.PositionX[i] += delta.x;
+	c.PositionY[i] += delta.y;
+}
 
-void pixel_engine::RigidBody2D::SetAcceleration(const FVector2D& acc) { m_acceleration = acc; }
+void pixel_engine::RigidBody2D::SetRotation(float radians)	   { Columns().Rotation[IndexOf(m_handle)]  = radians;	   }
+void pixel_engine::RigidBody2D::AddRotation(float deltaRadians) { Columns().Rotation[IndexOf(m_handle)] += deltaRadians; }
 
-void pixel_engine::RigidBody2D::SetAngularVelocity(float w)  { m_angularVelocity = w; }
-void pixel_engine::RigidBody2D::AddAngularVelocity(float dw) { m_angularVelocity += dw; }
+void pixel_engine::RigidBody2D::SetScale(const FVector2D& scale)
+{
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.ScaleX[i] = scale.x;
+	c.ScaleY[i] = scale.y;
+}
+
+void pixel_engine::RigidBody2D::SetPivot(const FVector2D& pivot)
+{
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.PivotX[i] = pivot.x;
+	c.PivotY[i] = pivot.y;
+}
+
+void pixel_engine::RigidBody2D::SetVelocity(const FVector2D& velocity)
+{
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.VelocityX[i] = velocity.x;
+	c.VelocityY[i] = velocity.y;
+}
+
+void pixel_engine::RigidBody2D::AddVelocity(const FVector2D& dv)
+{
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.VelocityX[i] += dv.x;
+	c.VelocityY[i] += dv.y;
+}
+
+void pixel_engine::RigidBody2D::SetAcceleration(const FVector2D& acc)
+{
+	auto& c = Columns();
+	const size_t i = IndexOf(m_handle);
+	c.AccelerationX[i] = acc.x;
+	c.AccelerationY[i] = acc.y;
+}
+
+void pixel_engine::RigidBody2D::SetAngularVelocity(float w)  { Columns().AngularVelocity[IndexOf(m_handle)]  = w;  }
+void pixel_engine::RigidBody2D::AddAngularVelocity(float dw) { Columns().AngularVelocity[IndexOf(m_handle)] += dw; }
 
 void pixel_engine::RigidBody2D::SetMass(float mass)
 {
-	if (mass > 0.0f) m_inverseMass = 1.0f / mass;
-	else m_inverseMass = 0.0f;
+	Columns().InverseMass[IndexOf(m_handle)] = (mass > 0.0f) ? 1.0f / mass : 0.0f;
 }
 
 void pixel_engine::RigidBody2D::SetInverseMass(float invMass)
 {
-	m_inverseMass = std::max(0.0f, invMass);
+	Columns().InverseMass[IndexOf(m_handle)] = std::max(0.0f, invMass);
 }
 
 void pixel_engine::RigidBody2D::SetLinearDamping(float d)
 {
-	m_linearDamping = std::max(0.0f, d);
+	Columns().LinearDamping[IndexOf(m_handle)] = std::max(0.0f, d);
 }
 
 void pixel_engine::RigidBody2D::SetAngularDamping(float d)
 {
-	m_angularDamping = std::max(0.0f, d);
-}
-
-void pixel_engine::RigidBody2D::ClearAccumulators()
-{
-	m_forceAcc = { 0.0f, 0.0f };
-	m_torqueAcc = 0.0f;
+	Columns().AngularDamping[IndexOf(m_handle)] = std::max(0.0f, d);
 }
@@ -15,12 +15,22 @@
 #include "fox_math/vector.h"
 #include "fox_math/transform.h"
 
+#include "pixel_engine/physics_manager/physics_api/store/transform_store.h"
+
 namespace pixel_engine
 {
+	//~ a view into PETransformStore, owns one body there for its lifetime
 	class PFE_API RigidBody2D
 	{
 	public:
 		RigidBody2D();
+		~RigidBody2D();
+
+		RigidBody2D(const RigidBody2D&) = delete;
+		RigidBody2D(RigidBody2D&&)		= delete;
+
+		RigidBody2D& operator=(const RigidBody2D&) = delete;
+		RigidBody2D& operator=(RigidBody2D&&)	   = delete;
 
 		//~ simulate
 		void AddForce(const FVector2D& force);
@@ -31,6 +41,8 @@ namespace pixel_engine
 		FTransform2D GetTransform() const;
 		FVector2D GetPosition() const;
 		float GetRotation() const;
+		FVector2D GetScale() const;
+		FVector2D GetPivot() const;
 
 		FVector2D GetVelocity() const;
 		FVector2D GetAcceleration() const;
@@ -45,7 +57,10 @@ namespace pixel_engine
 		//~ setters
 		void SetTransform(const FTransform2D& t);
 		void SetPosition(const FVector2D& p);
+		void AddPosition(const FVector2D& delta);
 		void SetRotation(float radians);
+		void SetScale(const FVector2D& scale);
+		void SetPivot(const FVector2D& pivot);
 		void AddRotation(float deltaRadians);
 
 		void SetVelocity(const FVector2D& velocity);
@@ -62,18 +77,9 @@ namespace pixel_engine
 		void SetLinearDamping(float d);
 		void SetAngularDamping(float d);
 
-		FTransform2D m_transform{};
-		FVector2D    m_velocity{};
-		FVector2D    m_acceleration{};
-		float		 m_angularVelocity{};
-		float		 m_inverseMass{ 1.0f };
-		float		 m_linearDamping{ 0.25f };
-		float		 m_angularDamping{ 0.0f };
-		FVector2D	 m_forceAcc{};
-		float		 m_torqueAcc{ 0.0f };
+		TransformHandle GetHandle() const noexcept { return m_handle; }
 
 	private:
-		void ClearAccumulators();
-
+		TransformHandle m_handle{ kInvalidTransform };
 	};
 } // namespace fox_physics
@@ -0,0 +1,243 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "transform_store.h"
+
+#include <cmath>
+
+using namespace pixel_engine;
+
+namespace
+{
+    void ClearAccumulators(PFE_TRANSFORM_COLUMNS& c, size_t i) noexcept
+    {
+        c.ForceX[i] = 0.0f;
+        c.ForceY[i] = 0.0f;
+        c.Torque[i] = 0.0f;
+    }
+
+    //~ semi implicit euler, same steps RigidBody2D::Integrate always took
+    void IntegrateAt(PFE_TRANSFORM_COLUMNS& c, size_t i, float dt) noexcept
+    {
+        const float ax = c.AccelerationX[i] + c.ForceX[i] * c.InverseMass[i];
+        const float ay = c.AccelerationY[i] + c.ForceY[i] * c.InverseMass[i];
+
+        float vx = c.VelocityX[i] + ax * dt;
+        float vy = c.VelocityY[i] + ay * dt;
+
+        if (c.LinearDamping[i] > 0.0f)
+        {
+            const float damping = std::exp(-c.LinearDamping[i] * dt);
+            vx *= damping;
+            vy *= damping;
+        }
+
+        c.VelocityX[i]  = vx;
+        c.VelocityY[i]  = vy;
+        c.PositionX[i] += vx * dt;
+        c.PositionY[i] += vy * dt;
+
+        float w = c.AngularVelocity[i] + c.Torque[i] * dt;
+        if (c.AngularDamping[i] > 0.0f)
+        {
+            w *= std::exp(-c.AngularDamping[i] * dt);
+        }
+
+        c.AngularVelocity[i] = w;
+        c.Rotation[i]       += w * dt;
+
+        ClearAccumulators(c, i);
+    }
+
+    //~ translation * rotation * scale * translation(-pivot), the same order as
+    //~ FTransform2D::ToMatrix, written out so no matrix is built
+    void CameraSpaceAt(
+        PFE_TRANSFORM_COLUMNS& c,
+        size_t                 i,
+        const FVector2D&       origin,
+        const FVector2D&       camU,
+        const FVector2D&       camV) noexcept
+    {
+        const float cs = std::cos(c.Rotation[i]);
+        const float sn = std::sin(c.Rotation[i]);
+
+        const float ux =  cs * c.ScaleX[i];
+        const float uy =  sn * c.ScaleX[i];
+        const float vx = -sn * c.ScaleY[i];
+        const float vy =  cs * c.ScaleY[i];
+        const float tx = c.PositionX[i] - (ux * c.PivotX[i] + vx * c.PivotY[i]);
+        const float ty = c.PositionY[i] - (uy * c.PivotX[i] + vy * c.PivotY[i]);
+
+        c.ViewUX[i] = ux * camU.x + uy * camV.x;
+        c.ViewUY[i] = ux * camU.y + uy * camV.y;
+        c.ViewVX[i] = vx * camU.x + vy * camV.x;
+        c.ViewVY[i] = vx * camU.y + vy * camV.y;
+        c.ViewX [i] = origin.x + tx * camU.x + ty * camV.x;
+        c.ViewY [i] = origin.y + tx * camU.y + ty * camV.y;
+    }
+} // namespace
+
+_Use_decl_annotations_
+TransformHandle PETransformStore::Create()
+{
+    TransformHandle handle = kInvalidTransform;
+    if (!m_free.empty())
+    {
+        handle = m_free.back();
+        m_free.pop_back();
+    }
+    else
+    {
+        handle = static_cast<TransformHandle>(m_slots.size());
+        m_slots.push_back(0u);
+    }
+    m_slots[handle] = static_cast<uint32_t>(Size());
+
+    PFE_TRANSFORM_COLUMNS& c = m_columns;
+    c.PositionX.push_back(0.0f);
+    c.PositionY.push_back(0.0f);
+    c.Rotation .push_back(0.0f);
+    c.ScaleX   .push_back(1.0f);
+    c.ScaleY   .push_back(1.0f);
+    c.PivotX   .push_back(0.0f);
+    c.PivotY   .push_back(0.0f);
+
+    c.VelocityX      .push_back(0.0f);
+    c.VelocityY      .push_back(0.0f);
+    c.AccelerationX  .push_back(0.0f);
+    c.AccelerationY  .push_back(0.0f);
+    c.AngularVelocity.push_back(0.0f);
+    c.ForceX         .push_back(0.0f);
+    c.ForceY         .push_back(0.0f);
+    c.Torque         .push_back(0.0f);
+    c.InverseMass    .push_back(1.0f);
+    c.LinearDamping  .push_back(0.0f);
+    c.AngularDamping .push_back(0.0f);
+
+    //~ unit box, static until the owner says otherwise
+    c.HalfExtentX .push_back(0.5f);
+    c.HalfExtentY .push_back(0.5f);
+    c.OffsetX     .push_back(0.0f);
+    c.OffsetY     .push_back(0.0f);
+    c.ColliderType.push_back(1u);
+
+    c.Layer.push_back(0u);
+
+    c.ViewX .push_back(0.0f);
+    c.ViewY .push_back(0.0f);
+    c.ViewUX.push_back(0.0f);
+    c.ViewUY.push_back(0.0f);
+    c.ViewVX.push_back(0.0f);
+    c.ViewVY.push_back(0.0f);
+
+    c.Simulate.push_back(0u);
+    c.Owner   .push_back(handle);
+    return handle;
+}
+
+_Use_decl_annotations_
+void PETransformStore::Destroy(TransformHandle handle)
+{
+    if (handle >= m_slots.size()) return;
+
+    const size_t at   = m_slots[handle];
+    const size_t last = Size() - 1u;
+
+    ForEachColumn([at, last](auto& column)
+    {
+        column[at] = column[last];
+        column.pop_back();
+    });
+
+    if (at != last) m_slots[m_columns.Owner[at]] = static_cast<uint32_t>(at);
+    m_free.push_back(handle);
+}
+
+void PETransformStore::ClearSimulate() noexcept
+{
+    for (uint8_t& flag : m_columns.Simulate) flag = 0u;
+}
+
+_Use_decl_annotations_
+void PETransformStore::SetSimulate(TransformHandle handle) noexcept
+{
+    m_columns.Simulate[Index(handle)] = 1u;
+}
+
+_Use_decl_annotations_
+void PETransformStore::Integrate(float deltaTime)
+{
+    const size_t count = Size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!m_columns.Simulate[i]) continue;
+
+        if (deltaTime <= 0.0f) ClearAccumulators(m_columns, i);
+        else                   IntegrateAt      (m_columns, i, deltaTime);
+    }
+}
+
+_Use_decl_annotations_
+void PETransformStore::UpdateCameraSpace(const FVector2D& origin, const FVector2D& x1, const FVector2D& y1)
+{
+    const FVector2D camU{ x1.x - origin.x, x1.y - origin.y };
+    const FVector2D camV{ y1.x - origin.x, y1.y - origin.y };
+
+    m_viewOrigin = origin;
+    m_viewAxisU  = camU;
+    m_viewAxisV  = camV;
+
+    const size_t count = Size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (m_columns.Simulate[i]) CameraSpaceAt(m_columns, i, origin, camU, camV);
+    }
+}
+
+_Use_decl_annotations_
+void PETransformStore::Integrate(TransformHandle handle, float deltaTime)
+{
+    const size_t i = Index(handle);
+    if (deltaTime <= 0.0f) ClearAccumulators(m_columns, i);
+    else                   IntegrateAt      (m_columns, i, deltaTime);
+}
+
+_Use_decl_annotations_
+void PETransformStore::UpdateCameraSpace(
+    TransformHandle  handle,
+    const FVector2D& origin,
+    const FVector2D& x1,
+    const FVector2D& y1)
+{
+    const FVector2D camU{ x1.x - origin.x, x1.y - origin.y };
+    const FVector2D camV{ y1.x - origin.x, y1.y - origin.y };
+    CameraSpaceAt(m_columns, Index(handle), origin, camU, camV);
+}
+
+template<typename Fn>
+void PETransformStore::ForEachColumn(Fn&& fn)
+{
+    PFE_TRANSFORM_COLUMNS& c = m_columns;
+    fn(c.PositionX); fn(c.PositionY); fn(c.Rotation); fn(c.ScaleX); fn(c.ScaleY); fn(c.PivotX); fn(c.PivotY);
+
+    fn(c.VelocityX); fn(c.VelocityY); fn(c.AccelerationX); fn(c.AccelerationY); fn(c.AngularVelocity);
+    fn(c.ForceX); fn(c.ForceY); fn(c.Torque); fn(c.InverseMass); fn(c.LinearDamping); fn(c.AngularDamping);
+
+    fn(c.HalfExtentX); fn(c.HalfExtentY); fn(c.OffsetX); fn(c.OffsetY); fn(c.ColliderType);
+
+    fn(c.Layer);
+
+    fn(c.ViewX); fn(c.ViewY); fn(c.ViewUX); fn(c.ViewUY); fn(c.ViewVX); fn(c.ViewVY);
+
+    fn(c.Simulate);
+    fn(c.Owner);
+}
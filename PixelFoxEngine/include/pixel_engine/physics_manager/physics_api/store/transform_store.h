@@ -0,0 +1,159 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/core/interface/interface_singleton.h"
+
+#include "fox_math/vector.h"
+#include "core/vector.h"
+
+#include <cstdint>
+
+namespace pixel_engine
+{
+	//~ stable for the lifetime of the body, the dense index behind it is not
+	using TransformHandle = uint32_t;
+	inline constexpr TransformHandle kInvalidTransform = 0xffffffffu;
+
+	//~ entry i of every column is the same body, bodies stay packed at the
+	//~ front so a sweep is a plain loop over each column
+	typedef struct _PFE_TRANSFORM_COLUMNS
+	{
+		//~ transform
+		fox::vector<float> PositionX{};
+		fox::vector<float> PositionY{};
+		fox::vector<float> Rotation {};
+		fox::vector<float> ScaleX	{};
+		fox::vector<float> ScaleY	{};
+		fox::vector<float> PivotX	{}; // local units, before scale
+		fox::vector<float> PivotY	{};
+
+		//~ rigid body
+		fox::vector<float> VelocityX	  {};
+		fox::vector<float> VelocityY	  {};
+		fox::vector<float> AccelerationX  {};
+		fox::vector<float> AccelerationY  {};
+		fox::vector<float> AngularVelocity{};
+		fox::vector<float> ForceX		  {};
+		fox::vector<float> ForceY		  {};
+		fox::vector<float> Torque		  {};
+		fox::vector<float> InverseMass	  {};
+		fox::vector<float> LinearDamping  {};
+		fox::vector<float> AngularDamping {};
+
+		//~ box collider, centred on the position plus the offset
+		fox::vector<float>	 HalfExtentX {};
+		fox::vector<float>	 HalfExtentY {};
+		fox::vector<float>	 OffsetX	 {};
+		fox::vector<float>	 OffsetY	 {};
+		fox::vector<uint8_t> ColliderType{}; // pixel_engine::ColliderType
+
+		//~ sprite
+		fox::vector<uint8_t> Layer{}; // pixel_engine::ELayer
+
+		//~ camera space, written by UpdateCameraSpace
+		fox::vector<float> ViewX  {};
+		fox::vector<float> ViewY  {};
+		fox::vector<float> ViewUX {};
+		fox::vector<float> ViewUY {};
+		fox::vector<float> ViewVX {};
+		fox::vector<float> ViewVY {};
+
+		//~ bodies the physics queue steps this frame
+		fox::vector<uint8_t> Simulate{};
+
+		fox::vector<TransformHandle> Owner{}; // dense index back to the handle
+	} PFE_TRANSFORM_COLUMNS;
+
+	/// <summary>
+	/// Engine owned structure of arrays for everything the frame sweeps
+	/// over: transform, motion, collider box and layer. RigidBody2D and
+	/// BoxCollider are views that only keep a handle, so integration and
+	/// the camera space pass read contiguous columns instead of chasing a
+	/// pointer per object. Logic thread only, the render thread reads the
+	/// snapshot the render queue publishes.
+	/// </summary>
+	class PFE_API PETransformStore final : public ISingleton<PETransformStore>
+	{
+	public:
+		PETransformStore () = default;
+		~PETransformStore() = default;
+
+		//~ appends a body with the RigidBody2D and BoxCollider defaults
+		_NODISCARD _Check_return_
+		TransformHandle Create();
+
+		//~ the last body moves into the hole, only its dense index changes
+		void Destroy(_In_ TransformHandle handle);
+
+		_NODISCARD _Check_return_
+		size_t Index(_In_ TransformHandle handle) const noexcept { return m_slots[handle]; }
+
+		_NODISCARD _Check_return_
+		size_t Size() const noexcept { return m_columns.Owner.size(); }
+
+		_NODISCARD _Check_return_
+		PFE_TRANSFORM_COLUMNS& Columns() noexcept { return m_columns; }
+
+		_NODISCARD _Check_return_
+		const PFE_TRANSFORM_COLUMNS& Columns() const noexcept { return m_columns; }
+
+		//~ sweeps, only bodies marked with SetSimulate take part
+		void ClearSimulate() noexcept;
+		void SetSimulate  (_In_ TransformHandle handle) noexcept;
+
+		void Integrate(_In_ float deltaTime);
+
+		//~ origin and the world unit axes already mapped to the screen
+		void UpdateCameraSpace(
+			_In_ const FVector2D& origin,
+			_In_ const FVector2D& x1,
+			_In_ const FVector2D& y1);
+
+		//~ what the last UpdateCameraSpace sweep mapped with, camera space =
+		//~ origin + x * axis u + y * axis v
+		_NODISCARD _Check_return_
+		const FVector2D& GetViewOrigin() const noexcept { return m_viewOrigin; }
+
+		_NODISCARD _Check_return_
+		const FVector2D& GetViewAxisU() const noexcept { return m_viewAxisU; }
+
+		_NODISCARD _Check_return_
+		const FVector2D& GetViewAxisV() const noexcept { return m_viewAxisV; }
+
+		//~ single body versions, for bodies outside the physics queue
+		void Integrate(
+			_In_ TransformHandle handle,
+			_In_ float			 deltaTime);
+
+		void UpdateCameraSpace(
+			_In_ TransformHandle  handle,
+			_In_ const FVector2D& origin,
+			_In_ const FVector2D& x1,
+			_In_ const FVector2D& y1);
+
+	private:
+		template<typename Fn>
+		void ForEachColumn(_Inout_ Fn&& fn);
+
+	private:
+		PFE_TRANSFORM_COLUMNS		 m_columns{};
+		fox::vector<uint32_t>		 m_slots  {}; // handle to dense index
+		fox::vector<TransformHandle> m_free	  {}; // handles to hand out again
+
+		FVector2D m_viewOrigin{};
+		FVector2D m_viewAxisU {};
+		FVector2D m_viewAxisV {};
+	};
+} // namespace pixel_engine
@@ -12,11 +12,23 @@
 #include "pch.h"
 #include "physics_queue.h"
 
-#include "physics_api/resolver/resolver.h"
+#include "physics_api/store/transform_store.h"
 
 #include "pixel_engine/render_manager/render_queue/render_queue.h"
 #include "pixel_engine/utilities/logger/logger.h"
 #include "pixel_engine/render_manager/render_queue/sampler/sample_allocator.h"
+#include "pixel_engine/core/jobs/job_system.h"
+
+#include <algorithm>
+
+namespace
+{
+    //~ world units, obstacles are two and three tiles across
+    constexpr float kStaticCellSize = 2.0f;
+
+    //~ fewer pairs per chunk cost more to hand out than to test
+    constexpr uint32_t kMinChunkPairs = 256u;
+}
 
 bool pixel_engine::PhysicsQueue::Initialize(Camera2D* camera)
 {
@@ -34,8 +46,18 @@ bool pixel_engine::PhysicsQueue::FrameBegin(float deltaTime)
         desc.X1 = m_pCamera->WorldToCamera({ 1.0f, 0.0f }, 32);
         desc.Y1 = m_pCamera->WorldToCamera({ 0.0f, 1.0f }, 32);
 
-        fox::vector<BoxCollider*> colliders;
-        colliders.reserve(m_sprites.size());
+        auto& colliders = m_colliders;
+        colliders.clear();
+
+        auto& store = PETransformStore::Instance();
+        store.ClearSimulate();
+
+        //~ textures finished on the sampler worker since the last frame
+        //~ and evicted ones the render thread can no longer be drawing
+        auto& sampler = Sampler::Instance();
+        const auto& renderQueue = PERenderQueue::Instance();
+        sampler.SetSnapshotFrames(renderQueue.GetPublishedFrame(), renderQueue.GetReleasedFrame());
+        sampler.PublishCompleted();
 
         for (const auto& obj : m_sprites)
         {
@@ -51,86 +73,98 @@ bool pixel_engine::PhysicsQueue::FrameBegin(float deltaTime)
 
                 if (tdesc.texture)
                 {
-                    auto* built = Sampler::Instance().BuildTexture(tdesc);
-                    sprite->AssignSampledTexture(built);
+                    Texture* built = nullptr;
+                    switch (sampler.RequestTexture(tdesc, built))
+                    {
+                    case ESampleRequest::Pending:
+                    case ESampleRequest::Failed:
+                        //~ keeps the last texture, a sprite without one
+                        //~ borrows the closest scale already sampled; a
+                        //~ failed build stays requested so it is retried
+                        if (!sprite->GetSampledTexture())
+                        {
+                            sprite->AssignPlaceholderTexture(sampler.FindNearestScale(tdesc));
+                        }
+                        break;
+                    case ESampleRequest::Ready:
+                        sprite->AssignSampledTexture(built);
+                        break;
+                    }
                 }
             }
 
+            //~ hidden sprites keep their texture for when they show again
+            sampler.MarkUsed(sprite->GetSampledTexture());
+
             if (!sprite->IsVisible()) continue;
 
-            sprite->Update(deltaTime, desc);
-
-            if (auto* rigidBody = sprite->GetRigidBody2D())
-            {
-                rigidBody->Integrate(deltaTime);
-            }
+            store.SetSimulate(sprite->GetTransformHandle());
 
             if (auto* collider = sprite->GetCollider())
             {
-                collider->Update(deltaTime);
-                colliders.push_back(collider);
+                //~ registered statics are met through their grid
+                if (m_staticSlots.empty() || !m_staticSlots.contains(obj.first))
+                {
+                    colliders.push_back(collider);
+                }
             }
         }
 
-        fox::vector<Contact> contacts{};
-        contacts.reserve(colliders.size());
+        //~ camera space before the step, the frame shows where the bodies
+        //~ started it, then one pass over the columns for every body
+        store.UpdateCameraSpace(desc.Origin, desc.X1, desc.Y1);
+        store.Integrate(deltaTime);
 
-        for (int i = 0; i < static_cast<int>(colliders.size()); i++)
+        for (BoxCollider* collider : colliders)
         {
-            for (int j = i + 1; j < static_cast<int>(colliders.size()); j++)
-            {
-                BoxCollider* a = colliders[i];
-                BoxCollider* b = colliders[j];
-                if (!a || !b) continue;
+            collider->Update(deltaTime);
+        }
+        UpdateTouchedStatics(deltaTime);
 
-                Contact contact{};
-                contact.A = a;
-                contact.B = b;
+        //~ broadphase over the boxes after the step, the narrowphase only
+        //~ sees pairs that can touch and that the layer matrix allows
+        const auto& layers = PECollisionLayers::Instance();
+        m_bounds.clear();
+        m_filters.clear();
+        for (BoxCollider* collider : colliders)
+        {
+            const FVector2D center = collider->GetWorldCenter();
+            const FVector2D half   = collider->GetHalfExtents();
+            m_bounds.push_back({ center.x - half.x, center.y - half.y,
+                                 center.x + half.x, center.y + half.y });
 
-                // skip unwanted cases
-                if (a->HasTag("Enemy") && b->IsStatic()) continue;
-                if (b->HasTag("Enemy") && a->IsStatic()) continue;
+            const TagMask mask = collider->GetLayerMask();
+            m_filters.push_back({ mask, layers.GetIgnoredBy(mask) });
+        }
+        m_broadphase.FindPairs(m_bounds, m_filters, m_pairs);
 
-                try
-                {
-                    if (a->CheckCollision(b, contact))
-                    {
-                        a->RegisterCollision(b, contact);
-                        b->RegisterCollision(a, contact);
-                        contacts.push_back(contact);
-                    }
-                }
-                catch (const std::exception& e)
-                {
-                    pixel_engine::logger::error(
-                        "PhysicsQueue::FrameBegin - Exception in CheckCollision(A={}, B={}): {}",
-                        static_cast<const void*>(a),
-                        static_cast<const void*>(b),
-                        e.what());
-                }
-                catch (...)
-                {
-                    pixel_engine::logger::error(
-                        "PhysicsQueue::FrameBegin - Unknown exception in CheckCollision(A={}, B={})",
-                        static_cast<const void*>(a),
-                        static_cast<const void*>(b));
-                }
-            }
+        //~ candidates in a fixed order, the moving pairs as the broadphase
+        //~ sorted them, then every moving collider against the static grid
+        m_candidates.clear();
+        for (const PFE_BROADPHASE_PAIR& pair : m_pairs)
+        {
+            BoxCollider* a = colliders[pair.a];
+            BoxCollider* b = colliders[pair.b];
+            if (a && b) m_candidates.push_back({ a, b, kNoStatic });
         }
+        QueryStaticColliders();
+
+        fox::vector<Contact> contacts{};
+        RunNarrowphase(contacts);
 
         try
         {
-            CollisionResolver::ResolveContact(contacts, deltaTime);
+            m_solver.Solve(contacts, deltaTime);
         }
         catch (const std::exception& e)
         {
             pixel_engine::logger::error(
-                "PhysicsQueue::FrameBegin - Exception in ResolveContact: {}", e.what());
+                "PhysicsQueue::FrameBegin - Exception in Solve: {}", e.what());
         }
         catch (...)
         {
             pixel_engine::logger::error(
-                "PhysicsQueue::FrameBegin - Unknown exception in ResolveContact()");
+                "PhysicsQueue::FrameBegin - Unknown exception in Solve()");
         }
     }
     catch (const std::exception& e)
@@ -185,6 +219,12 @@ bool pixel_engine::PhysicsQueue::RemoveObject(UniqueId id)
 {
     if (!m_sprites.contains(id)) return false;
     m_sprites.erase(id);
+
+    if (const uint32_t* slot = m_staticSlots.find(id))
+    {
+        m_staticColliders[*slot].sprite = nullptr;
+        m_staticSlots.erase(id);
+    }
     PERenderQueue::Instance().RemoveSprite(id);
     return true;
 }
@@ -192,4 +232,207 @@ bool pixel_engine::PhysicsQueue::RemoveObject(UniqueId id)
 void pixel_engine::PhysicsQueue::Clear()
 {
     m_sprites.clear();
+    ClearStaticColliders();
+}
+
+_Use_decl_annotations_
+void pixel_engine::PhysicsQueue::SetStaticColliders(const fox::vector<PEISprite*>& sprites)
+{
+    ClearStaticColliders();
+
+    fox::vector<PFE_AABB2D> bounds{};
+    bounds.reserve(sprites.size());
+    m_staticColliders.reserve(sprites.size());
+
+    for (PEISprite* sprite : sprites)
+    {
+        if (!sprite) continue;
+
+        BoxCollider* collider = sprite->GetCollider();
+        if (!collider || !collider->IsStatic()) continue;
+
+        //~ only sprites the queue owns, RemoveObject drops them again
+        const UniqueId id = sprite->GetInstanceID();
+        if (!m_sprites.contains(id) || m_staticSlots.contains(id)) continue;
+
+        const FVector2D center = collider->GetWorldCenter();
+        const FVector2D half   = collider->GetHalfExtents();
+        bounds.push_back({ center.x - half.x, center.y - half.y,
+                           center.x + half.x, center.y + half.y });
+
+        m_staticSlots[id] = static_cast<uint32_t>(m_staticColliders.size());
+        m_staticColliders.push_back({ sprite, collider, false });
+    }
+
+    m_staticGrid.Build(bounds, kStaticCellSize);
+}
+
+void pixel_engine::PhysicsQueue::ClearStaticColliders()
+{
+    //~ a new level, no pair from the old one carries its impulse over
+    m_solver.Reset();
+
+    m_staticGrid.Clear();
+    m_staticColliders.clear();
+    m_staticSlots.clear();
+    m_touchedStatics.clear();
+}
+
+void pixel_engine::PhysicsQueue::QueryStaticColliders()
+{
+    if (m_staticColliders.empty()) return;
+
+    //~ per moving collider in frame order, grid hits come back ascending,
+    //~ so the candidates keep the same order every run
+    for (size_t i = 0; i < m_colliders.size(); ++i)
+    {
+        BoxCollider* a = m_colliders[i];
+        if (!a) continue;
+
+        //~ everything in the set is on the static layer
+        const TagMask ignores = m_filters[i].ignores;
+        if (ignores & PECollisionLayers::kStaticLayer) continue;
+
+        m_staticGrid.Query(m_bounds[i], m_staticHits);
+        for (uint32_t k : m_staticHits)
+        {
+            const STATIC_COLLIDER& entry = m_staticColliders[k];
+            if (!entry.sprite || !entry.sprite->IsVisible()) continue;
+            if (ignores & entry.collider->GetLayerMask()) continue;
+
+            m_candidates.push_back({ a, entry.collider, k });
+        }
+    }
+}
+
+_Use_decl_annotations_
+void pixel_engine::PhysicsQueue::RunNarrowphase(fox::vector<Contact>& contacts)
+{
+    contacts.clear();
+
+    const uint32_t count = static_cast<uint32_t>(m_candidates.size());
+    if (count == 0u) return;
+
+    //~ the tests only read the transform columns, so chunks of candidates
+    //~ run on the workers and each keeps its own contacts
+    const bool     parallel   = m_nParallelPairs != 0u && count >= m_nParallelPairs && count >= 2u * kMinChunkPairs;
+    const uint32_t chunkCount = parallel ? std::min(kMaxChunks, count / kMinChunkPairs) : 1u;
+    for (uint32_t i = 0; i < chunkCount; ++i)
+    {
+        NARROWPHASE_CHUNK& chunk = m_chunks[i];
+        chunk.pairs = m_candidates.data();
+        chunk.begin = static_cast<uint32_t>(static_cast<uint64_t>(count) *  i       / chunkCount);
+        chunk.end   = static_cast<uint32_t>(static_cast<uint64_t>(count) * (i + 1u) / chunkCount);
+    }
+
+    if (chunkCount == 1u)
+    {
+        RunChunk(&m_chunks[0]);
+    }
+    else
+    {
+        PFE_JOB jobs[kMaxChunks]{};
+        for (uint32_t i = 0; i < chunkCount; ++i)
+        {
+            jobs[i] = PFE_JOB{ &PhysicsQueue::RunChunk, &m_chunks[i] };
+        }
+        PEJobSystem::Instance().Run(jobs, chunkCount);
+    }
+
+    //~ chunks are runs of the candidates, joined in chunk order the contacts
+    //~ come out in candidate order whatever the worker count; callbacks run
+    //~ here on the calling thread in that same order
+    size_t total = 0u;
+    for (uint32_t i = 0; i < chunkCount; ++i) total += m_chunks[i].contacts.size();
+    contacts.reserve(total);
+
+    for (uint32_t i = 0; i < chunkCount; ++i)
+    {
+        const NARROWPHASE_CHUNK& chunk = m_chunks[i];
+        for (size_t h = 0; h < chunk.contacts.size(); ++h)
+        {
+            const Contact&          contact = chunk.contacts[h];
+            const NARROWPHASE_PAIR& pair    = m_candidates[chunk.hits[h]];
+
+            try
+            {
+                pair.a->RegisterCollision(pair.b, contact);
+                pair.b->RegisterCollision(pair.a, contact);
+                contacts.push_back(contact);
+            }
+            catch (const std::exception& e)
+            {
+                pixel_engine::logger::error(
+                    "PhysicsQueue::RunNarrowphase - Exception in RegisterCollision(A={}, B={}): {}",
+                    static_cast<const void*>(pair.a),
+                    static_cast<const void*>(pair.b),
+                    e.what());
+                continue;
+            }
+            catch (...)
+            {
+                pixel_engine::logger::error(
+                    "PhysicsQueue::RunNarrowphase - Unknown exception in RegisterCollision(A={}, B={})",
+                    static_cast<const void*>(pair.a),
+                    static_cast<const void*>(pair.b));
+                continue;
+            }
+
+            if (pair.staticSlot == kNoStatic) continue;
+
+            STATIC_COLLIDER& entry = m_staticColliders[pair.staticSlot];
+            if (!entry.touched)
+            {
+                entry.touched = true;
+                m_touchedStatics.push_back(pair.staticSlot);
+            }
+        }
+    }
+}
+
+_Use_decl_annotations_
+void pixel_engine::PhysicsQueue::RunChunk(void* context)
+{
+    auto* chunk = static_cast<NARROWPHASE_CHUNK*>(context);
+    chunk->contacts.clear();
+    chunk->hits    .clear();
+
+    for (uint32_t i = chunk->begin; i < chunk->end; ++i)
+    {
+        const NARROWPHASE_PAIR& pair = chunk->pairs[i];
+
+        Contact contact{};
+        contact.A = pair.a;
+        contact.B = pair.b;
+
+        if (pair.a->TestCollision(pair.b, contact))
+        {
+            chunk->contacts.push_back(contact);
+            chunk->hits    .push_back(i);
+        }
+    }
+}
+
+void pixel_engine::PhysicsQueue::UpdateTouchedStatics(float deltaTime)
+{
+    //~ only statics something touched run Update, the rest have no exit
+    //~ callbacks to fire, they drop out once everything has left
+    size_t kept = 0u;
+    for (size_t i = 0; i < m_touchedStatics.size(); ++i)
+    {
+        const uint32_t k = m_touchedStatics[i];
+        STATIC_COLLIDER& entry = m_staticColliders[k];
+
+        if (entry.sprite && entry.sprite->IsVisible())
+        {
+            entry.collider->Update(deltaTime);
+        }
+
+        if (entry.sprite && entry.collider->HasTrackedHits())
+        {
+            m_touchedStatics[kept++] = k;
+        }
+        else entry.touched = false;
+    }
+    while (m_touchedStatics.size() > kept) m_touchedStatics.pop_back();
 }
@@ -4,7 +4,11 @@
 
 #include "pixel_engine/core/interface/interface_singleton.h"
 #include "pixel_engine/core/interface/interface_sprite.h"
+#include "pixel_engine/core/spatial/cull_grid.h"
 #include "pixel_engine/render_manager/components/camera/camera.h"
+#include "pixel_engine/physics_manager/physics_api/broadphase/broadphase.h"
+#include "pixel_engine/physics_manager/physics_api/collider/contact.h"
+#include "pixel_engine/physics_manager/physics_api/resolver/contact_solver.h"
 
 #include "core/unordered_map.h"
 
@@ -28,8 +32,89 @@ namespace pixel_engine
 		bool RemoveObject(UniqueId id);
 		void Clear();
 
+		//~ picks the pairs the narrowphase tests, see EBroadphase
+		_NODISCARD _Check_return_
+		PEBroadphase& GetBroadphase() noexcept { return m_broadphase; }
+
+		//~ resolves the contacts the narrowphase found, see EContactSolver
+		_NODISCARD _Check_return_
+		PEContactSolver& GetContactSolver() noexcept { return m_solver; }
+
+		//~ static colliders that never move, registered once per level. They
+		//~ leave the per frame pairs and every moving collider queries their
+		//~ grid instead, hidden ones are skipped until the next call
+		void SetStaticColliders(_In_ const fox::vector<PEISprite*>& sprites);
+		void ClearStaticColliders();
+
+		_NODISCARD _Check_return_
+		size_t GetStaticColliderCount() const noexcept { return m_staticColliders.size(); }
+
+		//~ frames with at least this many candidate pairs split the narrowphase
+		//~ across the physics workers, zero keeps it on the calling thread
+		void SetParallelPairs(_In_ uint32_t pairs) noexcept { m_nParallelPairs = pairs; }
+
+		_NODISCARD _Check_return_
+		uint32_t GetParallelPairs() const noexcept { return m_nParallelPairs; }
+
+	private:
+		static constexpr uint32_t kNoStatic	 = ~0u;
+		static constexpr uint32_t kMaxChunks = 16u;
+
+		//~ one pair for the narrowphase, staticSlot indexes m_staticColliders
+		typedef struct _NARROWPHASE_PAIR
+		{
+			BoxCollider* a			{ nullptr };
+			BoxCollider* b			{ nullptr };
+			uint32_t	 staticSlot { kNoStatic };
+		} NARROWPHASE_PAIR;
+
+		//~ a run of m_candidates tested on one worker, hits[k] is the
+		//~ candidate contacts[k] came from
+		typedef struct _NARROWPHASE_CHUNK
+		{
+			const NARROWPHASE_PAIR* pairs{ nullptr };
+			uint32_t				begin{ 0u };
+			uint32_t				end	 { 0u };
+			fox::vector<Contact>	contacts{};
+			fox::vector<uint32_t>	hits	{};
+		} NARROWPHASE_CHUNK;
+
+		void QueryStaticColliders();
+		void RunNarrowphase(_Out_ fox::vector<Contact>& contacts);
+		void UpdateTouchedStatics(float deltaTime);
+
+		static void RunChunk(_Inout_ void* context);
+
 	private:
 		Camera2D* m_pCamera{ nullptr };
 		fox::unordered_map<UniqueId, PEISprite*> m_sprites{};
+
+		//~ per frame, kept so a steady scene does not allocate
+		PEBroadphase					   m_broadphase{};
+		fox::vector<BoxCollider*>		   m_colliders {};
+		fox::vector<PFE_AABB2D>			   m_bounds	   {};
+		fox::vector<PFE_BROADPHASE_FILTER> m_filters   {};
+		fox::vector<PFE_BROADPHASE_PAIR>   m_pairs	   {};
+		fox::vector<NARROWPHASE_PAIR>	   m_candidates{}; // moving pairs, then the static grid
+		PEContactSolver					   m_solver	   {};
+
+		//~ chunks run on the engine job system, the raster workers belong
+		//~ to the render thread
+		uint32_t		  m_nParallelPairs{ 4096u };
+		NARROWPHASE_CHUNK m_chunks[kMaxChunks]{};
+
+		typedef struct _STATIC_COLLIDER
+		{
+			PEISprite*	 sprite  { nullptr }; // null once removed from the queue
+			BoxCollider* collider{ nullptr };
+			bool		 touched { false };	  // listed in m_touchedStatics
+		} STATIC_COLLIDER;
+
+		//~ rebuilt only by SetStaticColliders, grid item i is m_staticColliders[i]
+		PECullGrid							m_staticGrid	  {};
+		fox::vector<STATIC_COLLIDER>		m_staticColliders {};
+		fox::unordered_map<UniqueId, uint32_t> m_staticSlots {};
+		fox::vector<uint32_t>				m_staticHits	  {};
+		fox::vector<uint32_t>				m_touchedStatics  {}; // still owe exit callbacks
 	};
 } // namespace pixel_engine
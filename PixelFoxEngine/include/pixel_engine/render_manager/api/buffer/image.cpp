@@ -14,10 +14,27 @@
 
 #include "pixel_engine/utilities/logger/logger.h"
 
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	//~ little endian word with R in the lowest byte and an opaque alpha
+	inline uint32_t PackRGBA(const pixel_engine::PFE_FORMAT_R8G8B8_UINT& c) noexcept
+	{
+		return  static_cast<uint32_t>(c.R.Value)		|
+			   (static_cast<uint32_t>(c.G.Value) << 8)  |
+			   (static_cast<uint32_t>(c.B.Value) << 16) |
+			   0xFF000000u;
+	}
+} // namespace
+
 _Use_decl_annotations_
 pixel_engine::PEImageBuffer::PEImageBuffer(const PE_IMAGE_BUFFER_DESC& desc)
 {
-	m_rowPitch  = (desc.Width * 3u + 3u) & ~3u;
+	m_format	= desc.Format;
+	m_pixelSize = PixelFormatSize(desc.Format);
+	m_rowPitch  = (desc.Width * m_pixelSize + 3u) & ~size_t{ 3u };
 	m_imageSize = m_rowPitch * desc.Height;
 	m_height	= desc.Height;
 	m_width		= desc.Width;
@@ -153,6 +170,13 @@ bool pixel_engine::PEImageBuffer::WriteAt(size_t atRow, size_t atColumn, const P
 
     if (auto address = PixelAt(atRow, atColumn))
     {
+        if (m_format == EPixelFormat::R8G8B8A8)
+        {
+            const uint32_t packed = PackRGBA(rgb);
+            std::memcpy(address, &packed, sizeof(packed));
+            return true;
+        }
+
         address[0] = rgb.R.Value;
         address[1] = rgb.G.Value;
         address[2] = rgb.B.Value;
@@ -168,19 +192,63 @@ void pixel_engine::PEImageBuffer::ClearImageBuffer(const PFE_FORMAT_R8G8B8_UINT&
 {
     if (m_imageData.empty()) return;
 
-    for (size_t row = 0; row < m_height; ++row)
+    //~ fill the first row once and copy it to the others, the 32 bit
+    //~ target fills it with whole words
+    unsigned char* firstRow = m_imageData.data();
+    if (m_format == EPixelFormat::R8G8B8A8)
+    {
+        std::fill_n(reinterpret_cast<uint32_t*>(firstRow), m_width, PackRGBA(color));
+    }
+    else
     {
-        unsigned char* rowPtr = m_imageData.data() + row * m_rowPitch;
         for (size_t col = 0; col < m_width; ++col)
         {
-            if (unsigned char* px = rowPtr + col * 3u)
-            {
-                px[0] = color.R.Value;
-                px[1] = color.G.Value;
-                px[2] = color.B.Value;
-            }
+            unsigned char* px = firstRow + col * 3u;
+            px[0] = color.R.Value;
+            px[1] = color.G.Value;
+            px[2] = color.B.Value;
         }
     }
+
+    for (size_t row = 1; row < m_height; ++row)
+    {
+        std::memcpy(m_imageData.data() + row * m_rowPitch, firstRow, m_rowPitch);
+    }
+}
+
+_Use_decl_annotations_
+void pixel_engine::PEImageBuffer::ClearImageRect(
+    size_t minX, size_t minY,
+    size_t maxX, size_t maxY,
+    const PFE_FORMAT_R8G8B8_UINT& color)
+{
+    maxX = std::min<size_t>(maxX, m_width);
+    maxY = std::min<size_t>(maxY, m_height);
+    if (m_imageData.empty() || minX >= maxX || minY >= maxY) return;
+
+    //~ same as the full clear, fill one row segment and copy it down
+    unsigned char* first = m_imageData.data() + minY * m_rowPitch + minX * m_pixelSize;
+    const size_t   count = maxX - minX;
+    if (m_format == EPixelFormat::R8G8B8A8)
+    {
+        std::fill_n(reinterpret_cast<uint32_t*>(first), count, PackRGBA(color));
+    }
+    else
+    {
+        for (size_t col = 0; col < count; ++col)
+        {
+            unsigned char* px = first + col * 3u;
+            px[0] = color.R.Value;
+            px[1] = color.G.Value;
+            px[2] = color.B.Value;
+        }
+    }
+
+    const size_t bytes = count * m_pixelSize;
+    for (size_t row = minY + 1; row < maxY; ++row)
+    {
+        std::memcpy(m_imageData.data() + row * m_rowPitch + minX * m_pixelSize, first, bytes);
+    }
 }
 
 _Use_decl_annotations_
@@ -195,7 +263,7 @@ unsigned char* pixel_engine::PEImageBuffer::PixelAt(size_t atRow, size_t atColum
 	if (not IsInside(atRow, atColumn)) return nullptr;
 
 	unsigned char* selectedRow = m_imageData.data() + m_rowPitch * atRow;
-	unsigned char* address = selectedRow + atColumn * 3u;
+	unsigned char* address = selectedRow + atColumn * m_pixelSize;
 
 	return address;
 }
@@ -81,11 +81,19 @@ namespace pixel_engine
 		_Success_(return != false)
 		void ClearImageBuffer(_In_ const PFE_FORMAT_R8G8B8_UINT& color);
 
+		//~ Clear [minX, maxX) x [minY, maxY) to a color, clamped to the buffer
+		void ClearImageRect(
+			_In_ size_t minX,
+			_In_ size_t minY,
+			_In_ size_t maxX,
+			_In_ size_t maxY,
+			_In_ const PFE_FORMAT_R8G8B8_UINT& color);
+
 		//~ Check if pixel coordinate is inside the buffer
 		_NODISCARD _Success_(return != false)
 		bool IsInside(_In_ size_t atRow, _In_ size_t atColumn) const noexcept;
 
-		//~ Get pointer to pixel at (row, col)
+		//~ Get pointer to pixel at (row, col), R G B (A) byte order
 		_Ret_maybenull_ _Post_writable_byte_size_(3)
 		unsigned char* PixelAt(_In_ size_t atRow, _In_ size_t atColumn) noexcept;
 
@@ -99,6 +107,10 @@ namespace pixel_engine
 		_NODISCARD _Check_return_ 
 		__forceinline size_t RowPitch () const noexcept { return m_rowPitch;		  }
 		_NODISCARD _Check_return_
+		__forceinline size_t PixelSize() const noexcept { return m_pixelSize;		  }
+		_NODISCARD _Check_return_
+		__forceinline EPixelFormat Format() const noexcept { return m_format;		  }
+		_NODISCARD _Check_return_
 		__forceinline UINT   Width    () const noexcept { return m_width;			  }
 		_NODISCARD _Check_return_
 		__forceinline UINT   Height   () const noexcept { return m_height;			  }
@@ -111,6 +123,8 @@ namespace pixel_engine
 		UINT                       m_height;
 		UINT                       m_width;
 		size_t                     m_rowPitch;
+		size_t                     m_pixelSize;
+		EPixelFormat               m_format;
 		size_t                     m_imageSize;
 		fox::vector<unsigned char> m_imageData;
 	};
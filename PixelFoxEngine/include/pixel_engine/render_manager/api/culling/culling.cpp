@@ -70,6 +70,31 @@ pixel_engine::PFE_AABB2D pixel_engine::PECulling2D::ComputeQuadAABB(const PFE_SA
     return out;
 }
 
+_Use_decl_annotations_
+void pixel_engine::PECulling2D::BuildStaticIndex(const fox::vector<PFE_AABB2D>& bounds, float cellSize)
+{
+    m_staticGrid.Build(bounds, cellSize);
+}
+
+void pixel_engine::PECulling2D::ClearStaticIndex() noexcept
+{
+    m_staticGrid.Clear();
+}
+
+_Use_decl_annotations_
+void pixel_engine::PECulling2D::QueryStatic(const FVector2D& scroll, fox::vector<uint32_t>& out)
+{
+    //~ the viewport moved back into layer space, same edges ShouldCullQuad uses
+    const PFE_AABB2D view
+    {
+        -scroll.x,
+        -scroll.y,
+        static_cast<float>(m_viewport.w) - scroll.x,
+        static_cast<float>(m_viewport.h) - scroll.y
+    };
+    m_staticGrid.Query(view, out);
+}
+
 _Use_decl_annotations_
 void pixel_engine::PECulling2D::SetViewport(const pixel_engine::PFE_VIEWPORT& viewport) noexcept
 {
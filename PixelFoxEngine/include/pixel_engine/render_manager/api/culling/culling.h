@@ -14,6 +14,7 @@
 #include "PixelFoxEngineAPI.h"
 
 #include "pixel_engine/core/types.h"
+#include "pixel_engine/core/spatial/cull_grid.h"
 #include <algorithm>
 
 #include "fox_math/matrix.h"
@@ -49,7 +50,21 @@ namespace pixel_engine
         _NODISCARD _Check_return_
         PFE_AABB2D ComputeQuadAABB(_In_ const PFE_SAMPLE_GRID_2D& grid) const noexcept;
 
+        //~ static layer, bounds in layer space (screen space when built),
+        //~ rebuilt only when the static set changes
+        void BuildStaticIndex(
+            _In_ const fox::vector<PFE_AABB2D>& bounds,
+            _In_ float                          cellSize);
+
+        void ClearStaticIndex() noexcept;
+
+        //~ static items that may be on screen, screen = layer + scroll
+        void QueryStatic(
+            _In_  const FVector2D&       scroll,
+            _Out_ fox::vector<uint32_t>& out);
+
     private:
         PFE_VIEWPORT m_viewport{ 0, 0, 1280, 720 }; // just a default
+        PECullGrid   m_staticGrid{};
     };
 } // namespace pixel_engine
@@ -0,0 +1,207 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "frame_graph.h"
+
+#include "pixel_engine/utilities/logger/logger.h"
+
+#include <chrono>
+
+using namespace pixel_engine;
+
+namespace
+{
+    using stage_clock = std::chrono::steady_clock;
+}
+
+_Use_decl_annotations_
+FrameStageId PEFrameGraph::AddStage(const PFE_FRAME_STAGE_DESC& desc)
+{
+    const auto id = static_cast<FrameStageId>(m_stages.size());
+
+    auto stage   = std::make_unique<Stage>();
+    stage->desc  = desc;
+    stage->graph = this;
+    stage->id    = id;
+
+    //~ only earlier stages, anything else would be a cycle or a typo
+    stage->desc.DependsOn.clear();
+    for (const FrameStageId dep : desc.DependsOn)
+    {
+        if (dep >= id)
+        {
+            logger::error(
+                pixel_engine::logger_config::LogCategory::Render,
+                "[FrameGraph] stage '{}' depends on stage {} which is not added yet, ignored",
+                desc.Name, dep);
+            continue;
+        }
+        stage->desc.DependsOn.push_back(dep);
+        m_stages[dep]->dependents.push_back(id);
+    }
+
+    m_stages.push_back(std::move(stage));
+    return id;
+}
+
+_Use_decl_annotations_
+void PEFrameGraph::Execute(IRasterScheduler* scheduler)
+{
+    const auto begin = stage_clock::now();
+    const auto count = static_cast<uint32_t>(m_stages.size());
+
+    for (auto& stage : m_stages)
+    {
+        stage->pending.store(static_cast<uint32_t>(stage->desc.DependsOn.size()), std::memory_order_relaxed);
+        stage->started = false;
+    }
+    m_nFinished.store(0u, std::memory_order_relaxed);
+
+    if (!scheduler)
+    {
+        //~ added order is already a valid order
+        for (auto& stage : m_stages) RunStage(*stage);
+    }
+    else
+    {
+        m_ready.clear();
+        for (auto& stage : m_stages)
+        {
+            if (stage->desc.Lane == EFrameStageLane::Worker && stage->desc.DependsOn.empty())
+                m_ready.push_back(stage->id);
+        }
+        SubmitWorkerStages(scheduler, m_ready);
+
+        while (m_nFinished.load(std::memory_order_acquire) < count)
+        {
+            //~ stages are in dependency order, so a chain of render thread
+            //~ stages runs in a single pass
+            bool ran = false;
+            for (auto& stage : m_stages)
+            {
+                if (stage->desc.Lane != EFrameStageLane::RenderThread || stage->started) continue;
+                if (stage->pending.load(std::memory_order_acquire) != 0u)				  continue;
+
+                stage->started = true;
+                RunStage   (*stage);
+                FinishStage(*stage, m_ready);
+                ran = true;
+            }
+            SubmitWorkerStages(scheduler, m_ready);
+
+            //~ only worker stages left in the way, help them finish
+            if (!ran) scheduler->Wait();
+        }
+        scheduler->Wait();
+    }
+
+    m_nLastFrameMs = std::chrono::duration<double, std::milli>(stage_clock::now() - begin).count();
+}
+
+void PEFrameGraph::Clear()
+{
+    m_stages.clear();
+    m_ready .clear();
+    m_nLastFrameMs = 0.0;
+}
+
+fox::vector<PFE_FRAME_STAGE_TIMING> PEFrameGraph::GetTimings() const
+{
+    fox::vector<PFE_FRAME_STAGE_TIMING> timings{};
+    timings.reserve(m_stages.size());
+    for (const auto& stage : m_stages)
+    {
+        PFE_FRAME_STAGE_TIMING timing{};
+        timing.Name      = stage->desc.Name;
+        timing.Lane      = stage->desc.Lane;
+        timing.LastMs    = stage->lastMs;
+        timing.AverageMs = stage->runs ? stage->totalMs / static_cast<double>(stage->runs) : 0.0;
+        timings.push_back(timing);
+    }
+    return timings;
+}
+
+void PEFrameGraph::ResetTimings() noexcept
+{
+    for (auto& stage : m_stages)
+    {
+        stage->totalMs = 0.0;
+        stage->runs    = 0u;
+    }
+}
+
+_Use_decl_annotations_
+void PEFrameGraph::RunWorkerStage(void* context)
+{
+    auto* stage = static_cast<Stage*>(context);
+    PEFrameGraph* graph = stage->graph;
+
+    //~ unlocked worker stages run here instead of going back to the
+    //~ scheduler, only the render thread submits
+    fox::vector<FrameStageId> ready{};
+    for (;;)
+    {
+        graph->RunStage   (*stage);
+        graph->FinishStage(*stage, ready);
+
+        if (ready.empty()) return;
+
+        stage = graph->m_stages[ready.back()].get();
+        ready.pop_back();
+    }
+}
+
+_Use_decl_annotations_
+void PEFrameGraph::RunStage(Stage& stage)
+{
+    const auto begin = stage_clock::now();
+    if (stage.desc.Execute) stage.desc.Execute();
+    const auto end = stage_clock::now();
+
+    stage.lastMs   = std::chrono::duration<double, std::milli>(end - begin).count();
+    stage.totalMs += stage.lastMs;
+    ++stage.runs;
+}
+
+_Use_decl_annotations_
+void PEFrameGraph::FinishStage(Stage& stage, fox::vector<FrameStageId>& ready)
+{
+    for (const FrameStageId id : stage.dependents)
+    {
+        Stage& next = *m_stages[id];
+        if (next.pending.fetch_sub(1u, std::memory_order_acq_rel) != 1u) continue;
+
+        if (next.desc.Lane == EFrameStageLane::Worker)
+        {
+            next.started = true;
+            ready.push_back(id);
+        }
+    }
+    m_nFinished.fetch_add(1u, std::memory_order_release);
+}
+
+_Use_decl_annotations_
+void PEFrameGraph::SubmitWorkerStages(IRasterScheduler* scheduler, fox::vector<FrameStageId>& ready)
+{
+    if (ready.empty()) return;
+
+    for (const FrameStageId id : ready)
+    {
+        Stage& stage  = *m_stages[id];
+        stage.started = true;
+
+        scheduler->Enqueue(PFE_JOB{ &PEFrameGraph::RunWorkerStage, &stage });
+    }
+    ready.clear();
+
+    scheduler->Submit();
+}
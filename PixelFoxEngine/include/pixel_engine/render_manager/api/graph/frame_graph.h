@@ -0,0 +1,128 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/render_manager/api/raster/task/raster_scheduler.h"
+
+#include "core/vector.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace pixel_engine
+{
+	using FrameStageId = uint32_t;
+
+	enum class EFrameStageLane : uint8_t
+	{
+		RenderThread, // owns the raster and the device context
+		Worker		  // raster worker pool, must not touch the raster
+	};
+
+	typedef struct _PFE_FRAME_STAGE_DESC
+	{
+		_In_ const char*				Name	 { "" };
+		_In_ EFrameStageLane			Lane	 { EFrameStageLane::RenderThread };
+		_In_ std::function<void()>		Execute	 {};
+		_In_ fox::vector<FrameStageId>	DependsOn{};
+	} PFE_FRAME_STAGE_DESC;
+
+	typedef struct _PFE_FRAME_STAGE_TIMING
+	{
+		const char*		Name	 { "" };
+		EFrameStageLane Lane	 { EFrameStageLane::RenderThread };
+		double			LastMs	 { 0.0 };
+		double			AverageMs{ 0.0 }; // since the last ResetTimings
+	} PFE_FRAME_STAGE_TIMING;
+
+	/// <summary>
+	/// The frame as a small graph of dependent stages. Worker stages go to
+	/// the raster scheduler as jobs and a worker stage that
+	/// unlocks another one runs it right away on the same thread, render
+	/// thread stages run on the caller while the workers are busy. Stages
+	/// are added once, Execute runs the whole graph once per frame.
+	/// </summary>
+	class PFE_API PEFrameGraph
+	{
+	public:
+		PEFrameGraph() = default;
+		~PEFrameGraph() = default;
+
+		PEFrameGraph(_In_ const PEFrameGraph&) = delete;
+		PEFrameGraph(_Inout_ PEFrameGraph&&)   = delete;
+
+		PEFrameGraph& operator=(_In_ const PEFrameGraph&) = delete;
+		PEFrameGraph& operator=(_Inout_ PEFrameGraph&&)   = delete;
+
+		//~ dependencies must be stages added before this one, so the graph
+		//~ can never hold a cycle
+		_NODISCARD _Check_return_
+		FrameStageId AddStage(_In_ const PFE_FRAME_STAGE_DESC& desc);
+
+		//~ nullptr runs every stage on the caller in the order added
+		void Execute(_Inout_ IRasterScheduler* scheduler);
+
+		void Clear();
+
+		_NODISCARD _Check_return_
+		fox::vector<PFE_FRAME_STAGE_TIMING> GetTimings() const;
+
+		void ResetTimings() noexcept;
+
+		_NODISCARD _Check_return_
+		double GetLastFrameMs() const noexcept { return m_nLastFrameMs; }
+
+		_NODISCARD _Check_return_
+		size_t GetStageCount() const noexcept { return m_stages.size(); }
+
+	private:
+		struct Stage
+		{
+			PFE_FRAME_STAGE_DESC	  desc	   {};
+			fox::vector<FrameStageId> dependents{};
+
+			PEFrameGraph* graph{ nullptr };
+			FrameStageId  id   { 0u };
+
+			std::atomic<uint32_t> pending{ 0u }; // unfinished dependencies this frame
+			bool				  started{ false };
+
+			double lastMs { 0.0 };
+			double totalMs{ 0.0 };
+			uint64_t runs { 0u };
+		};
+
+		//~ callback task entry, runs the stage and every worker stage it unlocks
+		static void RunWorkerStage(_Inout_ void* context);
+
+		void RunStage(_Inout_ Stage& stage);
+
+		//~ counts down the dependents, worker ones that become ready are
+		//~ appended to ready
+		void FinishStage(
+			_In_	Stage&					   stage,
+			_Inout_ fox::vector<FrameStageId>& ready);
+
+		void SubmitWorkerStages(
+			_Inout_ IRasterScheduler*			 scheduler,
+			_Inout_ fox::vector<FrameStageId>& ready);
+
+	private:
+		fox::vector<std::unique_ptr<Stage>> m_stages{};
+		fox::vector<FrameStageId>			m_ready {};
+		std::atomic<uint32_t>				m_nFinished{ 0u };
+		double								m_nLastFrameMs{ 0.0 };
+	};
+} // namespace pixel_engine
@@ -0,0 +1,53 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "d3d11_present.h"
+
+using namespace pixel_engine;
+
+_Use_decl_annotations_
+PED3D11PresentTarget::PED3D11PresentTarget(ID3D11DeviceContext* context, ID3D11Buffer* cpuBuffer) noexcept
+    : m_pContext(context), m_pCpuBuffer(cpuBuffer)
+{
+}
+
+_Use_decl_annotations_
+void PED3D11PresentTarget::Present(const PEImageBuffer& image, int minY, int maxY)
+{
+    if (!m_pContext || !m_pCpuBuffer) return;
+
+    const int height = static_cast<int>(image.Height());
+    if (minY == 0 && maxY == height)
+    {
+        m_pContext->UpdateSubresource(
+            m_pCpuBuffer, 0, nullptr,
+            image.Data(),
+            (UINT)image.RowPitch(), 0);
+        return;
+    }
+
+    //~ rows are contiguous in the raw buffer so the band is one byte range
+    const size_t pitch = image.RowPitch();
+
+    D3D11_BOX box{};
+    box.left   = static_cast<UINT>(pitch * static_cast<size_t>(minY));
+    box.right  = static_cast<UINT>(pitch * static_cast<size_t>(maxY));
+    box.top    = 0u;
+    box.bottom = 1u;
+    box.front  = 0u;
+    box.back   = 1u;
+
+    m_pContext->UpdateSubresource(
+        m_pCpuBuffer, 0, &box,
+        image.Data() + pitch * static_cast<size_t>(minY),
+        (UINT)pitch, 0);
+}
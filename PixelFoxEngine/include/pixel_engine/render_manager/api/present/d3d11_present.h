@@ -0,0 +1,40 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "present_target.h"
+
+#include <d3d11.h>
+
+namespace pixel_engine
+{
+	//~ uploads the rows into the raw buffer the fullscreen pixel shader
+	//~ reads, the render api owns the context and the buffer
+	class PFE_API PED3D11PresentTarget final : public IPresentTarget
+	{
+	public:
+		PED3D11PresentTarget(
+			_In_ ID3D11DeviceContext* context,
+			_In_ ID3D11Buffer*		  cpuBuffer) noexcept;
+
+		void Present(
+			_In_ const PEImageBuffer& image,
+			_In_ int				  minY,
+			_In_ int				  maxY) override;
+
+	private:
+		ID3D11DeviceContext* m_pContext  { nullptr };
+		ID3D11Buffer*		 m_pCpuBuffer{ nullptr };
+	};
+} // namespace pixel_engine
@@ -0,0 +1,220 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "headless_present.h"
+
+#include "pixel_engine/utilities/logger/logger.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+using namespace pixel_engine;
+
+namespace
+{
+    constexpr int kPpmMaxValue = 255;
+
+    //~ skips whitespace and # comments between the ppm header fields
+    _Check_return_
+    bool ReadPpmField(_Inout_ std::ifstream& file, _Out_ int& value)
+    {
+        value = 0;
+        int c = file.get();
+        while (file)
+        {
+            if (c == '#')
+            {
+                while (file && c != '\n') c = file.get();
+            }
+            else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            {
+                c = file.get();
+            }
+            else break;
+        }
+
+        if (!file || c < '0' || c > '9') return false;
+        while (file && c >= '0' && c <= '9')
+        {
+            value = value * 10 + (c - '0');
+            if (value > 1 << 20) return false;
+            c = file.get();
+        }
+        //~ exactly one whitespace ends the field, already consumed by get
+        return true;
+    }
+} // namespace
+
+_Use_decl_annotations_
+void PEHeadlessPresentTarget::Present(const PEImageBuffer& image, int minY, int maxY)
+{
+    if (image.Empty()) return;
+
+    const UINT width  = image.Width ();
+    const UINT height = image.Height();
+
+    //~ a new size is a new buffer on the gpu too, nothing carries over
+    if (m_frame.Width != width || m_frame.Height != height)
+    {
+        m_frame.Width  = width;
+        m_frame.Height = height;
+        m_frame.Pixels.assign(static_cast<size_t>(width) * height * 3u, 0u);
+    }
+
+    minY = std::max(minY, 0);
+    maxY = std::min(maxY, static_cast<int>(height));
+    ++m_nPresents;
+    if (minY >= maxY) return;
+
+    const size_t pitch     = image.RowPitch ();
+    const size_t pixelSize = image.PixelSize();
+    const size_t outPitch  = static_cast<size_t>(width) * 3u;
+
+    //~ keeps the first three channels, alpha never reaches the screen
+    for (int y = minY; y < maxY; ++y)
+    {
+        const unsigned char* src = image.Data() + pitch * static_cast<size_t>(y);
+        uint8_t*             dst = m_frame.Pixels.data() + outPitch * static_cast<size_t>(y);
+
+        if (pixelSize == 3u)
+        {
+            std::copy(src, src + outPitch, dst);
+            continue;
+        }
+
+        for (UINT x = 0; x < width; ++x, src += pixelSize, dst += 3)
+        {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        }
+    }
+
+    m_nPresentedRows += static_cast<uint64_t>(maxY - minY);
+}
+
+void PEHeadlessPresentTarget::Reset() noexcept
+{
+    m_frame.Width  = 0u;
+    m_frame.Height = 0u;
+    m_frame.Pixels.clear();
+    m_nPresents      = 0u;
+    m_nPresentedRows = 0u;
+}
+
+uint64_t PEHeadlessPresentTarget::Hash() const noexcept
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+
+    mix(m_frame.Width);
+    mix(m_frame.Height);
+    for (const uint8_t value : m_frame.Pixels) mix(value);
+    return hash;
+}
+
+_Use_decl_annotations_
+bool PEHeadlessPresentTarget::WritePPM(const std::string& path) const
+{
+    if (m_frame.Pixels.empty())
+    {
+        logger::error("Headless present: nothing presented to write to {}", path);
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        logger::error("Headless present: failed to open {} for writing", path);
+        return false;
+    }
+
+    file << "P6\n" << m_frame.Width << ' ' << m_frame.Height << '\n' << kPpmMaxValue << '\n';
+    file.write(reinterpret_cast<const char*>(m_frame.Pixels.data()),
+               static_cast<std::streamsize>(m_frame.Pixels.size()));
+
+    return static_cast<bool>(file);
+}
+
+_Use_decl_annotations_
+bool PEHeadlessPresentTarget::ReadPPM(const std::string& path, PFE_HEADLESS_IMAGE& image)
+{
+    image.Width  = 0u;
+    image.Height = 0u;
+    image.Pixels.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    if (file.get() != 'P' || file.get() != '6')
+    {
+        logger::error("Headless present: {} is not a binary ppm", path);
+        return false;
+    }
+
+    int width = 0, height = 0, maxValue = 0;
+    if (!ReadPpmField(file, width)  ||
+        !ReadPpmField(file, height) ||
+        !ReadPpmField(file, maxValue) ||
+        maxValue != kPpmMaxValue || width <= 0 || height <= 0)
+    {
+        logger::error("Headless present: {} has an unsupported ppm header", path);
+        return false;
+    }
+
+    const size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 3u;
+    image.Pixels.assign(bytes, 0u);
+    file.read(reinterpret_cast<char*>(image.Pixels.data()), static_cast<std::streamsize>(bytes));
+    if (static_cast<size_t>(file.gcount()) != bytes)
+    {
+        logger::error("Headless present: {} is truncated", path);
+        image.Pixels.clear();
+        return false;
+    }
+
+    image.Width  = static_cast<UINT>(width);
+    image.Height = static_cast<UINT>(height);
+    return true;
+}
+
+_Use_decl_annotations_
+size_t PEHeadlessPresentTarget::CountMismatched(
+    const PFE_HEADLESS_IMAGE& a,
+    const PFE_HEADLESS_IMAGE& b,
+    uint8_t                   tolerance) noexcept
+{
+    const size_t pixelsA = static_cast<size_t>(a.Width) * a.Height;
+    if (a.Width != b.Width || a.Height != b.Height ||
+        a.Pixels.size() != b.Pixels.size() || a.Pixels.size() != pixelsA * 3u)
+    {
+        return std::max(pixelsA, static_cast<size_t>(b.Width) * b.Height);
+    }
+
+    size_t mismatched = 0u;
+    for (size_t i = 0; i < a.Pixels.size(); i += 3u)
+    {
+        for (size_t c = 0; c < 3u; ++c)
+        {
+            if (std::abs(int(a.Pixels[i + c]) - int(b.Pixels[i + c])) > tolerance)
+            {
+                ++mismatched;
+                break;
+            }
+        }
+    }
+    return mismatched;
+}
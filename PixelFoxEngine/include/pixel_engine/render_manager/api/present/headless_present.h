@@ -0,0 +1,88 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "present_target.h"
+
+#include "core/vector.h"
+
+#include <cstdint>
+#include <string>
+
+namespace pixel_engine
+{
+	//~ 8 bit rgb, rows packed without padding, the same as a binary ppm
+	typedef struct _PFE_HEADLESS_IMAGE
+	{
+		UINT				 Width { 0u };
+		UINT				 Height{ 0u };
+		fox::vector<uint8_t> Pixels{};
+	} PFE_HEADLESS_IMAGE;
+
+	/// <summary>
+	/// Present target without a device. Keeps the presented frame in memory
+	/// and applies every band the way the gpu buffer would, so a row the
+	/// damage tracking forgot to upload stays stale here too. Used to run
+	/// the raster on a machine without a gpu and to compare frames against
+	/// golden images.
+	/// </summary>
+	class PFE_API PEHeadlessPresentTarget final : public IPresentTarget
+	{
+	public:
+		PEHeadlessPresentTarget() = default;
+
+		void Present(
+			_In_ const PEImageBuffer& image,
+			_In_ int				  minY,
+			_In_ int				  maxY) override;
+
+		//~ forgets the kept frame, the next present starts from black
+		void Reset() noexcept;
+
+		_NODISCARD _Check_return_
+		const PFE_HEADLESS_IMAGE& GetFrame() const noexcept { return m_frame; }
+
+		_NODISCARD _Check_return_
+		uint64_t GetPresentCount() const noexcept { return m_nPresents; }
+
+		//~ rows copied over every present, shows what the damage saved
+		_NODISCARD _Check_return_
+		uint64_t GetPresentedRows() const noexcept { return m_nPresentedRows; }
+
+		//~ fnv-1a over the kept pixels, equal frames hash equal
+		_NODISCARD _Check_return_
+		uint64_t Hash() const noexcept;
+
+		_NODISCARD _Check_return_
+		bool WritePPM(_In_ const std::string& path) const;
+
+		_NODISCARD _Check_return_
+		static bool ReadPPM(
+			_In_  const std::string&  path,
+			_Out_ PFE_HEADLESS_IMAGE& image);
+
+		//~ pixels with any channel further apart than tolerance, every
+		//~ pixel when the sizes differ
+		_NODISCARD _Check_return_
+		static size_t CountMismatched(
+			_In_ const PFE_HEADLESS_IMAGE& a,
+			_In_ const PFE_HEADLESS_IMAGE& b,
+			_In_ uint8_t				   tolerance) noexcept;
+
+	private:
+		PFE_HEADLESS_IMAGE m_frame		  {};
+		uint64_t		   m_nPresents	  { 0u };
+		uint64_t		   m_nPresentedRows{ 0u };
+	};
+} // namespace pixel_engine
@@ -0,0 +1,33 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/render_manager/api/buffer/image.h"
+
+namespace pixel_engine
+{
+	//~ where PERaster2D::Present sends the finished frame. Rows outside
+	//~ [minY, maxY) did not change since the last call, a target keeps what
+	//~ it was given before for them, the same way the gpu buffer does
+	class PFE_API IPresentTarget
+	{
+	public:
+		virtual ~IPresentTarget() = default;
+
+		virtual void Present(
+			_In_ const PEImageBuffer& image,
+			_In_ int				  minY,
+			_In_ int				  maxY) = 0;
+	};
+} // namespace pixel_engine
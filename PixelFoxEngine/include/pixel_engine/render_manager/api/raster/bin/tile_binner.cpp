@@ -0,0 +1,172 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "tile_binner.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace pixel_engine;
+
+_Use_decl_annotations_
+void PETileBinner::Init(UINT width, UINT height, int tileSize)
+{
+    m_nTileSize = std::max(8, tileSize);
+    m_nWidth    = static_cast<int>(width);
+    m_nHeight   = static_cast<int>(height);
+    m_nTilesX   = (m_nWidth  + m_nTileSize - 1) / m_nTileSize;
+    m_nTilesY   = (m_nHeight + m_nTileSize - 1) / m_nTileSize;
+
+    m_commands.clear();
+    m_bins.clear();
+    m_bins.resize(static_cast<size_t>(m_nTilesX) * static_cast<size_t>(m_nTilesY));
+
+    for (int ty = 0; ty < m_nTilesY; ++ty)
+    {
+        for (int tx = 0; tx < m_nTilesX; ++tx)
+        {
+            auto& bin = m_bins[static_cast<size_t>(ty) * m_nTilesX + tx];
+            bin.minX  = tx * m_nTileSize;
+            bin.minY  = ty * m_nTileSize;
+            bin.maxX  = std::min(m_nWidth,  bin.minX + m_nTileSize);
+            bin.maxY  = std::min(m_nHeight, bin.minY + m_nTileSize);
+        }
+    }
+
+    //~ nothing tracked yet, every tile takes commands
+    ResetDamage(true);
+}
+
+void PETileBinner::Reset() noexcept
+{
+    //~ keeps capacity so steady state frames do not allocate
+    m_commands.clear();
+    for (auto& bin : m_bins) bin.commands.clear();
+}
+
+_Use_decl_annotations_
+bool PETileBinner::Submit(const PFE_RASTER_BIN_CMD& cmd)
+{
+    if (!cmd.sampledTexture || cmd.totalColumns <= 0 || cmd.totalRows <= 0) return false;
+    if (cmd.blendMode == EBlendMode::ColorKey)
+    {
+        if (cmd.sampledTexture->GetCoverage() == TextureCoverage::Transparent) return false;
+    }
+    else if (cmd.opacity == 0u) return false;
+
+    const FVector2D& u = cmd.deltaAxisU;
+    const FVector2D& v = cmd.deltaAxisV;
+
+    const float det = u.x * v.y - u.y * v.x;
+    if (std::abs(det) < 1e-8f) return false;
+
+    const float cols = static_cast<float>(cmd.totalColumns);
+    const float rows = static_cast<float>(cmd.totalRows);
+
+    //~ outer edges of the texel rectangle, covers both rounded lattice
+    //~ points (forward kernel) and whole texel footprints (span kernel)
+    const FVector2D A{ cmd.startBase.x - 0.5f * (u.x + v.x), cmd.startBase.y - 0.5f * (u.y + v.y) };
+    const FVector2D B{ A.x + u.x * cols, A.y + u.y * cols };
+    const FVector2D C{ A.x + v.x * rows, A.y + v.y * rows };
+    const FVector2D D{ B.x + v.x * rows, B.y + v.y * rows };
+
+    const float minX = std::min(std::min(A.x, B.x), std::min(C.x, D.x)) - 1.0f;
+    const float maxX = std::max(std::max(A.x, B.x), std::max(C.x, D.x)) + 1.0f;
+    const float minY = std::min(std::min(A.y, B.y), std::min(C.y, D.y)) - 1.0f;
+    const float maxY = std::max(std::max(A.y, B.y), std::max(C.y, D.y)) + 1.0f;
+
+    if (maxX < 0.f || maxY < 0.f) return false;
+    if (minX >= static_cast<float>(m_nWidth) || minY >= static_cast<float>(m_nHeight)) return false;
+
+    const int tx0 = std::max(0, static_cast<int>(minX) / m_nTileSize);
+    const int ty0 = std::max(0, static_cast<int>(minY) / m_nTileSize);
+    const int tx1 = std::min(m_nTilesX - 1, static_cast<int>(maxX) / m_nTileSize);
+    const int ty1 = std::min(m_nTilesY - 1, static_cast<int>(maxY) / m_nTileSize);
+
+    //~ skip the setup when every touched tile is clean
+    if (m_nDamaged < m_bins.size())
+    {
+        bool touchesDamage = false;
+        for (int ty = ty0; ty <= ty1 && !touchesDamage; ++ty)
+        {
+            for (int tx = tx0; tx <= tx1; ++tx)
+            {
+                if (m_damage[static_cast<size_t>(ty) * m_nTilesX + tx]) { touchesDamage = true; break; }
+            }
+        }
+        if (!touchesDamage) return false;
+    }
+
+    PFE_RASTER_BIN_CMD stored = cmd;
+    const float inv = 1.0f / det;
+    stored.m00 =  v.y * inv;
+    stored.m01 = -v.x * inv;
+    stored.m10 = -u.y * inv;
+    stored.m11 =  u.x * inv;
+
+    if (stored.kernel == ERasterKernel::InverseSpan &&
+        !PESpanRasterizer::Setup(
+            cmd.startBase, u, v,
+            cmd.totalColumns, cmd.totalRows, stored.span)) return false;
+
+    const uint32_t index = static_cast<uint32_t>(m_commands.size());
+    m_commands.push_back(stored);
+
+    bool binned = false;
+    for (int ty = ty0; ty <= ty1; ++ty)
+    {
+        for (int tx = tx0; tx <= tx1; ++tx)
+        {
+            const size_t bin = static_cast<size_t>(ty) * m_nTilesX + tx;
+            if (!m_damage[bin]) continue;
+
+            m_bins[bin].commands.push_back(index);
+            binned = true;
+        }
+    }
+
+    if (!binned) m_commands.pop_back();
+    return binned;
+}
+
+_Use_decl_annotations_
+void PETileBinner::ResetDamage(bool full) noexcept
+{
+    m_damage.assign(m_bins.size(), full ? 1u : 0u);
+    m_nDamaged = full ? m_bins.size() : 0u;
+}
+
+_Use_decl_annotations_
+void PETileBinner::MarkDamage(const PFE_AABB2D& rect) noexcept
+{
+    if (m_bins.empty()) return;
+    if (rect.maxX < 0.f || rect.maxY < 0.f) return;
+    if (rect.minX >= static_cast<float>(m_nWidth) || rect.minY >= static_cast<float>(m_nHeight)) return;
+    if (rect.minX > rect.maxX || rect.minY > rect.maxY) return;
+
+    const int tx0 = std::max(0, static_cast<int>(rect.minX) / m_nTileSize);
+    const int ty0 = std::max(0, static_cast<int>(rect.minY) / m_nTileSize);
+    const int tx1 = std::min(m_nTilesX - 1, static_cast<int>(rect.maxX) / m_nTileSize);
+    const int ty1 = std::min(m_nTilesY - 1, static_cast<int>(rect.maxY) / m_nTileSize);
+
+    for (int ty = ty0; ty <= ty1; ++ty)
+    {
+        for (int tx = tx0; tx <= tx1; ++tx)
+        {
+            uint8_t& damaged = m_damage[static_cast<size_t>(ty) * m_nTilesX + tx];
+            if (damaged) continue;
+
+            damaged = 1u;
+            ++m_nDamaged;
+        }
+    }
+}
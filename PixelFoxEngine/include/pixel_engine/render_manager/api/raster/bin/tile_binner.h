@@ -0,0 +1,113 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/core/types.h"
+#include "pixel_engine/render_manager/components/texture/resource/texture.h"
+#include "pixel_engine/render_manager/api/raster/span/span_rasterizer.h"
+
+#include "core/vector.h"
+#include "fox_math/vector.h"
+
+#include <cstdint>
+
+namespace pixel_engine
+{
+	//~ owned copy of a draw command, PFE_RASTER_DRAW_CMD only holds references
+	typedef struct _PFE_RASTER_BIN_CMD
+	{
+		_In_ FVector2D		startBase {};
+		_In_ FVector2D		deltaAxisU{};
+		_In_ FVector2D		deltaAxisV{};
+		_In_ int			totalColumns{ 0 };
+		_In_ int			totalRows	{ 0 };
+		_In_ const Texture* sampledTexture{ nullptr };
+		_In_ ERasterKernel	kernel{ ERasterKernel::ForwardMapped };
+		_In_ EBlendMode		blendMode{ EBlendMode::ColorKey };
+		_In_ uint8_t		opacity	 { 255u };
+
+		//~ screen -> texel space (inverse of [U V]), filled by the binner
+		_Out_ float m00{ 0.f }, m01{ 0.f }, m10{ 0.f }, m11{ 0.f };
+
+		//~ fixed point setup, filled by the binner for the span kernel
+		_Out_ PFE_SPAN_QUAD span{};
+	} PFE_RASTER_BIN_CMD;
+
+	typedef struct _PFE_RASTER_TILE_BIN
+	{
+		_In_ int minX{ 0 };
+		_In_ int minY{ 0 };
+		_In_ int maxX{ 0 }; // exclusive
+		_In_ int maxY{ 0 }; // exclusive
+
+		//~ indices into the binner command list, in submission (layer) order
+		fox::vector<uint32_t> commands{};
+	} PFE_RASTER_TILE_BIN;
+
+	/// <summary>
+	/// Buckets quad draw commands into fixed screen tiles so that each
+	/// tile can be rasterized on its own worker without touching pixels
+	/// owned by any other tile. Commands keep their submission order
+	/// inside a tile which keeps the same output as serial drawing.
+	/// </summary>
+	class PFE_API PETileBinner
+	{
+	public:
+		PETileBinner() = default;
+
+		void Init(
+			_In_ UINT width,
+			_In_ UINT height,
+			_In_ int  tileSize);
+
+		void Reset() noexcept;
+
+		//~ returns false if the command touches no damaged tile
+		bool Submit(_In_ const PFE_RASTER_BIN_CMD& cmd);
+
+		//~ damaged tiles survive Reset, commands only land in damaged tiles
+		void ResetDamage(_In_ bool full) noexcept;
+		void MarkDamage (_In_ const PFE_AABB2D& rect) noexcept;
+
+		_NODISCARD _Check_return_
+		bool IsDamaged(_In_ size_t bin) const noexcept { return bin < m_damage.size() && m_damage[bin] != 0u; }
+
+		_NODISCARD _Check_return_
+		size_t GetDamagedCount() const noexcept { return m_nDamaged; }
+
+		_NODISCARD _Check_return_
+		bool Empty() const noexcept { return m_commands.empty(); }
+
+		_NODISCARD _Check_return_
+		int GetTileSize() const noexcept { return m_nTileSize; }
+
+		_NODISCARD _Check_return_
+		const fox::vector<PFE_RASTER_TILE_BIN>& GetBins() const noexcept { return m_bins; }
+
+		_NODISCARD _Check_return_
+		const fox::vector<PFE_RASTER_BIN_CMD>& GetCommands() const noexcept { return m_commands; }
+
+	private:
+		int m_nTileSize{ 64 };
+		int m_nTilesX  { 0 };
+		int m_nTilesY  { 0 };
+		int m_nWidth   { 0 };
+		int m_nHeight  { 0 };
+
+		fox::vector<PFE_RASTER_BIN_CMD>  m_commands{};
+		fox::vector<PFE_RASTER_TILE_BIN> m_bins	   {};
+		fox::vector<uint8_t>			 m_damage  {};
+		size_t							 m_nDamaged{ 0u };
+	};
+} // namespace pixel_engine
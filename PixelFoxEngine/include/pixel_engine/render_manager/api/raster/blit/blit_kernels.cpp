@@ -0,0 +1,796 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "blit_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <intrin.h>
+#include <immintrin.h>
+#include <iterator>
+
+using namespace pixel_engine;
+
+namespace
+{
+	constexpr uint8_t KEY_THRESHOLD = 10u;
+
+	PFE_CPU_FEATURES DetectCpuFeatures() noexcept
+	{
+		PFE_CPU_FEATURES features{};
+
+		int info[4]{};
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+		if (maxLeaf < 1) return features;
+
+		__cpuid(info, 1);
+		features.SSE2  = (info[3] & (1 << 26)) != 0;
+		features.SSSE3 = (info[2] & (1 <<  9)) != 0;
+
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx	   = (info[2] & (1 << 28)) != 0;
+
+		//~ the OS has to save ymm state as well, not only the CPU support it
+		bool ymmEnabled = false;
+		if (osxsave && avx)
+		{
+			const unsigned long long xcr0 = _xgetbv(0);
+			ymmEnabled = (xcr0 & 0x6) == 0x6;
+		}
+
+		if (maxLeaf >= 7 && ymmEnabled)
+		{
+			__cpuidex(info, 7, 0);
+			features.AVX2 = (info[1] & (1 << 5)) != 0;
+		}
+		return features;
+	}
+
+	constexpr uint32_t OPAQUE_ALPHA = 0xFF000000u;
+
+	//~ scalar, D is the target pixel size (3 or 4 bytes)
+	template<size_t D>
+	inline void StoreTexel(uint8_t* dst, const uint8_t* src) noexcept
+	{
+		if constexpr (D == 4u)
+		{
+			uint32_t px;
+			std::memcpy(&px, src, sizeof(px));
+			px |= OPAQUE_ALPHA;
+			std::memcpy(dst, &px, sizeof(px));
+		}
+		else
+		{
+			dst[0] = src[0];
+			dst[1] = src[1];
+			dst[2] = src[2];
+		}
+	}
+
+	template<size_t D>
+	void BlitKeyedScalar(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		for (int i = 0; i < count; ++i, dst += D, src += 4)
+		{
+			if (src[0] <= KEY_THRESHOLD &&
+				src[1] <= KEY_THRESHOLD &&
+				src[2] <= KEY_THRESHOLD) continue;
+
+			StoreTexel<D>(dst, src);
+		}
+	}
+
+	template<size_t D>
+	void BlitOpaqueScalar(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		for (int i = 0; i < count; ++i, dst += D, src += 4)
+		{
+			StoreTexel<D>(dst, src);
+		}
+	}
+
+	//~ rounded x / 255 for x <= 255 * 255
+	inline uint32_t Div255(uint32_t x) noexcept
+	{
+		x += 128u;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	template<size_t D>
+	void BlendScalar(uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+	{
+		for (int i = 0; i < count; ++i, dst += D, src += 4)
+		{
+			if (src[3] == 0u) continue;
+
+			uint32_t r = src[0], g = src[1], b = src[2], a = src[3];
+			if (opacity != 255u)
+			{
+				r = Div255(r * opacity);
+				g = Div255(g * opacity);
+				b = Div255(b * opacity);
+				a = Div255(a * opacity);
+			}
+
+			const uint32_t inv = 255u - a;
+			dst[0] = static_cast<uint8_t>(std::min(255u, r + Div255(dst[0] * inv)));
+			dst[1] = static_cast<uint8_t>(std::min(255u, g + Div255(dst[1] * inv)));
+			dst[2] = static_cast<uint8_t>(std::min(255u, b + Div255(dst[2] * inv)));
+			if constexpr (D == 4u) dst[3] = 255u;
+		}
+	}
+
+	//~ SSSE3, 16 pixels = 64 source bytes = 48 destination bytes = 3 registers
+	struct SSSE3Pack
+	{
+		//~ RGBA x4 -> RGB x4 in the low 12 bytes
+		static __m128i Shuffle() noexcept
+		{
+			return _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+		}
+
+		static void Pack(
+			__m128i a, __m128i b, __m128i c, __m128i d,
+			__m128i& o0, __m128i& o1, __m128i& o2) noexcept
+		{
+			const __m128i shuf = Shuffle();
+			a = _mm_shuffle_epi8(a, shuf);
+			b = _mm_shuffle_epi8(b, shuf);
+			c = _mm_shuffle_epi8(c, shuf);
+			d = _mm_shuffle_epi8(d, shuf);
+
+			o0 = _mm_or_si128(a,				   _mm_slli_si128(b, 12));
+			o1 = _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8));
+			o2 = _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4));
+		}
+
+		//~ all ones lanes for pixels that are keyed out
+		static __m128i KeyMask(__m128i px) noexcept
+		{
+			const __m128i threshold = _mm_set1_epi8(static_cast<char>(KEY_THRESHOLD));
+			const __m128i alpha		= _mm_set1_epi32(static_cast<int>(0xFF000000u));
+			const __m128i dark		= _mm_cmpeq_epi8(_mm_subs_epu8(px, threshold), _mm_setzero_si128());
+			return _mm_cmpeq_epi32(_mm_or_si128(dark, alpha), _mm_set1_epi32(-1));
+		}
+	};
+
+	void BlitKeyedSSSE3(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		int i = 0;
+		for (; i + 16 <= count; i += 16, dst += 48, src += 64)
+		{
+			const __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src +  0));
+			const __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+			const __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+			const __m128i s3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+
+			const __m128i k0 = SSSE3Pack::KeyMask(s0);
+			const __m128i k1 = SSSE3Pack::KeyMask(s1);
+			const __m128i k2 = SSSE3Pack::KeyMask(s2);
+			const __m128i k3 = SSSE3Pack::KeyMask(s3);
+
+			const int keyed =  _mm_movemask_ps(_mm_castsi128_ps(k0))		|
+							  (_mm_movemask_ps(_mm_castsi128_ps(k1)) << 4)  |
+							  (_mm_movemask_ps(_mm_castsi128_ps(k2)) << 8)  |
+							  (_mm_movemask_ps(_mm_castsi128_ps(k3)) << 12);
+
+			if (keyed == 0xFFFF) continue;
+
+			__m128i p0, p1, p2;
+			SSSE3Pack::Pack(s0, s1, s2, s3, p0, p1, p2);
+
+			__m128i* out = reinterpret_cast<__m128i*>(dst);
+			if (keyed == 0)
+			{
+				_mm_storeu_si128(out + 0, p0);
+				_mm_storeu_si128(out + 1, p1);
+				_mm_storeu_si128(out + 2, p2);
+				continue;
+			}
+
+			//~ byte mask of pixels to keep from the source, packed like the colors
+			const __m128i ones = _mm_set1_epi32(-1);
+			__m128i m0, m1, m2;
+			SSSE3Pack::Pack(
+				_mm_xor_si128(k0, ones), _mm_xor_si128(k1, ones),
+				_mm_xor_si128(k2, ones), _mm_xor_si128(k3, ones),
+				m0, m1, m2);
+
+			//~ read modify write stays inside the 48 bytes this span owns
+			const __m128i d0 = _mm_loadu_si128(out + 0);
+			const __m128i d1 = _mm_loadu_si128(out + 1);
+			const __m128i d2 = _mm_loadu_si128(out + 2);
+
+			_mm_storeu_si128(out + 0, _mm_or_si128(_mm_and_si128(m0, p0), _mm_andnot_si128(m0, d0)));
+			_mm_storeu_si128(out + 1, _mm_or_si128(_mm_and_si128(m1, p1), _mm_andnot_si128(m1, d1)));
+			_mm_storeu_si128(out + 2, _mm_or_si128(_mm_and_si128(m2, p2), _mm_andnot_si128(m2, d2)));
+		}
+		BlitKeyedScalar<3>(dst, src, count - i);
+	}
+
+	void BlitOpaqueSSSE3(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		int i = 0;
+		for (; i + 16 <= count; i += 16, dst += 48, src += 64)
+		{
+			__m128i p0, p1, p2;
+			SSSE3Pack::Pack(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(src +  0)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48)),
+				p0, p1, p2);
+
+			__m128i* out = reinterpret_cast<__m128i*>(dst);
+			_mm_storeu_si128(out + 0, p0);
+			_mm_storeu_si128(out + 1, p1);
+			_mm_storeu_si128(out + 2, p2);
+		}
+		BlitOpaqueScalar<3>(dst, src, count - i);
+	}
+
+	//~ source over on 4 pixels at a time, widened to 16 bit lanes
+	struct SSSE3Blend
+	{
+		static __m128i Div255(__m128i x) noexcept
+		{
+			x = _mm_add_epi16(x, _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+		}
+
+		//~ RGB x4 (48 bytes over 3 registers) -> RGB0 x4 in each of 4 registers
+		static void Unpack(
+			__m128i d0, __m128i d1, __m128i d2,
+			__m128i& o0, __m128i& o1, __m128i& o2, __m128i& o3) noexcept
+		{
+			const __m128i shuf = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			o0 = _mm_shuffle_epi8(d0,						 shuf);
+			o1 = _mm_shuffle_epi8(_mm_alignr_epi8(d1, d0, 12), shuf);
+			o2 = _mm_shuffle_epi8(_mm_alignr_epi8(d2, d1,  8), shuf);
+			o3 = _mm_shuffle_epi8(_mm_srli_si128 (d2,	   4), shuf);
+		}
+
+		//~ two pixels, 8 lanes of 16 bit
+		static __m128i Blend2(__m128i s, __m128i d, __m128i opacity, bool scale) noexcept
+		{
+			if (scale) s = Div255(_mm_mullo_epi16(s, opacity));
+
+			const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+			const __m128i inv	= _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+			return _mm_add_epi16(s, Div255(_mm_mullo_epi16(d, inv)));
+		}
+
+		static __m128i Blend4(__m128i s, __m128i d, __m128i opacity, bool scale) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i lo   = Blend2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), opacity, scale);
+			const __m128i hi   = Blend2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), opacity, scale);
+			return _mm_packus_epi16(lo, hi);
+		}
+	};
+
+	void BlendSSSE3(uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+	{
+		const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+		const __m128i zero		= _mm_setzero_si128();
+		const __m128i opacity16 = _mm_set1_epi16(static_cast<short>(opacity));
+		const bool	  scale		= opacity != 255u;
+
+		int i = 0;
+		for (; i + 16 <= count; i += 16, dst += 48, src += 64)
+		{
+			const __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src +  0));
+			const __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+			const __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+			const __m128i s3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+
+			//~ fully transparent group leaves the target alone
+			const __m128i anyAlpha = _mm_and_si128(
+				_mm_or_si128(_mm_or_si128(s0, s1), _mm_or_si128(s2, s3)), alphaMask);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(anyAlpha, zero)) == 0xFFFF) continue;
+
+			__m128i* out = reinterpret_cast<__m128i*>(dst);
+
+			//~ fully opaque group at full opacity is a plain copy
+			const __m128i allAlpha = _mm_and_si128(
+				_mm_and_si128(_mm_and_si128(s0, s1), _mm_and_si128(s2, s3)), alphaMask);
+			if (!scale && _mm_movemask_epi8(_mm_cmpeq_epi8(allAlpha, alphaMask)) == 0xFFFF)
+			{
+				__m128i p0, p1, p2;
+				SSSE3Pack::Pack(s0, s1, s2, s3, p0, p1, p2);
+				_mm_storeu_si128(out + 0, p0);
+				_mm_storeu_si128(out + 1, p1);
+				_mm_storeu_si128(out + 2, p2);
+				continue;
+			}
+
+			__m128i d0, d1, d2, d3;
+			SSSE3Blend::Unpack(
+				_mm_loadu_si128(out + 0),
+				_mm_loadu_si128(out + 1),
+				_mm_loadu_si128(out + 2),
+				d0, d1, d2, d3);
+
+			__m128i p0, p1, p2;
+			SSSE3Pack::Pack(
+				SSSE3Blend::Blend4(s0, d0, opacity16, scale),
+				SSSE3Blend::Blend4(s1, d1, opacity16, scale),
+				SSSE3Blend::Blend4(s2, d2, opacity16, scale),
+				SSSE3Blend::Blend4(s3, d3, opacity16, scale),
+				p0, p1, p2);
+
+			_mm_storeu_si128(out + 0, p0);
+			_mm_storeu_si128(out + 1, p1);
+			_mm_storeu_si128(out + 2, p2);
+		}
+		BlendScalar<3>(dst, src, count - i, opacity);
+	}
+
+	//~ SSSE3 into a 32 bit target, 4 pixels per register and no repacking
+	void BlitKeyed32SSSE3(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		const __m128i alpha = _mm_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+
+		int i = 0;
+		for (; i + 16 <= count; i += 16, dst += 64, src += 64)
+		{
+			__m128i px[4], k[4];
+			int keyed = 0;
+			for (int r = 0; r < 4; ++r)
+			{
+				px[r]  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + r);
+				k[r]   = SSSE3Pack::KeyMask(px[r]);
+				keyed |= _mm_movemask_ps(_mm_castsi128_ps(k[r])) << (r * 4);
+			}
+			if (keyed == 0xFFFF) continue;
+
+			__m128i* out = reinterpret_cast<__m128i*>(dst);
+			for (int r = 0; r < 4; ++r)
+			{
+				const __m128i color = _mm_or_si128(px[r], alpha);
+				if (keyed == 0)
+				{
+					_mm_storeu_si128(out + r, color);
+					continue;
+				}
+				_mm_storeu_si128(out + r, _mm_or_si128(_mm_andnot_si128(k[r], color), _mm_and_si128(k[r], _mm_loadu_si128(out + r))));
+			}
+		}
+		BlitKeyedScalar<4>(dst, src, count - i);
+	}
+
+	void BlitOpaque32SSSE3(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		const __m128i alpha = _mm_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+
+		int i = 0;
+		for (; i + 4 <= count; i += 4, dst += 16, src += 16)
+		{
+			const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(px, alpha));
+		}
+		BlitOpaqueScalar<4>(dst, src, count - i);
+	}
+
+	void Blend32SSSE3(uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+	{
+		const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+		const __m128i zero		= _mm_setzero_si128();
+		const __m128i opacity16 = _mm_set1_epi16(static_cast<short>(opacity));
+		const bool	  scale		= opacity != 255u;
+
+		int i = 0;
+		for (; i + 4 <= count; i += 4, dst += 16, src += 16)
+		{
+			const __m128i px	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			const __m128i alpha = _mm_and_si128(px, alphaMask);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(alpha, zero)) == 0xFFFF) continue;
+
+			__m128i* out = reinterpret_cast<__m128i*>(dst);
+			if (!scale && _mm_movemask_epi8(_mm_cmpeq_epi8(alpha, alphaMask)) == 0xFFFF)
+			{
+				_mm_storeu_si128(out, px);
+				continue;
+			}
+
+			const __m128i blended = SSSE3Blend::Blend4(px, _mm_loadu_si128(out), opacity16, scale);
+			_mm_storeu_si128(out, _mm_or_si128(blended, alphaMask));
+		}
+		BlendScalar<4>(dst, src, count - i, opacity);
+	}
+
+	//~ AVX2, 16 pixels = 64 source bytes = 48 destination bytes = one ymm + one xmm
+	struct AVX2Pack
+	{
+		//~ in lane RGBA -> RGB, then gather the two 12 byte halves into dwords 0..5
+		static __m256i PackHalf(__m256i px) noexcept
+		{
+			const __m256i shuf = _mm256_setr_epi8(
+				0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+				0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+			const __m256i perm = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+			return _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(px, shuf), perm);
+		}
+
+		//~ 2 x 24 bytes -> 32 bytes in lo and the remaining 16 in hi
+		static void Pack(__m256i a, __m256i b, __m256i& lo, __m128i& hi) noexcept
+		{
+			const __m256i pa = PackHalf(a);
+			const __m256i pb = _mm256_permutevar8x32_epi32(
+				PackHalf(b), _mm256_setr_epi32(2, 3, 4, 5, 0, 0, 0, 1));
+
+			lo = _mm256_blend_epi32(pa, pb, 0xC0);
+			hi = _mm256_castsi256_si128(pb);
+		}
+
+		static __m256i KeyMask(__m256i px) noexcept
+		{
+			const __m256i threshold = _mm256_set1_epi8(static_cast<char>(KEY_THRESHOLD));
+			const __m256i alpha		= _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+			const __m256i dark		= _mm256_cmpeq_epi8(_mm256_subs_epu8(px, threshold), _mm256_setzero_si256());
+			return _mm256_cmpeq_epi32(_mm256_or_si256(dark, alpha), _mm256_set1_epi32(-1));
+		}
+	};
+
+	void BlitKeyedAVX2(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		const __m256i ones = _mm256_set1_epi32(-1);
+
+		int i = 0;
+		for (; i + 16 <= count; i += 16, dst += 48, src += 64)
+		{
+			const __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src +  0));
+			const __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+
+			const __m256i k0 = AVX2Pack::KeyMask(s0);
+			const __m256i k1 = AVX2Pack::KeyMask(s1);
+
+			const int keyed =  _mm256_movemask_ps(_mm256_castsi256_ps(k0)) |
+							  (_mm256_movemask_ps(_mm256_castsi256_ps(k1)) << 8);
+			if (keyed == 0xFFFF) continue;
+
+			__m256i pLo;
+			__m128i pHi;
+			AVX2Pack::Pack(s0, s1, pLo, pHi);
+
+			__m256i* outLo = reinterpret_cast<__m256i*>(dst);
+			__m128i* outHi = reinterpret_cast<__m128i*>(dst + 32);
+
+			if (keyed == 0)
+			{
+				_mm256_storeu_si256(outLo, pLo);
+				_mm_storeu_si128   (outHi, pHi);
+				continue;
+			}
+
+			__m256i mLo;
+			__m128i mHi;
+			AVX2Pack::Pack(_mm256_xor_si256(k0, ones), _mm256_xor_si256(k1, ones), mLo, mHi);
+
+			//~ read modify write stays inside the 48 bytes this span owns
+			_mm256_storeu_si256(outLo, _mm256_blendv_epi8(_mm256_loadu_si256(outLo), pLo, mLo));
+			_mm_storeu_si128   (outHi, _mm_blendv_epi8	 (_mm_loadu_si128	(outHi), pHi, mHi));
+		}
+		BlitKeyedScalar<3>(dst, src, count - i);
+	}
+
+	void BlitOpaqueAVX2(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		int i = 0;
+		for (; i + 16 <= count; i += 16, dst += 48, src += 64)
+		{
+			__m256i pLo;
+			__m128i pHi;
+			AVX2Pack::Pack(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src +  0)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32)),
+				pLo, pHi);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst),	  pLo);
+			_mm_storeu_si128   (reinterpret_cast<__m128i*>(dst + 32), pHi);
+		}
+		BlitOpaqueScalar<3>(dst, src, count - i);
+	}
+
+	//~ AVX2 into a 32 bit target, 8 pixels per register, unpack and pack stay in lane
+	struct AVX2Blend
+	{
+		static __m256i Div255(__m256i x) noexcept
+		{
+			x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+			return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+		}
+
+		//~ four pixels, 16 lanes of 16 bit
+		static __m256i Blend4(__m256i s, __m256i d, __m256i opacity, bool scale) noexcept
+		{
+			if (scale) s = Div255(_mm256_mullo_epi16(s, opacity));
+
+			const __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF);
+			const __m256i inv	= _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+			return _mm256_add_epi16(s, Div255(_mm256_mullo_epi16(d, inv)));
+		}
+
+		static __m256i Blend8(__m256i s, __m256i d, __m256i opacity, bool scale) noexcept
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i lo   = Blend4(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), opacity, scale);
+			const __m256i hi   = Blend4(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), opacity, scale);
+			return _mm256_packus_epi16(lo, hi);
+		}
+	};
+
+	void BlitKeyed32AVX2(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		const __m256i alpha = _mm256_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+
+		int i = 0;
+		for (; i + 16 <= count; i += 16, dst += 64, src += 64)
+		{
+			const __m256i p0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src +  0));
+			const __m256i p1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+			const __m256i k0 = AVX2Pack::KeyMask(p0);
+			const __m256i k1 = AVX2Pack::KeyMask(p1);
+
+			const int keyed =  _mm256_movemask_ps(_mm256_castsi256_ps(k0)) |
+							  (_mm256_movemask_ps(_mm256_castsi256_ps(k1)) << 8);
+			if (keyed == 0xFFFF) continue;
+
+			__m256i* out = reinterpret_cast<__m256i*>(dst);
+			const __m256i c0 = _mm256_or_si256(p0, alpha);
+			const __m256i c1 = _mm256_or_si256(p1, alpha);
+			if (keyed == 0)
+			{
+				_mm256_storeu_si256(out + 0, c0);
+				_mm256_storeu_si256(out + 1, c1);
+				continue;
+			}
+			_mm256_storeu_si256(out + 0, _mm256_blendv_epi8(c0, _mm256_loadu_si256(out + 0), k0));
+			_mm256_storeu_si256(out + 1, _mm256_blendv_epi8(c1, _mm256_loadu_si256(out + 1), k1));
+		}
+		BlitKeyedScalar<4>(dst, src, count - i);
+	}
+
+	void BlitOpaque32AVX2(uint8_t* dst, const uint8_t* src, int count) noexcept
+	{
+		const __m256i alpha = _mm256_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+
+		int i = 0;
+		for (; i + 8 <= count; i += 8, dst += 32, src += 32)
+		{
+			const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_or_si256(px, alpha));
+		}
+		BlitOpaqueScalar<4>(dst, src, count - i);
+	}
+
+	void Blend32AVX2(uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+	{
+		const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+		const __m256i zero		= _mm256_setzero_si256();
+		const __m256i opacity16 = _mm256_set1_epi16(static_cast<short>(opacity));
+		const bool	  scale		= opacity != 255u;
+
+		int i = 0;
+		for (; i + 8 <= count; i += 8, dst += 32, src += 32)
+		{
+			const __m256i px	= _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+			const __m256i alpha = _mm256_and_si256(px, alphaMask);
+			if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(alpha, zero)) == -1) continue;
+
+			__m256i* out = reinterpret_cast<__m256i*>(dst);
+			if (!scale && _mm256_movemask_epi8(_mm256_cmpeq_epi8(alpha, alphaMask)) == -1)
+			{
+				_mm256_storeu_si256(out, px);
+				continue;
+			}
+
+			const __m256i blended = AVX2Blend::Blend8(px, _mm256_loadu_si256(out), opacity16, scale);
+			_mm256_storeu_si256(out, _mm256_or_si256(blended, alphaMask));
+		}
+		BlendScalar<4>(dst, src, count - i, opacity);
+	}
+
+	using blit_fn = void(*)(uint8_t*, const uint8_t*, int) noexcept;
+
+	constexpr blit_fn KEYED_TABLE[] =
+	{
+		&BlitKeyedScalar<3>,
+		&BlitKeyedSSSE3,
+		&BlitKeyedAVX2
+	};
+
+	constexpr blit_fn OPAQUE_TABLE[] =
+	{
+		&BlitOpaqueScalar<3>,
+		&BlitOpaqueSSSE3,
+		&BlitOpaqueAVX2
+	};
+
+	constexpr blit_fn KEYED32_TABLE[] =
+	{
+		&BlitKeyedScalar<4>,
+		&BlitKeyed32SSSE3,
+		&BlitKeyed32AVX2
+	};
+
+	constexpr blit_fn OPAQUE32_TABLE[] =
+	{
+		&BlitOpaqueScalar<4>,
+		&BlitOpaque32SSSE3,
+		&BlitOpaque32AVX2
+	};
+
+	using blend_fn = void(*)(uint8_t*, const uint8_t*, int, uint8_t) noexcept;
+
+	//~ the 24 bit blend is bound by the 16 bit multiplies, not by loads, so
+	//~ AVX2 reuses the SSSE3 kernel instead of paying for cross lane unpacking
+	constexpr blend_fn BLEND_TABLE[] =
+	{
+		&BlendScalar<3>,
+		&BlendSSSE3,
+		&BlendSSSE3
+	};
+
+	constexpr blend_fn BLEND32_TABLE[] =
+	{
+		&BlendScalar<4>,
+		&Blend32SSSE3,
+		&Blend32AVX2
+	};
+
+	static_assert(std::size(KEYED_TABLE)	== static_cast<size_t>(EBlitPath::Count));
+	static_assert(std::size(OPAQUE_TABLE)	== static_cast<size_t>(EBlitPath::Count));
+	static_assert(std::size(BLEND_TABLE)	== static_cast<size_t>(EBlitPath::Count));
+	static_assert(std::size(KEYED32_TABLE)	== static_cast<size_t>(EBlitPath::Count));
+	static_assert(std::size(OPAQUE32_TABLE) == static_cast<size_t>(EBlitPath::Count));
+	static_assert(std::size(BLEND32_TABLE)	== static_cast<size_t>(EBlitPath::Count));
+
+	std::atomic<EBlitPath>& ActivePath() noexcept
+	{
+		static std::atomic<EBlitPath> path{ PEBlitKernels::GetBestPath() };
+		return path;
+	}
+} // namespace
+
+const PFE_CPU_FEATURES& PEBlitKernels::GetCpuFeatures() noexcept
+{
+	static const PFE_CPU_FEATURES features = DetectCpuFeatures();
+	return features;
+}
+
+_Use_decl_annotations_
+bool PEBlitKernels::IsSupported(EBlitPath path) noexcept
+{
+	const auto& cpu = GetCpuFeatures();
+	switch (path)
+	{
+	case EBlitPath::Scalar: return true;
+	case EBlitPath::SSSE3:	return cpu.SSE2 && cpu.SSSE3;
+	case EBlitPath::AVX2:	return cpu.AVX2;
+	default:				return false;
+	}
+}
+
+EBlitPath PEBlitKernels::GetBestPath() noexcept
+{
+	if (IsSupported(EBlitPath::AVX2))  return EBlitPath::AVX2;
+	if (IsSupported(EBlitPath::SSSE3)) return EBlitPath::SSSE3;
+	return EBlitPath::Scalar;
+}
+
+EBlitPath PEBlitKernels::GetActivePath() noexcept
+{
+	return ActivePath().load(std::memory_order_relaxed);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::SetActivePath(EBlitPath path) noexcept
+{
+	ActivePath().store(IsSupported(path) ? path : GetBestPath(), std::memory_order_relaxed);
+}
+
+_Use_decl_annotations_
+const char* PEBlitKernels::ToString(EBlitPath path) noexcept
+{
+	switch (path)
+	{
+	case EBlitPath::Scalar: return "Scalar";
+	case EBlitPath::SSSE3:	return "SSSE3";
+	case EBlitPath::AVX2:	return "AVX2";
+	default:				return "Unknown";
+	}
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlitKeyedRGBA(uint8_t* dst, const uint8_t* src, int count) noexcept
+{
+	KEYED_TABLE[static_cast<size_t>(GetActivePath())](dst, src, count);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlitOpaqueRGBA(uint8_t* dst, const uint8_t* src, int count) noexcept
+{
+	OPAQUE_TABLE[static_cast<size_t>(GetActivePath())](dst, src, count);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlitKeyedRGBA(EBlitPath path, uint8_t* dst, const uint8_t* src, int count) noexcept
+{
+	if (!IsSupported(path)) path = GetBestPath();
+	KEYED_TABLE[static_cast<size_t>(path)](dst, src, count);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlitOpaqueRGBA(EBlitPath path, uint8_t* dst, const uint8_t* src, int count) noexcept
+{
+	if (!IsSupported(path)) path = GetBestPath();
+	OPAQUE_TABLE[static_cast<size_t>(path)](dst, src, count);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlendPremultipliedRGBA(uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+{
+	if (opacity == 0u) return;
+	BLEND_TABLE[static_cast<size_t>(GetActivePath())](dst, src, count, opacity);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlendPremultipliedRGBA(EBlitPath path, uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+{
+	if (opacity == 0u) return;
+	if (!IsSupported(path)) path = GetBestPath();
+	BLEND_TABLE[static_cast<size_t>(path)](dst, src, count, opacity);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlitKeyedRGBA32(uint8_t* dst, const uint8_t* src, int count) noexcept
+{
+	KEYED32_TABLE[static_cast<size_t>(GetActivePath())](dst, src, count);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlitOpaqueRGBA32(uint8_t* dst, const uint8_t* src, int count) noexcept
+{
+	OPAQUE32_TABLE[static_cast<size_t>(GetActivePath())](dst, src, count);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlendPremultipliedRGBA32(uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+{
+	if (opacity == 0u) return;
+	BLEND32_TABLE[static_cast<size_t>(GetActivePath())](dst, src, count, opacity);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlitKeyedRGBA32(EBlitPath path, uint8_t* dst, const uint8_t* src, int count) noexcept
+{
+	if (!IsSupported(path)) path = GetBestPath();
+	KEYED32_TABLE[static_cast<size_t>(path)](dst, src, count);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlitOpaqueRGBA32(EBlitPath path, uint8_t* dst, const uint8_t* src, int count) noexcept
+{
+	if (!IsSupported(path)) path = GetBestPath();
+	OPAQUE32_TABLE[static_cast<size_t>(path)](dst, src, count);
+}
+
+_Use_decl_annotations_
+void PEBlitKernels::BlendPremultipliedRGBA32(EBlitPath path, uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+{
+	if (opacity == 0u) return;
+	if (!IsSupported(path)) path = GetBestPath();
+	BLEND32_TABLE[static_cast<size_t>(path)](dst, src, count, opacity);
+}
@@ -0,0 +1,139 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include <cstdint>
+
+namespace pixel_engine
+{
+	enum class EBlitPath : uint8_t
+	{
+		Scalar,
+		SSSE3, // 16 pixels per iteration
+		AVX2,  // 16 pixels per iteration
+		Count
+	};
+
+	typedef struct _PFE_CPU_FEATURES
+	{
+		bool SSE2 { false };
+		bool SSSE3{ false };
+		bool AVX2 { false };
+	} PFE_CPU_FEATURES;
+
+	/// <summary>
+	/// Row blits from RGBA8 texels into the render target for unrotated,
+	/// unscaled spans, the plain names write 24 bit pixels and the ...32
+	/// names write 32 bit RGBA pixels with an opaque alpha. The keyed
+	/// variants skip texels whose channels are all <= 10 (same rule as
+	/// IsBlack). The blend variants composite premultiplied texels source
+	/// over in 16 bit integer lanes. The widest path the CPU supports is
+	/// picked on first use and can be overridden.
+	/// </summary>
+	class PFE_API PEBlitKernels
+	{
+	public:
+		_NODISCARD _Check_return_
+		static const PFE_CPU_FEATURES& GetCpuFeatures() noexcept;
+
+		_NODISCARD _Check_return_
+		static bool IsSupported(_In_ EBlitPath path) noexcept;
+
+		_NODISCARD _Check_return_
+		static EBlitPath GetBestPath() noexcept;
+
+		_NODISCARD _Check_return_
+		static EBlitPath GetActivePath() noexcept;
+
+		//~ falls back to the best supported path if the CPU lacks it
+		static void SetActivePath(_In_ EBlitPath path) noexcept;
+
+		_NODISCARD _Check_return_
+		static const char* ToString(_In_ EBlitPath path) noexcept;
+
+		//~ active path
+		static void BlitKeyedRGBA (
+			_Out_writes_bytes_(count * 3) uint8_t*		 dst,
+			_In_reads_bytes_(count * 4)	  const uint8_t* src,
+			_In_						  int			 count) noexcept;
+
+		static void BlitOpaqueRGBA(
+			_Out_writes_bytes_(count * 3) uint8_t*		 dst,
+			_In_reads_bytes_(count * 4)	  const uint8_t* src,
+			_In_						  int			 count) noexcept;
+
+		//~ dst = src * opacity + dst * (255 - alpha * opacity) / 255, src premultiplied
+		static void BlendPremultipliedRGBA(
+			_Inout_updates_bytes_(count * 3) uint8_t*		dst,
+			_In_reads_bytes_(count * 4)		 const uint8_t* src,
+			_In_							 int			count,
+			_In_							 uint8_t		opacity) noexcept;
+
+		//~ 32 bit target, active path
+		static void BlitKeyedRGBA32 (
+			_Out_writes_bytes_(count * 4) uint8_t*		 dst,
+			_In_reads_bytes_(count * 4)	  const uint8_t* src,
+			_In_						  int			 count) noexcept;
+
+		static void BlitOpaqueRGBA32(
+			_Out_writes_bytes_(count * 4) uint8_t*		 dst,
+			_In_reads_bytes_(count * 4)	  const uint8_t* src,
+			_In_						  int			 count) noexcept;
+
+		static void BlendPremultipliedRGBA32(
+			_Inout_updates_bytes_(count * 4) uint8_t*		dst,
+			_In_reads_bytes_(count * 4)		 const uint8_t* src,
+			_In_							 int			count,
+			_In_							 uint8_t		opacity) noexcept;
+
+		//~ explicit path, used by the benchmarks
+		static void BlitKeyedRGBA (
+			_In_						  EBlitPath		 path,
+			_Out_writes_bytes_(count * 3) uint8_t*		 dst,
+			_In_reads_bytes_(count * 4)	  const uint8_t* src,
+			_In_						  int			 count) noexcept;
+
+		static void BlitOpaqueRGBA(
+			_In_						  EBlitPath		 path,
+			_Out_writes_bytes_(count * 3) uint8_t*		 dst,
+			_In_reads_bytes_(count * 4)	  const uint8_t* src,
+			_In_						  int			 count) noexcept;
+
+		static void BlendPremultipliedRGBA(
+			_In_							 EBlitPath		path,
+			_Inout_updates_bytes_(count * 3) uint8_t*		dst,
+			_In_reads_bytes_(count * 4)		 const uint8_t* src,
+			_In_							 int			count,
+			_In_							 uint8_t		opacity) noexcept;
+
+		static void BlitKeyedRGBA32 (
+			_In_						  EBlitPath		 path,
+			_Out_writes_bytes_(count * 4) uint8_t*		 dst,
+			_In_reads_bytes_(count * 4)	  const uint8_t* src,
+			_In_						  int			 count) noexcept;
+
+		static void BlitOpaqueRGBA32(
+			_In_						  EBlitPath		 path,
+			_Out_writes_bytes_(count * 4) uint8_t*		 dst,
+			_In_reads_bytes_(count * 4)	  const uint8_t* src,
+			_In_						  int			 count) noexcept;
+
+		static void BlendPremultipliedRGBA32(
+			_In_							 EBlitPath		path,
+			_Inout_updates_bytes_(count * 4) uint8_t*		dst,
+			_In_reads_bytes_(count * 4)		 const uint8_t* src,
+			_In_							 int			count,
+			_In_							 uint8_t		opacity) noexcept;
+	};
+} // namespace pixel_engine
@@ -0,0 +1,243 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "layer_cache.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace pixel_engine;
+
+_Use_decl_annotations_
+void PELayerCache::Init(const PFE_LAYER_CACHE_DESC& desc)
+{
+    m_nViewWidth  = static_cast<int>(desc.ViewWidth);
+    m_nViewHeight = static_cast<int>(desc.ViewHeight);
+    m_nMargin     = std::max(0, desc.Margin);
+    m_nRingWidth  = m_nViewWidth  + 2 * m_nMargin;
+    m_nRingHeight = m_nViewHeight + 2 * m_nMargin;
+    m_clearColor  = desc.ClearColor;
+
+    PE_IMAGE_BUFFER_DESC ringDesc{};
+    ringDesc.Width  = static_cast<UINT>(m_nRingWidth);
+    ringDesc.Height = static_cast<UINT>(m_nRingHeight);
+    ringDesc.Format = desc.Format;
+    m_pRing = std::make_unique<PEImageBuffer>(ringDesc);
+
+    m_bValid = false;
+}
+
+_Use_decl_annotations_
+void PELayerCache::SetQuads(const fox::vector<PFE_LAYER_QUAD>& quads)
+{
+    m_quads = quads;
+
+    //~ conservative layer bounds, same half texel plus one pixel as the binner
+    m_bounds.clear();
+    m_spans .clear();
+    m_bounds.reserve(m_quads.size());
+    m_spans .reserve(m_quads.size());
+    for (const auto& q : m_quads)
+    {
+        PFE_SPAN_QUAD span{};
+        if (!PESpanRasterizer::Setup(q.startBase, q.deltaAxisU, q.deltaAxisV, q.totalColumns, q.totalRows, span))
+            span.totalColumns = 0;
+        m_spans.push_back(span);
+
+        const FVector2D a{ q.startBase.x - 0.5f * (q.deltaAxisU.x + q.deltaAxisV.x),
+                           q.startBase.y - 0.5f * (q.deltaAxisU.y + q.deltaAxisV.y) };
+        const FVector2D b{ a.x + q.deltaAxisU.x * q.totalColumns, a.y + q.deltaAxisU.y * q.totalColumns };
+        const FVector2D c{ a.x + q.deltaAxisV.x * q.totalRows,    a.y + q.deltaAxisV.y * q.totalRows    };
+        const FVector2D d{ b.x + q.deltaAxisV.x * q.totalRows,    b.y + q.deltaAxisV.y * q.totalRows    };
+
+        PFE_AABB2D box{};
+        box.minX = std::min(std::min(a.x, b.x), std::min(c.x, d.x)) - 1.0f;
+        box.maxX = std::max(std::max(a.x, b.x), std::max(c.x, d.x)) + 1.0f;
+        box.minY = std::min(std::min(a.y, b.y), std::min(c.y, d.y)) - 1.0f;
+        box.maxY = std::max(std::max(a.y, b.y), std::max(c.y, d.y)) + 1.0f;
+        m_bounds.push_back(box);
+    }
+
+    m_bValid = false;
+}
+
+_Use_decl_annotations_
+void PELayerCache::SetClearColor(const PFE_FORMAT_R8G8B8_UINT& color) noexcept
+{
+    if (color.R.Value == m_clearColor.R.Value &&
+        color.G.Value == m_clearColor.G.Value &&
+        color.B.Value == m_clearColor.B.Value) return;
+
+    m_clearColor = color;
+    m_bValid     = false;
+}
+
+_Use_decl_annotations_
+void PELayerCache::Composite(
+    PEImageBuffer&       target,
+    int                  scrollX,
+    int                  scrollY,
+    const PFE_SPAN_CLIP* rects,
+    size_t               rectCount)
+{
+    m_nRedrawnPixels = 0u;
+    if (!m_pRing || target.Empty() || target.PixelSize() != m_pRing->PixelSize()) return;
+
+    Scroll(-scrollX, -scrollY);
+
+    const size_t pixel = target.PixelSize();
+    const int    maxX  = static_cast<int>(target.Width ());
+    const int    maxY  = static_cast<int>(target.Height());
+
+    for (size_t r = 0; r < rectCount; ++r)
+    {
+        const int x0 = std::max(0,    rects[r].minX);
+        const int x1 = std::min(maxX, rects[r].maxX);
+        const int y0 = std::max(0,    rects[r].minY);
+        const int y1 = std::min(maxY, rects[r].maxY);
+        if (x0 >= x1 || y0 >= y1) continue;
+
+        //~ a target row is at most two ring segments, split where the ring wraps
+        const int ringX    = WrapIndex(x0 - scrollX, m_nRingWidth);
+        const int count    = x1 - x0;
+        const int firstRun = std::min(count, m_nRingWidth - ringX);
+
+        for (int y = y0; y < y1; ++y)
+        {
+            const int ringY = WrapIndex(y - scrollY, m_nRingHeight);
+
+            unsigned char*       dst = target.Data()  + static_cast<size_t>(y)     * target.RowPitch()   + static_cast<size_t>(x0) * pixel;
+            const unsigned char* src = m_pRing->Data() + static_cast<size_t>(ringY) * m_pRing->RowPitch();
+
+            std::memcpy(dst, src + static_cast<size_t>(ringX) * pixel, static_cast<size_t>(firstRun) * pixel);
+            if (firstRun < count)
+            {
+                std::memcpy(dst + static_cast<size_t>(firstRun) * pixel, src, static_cast<size_t>(count - firstRun) * pixel);
+            }
+        }
+    }
+}
+
+_Use_decl_annotations_
+void PELayerCache::Scroll(int viewX, int viewY)
+{
+    const bool insideX = viewX >= m_nValidX && viewX + m_nViewWidth  <= m_nValidX + m_nRingWidth;
+    const bool insideY = viewY >= m_nValidY && viewY + m_nViewHeight <= m_nValidY + m_nRingHeight;
+    if (m_bValid && insideX && insideY) return;
+
+    //~ recentre so the next margin worth of scrolling is free
+    const int newX = insideX && m_bValid ? m_nValidX : viewX - m_nMargin;
+    const int newY = insideY && m_bValid ? m_nValidY : viewY - m_nMargin;
+
+    const bool jumped = !m_bValid                                    ||
+                        std::abs(newX - m_nValidX) >= m_nRingWidth  ||
+                        std::abs(newY - m_nValidY) >= m_nRingHeight;
+    if (jumped)
+    {
+        m_nValidX = newX;
+        m_nValidY = newY;
+        m_bValid  = true;
+        RedrawRect({ newX, newY, newX + m_nRingWidth, newY + m_nRingHeight });
+        return;
+    }
+
+    //~ columns that entered the window, over the new rows
+    if (newX > m_nValidX)      RedrawRect({ m_nValidX + m_nRingWidth, newY, newX + m_nRingWidth, newY + m_nRingHeight });
+    else if (newX < m_nValidX) RedrawRect({ newX,                     newY, m_nValidX,           newY + m_nRingHeight });
+
+    //~ rows that entered the window, the columns above are already fresh
+    const int keepX0 = std::max(newX, m_nValidX);
+    const int keepX1 = std::min(newX, m_nValidX) + m_nRingWidth;
+    if (keepX0 < keepX1)
+    {
+        if (newY > m_nValidY)      RedrawRect({ keepX0, m_nValidY + m_nRingHeight, keepX1, newY + m_nRingHeight });
+        else if (newY < m_nValidY) RedrawRect({ keepX0, newY,                      keepX1, m_nValidY            });
+    }
+
+    m_nValidX = newX;
+    m_nValidY = newY;
+}
+
+_Use_decl_annotations_
+void PELayerCache::RedrawRect(const PFE_SPAN_CLIP& layerRect)
+{
+    if (layerRect.minX >= layerRect.maxX || layerRect.minY >= layerRect.maxY) return;
+
+    m_nRedrawnPixels += static_cast<size_t>(layerRect.maxX - layerRect.minX) *
+                        static_cast<size_t>(layerRect.maxY - layerRect.minY);
+
+    //~ split where the ring wraps, every piece is a plain translation
+    for (int y = layerRect.minY; y < layerRect.maxY;)
+    {
+        const int ringY = WrapIndex(y, m_nRingHeight);
+        const int yEnd  = std::min(layerRect.maxY, y + (m_nRingHeight - ringY));
+
+        for (int x = layerRect.minX; x < layerRect.maxX;)
+        {
+            const int ringX = WrapIndex(x, m_nRingWidth);
+            const int xEnd  = std::min(layerRect.maxX, x + (m_nRingWidth - ringX));
+
+            const PFE_SPAN_CLIP ringRect{ ringX, ringY, ringX + (xEnd - x), ringY + (yEnd - y) };
+
+            m_pRing->ClearImageRect(
+                static_cast<size_t>(ringRect.minX), static_cast<size_t>(ringRect.minY),
+                static_cast<size_t>(ringRect.maxX), static_cast<size_t>(ringRect.maxY),
+                m_clearColor);
+
+            DrawQuads(ringRect, ringX - x, ringY - y);
+            x = xEnd;
+        }
+        y = yEnd;
+    }
+}
+
+_Use_decl_annotations_
+void PELayerCache::DrawQuads(const PFE_SPAN_CLIP& ringRect, int offsetX, int offsetY)
+{
+    const float layerMinX = static_cast<float>(ringRect.minX - offsetX);
+    const float layerMinY = static_cast<float>(ringRect.minY - offsetY);
+    const float layerMaxX = static_cast<float>(ringRect.maxX - offsetX);
+    const float layerMaxY = static_cast<float>(ringRect.maxY - offsetY);
+
+    for (size_t k = 0; k < m_quads.size(); ++k)
+    {
+        const PFE_AABB2D& box = m_bounds[k];
+        if (box.maxX < layerMinX || box.minX >= layerMaxX ||
+            box.maxY < layerMinY || box.minY >= layerMaxY) continue;
+
+        const PFE_LAYER_QUAD& q = m_quads[k];
+        if (!q.sampledTexture || m_spans[k].totalColumns == 0) continue;
+
+        const PFE_SPAN_QUAD span = TranslateSpan(m_spans[k], offsetX, offsetY);
+        if (q.opaque) PESpanRasterizer::DrawTextureOpaque(*m_pRing, span, *q.sampledTexture, ringRect);
+        else          PESpanRasterizer::DrawTexture      (*m_pRing, span, *q.sampledTexture, ringRect);
+    }
+}
+
+_Use_decl_annotations_
+PFE_SPAN_QUAD PELayerCache::TranslateSpan(const PFE_SPAN_QUAD& quad, int offsetX, int offsetY) noexcept
+{
+    PFE_SPAN_QUAD out = quad;
+    out.u0   -= quad.dudx * offsetX + quad.dudy * offsetY;
+    out.v0   -= quad.dvdx * offsetX + quad.dvdy * offsetY;
+    out.minY += offsetY;
+    out.maxY += offsetY;
+    return out;
+}
+
+_Use_decl_annotations_
+int PELayerCache::WrapIndex(int value, int size) noexcept
+{
+    const int r = value % size;
+    return r < 0 ? r + size : r;
+}
@@ -0,0 +1,128 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/core/types.h"
+#include "pixel_engine/render_manager/api/buffer/image.h"
+#include "pixel_engine/render_manager/api/raster/span/span_rasterizer.h"
+#include "pixel_engine/render_manager/components/texture/resource/texture.h"
+
+#include "core/vector.h"
+#include "fox_math/vector.h"
+
+#include <memory>
+
+namespace pixel_engine
+{
+	typedef struct _PFE_LAYER_CACHE_DESC
+	{
+		_In_ UINT		  ViewWidth	{ 0u };
+		_In_ UINT		  ViewHeight{ 0u };
+		_In_ int		  Margin	{ 128 }; // layer pixels kept around the view on every side
+		_In_ EPixelFormat Format	{ EPixelFormat::R8G8B8A8 };
+		_In_ PFE_FORMAT_R8G8B8_UINT ClearColor{ 0u, 0u, 0u };
+	} PFE_LAYER_CACHE_DESC;
+
+	//~ one static quad in layer pixels, layer = screen space at SetQuads time
+	typedef struct _PFE_LAYER_QUAD
+	{
+		_In_ FVector2D		startBase {};
+		_In_ FVector2D		deltaAxisU{};
+		_In_ FVector2D		deltaAxisV{};
+		_In_ int			totalColumns{ 0 };
+		_In_ int			totalRows	{ 0 };
+		_In_ const Texture* sampledTexture{ nullptr };
+		_In_ bool			opaque{ false }; // backgrounds write every texel, the rest is colour keyed
+	} PFE_LAYER_QUAD;
+
+	/// <summary>
+	/// Pre-rendered static layer kept in a wrap around (ring) buffer a
+	/// margin larger than the view. Scrolling only redraws the strips that
+	/// come into the kept window, compositing is a row copy per target row.
+	/// Scroll is in whole pixels, the layer snaps to the nearest pixel.
+	/// </summary>
+	class PFE_API PELayerCache
+	{
+	public:
+		PELayerCache() = default;
+
+		void Init(_In_ const PFE_LAYER_CACHE_DESC& desc);
+
+		//~ replaces the cached quads, the whole window is redrawn on next use
+		void SetQuads(_In_ const fox::vector<PFE_LAYER_QUAD>& quads);
+
+		void Invalidate() noexcept { m_bValid = false; }
+
+		_NODISCARD _Check_return_
+		bool Empty() const noexcept { return m_quads.empty(); }
+
+		void SetClearColor(_In_ const PFE_FORMAT_R8G8B8_UINT& color) noexcept;
+
+		//~ copies the layer onto target rects, screen = layer + scroll
+		void Composite(
+			_Inout_ PEImageBuffer&				 target,
+			_In_	int							 scrollX,
+			_In_	int							 scrollY,
+			_In_	const PFE_SPAN_CLIP*		 rects,
+			_In_	size_t						 rectCount);
+
+		//~ layer pixels redrawn by the last Composite, zero when it only copied
+		_NODISCARD _Check_return_
+		size_t GetRedrawnPixels() const noexcept { return m_nRedrawnPixels; }
+
+	private:
+		//~ moves the kept window so it holds the view, redraws what came in
+		void Scroll(_In_ int viewX, _In_ int viewY);
+
+		//~ clears and redraws a layer rect no larger than the ring
+		void RedrawRect(_In_ const PFE_SPAN_CLIP& layerRect);
+
+		//~ ring space rect that does not wrap, offset maps layer -> ring
+		void DrawQuads(
+			_In_ const PFE_SPAN_CLIP& ringRect,
+			_In_ int				  offsetX,
+			_In_ int				  offsetY);
+
+		_NODISCARD _Check_return_
+		static int WrapIndex(_In_ int value, _In_ int size) noexcept;
+
+		//~ same quad moved by whole pixels, exact in fixed point so strips
+		//~ drawn at different ring offsets meet without seams
+		_NODISCARD _Check_return_
+		static PFE_SPAN_QUAD TranslateSpan(
+			_In_ const PFE_SPAN_QUAD& quad,
+			_In_ int				  offsetX,
+			_In_ int				  offsetY) noexcept;
+
+	private:
+		std::unique_ptr<PEImageBuffer> m_pRing{ nullptr };
+		int m_nRingWidth { 0 };
+		int m_nRingHeight{ 0 };
+		int m_nViewWidth { 0 };
+		int m_nViewHeight{ 0 };
+		int m_nMargin	 { 128 };
+
+		PFE_FORMAT_R8G8B8_UINT m_clearColor{ 0u, 0u, 0u };
+
+		//~ layer rect [x, x + ring width) x [y, y + ring height) held by the ring
+		bool m_bValid { false };
+		int	 m_nValidX{ 0 };
+		int	 m_nValidY{ 0 };
+
+		fox::vector<PFE_LAYER_QUAD> m_quads {};
+		fox::vector<PFE_SPAN_QUAD>	m_spans {}; // layer space, totalColumns 0 if degenerate
+		fox::vector<PFE_AABB2D>		m_bounds{};
+		size_t						m_nRedrawnPixels{ 0u };
+	};
+} // namespace pixel_engine
@@ -11,11 +11,11 @@
 
 #include "pch.h"
 #include "raster.h"
+#include "task/work_stealing_scheduler.h"
 
 #include <algorithm>
 #include <cmath>
 #include <limits>
-#include <d3d11.h>
 
 #include "pixel_engine/utilities/logger/logger.h"
 
@@ -24,13 +24,16 @@ using namespace pixel_engine;
 _Use_decl_annotations_
 PERaster2D::PERaster2D(const PFE_RASTER_CONSTRUCT_DESC* desc)
 {
-    m_descViewport = desc->Viewport;
-    m_bBoundCheck  = desc->EnableBoundCheck;
+    m_descViewport  = desc->Viewport;
+    m_bBoundCheck   = desc->EnableBoundCheck;
+    m_eTargetFormat = desc->TargetFormat;
+    m_clearColor    = desc->ClearColor;
     CreateRenderTarget(m_descViewport);
 }
 
 pixel_engine::PERaster2D::~PERaster2D()
 {
+    FlushBackground();
     if (m_pImageBuffer)
     { 
         m_pImageBuffer.reset();
@@ -41,13 +44,36 @@ pixel_engine::PERaster2D::~PERaster2D()
 _Use_decl_annotations_
 bool PERaster2D::Init(const PFE_RASTER_INIT_DESC* desc)
 {
-    m_pScheduler = std::make_unique<RasterizeScheduler>();
+    FlushBackground();
+
+    if (desc->Scheduler == ERasterScheduler::WorkStealing)
+        m_pScheduler = std::make_unique<PEWorkStealingScheduler>();
+    else
+        m_pScheduler = std::make_unique<RasterizeScheduler>();
     m_pScheduler->Initialize(desc->WorkerCount);
+
+    m_bTileBinning = desc->EnableTileBinning;
+    m_nBinTileSize = desc->BinTileSize;
+    m_eQuadKernel  = desc->QuadKernel;
+
+    m_bDamageTracking  = desc->EnableDamageTracking;
+    m_fDamageThreshold = std::clamp(desc->DamageThreshold, 0.0f, 1.0f);
+
+    m_pTileBinner = std::make_unique<PETileBinner>();
+    m_pTileBinner->Init(
+        m_pImageBuffer ? m_pImageBuffer->Width () : 0u,
+        m_pImageBuffer ? m_pImageBuffer->Height() : 0u,
+        m_nBinTileSize);
+
+    m_bLayerCache       = desc->EnableLayerCache;
+    m_nLayerCacheMargin = std::max(0, desc->LayerCacheMargin);
+    CreateLayerCache();
     return true;
 }
 
 void PERaster2D::Release()
 {
+    FlushBackground();
     if (m_pImageBuffer)
     {
         m_pImageBuffer.reset();
@@ -68,11 +94,58 @@ void PERaster2D::PutPixel(int y, int x, const PFE_FORMAT_R8G8B8_UINT& color)
 {
     if (!m_pImageBuffer) return;
     if (m_bBoundCheck && !IsBounded(x, y)) return;
+    FlushBackground();
     m_pImageBuffer->WriteAt(y, x, color);
 }
 
 _Use_decl_annotations_
 void pixel_engine::PERaster2D::DrawQuadColor(const PFE_RASTER_DRAW_CMD& cmd)
+{
+    if (!m_pImageBuffer) return;
+    FlushBackground();
+
+    if (m_eQuadKernel == ERasterKernel::ForwardMapped)
+    {
+        DrawQuadColorForward(cmd);
+        return;
+    }
+
+    PFE_SPAN_QUAD quad{};
+    if (!PESpanRasterizer::Setup(
+        cmd.startBase, cmd.deltaAxisU, cmd.deltaAxisV,
+        cmd.totalColumns, cmd.totalRows, quad)) return;
+
+    PESpanRasterizer::DrawColor(*m_pImageBuffer, quad, cmd.color, ViewportClip());
+}
+
+_Use_decl_annotations_
+void pixel_engine::PERaster2D::DrawQuadTile(const PFE_RASTER_DRAW_CMD& cmd)
+{
+    if (!m_pImageBuffer || !cmd.sampledTexture) return;
+    FlushBackground();
+
+    const bool blended = IsBlended(cmd);
+    if (m_eQuadKernel == ERasterKernel::ForwardMapped && !blended)
+    {
+        DrawQuadTileForward(cmd);
+        return;
+    }
+
+    PFE_SPAN_QUAD quad{};
+    if (!PESpanRasterizer::Setup(
+        cmd.startBase, cmd.deltaAxisU, cmd.deltaAxisV,
+        cmd.totalColumns, cmd.totalRows, quad)) return;
+
+    if (blended)
+    {
+        PESpanRasterizer::DrawTextureBlended(*m_pImageBuffer, quad, *cmd.sampledTexture, cmd.opacity, ViewportClip());
+        return;
+    }
+    PESpanRasterizer::DrawTexture(*m_pImageBuffer, quad, *cmd.sampledTexture, ViewportClip());
+}
+
+_Use_decl_annotations_
+void pixel_engine::PERaster2D::DrawQuadColorForward(const PFE_RASTER_DRAW_CMD& cmd)
 {
     auto startFrom = cmd.startBase;
     for (int j = 0; j < cmd.totalRows; ++j)
@@ -96,7 +169,7 @@ void pixel_engine::PERaster2D::DrawQuadColor(const PFE_RASTER_DRAW_CMD& cmd)
 }
 
 _Use_decl_annotations_
-void pixel_engine::PERaster2D::DrawQuadTile(const PFE_RASTER_DRAW_CMD& cmd)
+void pixel_engine::PERaster2D::DrawQuadTileForward(const PFE_RASTER_DRAW_CMD& cmd)
 {
     auto startFrom = cmd.startBase;
     for (int j = 0; j < cmd.totalRows; ++j)
@@ -130,6 +203,118 @@ void pixel_engine::PERaster2D::DrawQuadBackground(const PFE_RASTER_DRAW_CMD& cmd
 {
     if (!m_pScheduler || !m_pImageBuffer || !cmd.sampledTexture) return;
 
+    //~ queued backgrounds run together, one that overlaps a queued one
+    //~ waits for them so the later quad still lands on top
+    const PFE_AABB2D bounds = QuadBounds(cmd);
+    for (const PFE_AABB2D& queued : m_pendingBackground)
+    {
+        if (bounds.minX < queued.maxX && queued.minX < bounds.maxX &&
+            bounds.minY < queued.maxY && queued.minY < bounds.maxY)
+        {
+            FlushBackground();
+            break;
+        }
+    }
+    m_pendingBackground.push_back(bounds);
+
+    if (m_bFullRedraw)
+    {
+        EnqueueQuadRows(cmd, ViewportClip());
+    }
+    else
+    {
+        const FVector2D& u = cmd.deltaAxisU;
+        const FVector2D& v = cmd.deltaAxisV;
+
+        const float det = u.x * v.y - u.y * v.x;
+        if (std::abs(det) < 1e-8f) return;
+
+        const float inv = 1.0f / det;
+        const float m00 =  v.y * inv, m01 = -v.x * inv;
+        const float m10 = -u.y * inv, m11 =  u.x * inv;
+
+        //~ only the texels that can round into a damaged rect, same slack as the tile bins
+        for (const PFE_SPAN_CLIP& rect : m_damageRects)
+        {
+            const float rx[2] = { static_cast<float>(rect.minX) - 1.0f - cmd.startBase.x, static_cast<float>(rect.maxX) + 1.0f - cmd.startBase.x };
+            const float ry[2] = { static_cast<float>(rect.minY) - 1.0f - cmd.startBase.y, static_cast<float>(rect.maxY) + 1.0f - cmd.startBase.y };
+
+            float iMin =  std::numeric_limits<float>::max(), jMin =  std::numeric_limits<float>::max();
+            float iMax = -std::numeric_limits<float>::max(), jMax = -std::numeric_limits<float>::max();
+            for (const float dx : rx)
+            {
+                for (const float dy : ry)
+                {
+                    const float i = m00 * dx + m01 * dy;
+                    const float j = m10 * dx + m11 * dy;
+                    iMin = std::min(iMin, i); iMax = std::max(iMax, i);
+                    jMin = std::min(jMin, j); jMax = std::max(jMax, j);
+                }
+            }
+
+            const int i0 = std::max(cmd.columnStartFrom, static_cast<int>(std::floor(iMin)));
+            const int i1 = std::min(cmd.columneEndAt,    static_cast<int>(std::ceil (iMax)) + 1);
+            const int j0 = std::max(cmd.rowStartFrom,    static_cast<int>(std::floor(jMin)));
+            const int j1 = std::min(cmd.rowEndAt,        static_cast<int>(std::ceil (jMax)) + 1);
+            if (i0 >= i1 || j0 >= j1) continue;
+
+            PFE_RASTER_DRAW_CMD part
+            {
+                .startBase       = cmd.startBase,
+                .deltaAxisU      = cmd.deltaAxisU,
+                .deltaAxisV      = cmd.deltaAxisV,
+                .columnStartFrom = i0,
+                .columneEndAt    = i1,
+                .rowStartFrom    = j0,
+                .rowEndAt        = j1,
+                .totalColumns    = cmd.totalColumns,
+                .totalRows       = cmd.totalRows,
+                .sampledTexture  = cmd.sampledTexture,
+                .color           = cmd.color,
+                .blendMode       = cmd.blendMode,
+                .opacity         = cmd.opacity,
+            };
+            EnqueueQuadRows(part, rect);
+        }
+    }
+}
+
+void PERaster2D::FlushBackground()
+{
+    if (m_pendingBackground.empty()) return;
+
+    m_pScheduler->Dispatch();
+    m_pScheduler->Wait    ();
+    m_pendingBackground.clear();
+}
+
+_Use_decl_annotations_
+PFE_AABB2D PERaster2D::QuadBounds(const PFE_RASTER_DRAW_CMD& cmd) noexcept
+{
+    const FVector2D& s = cmd.startBase;
+    const FVector2D& u = cmd.deltaAxisU;
+    const FVector2D& v = cmd.deltaAxisV;
+    const float		 w = static_cast<float>(cmd.totalColumns);
+    const float		 h = static_cast<float>(cmd.totalRows);
+
+    const float xs[4] = { s.x, s.x + u.x * w, s.x + v.x * h, s.x + u.x * w + v.x * h };
+    const float ys[4] = { s.y, s.y + u.y * w, s.y + v.y * h, s.y + u.y * w + v.y * h };
+
+    //~ texels round half a texel past the lattice, one more pixel of slack
+    const float padX = 0.5f * (std::abs(u.x) + std::abs(v.x)) + 1.0f;
+    const float padY = 0.5f * (std::abs(u.y) + std::abs(v.y)) + 1.0f;
+
+    PFE_AABB2D box{};
+    box.minX = *std::min_element(xs, xs + 4) - padX;
+    box.maxX = *std::max_element(xs, xs + 4) + padX;
+    box.minY = *std::min_element(ys, ys + 4) - padY;
+    box.maxY = *std::max_element(ys, ys + 4) + padY;
+    return box;
+}
+
+_Use_decl_annotations_
+void pixel_engine::PERaster2D::EnqueueQuadRows(const PFE_RASTER_DRAW_CMD& cmd, const PFE_SPAN_CLIP& clip)
+{
     pixel_engine::RASTERIZE_TASK_DESC proto{};
     proto.target          = m_pImageBuffer.get();
     proto.sampledTexture  = cmd.sampledTexture;
@@ -142,6 +327,7 @@ void pixel_engine::PERaster2D::DrawQuadBackground(const PFE_RASTER_DRAW_CMD& cmd
     proto.totalRows       = cmd.totalColumns;
     proto.TexWidth        = cmd.sampledTexture->GetWidth();
     proto.TexHeight       = cmd.sampledTexture->GetHeight();
+    proto.clip            = clip;
 
     proto.startBase =
     {
@@ -176,9 +362,68 @@ void pixel_engine::PERaster2D::DrawQuadBackground(const PFE_RASTER_DRAW_CMD& cmd
 
         m_pScheduler->Enqueue(pixel_engine::PERasterizeTask{ desc });
     }
+}
+
+void PERaster2D::BeginTileBinning()
+{
+    if (m_pTileBinner) m_pTileBinner->Reset();
+}
+
+_Use_decl_annotations_
+void PERaster2D::SubmitQuadTile(const PFE_RASTER_DRAW_CMD& cmd)
+{
+    if (!m_bTileBinning || !m_pScheduler || !m_pTileBinner || !cmd.sampledTexture)
+    {
+        DrawQuadTile(cmd);
+        return;
+    }
+
+    PFE_RASTER_BIN_CMD binCmd{};
+    binCmd.startBase      = cmd.startBase;
+    binCmd.deltaAxisU     = cmd.deltaAxisU;
+    binCmd.deltaAxisV     = cmd.deltaAxisV;
+    binCmd.totalColumns   = cmd.totalColumns;
+    binCmd.totalRows      = cmd.totalRows;
+    binCmd.sampledTexture = cmd.sampledTexture;
+    binCmd.kernel         = m_eQuadKernel;
+
+    //~ the forward kernel has no blending, blended quads use the span kernel
+    if (IsBlended(cmd))
+    {
+        binCmd.kernel    = ERasterKernel::InverseSpan;
+        binCmd.blendMode = EBlendMode::PremultipliedAlpha;
+        binCmd.opacity   = cmd.opacity;
+    }
+
+    (void)m_pTileBinner->Submit(binCmd);
+}
+
+void PERaster2D::FlushTileBins()
+{
+    if (!m_pScheduler || !m_pTileBinner || !m_pImageBuffer) return;
+
+    //~ binned sprites draw over the backgrounds queued before them
+    FlushBackground();
+    if (m_pTileBinner->Empty()) return;
+
+    const auto& bins = m_pTileBinner->GetBins();
+    for (size_t k = 0; k < bins.size(); ++k)
+    {
+        if (bins[k].commands.empty()) continue;
+
+        RASTERIZE_TASK_DESC desc{};
+        desc.kind     = ERasterTaskKind::TileBin;
+        desc.target   = m_pImageBuffer.get();
+        desc.binner   = m_pTileBinner.get();
+        desc.binIndex = static_cast<int>(k);
+
+        m_pScheduler->Enqueue(PERasterizeTask{ desc });
+    }
 
     m_pScheduler->Dispatch();
     m_pScheduler->Wait    ();
+
+    m_pTileBinner->Reset();
 }
 
 _Use_decl_annotations_
@@ -193,29 +438,234 @@ bool PERaster2D::IsBounded(int x, int y) const noexcept
             (static_cast<unsigned>(y) < static_cast<unsigned>(H));
 }
 
+PFE_SPAN_CLIP PERaster2D::ViewportClip() const noexcept
+{
+    PFE_SPAN_CLIP clip{};
+    clip.maxX = static_cast<int>(m_pImageBuffer ? m_pImageBuffer->Width () : 0u);
+    clip.maxY = static_cast<int>(m_pImageBuffer ? m_pImageBuffer->Height() : 0u);
+
+    if (m_bBoundCheck)
+    {
+        clip.maxX = std::min(clip.maxX, static_cast<int>(m_descViewport.w));
+        clip.maxY = std::min(clip.maxY, static_cast<int>(m_descViewport.h));
+    }
+    return clip;
+}
+
+_Use_decl_annotations_
+bool PERaster2D::IsBlended(const PFE_RASTER_DRAW_CMD& cmd) noexcept
+{
+    return cmd.blendMode == EBlendMode::PremultipliedAlpha &&
+           cmd.sampledTexture                              &&
+           cmd.sampledTexture->HasPremultiplied();
+}
+
 _Use_decl_annotations_
 void PERaster2D::Clear(const PFE_FORMAT_R8G8B8_UINT& color)
 {
-    if (m_pImageBuffer) m_pImageBuffer->ClearImageBuffer(color);
+    if (!m_pImageBuffer) return;
+    FlushBackground();
+
+    m_pImageBuffer->ClearImageBuffer(color);
+    MarkUploadRows(0, static_cast<int>(m_pImageBuffer->Height()));
+}
+
+_Use_decl_annotations_
+void PERaster2D::BeginDamage(bool fullRedraw) noexcept
+{
+    m_damageRects.clear();
+    m_bFullRedraw = fullRedraw        ||
+                    m_bTargetFresh    ||
+                    !m_bDamageTracking ||
+                    !m_bTileBinning   ||
+                    !m_pTileBinner;
+
+    if (m_pTileBinner) m_pTileBinner->ResetDamage(m_bFullRedraw);
+}
+
+_Use_decl_annotations_
+void PERaster2D::AddDamage(const PFE_AABB2D& rect) noexcept
+{
+    if (m_bFullRedraw || !m_pTileBinner) return;
+    m_pTileBinner->MarkDamage(rect);
+}
+
+void PERaster2D::EndDamage()
+{
+    if (!m_pImageBuffer) return;
+
+    if (!m_bFullRedraw)
+    {
+        //~ past the threshold one full pass is cheaper than many small rects
+        const size_t tiles = m_pTileBinner->GetBins().size();
+        if (tiles == 0u ||
+            static_cast<float>(m_pTileBinner->GetDamagedCount()) > m_fDamageThreshold * static_cast<float>(tiles))
+        {
+            m_bFullRedraw = true;
+            m_pTileBinner->ResetDamage(true);
+        }
+    }
+
+    if (m_bFullRedraw)
+    {
+        m_bTargetFresh = false;
+        MarkUploadRows(0, static_cast<int>(m_pImageBuffer->Height()));
+        return;
+    }
+
+    BuildDamageRects();
+    for (const PFE_SPAN_CLIP& rect : m_damageRects)
+    {
+        MarkUploadRows(rect.minY, rect.maxY);
+    }
+}
+
+void PERaster2D::ClearDamage()
+{
+    if (!m_pImageBuffer) return;
+    FlushBackground();
+
+    if (m_bFullRedraw)
+    {
+        m_pImageBuffer->ClearImageBuffer(m_clearColor);
+        return;
+    }
+
+    for (const PFE_SPAN_CLIP& rect : m_damageRects)
+    {
+        m_pImageBuffer->ClearImageRect(
+            static_cast<size_t>(rect.minX), static_cast<size_t>(rect.minY),
+            static_cast<size_t>(rect.maxX), static_cast<size_t>(rect.maxY),
+            m_clearColor);
+    }
+}
+
+_Use_decl_annotations_
+void PERaster2D::CompositeLayerCache(int scrollX, int scrollY)
+{
+    if (!m_pImageBuffer || !m_pLayerCache) return;
+    FlushBackground();
+
+    if (m_bFullRedraw)
+    {
+        const PFE_SPAN_CLIP full = ViewportClip();
+        m_pLayerCache->Composite(*m_pImageBuffer, scrollX, scrollY, &full, 1u);
+        return;
+    }
+
+    m_pLayerCache->Composite(
+        *m_pImageBuffer, scrollX, scrollY,
+        m_damageRects.data(), m_damageRects.size());
+}
+
+_Use_decl_annotations_
+void PERaster2D::SetClearColor(const PFE_FORMAT_R8G8B8_UINT& color) noexcept
+{
+    m_clearColor = color;
+    if (m_pLayerCache) m_pLayerCache->SetClearColor(color);
+}
+
+void PERaster2D::BuildDamageRects()
+{
+    m_damageRects.clear();
+
+    //~ runs of damaged tiles per tile row, stacked onto the run above when
+    //~ both cover the same columns
+    const auto& bins = m_pTileBinner->GetBins();
+    for (size_t k = 0; k < bins.size();)
+    {
+        if (!m_pTileBinner->IsDamaged(k)) { ++k; continue; }
+
+        PFE_SPAN_CLIP run{ bins[k].minX, bins[k].minY, bins[k].maxX, bins[k].maxY };
+        for (++k; k < bins.size() && bins[k].minY == run.minY && m_pTileBinner->IsDamaged(k); ++k)
+        {
+            run.maxX = bins[k].maxX;
+        }
+
+        bool stacked = false;
+        for (PFE_SPAN_CLIP& rect : m_damageRects)
+        {
+            if (rect.maxY == run.minY && rect.minX == run.minX && rect.maxX == run.maxX)
+            {
+                rect.maxY = run.maxY;
+                stacked   = true;
+                break;
+            }
+        }
+        if (!stacked) m_damageRects.push_back(run);
+    }
+}
+
+_Use_decl_annotations_
+void PERaster2D::MarkUploadRows(int minY, int maxY) noexcept
+{
+    if (minY >= maxY) return;
+    if (m_nUploadMinY >= m_nUploadMaxY)
+    {
+        m_nUploadMinY = minY;
+        m_nUploadMaxY = maxY;
+        return;
+    }
+    m_nUploadMinY = std::min(m_nUploadMinY, minY);
+    m_nUploadMaxY = std::max(m_nUploadMaxY, maxY);
 }
 
 _Use_decl_annotations_
-void PERaster2D::Present(ID3D11DeviceContext* context, ID3D11Buffer* cpuBuffer)
+void PERaster2D::Present(IPresentTarget* target)
 {
-    context->UpdateSubresource(
-        cpuBuffer, 0, nullptr,
-        m_pImageBuffer->Data(),
-        (UINT)m_pImageBuffer->RowPitch(), 0);
+    if (!m_pImageBuffer || !target) return;
+    FlushBackground();
+
+    const int height = static_cast<int>(m_pImageBuffer->Height());
+    const int minY   = m_bDamageTracking ? std::max(0, m_nUploadMinY)      : 0;
+    const int maxY   = m_bDamageTracking ? std::min(height, m_nUploadMaxY) : height;
+
+    m_nUploadMinY = 0;
+    m_nUploadMaxY = 0;
+
+    //~ nothing changed, the target still holds the last upload
+    if (minY >= maxY) return;
+
+    target->Present(*m_pImageBuffer, minY, maxY);
 }
 
 _Use_decl_annotations_
 void PERaster2D::CreateRenderTarget(const PFE_VIEWPORT& rect)
 {
+    FlushBackground();
     if (m_pImageBuffer) m_pImageBuffer.reset();
 
     PE_IMAGE_BUFFER_DESC imageDesc{};
     imageDesc.Height = rect.h - rect.y;
     imageDesc.Width  = rect.w - rect.x;
+    imageDesc.Format = m_eTargetFormat;
 
     m_pImageBuffer = std::make_unique<PEImageBuffer>(imageDesc);
+    m_bTargetFresh = true;
+    MarkUploadRows(0, static_cast<int>(imageDesc.Height));
+
+    if (m_pTileBinner)
+        m_pTileBinner->Init(imageDesc.Width, imageDesc.Height, m_nBinTileSize);
+
+    CreateLayerCache();
+}
+
+void PERaster2D::CreateLayerCache()
+{
+    if (!m_bLayerCache || !m_pImageBuffer)
+    {
+        m_pLayerCache.reset();
+        return;
+    }
+
+    PFE_LAYER_CACHE_DESC cacheDesc{};
+    cacheDesc.ViewWidth  = m_pImageBuffer->Width ();
+    cacheDesc.ViewHeight = m_pImageBuffer->Height();
+    cacheDesc.Margin     = m_nLayerCacheMargin;
+    cacheDesc.Format     = m_eTargetFormat;
+    cacheDesc.ClearColor = m_clearColor;
+
+    //~ the quads survive a resize, the ring is redrawn on next use
+    if (!m_pLayerCache) m_pLayerCache = std::make_unique<PELayerCache>();
+    m_pLayerCache->Init(cacheDesc);
 }
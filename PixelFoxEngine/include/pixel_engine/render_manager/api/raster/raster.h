@@ -23,8 +23,10 @@
 #include "fox_math/vector.h"
 
 #include "task/raster_scheduler.h"
-
-#include <d3d11.h>
+#include "bin/tile_binner.h"
+#include "span/span_rasterizer.h"
+#include "cache/layer_cache.h"
+#include "pixel_engine/render_manager/api/present/present_target.h"
 
 namespace pixel_engine
 {
@@ -32,11 +34,25 @@ namespace pixel_engine
     {
         _In_ PFE_VIEWPORT Viewport        {};
         _In_ bool         EnableBoundCheck{ true };
+        _In_ EPixelFormat TargetFormat    { EPixelFormat::R8G8B8A8 }; // R8G8B8 kept for comparison
+        _In_ PFE_FORMAT_R8G8B8_UINT ClearColor{ 0u, 0u, 0u };     // used by ClearDamage
     } PFE_RASTER_CONSTRUCT_DESC;
 
     typedef struct _PFE_RASTER_INIT_DESC
     {
-        _In_ unsigned WorkerCount{ 4u };
+        _In_ unsigned WorkerCount	   { 4u };
+        _In_ bool     EnableTileBinning{ true };
+        _In_ int      BinTileSize	   { 64 };
+        _In_ ERasterKernel QuadKernel  { ERasterKernel::InverseSpan };
+        _In_ ERasterScheduler Scheduler{ ERasterScheduler::WorkStealing }; // SharedQueue kept for comparison
+
+        //~ redraw only the tiles marked damaged, needs tile binning
+        _In_ bool  EnableDamageTracking{ true };
+        _In_ float DamageThreshold     { 0.5f }; // damaged tile share that falls back to a full redraw
+
+        //~ static background layer pre-rendered once and reused while scrolling
+        _In_ bool EnableLayerCache{ true };
+        _In_ int  LayerCacheMargin{ 128 }; // pixels kept around the view on every side
     } PFE_RASTER_INIT_DESC;
 
     typedef struct _PFE_RASTER_DRAW_CMD
@@ -54,6 +70,10 @@ namespace pixel_engine
 
         //~ rare case if sampled texture is failed
         _In_ const PFE_FORMAT_R8G8B8_UINT& color;
+
+        //~ alpha blended quads always take the span kernel
+        _In_ EBlendMode blendMode{ EBlendMode::ColorKey };
+        _In_ uint8_t    opacity  { 255u };
     } PFE_RASTER_DRAW_CMD;
 
     class PFE_API PERaster2D
@@ -81,6 +101,9 @@ namespace pixel_engine
         _NODISCARD _Check_return_
         PFE_VIEWPORT GetViewport() const noexcept { return m_descViewport; }
 
+        _NODISCARD _Check_return_
+        EPixelFormat GetTargetFormat() const noexcept { return m_eTargetFormat; }
+
         void Clear(_In_ const PFE_FORMAT_R8G8B8_UINT& color);
 
         void PutPixel(
@@ -90,11 +113,71 @@ namespace pixel_engine
 
         void DrawQuadColor     (_In_ const PFE_RASTER_DRAW_CMD& cmd);
         void DrawQuadTile      (_In_ const PFE_RASTER_DRAW_CMD& cmd);
+
+        //~ queued, drawn together by the next FlushTileBins, Present or other write
         void DrawQuadBackground(_In_ const PFE_RASTER_DRAW_CMD& cmd);
 
-        void Present(
-            _In_ ID3D11DeviceContext* context,
-            _In_ ID3D11Buffer* cpuBuffer);
+        //~ tile binned sprite drawing, falls back to DrawQuadTile when disabled
+        void BeginTileBinning();
+        void SubmitQuadTile  (_In_ const PFE_RASTER_DRAW_CMD& cmd);
+        void FlushTileBins   ();
+
+        void SetTileBinning(_In_ bool enabled) noexcept { m_bTileBinning = enabled; }
+
+        _NODISCARD _Check_return_
+        bool GetTileBinning() const noexcept { return m_bTileBinning; }
+
+        //~ selects how DrawQuadTile / DrawQuadColor map texels onto the screen
+        void SetQuadKernel(_In_ ERasterKernel kernel) noexcept { m_eQuadKernel = kernel; }
+
+        _NODISCARD _Check_return_
+        ERasterKernel GetQuadKernel() const noexcept { return m_eQuadKernel; }
+
+        //~ damage tracking, the caller marks what changed since the last frame
+        //~ then ClearDamage, FlushTileBins, DrawQuadBackground and Present
+        //~ only touch the damaged tiles until the next BeginDamage
+        void BeginDamage(_In_ bool fullRedraw) noexcept;
+        void AddDamage  (_In_ const PFE_AABB2D& rect) noexcept;
+        void EndDamage  ();
+
+        void ClearDamage();
+
+        //~ same as ClearDamage but fills the damage from the static layer,
+        //~ screen = layer + scroll, sprites in the layer are not drawn again
+        void CompositeLayerCache(
+            _In_ int scrollX,
+            _In_ int scrollY);
+
+        //~ the raster worker pool, the frame graph runs its worker stages on it
+        _NODISCARD _Check_return_
+        IRasterScheduler* GetScheduler() const noexcept { return m_pScheduler.get(); }
+
+        //~ nullptr when the layer cache is disabled
+        _NODISCARD _Check_return_
+        PELayerCache* GetLayerCache() const noexcept { return m_pLayerCache.get(); }
+
+        _NODISCARD _Check_return_
+        bool IsFullRedraw() const noexcept { return m_bFullRedraw; }
+
+        _NODISCARD _Check_return_
+        bool HasDamage() const noexcept { return m_bFullRedraw || !m_damageRects.empty(); }
+
+        //~ tile aligned rects, empty on a full redraw
+        _NODISCARD _Check_return_
+        const fox::vector<PFE_SPAN_CLIP>& GetDamageRects() const noexcept { return m_damageRects; }
+
+        void SetDamageTracking(_In_ bool enabled) noexcept { m_bDamageTracking = enabled; }
+
+        _NODISCARD _Check_return_
+        bool GetDamageTracking() const noexcept { return m_bDamageTracking; }
+
+        void SetClearColor(_In_ const PFE_FORMAT_R8G8B8_UINT& color) noexcept;
+
+        _NODISCARD _Check_return_
+        PFE_FORMAT_R8G8B8_UINT GetClearColor() const noexcept { return m_clearColor; }
+
+        //~ hands the rows written since the last call to the target, nothing if none were
+        void Present(_In_ IPresentTarget* target);
 
         _NODISCARD _Check_return_
         bool IsBounded(
@@ -108,12 +191,61 @@ namespace pixel_engine
 
     private:
         void CreateRenderTarget(_In_ const PFE_VIEWPORT& rect);
+        void CreateLayerCache  ();
+
+        void DrawQuadColorForward(_In_ const PFE_RASTER_DRAW_CMD& cmd);
+        void DrawQuadTileForward (_In_ const PFE_RASTER_DRAW_CMD& cmd);
+
+        //~ runs and waits for the queued background rows, every other
+        //~ write to the target calls it first
+        void FlushBackground();
+
+        _NODISCARD _Check_return_
+        static PFE_AABB2D QuadBounds(_In_ const PFE_RASTER_DRAW_CMD& cmd) noexcept;
+
+        //~ queues the background rows that can land inside clip
+        void EnqueueQuadRows(
+            _In_ const PFE_RASTER_DRAW_CMD& cmd,
+            _In_ const PFE_SPAN_CLIP&       clip);
+
+        void BuildDamageRects();
+        void MarkUploadRows(_In_ int minY, _In_ int maxY) noexcept;
+
+        _NODISCARD _Check_return_
+        PFE_SPAN_CLIP ViewportClip() const noexcept;
+
+        //~ premultiplied data is available for the requested blend
+        _NODISCARD _Check_return_
+        static bool IsBlended(_In_ const PFE_RASTER_DRAW_CMD& cmd) noexcept;
 
     private:
         std::unique_ptr<PEImageBuffer>      m_pImageBuffer{ nullptr };
-        std::unique_ptr<RasterizeScheduler> m_pScheduler  { nullptr };
+        std::unique_ptr<IRasterScheduler>   m_pScheduler  { nullptr };
+        std::unique_ptr<PETileBinner>       m_pTileBinner { nullptr };
+        std::unique_ptr<PELayerCache>       m_pLayerCache { nullptr };
 
         PFE_VIEWPORT                   m_descViewport{ 0, 0, 0, 0 };
+        EPixelFormat                   m_eTargetFormat{ EPixelFormat::R8G8B8A8 };
         bool                           m_bBoundCheck { true };
+        bool                           m_bTileBinning{ false };
+        int                            m_nBinTileSize{ 64 };
+        ERasterKernel                  m_eQuadKernel { ERasterKernel::InverseSpan };
+        fox::vector<PFE_AABB2D>        m_pendingBackground{}; // queued, not drawn yet
+
+        //~ damage tracking
+        PFE_FORMAT_R8G8B8_UINT         m_clearColor      { 0u, 0u, 0u };
+        bool                           m_bDamageTracking { false };
+        float                          m_fDamageThreshold{ 0.5f };
+        bool                           m_bFullRedraw     { true };
+        bool                           m_bTargetFresh    { true }; // new target, nothing valid to keep
+        fox::vector<PFE_SPAN_CLIP>     m_damageRects     {};
+
+        //~ static layer cache
+        bool                           m_bLayerCache     { false };
+        int                            m_nLayerCacheMargin{ 128 };
+
+        //~ rows [min, max) not uploaded yet
+        int                            m_nUploadMinY{ 0 };
+        int                            m_nUploadMaxY{ 0 };
     };
 } // namespace pixel_engine
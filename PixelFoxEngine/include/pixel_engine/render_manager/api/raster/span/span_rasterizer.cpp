@@ -0,0 +1,588 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "span_rasterizer.h"
+#include "pixel_engine/render_manager/api/raster/blit/blit_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace pixel_engine;
+
+namespace
+{
+	//~ integer division rounding towards -inf / +inf, b must be > 0
+	inline int64_t FloorDiv(int64_t a, int64_t b) noexcept
+	{
+		return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+	}
+
+	inline int64_t CeilDiv(int64_t a, int64_t b) noexcept
+	{
+		return -FloorDiv(-a, b);
+	}
+
+	inline int64_t ToFixed(double v) noexcept
+	{
+		return static_cast<int64_t>(std::llround(v * static_cast<double>(PFE_SPAN_ONE)));
+	}
+
+	//~ narrows [lo, hi] to the x where 0 <= base + x * step < limit
+	inline bool SolveAxis(
+		int64_t base, int64_t step, int64_t limit,
+		int64_t& lo,  int64_t& hi) noexcept
+	{
+		if (step == 0) return base >= 0 && base < limit;
+
+		if (step > 0)
+		{
+			lo = std::max(lo, CeilDiv (-base,			  step));
+			hi = std::min(hi, FloorDiv(limit - 1 - base, step));
+		}
+		else
+		{
+			lo = std::max(lo, CeilDiv (base - limit + 1, -step));
+			hi = std::min(hi, FloorDiv(base,			  -step));
+		}
+		return lo <= hi;
+	}
+
+	//~ per format texel fetch, picked once per draw instead of per pixel
+	template<TextureFormat F> struct TexelFetch;
+
+	template<> struct TexelFetch<TextureFormat::R8>
+	{
+		static constexpr size_t Bpp = 1u;
+		static void Load(const uint8_t* p, uint8_t& r, uint8_t& g, uint8_t& b) noexcept { r = g = b = p[0]; }
+	};
+
+	template<> struct TexelFetch<TextureFormat::RG8>
+	{
+		static constexpr size_t Bpp = 2u;
+		static void Load(const uint8_t* p, uint8_t& r, uint8_t& g, uint8_t& b) noexcept { r = p[0]; g = p[1]; b = 0u; }
+	};
+
+	template<> struct TexelFetch<TextureFormat::RGB8>
+	{
+		static constexpr size_t Bpp = 3u;
+		static void Load(const uint8_t* p, uint8_t& r, uint8_t& g, uint8_t& b) noexcept { r = p[0]; g = p[1]; b = p[2]; }
+	};
+
+	template<> struct TexelFetch<TextureFormat::RGBA8>
+	{
+		static constexpr size_t Bpp = 4u;
+		static void Load(const uint8_t* p, uint8_t& r, uint8_t& g, uint8_t& b) noexcept { r = p[0]; g = p[1]; b = p[2]; }
+	};
+
+	//~ per target pixel size stores and row blits, picked once per draw as well
+	template<size_t D> struct TargetStore;
+
+	template<> struct TargetStore<3u>
+	{
+		static void Store(uint8_t* p, uint8_t r, uint8_t g, uint8_t b) noexcept { p[0] = r; p[1] = g; p[2] = b; }
+
+		static void Keyed (uint8_t* dst, const uint8_t* src, int count) noexcept { PEBlitKernels::BlitKeyedRGBA (dst, src, count); }
+		static void Opaque(uint8_t* dst, const uint8_t* src, int count) noexcept { PEBlitKernels::BlitOpaqueRGBA(dst, src, count); }
+		static void Blend (uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+		{
+			PEBlitKernels::BlendPremultipliedRGBA(dst, src, count, opacity);
+		}
+	};
+
+	template<> struct TargetStore<4u>
+	{
+		//~ one word store, alpha is always opaque
+		static void Store(uint8_t* p, uint8_t r, uint8_t g, uint8_t b) noexcept
+		{
+			const uint32_t px =  static_cast<uint32_t>(r)		  |
+								(static_cast<uint32_t>(g) << 8)  |
+								(static_cast<uint32_t>(b) << 16) |
+								0xFF000000u;
+			std::memcpy(p, &px, sizeof(px));
+		}
+
+		static void Keyed (uint8_t* dst, const uint8_t* src, int count) noexcept { PEBlitKernels::BlitKeyedRGBA32 (dst, src, count); }
+		static void Opaque(uint8_t* dst, const uint8_t* src, int count) noexcept { PEBlitKernels::BlitOpaqueRGBA32(dst, src, count); }
+		static void Blend (uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) noexcept
+		{
+			PEBlitKernels::BlendPremultipliedRGBA32(dst, src, count, opacity);
+		}
+	};
+
+	//~ copies only the visible runs of one texel row, no key test needed
+	template<TextureFormat F, size_t D>
+	void DrawCoveredSpan(
+		uint8_t*				dst,
+		int						count,
+		int64_t					u,
+		int64_t					du,
+		const uint8_t*			row,
+		const PFE_COVERAGE_RUN* runs,
+		uint32_t				runCount) noexcept
+	{
+		using Fetch	 = TexelFetch<F>;
+		using Target = TargetStore<D>;
+
+		if (runCount == 0u) return;
+
+		//~ many short runs are cheaper as one keyed SIMD blit over the
+		//~ visible extent than as a string of tiny opaque copies
+		if constexpr (F == TextureFormat::RGBA8)
+		{
+			if (du == PFE_SPAN_ONE && runCount > 2u)
+			{
+				int64_t lo = 0;
+				int64_t hi = count - 1;
+				const int64_t extentBegin = static_cast<int64_t>(runs[0].begin) << PFE_SPAN_FRACTION_BITS;
+				const int64_t extentSize  = static_cast<int64_t>(runs[runCount - 1u].end - runs[0].begin) << PFE_SPAN_FRACTION_BITS;
+				if (!SolveAxis(u - extentBegin, du, extentSize, lo, hi)) return;
+
+				Target::Keyed(
+					dst + static_cast<size_t>(lo) * D,
+					row + static_cast<size_t>((u + du * lo) >> PFE_SPAN_FRACTION_BITS) * Fetch::Bpp,
+					static_cast<int>(hi - lo + 1));
+				return;
+			}
+		}
+
+		for (uint32_t r = 0; r < runCount; ++r)
+		{
+			//~ pixels k in [lo, hi] whose texel falls inside the run
+			int64_t lo = 0;
+			int64_t hi = count - 1;
+			const int64_t runBegin = static_cast<int64_t>(runs[r].begin) << PFE_SPAN_FRACTION_BITS;
+			const int64_t runSize  = static_cast<int64_t>(runs[r].end - runs[r].begin) << PFE_SPAN_FRACTION_BITS;
+			if (!SolveAxis(u - runBegin, du, runSize, lo, hi)) continue;
+
+			uint8_t* out = dst + static_cast<size_t>(lo) * D;
+			int64_t	 t	 = u + du * lo;
+
+			if constexpr (F == TextureFormat::RGBA8)
+			{
+				if (du == PFE_SPAN_ONE)
+				{
+					Target::Opaque(
+						out,
+						row + static_cast<size_t>(t >> PFE_SPAN_FRACTION_BITS) * Fetch::Bpp,
+						static_cast<int>(hi - lo + 1));
+					continue;
+				}
+			}
+
+			for (int64_t k = lo; k <= hi; ++k, out += D, t += du)
+			{
+				uint8_t rr, gg, bb;
+				Fetch::Load(row + static_cast<size_t>(t >> PFE_SPAN_FRACTION_BITS) * Fetch::Bpp, rr, gg, bb);
+				Target::Store(out, rr, gg, bb);
+			}
+		}
+	}
+
+	template<TextureFormat F, size_t D>
+	void DrawTextureRows(
+		PEImageBuffer&		 target,
+		const PFE_SPAN_QUAD& quad,
+		const Texture&		 texture,
+		const PFE_SPAN_CLIP& clip) noexcept
+	{
+		const uint8_t* texels	   = texture.GetRaw().data();
+		const size_t   texStride   = texture.GetRowStride();
+		const bool	   hasCoverage = texture.HasCoverage();
+
+		using Fetch	 = TexelFetch<F>;
+		using Target = TargetStore<D>;
+
+		const int y0 = std::max(quad.minY, clip.minY);
+		const int y1 = std::min(quad.maxY, clip.maxY);
+
+		for (int y = y0; y < y1; ++y)
+		{
+			int x0 = 0, x1 = 0;
+			if (!PESpanRasterizer::ComputeSpan(quad, y, clip.minX, clip.maxX, x0, x1)) continue;
+
+			int64_t u = quad.u0 + quad.dudx * x0 + quad.dudy * y;
+			int64_t v = quad.v0 + quad.dvdx * x0 + quad.dvdy * y;
+
+			uint8_t* dst = target.PixelAt(static_cast<size_t>(y), static_cast<size_t>(x0));
+
+			if (quad.dvdx == 0)
+			{
+				//~ axis aligned, the source row is fixed for the whole span
+				const uint32_t texRow = static_cast<uint32_t>(v >> PFE_SPAN_FRACTION_BITS);
+				const uint8_t* row	  = texels + static_cast<size_t>(texRow) * texStride;
+
+				//~ skip keyed runs entirely and bulk copy the visible ones
+				if (hasCoverage)
+				{
+					uint32_t runCount = 0u;
+					const PFE_COVERAGE_RUN* runs = texture.GetCoverageRuns(texRow, runCount);
+					DrawCoveredSpan<F, D>(dst, x1 - x0, u, quad.dudx, row, runs, runCount);
+					continue;
+				}
+
+				//~ unscaled as well, texels map 1:1 so hand the run to the SIMD blit
+				if constexpr (F == TextureFormat::RGBA8)
+				{
+					if (quad.dudx == PFE_SPAN_ONE)
+					{
+						Target::Keyed(
+							dst,
+							row + static_cast<size_t>(u >> PFE_SPAN_FRACTION_BITS) * Fetch::Bpp,
+							x1 - x0);
+						continue;
+					}
+				}
+
+				for (int x = x0; x < x1; ++x, dst += D, u += quad.dudx)
+				{
+					uint8_t r, g, b;
+					Fetch::Load(row + static_cast<size_t>(u >> PFE_SPAN_FRACTION_BITS) * Fetch::Bpp, r, g, b);
+					if (r <= 10u && g <= 10u && b <= 10u) continue;
+
+					Target::Store(dst, r, g, b);
+				}
+				continue;
+			}
+
+			for (int x = x0; x < x1; ++x, dst += D, u += quad.dudx, v += quad.dvdx)
+			{
+				const uint8_t* src = texels														 +
+									 static_cast<size_t>(v >> PFE_SPAN_FRACTION_BITS) * texStride +
+									 static_cast<size_t>(u >> PFE_SPAN_FRACTION_BITS) * Fetch::Bpp;
+				uint8_t r, g, b;
+				Fetch::Load(src, r, g, b);
+				if (r <= 10u && g <= 10u && b <= 10u) continue;
+
+				Target::Store(dst, r, g, b);
+			}
+		}
+	}
+
+	template<TextureFormat F>
+	void DrawTextureForTarget(
+		PEImageBuffer&		 target,
+		const PFE_SPAN_QUAD& quad,
+		const Texture&		 texture,
+		const PFE_SPAN_CLIP& clip) noexcept
+	{
+		if (target.PixelSize() == 4u) DrawTextureRows<F, 4u>(target, quad, texture, clip);
+		else						  DrawTextureRows<F, 3u>(target, quad, texture, clip);
+	}
+
+	template<TextureFormat F, size_t D>
+	void DrawOpaqueRows(
+		PEImageBuffer&		 target,
+		const PFE_SPAN_QUAD& quad,
+		const Texture&		 texture,
+		const PFE_SPAN_CLIP& clip) noexcept
+	{
+		const uint8_t* texels	 = texture.GetRaw().data();
+		const size_t   texStride = texture.GetRowStride();
+
+		using Fetch	 = TexelFetch<F>;
+		using Target = TargetStore<D>;
+
+		const int y0 = std::max(quad.minY, clip.minY);
+		const int y1 = std::min(quad.maxY, clip.maxY);
+
+		for (int y = y0; y < y1; ++y)
+		{
+			int x0 = 0, x1 = 0;
+			if (!PESpanRasterizer::ComputeSpan(quad, y, clip.minX, clip.maxX, x0, x1)) continue;
+
+			int64_t u = quad.u0 + quad.dudx * x0 + quad.dudy * y;
+			int64_t v = quad.v0 + quad.dvdx * x0 + quad.dvdy * y;
+
+			uint8_t* dst = target.PixelAt(static_cast<size_t>(y), static_cast<size_t>(x0));
+
+			if constexpr (F == TextureFormat::RGBA8)
+			{
+				if (quad.dvdx == 0 && quad.dudx == PFE_SPAN_ONE)
+				{
+					const uint8_t* row = texels + static_cast<size_t>(v >> PFE_SPAN_FRACTION_BITS) * texStride;
+					Target::Opaque(dst, row + static_cast<size_t>(u >> PFE_SPAN_FRACTION_BITS) * Fetch::Bpp, x1 - x0);
+					continue;
+				}
+			}
+
+			for (int x = x0; x < x1; ++x, dst += D, u += quad.dudx, v += quad.dvdx)
+			{
+				const uint8_t* src = texels														 +
+									 static_cast<size_t>(v >> PFE_SPAN_FRACTION_BITS) * texStride +
+									 static_cast<size_t>(u >> PFE_SPAN_FRACTION_BITS) * Fetch::Bpp;
+				uint8_t r, g, b;
+				Fetch::Load(src, r, g, b);
+				Target::Store(dst, r, g, b);
+			}
+		}
+	}
+
+	template<TextureFormat F>
+	void DrawOpaqueForTarget(
+		PEImageBuffer&		 target,
+		const PFE_SPAN_QUAD& quad,
+		const Texture&		 texture,
+		const PFE_SPAN_CLIP& clip) noexcept
+	{
+		if (target.PixelSize() == 4u) DrawOpaqueRows<F, 4u>(target, quad, texture, clip);
+		else						  DrawOpaqueRows<F, 3u>(target, quad, texture, clip);
+	}
+
+	//~ premultiplied texels are gathered into a small stack buffer so the
+	//~ blend itself always runs on contiguous rows, scaled or rotated
+	constexpr int BLEND_GATHER_PIXELS = 64;
+
+	template<size_t D>
+	void DrawBlendedRows(
+		PEImageBuffer&		 target,
+		const PFE_SPAN_QUAD& quad,
+		const Texture&		 texture,
+		uint8_t				 opacity,
+		const PFE_SPAN_CLIP& clip) noexcept
+	{
+		using Target = TargetStore<D>;
+
+		const uint8_t* texels	 = texture.GetPremultiplied().data();
+		const size_t   texStride = static_cast<size_t>(texture.GetWidth()) * 4u;
+
+		alignas(16) uint8_t gathered[BLEND_GATHER_PIXELS * 4];
+
+		const int y0 = std::max(quad.minY, clip.minY);
+		const int y1 = std::min(quad.maxY, clip.maxY);
+
+		for (int y = y0; y < y1; ++y)
+		{
+			int x0 = 0, x1 = 0;
+			if (!PESpanRasterizer::ComputeSpan(quad, y, clip.minX, clip.maxX, x0, x1)) continue;
+
+			int64_t u = quad.u0 + quad.dudx * x0 + quad.dudy * y;
+			int64_t v = quad.v0 + quad.dvdx * x0 + quad.dvdy * y;
+
+			uint8_t* dst = target.PixelAt(static_cast<size_t>(y), static_cast<size_t>(x0));
+
+			//~ unrotated and unscaled, the texel row is already contiguous
+			if (quad.dvdx == 0 && quad.dudx == PFE_SPAN_ONE)
+			{
+				const uint8_t* row = texels														 +
+									 static_cast<size_t>(v >> PFE_SPAN_FRACTION_BITS) * texStride +
+									 static_cast<size_t>(u >> PFE_SPAN_FRACTION_BITS) * 4u;
+				Target::Blend(dst, row, x1 - x0, opacity);
+				continue;
+			}
+
+			for (int x = x0; x < x1;)
+			{
+				const int count = std::min(BLEND_GATHER_PIXELS, x1 - x);
+				for (int k = 0; k < count; ++k, u += quad.dudx, v += quad.dvdx)
+				{
+					const uint8_t* src = texels														 +
+										 static_cast<size_t>(v >> PFE_SPAN_FRACTION_BITS) * texStride +
+										 static_cast<size_t>(u >> PFE_SPAN_FRACTION_BITS) * 4u;
+					std::memcpy(gathered + k * 4, src, 4u);
+				}
+
+				Target::Blend(dst, gathered, count, opacity);
+				dst += static_cast<size_t>(count) * D;
+				x	+= count;
+			}
+		}
+	}
+
+	template<size_t D>
+	void DrawColorRows(
+		PEImageBuffer&				  target,
+		const PFE_SPAN_QUAD&		  quad,
+		const PFE_FORMAT_R8G8B8_UINT& color,
+		const PFE_SPAN_CLIP&		  clip) noexcept
+	{
+		const int y0 = std::max(quad.minY, clip.minY);
+		const int y1 = std::min(quad.maxY, clip.maxY);
+
+		for (int y = y0; y < y1; ++y)
+		{
+			int x0 = 0, x1 = 0;
+			if (!PESpanRasterizer::ComputeSpan(quad, y, clip.minX, clip.maxX, x0, x1)) continue;
+
+			uint8_t* dst = target.PixelAt(static_cast<size_t>(y), static_cast<size_t>(x0));
+			for (int x = x0; x < x1; ++x, dst += D)
+			{
+				TargetStore<D>::Store(dst, color.R.Value, color.G.Value, color.B.Value);
+			}
+		}
+	}
+
+	PFE_SPAN_CLIP ClampClip(const PEImageBuffer& target, const PFE_SPAN_CLIP& clip) noexcept
+	{
+		PFE_SPAN_CLIP out{};
+		out.minX = std::max(0, clip.minX);
+		out.minY = std::max(0, clip.minY);
+		out.maxX = std::min(static_cast<int>(target.Width ()), clip.maxX);
+		out.maxY = std::min(static_cast<int>(target.Height()), clip.maxY);
+		return out;
+	}
+} // namespace
+
+_Use_decl_annotations_
+bool PESpanRasterizer::Setup(
+	const FVector2D& startBase,
+	const FVector2D& deltaAxisU,
+	const FVector2D& deltaAxisV,
+	int				 totalColumns,
+	int				 totalRows,
+	PFE_SPAN_QUAD&	 out) noexcept
+{
+	out = {};
+	if (totalColumns <= 0 || totalRows <= 0) return false;
+
+	const double ux = deltaAxisU.x, uy = deltaAxisU.y;
+	const double vx = deltaAxisV.x, vy = deltaAxisV.y;
+
+	const double det = ux * vy - uy * vx;
+	if (std::abs(det) < 1e-8) return false;
+
+	//~ texel = inverse([U V]) * (pixel - start), texel (i, j) sits on start + iU + jV
+	const double inv = 1.0 / det;
+	const double m00 =  vy * inv, m01 = -vx * inv;
+	const double m10 = -uy * inv, m11 =  ux * inv;
+
+	const double sx = startBase.x, sy = startBase.y;
+
+	//~ + 0.5 so that flooring picks the nearest texel
+	out.u0	 = ToFixed(0.5 - (m00 * sx + m01 * sy));
+	out.v0	 = ToFixed(0.5 - (m10 * sx + m11 * sy));
+	out.dudx = ToFixed(m00);
+	out.dudy = ToFixed(m01);
+	out.dvdx = ToFixed(m10);
+	out.dvdy = ToFixed(m11);
+
+	out.totalColumns = totalColumns;
+	out.totalRows	 = totalRows;
+
+	//~ rows covered by the texel rectangle edges, one pixel of slack each side
+	const double a0 = -0.5, a1 = static_cast<double>(totalColumns) - 0.5;
+	const double b0 = -0.5, b1 = static_cast<double>(totalRows)	   - 0.5;
+
+	const double y00 = sy + a0 * uy + b0 * vy;
+	const double y10 = sy + a1 * uy + b0 * vy;
+	const double y01 = sy + a0 * uy + b1 * vy;
+	const double y11 = sy + a1 * uy + b1 * vy;
+
+	const double yMin = std::min(std::min(y00, y10), std::min(y01, y11));
+	const double yMax = std::max(std::max(y00, y10), std::max(y01, y11));
+
+	out.minY = static_cast<int>(std::floor(yMin)) - 1;
+	out.maxY = static_cast<int>(std::ceil (yMax)) + 2;
+	return true;
+}
+
+_Use_decl_annotations_
+bool PESpanRasterizer::ComputeSpan(
+	const PFE_SPAN_QUAD& quad,
+	int					 y,
+	int					 clipMinX,
+	int					 clipMaxX,
+	int&				 x0,
+	int&				 x1) noexcept
+{
+	int64_t lo = clipMinX;
+	int64_t hi = static_cast<int64_t>(clipMaxX) - 1;
+	if (lo > hi) return false;
+
+	const int64_t baseU = quad.u0 + quad.dudy * y;
+	const int64_t baseV = quad.v0 + quad.dvdy * y;
+
+	if (!SolveAxis(baseU, quad.dudx, static_cast<int64_t>(quad.totalColumns) << PFE_SPAN_FRACTION_BITS, lo, hi)) return false;
+	if (!SolveAxis(baseV, quad.dvdx, static_cast<int64_t>(quad.totalRows)	 << PFE_SPAN_FRACTION_BITS, lo, hi)) return false;
+
+	x0 = static_cast<int>(lo);
+	x1 = static_cast<int>(hi) + 1;
+	return true;
+}
+
+_Use_decl_annotations_
+void PESpanRasterizer::DrawTexture(
+	PEImageBuffer&		 target,
+	const PFE_SPAN_QUAD& quad,
+	const Texture&		 texture,
+	const PFE_SPAN_CLIP& clip) noexcept
+{
+	if (texture.IsEmpty() || target.Empty()) return;
+	if (texture.GetCoverage() == TextureCoverage::Transparent) return;
+	if (quad.totalColumns > static_cast<int>(texture.GetWidth ()) ||
+		quad.totalRows	  > static_cast<int>(texture.GetHeight())) return;
+
+	const PFE_SPAN_CLIP bounded = ClampClip(target, clip);
+
+	switch (texture.GetFormat())
+	{
+	case TextureFormat::R8:	   DrawTextureForTarget<TextureFormat::R8>   (target, quad, texture, bounded); break;
+	case TextureFormat::RG8:   DrawTextureForTarget<TextureFormat::RG8>  (target, quad, texture, bounded); break;
+	case TextureFormat::RGB8:  DrawTextureForTarget<TextureFormat::RGB8> (target, quad, texture, bounded); break;
+	case TextureFormat::RGBA8: DrawTextureForTarget<TextureFormat::RGBA8>(target, quad, texture, bounded); break;
+	default: break;
+	}
+}
+
+_Use_decl_annotations_
+void PESpanRasterizer::DrawTextureOpaque(
+	PEImageBuffer&		 target,
+	const PFE_SPAN_QUAD& quad,
+	const Texture&		 texture,
+	const PFE_SPAN_CLIP& clip) noexcept
+{
+	if (texture.IsEmpty() || target.Empty()) return;
+	if (quad.totalColumns > static_cast<int>(texture.GetWidth ()) ||
+		quad.totalRows	  > static_cast<int>(texture.GetHeight())) return;
+
+	const PFE_SPAN_CLIP bounded = ClampClip(target, clip);
+
+	switch (texture.GetFormat())
+	{
+	case TextureFormat::R8:	   DrawOpaqueForTarget<TextureFormat::R8>   (target, quad, texture, bounded); break;
+	case TextureFormat::RG8:   DrawOpaqueForTarget<TextureFormat::RG8>  (target, quad, texture, bounded); break;
+	case TextureFormat::RGB8:  DrawOpaqueForTarget<TextureFormat::RGB8> (target, quad, texture, bounded); break;
+	case TextureFormat::RGBA8: DrawOpaqueForTarget<TextureFormat::RGBA8>(target, quad, texture, bounded); break;
+	default: break;
+	}
+}
+
+_Use_decl_annotations_
+void PESpanRasterizer::DrawTextureBlended(
+	PEImageBuffer&		 target,
+	const PFE_SPAN_QUAD& quad,
+	const Texture&		 texture,
+	uint8_t				 opacity,
+	const PFE_SPAN_CLIP& clip) noexcept
+{
+	if (opacity == 0u || !texture.HasPremultiplied() || target.Empty()) return;
+	if (quad.totalColumns > static_cast<int>(texture.GetWidth ()) ||
+		quad.totalRows	  > static_cast<int>(texture.GetHeight())) return;
+
+	const PFE_SPAN_CLIP bounded = ClampClip(target, clip);
+	if (target.PixelSize() == 4u) DrawBlendedRows<4u>(target, quad, texture, opacity, bounded);
+	else						  DrawBlendedRows<3u>(target, quad, texture, opacity, bounded);
+}
+
+_Use_decl_annotations_
+void PESpanRasterizer::DrawColor(
+	PEImageBuffer&				  target,
+	const PFE_SPAN_QUAD&		  quad,
+	const PFE_FORMAT_R8G8B8_UINT& color,
+	const PFE_SPAN_CLIP&		  clip) noexcept
+{
+	if (target.Empty()) return;
+
+	const PFE_SPAN_CLIP bounded = ClampClip(target, clip);
+	if (target.PixelSize() == 4u) DrawColorRows<4u>(target, quad, color, bounded);
+	else						  DrawColorRows<3u>(target, quad, color, bounded);
+}
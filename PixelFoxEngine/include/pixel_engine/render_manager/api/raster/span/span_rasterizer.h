@@ -0,0 +1,123 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/core/types.h"
+#include "pixel_engine/render_manager/components/texture/resource/texture.h"
+#include "pixel_engine/render_manager/api/buffer/image.h"
+
+#include "fox_math/vector.h"
+
+#include <cstdint>
+
+namespace pixel_engine
+{
+	enum class ERasterKernel : uint8_t
+	{
+		ForwardMapped, // walk texels and round them onto the screen (old path)
+		InverseSpan	   // walk screen spans and fetch texels in fixed point
+	};
+
+	//~ 16.16 fixed point texel coordinates, texel = value >> 16
+	constexpr int	  PFE_SPAN_FRACTION_BITS = 16;
+	constexpr int64_t PFE_SPAN_ONE			 = int64_t{ 1 } << PFE_SPAN_FRACTION_BITS;
+
+	typedef struct _PFE_SPAN_CLIP
+	{
+		_In_ int minX{ 0 };
+		_In_ int minY{ 0 };
+		_In_ int maxX{ 0 }; // exclusive
+		_In_ int maxY{ 0 }; // exclusive
+	} PFE_SPAN_CLIP;
+
+	//~ screen -> texel mapping of one quad, built once per draw
+	typedef struct _PFE_SPAN_QUAD
+	{
+		//~ texel coordinate at pixel (0, 0), half texel bias already added
+		_In_ int64_t u0{ 0 };
+		_In_ int64_t v0{ 0 };
+
+		//~ texel step per screen pixel
+		_In_ int64_t dudx{ 0 };
+		_In_ int64_t dvdx{ 0 };
+		_In_ int64_t dudy{ 0 };
+		_In_ int64_t dvdy{ 0 };
+
+		_In_ int totalColumns{ 0 };
+		_In_ int totalRows	 { 0 };
+
+		//~ conservative screen rows the quad can touch
+		_In_ int minY{ 0 };
+		_In_ int maxY{ 0 }; // exclusive
+	} PFE_SPAN_QUAD;
+
+	/// <summary>
+	/// Inverse mapped quad rasterizer. For every destination row the
+	/// covered span is solved exactly in fixed point, so the inner loop
+	/// only steps texel coordinates and copies pixels with no bounds checks.
+	/// Pixels match the texel the forward path would round onto them,
+	/// without the holes rotation leaves or the overdraw magnification causes.
+	/// </summary>
+	class PFE_API PESpanRasterizer
+	{
+	public:
+		//~ returns false for degenerate or empty quads
+		_NODISCARD _Check_return_
+		static bool Setup(
+			_In_  const FVector2D& startBase,
+			_In_  const FVector2D& deltaAxisU,
+			_In_  const FVector2D& deltaAxisV,
+			_In_  int			   totalColumns,
+			_In_  int			   totalRows,
+			_Out_ PFE_SPAN_QUAD&   out) noexcept;
+
+		//~ [x0, x1) covered on row y inside [clipMinX, clipMaxX)
+		_NODISCARD _Check_return_
+		static bool ComputeSpan(
+			_In_  const PFE_SPAN_QUAD& quad,
+			_In_  int				   y,
+			_In_  int				   clipMinX,
+			_In_  int				   clipMaxX,
+			_Out_ int&				   x0,
+			_Out_ int&				   x1) noexcept;
+
+		//~ black texels are treated as transparent, same as DrawQuadTile
+		static void DrawTexture(
+			_Inout_ PEImageBuffer&		 target,
+			_In_	const PFE_SPAN_QUAD& quad,
+			_In_	const Texture&		 texture,
+			_In_	const PFE_SPAN_CLIP& clip) noexcept;
+
+		//~ every texel is written, black included, same as DrawQuadBackground
+		static void DrawTextureOpaque(
+			_Inout_ PEImageBuffer&		 target,
+			_In_	const PFE_SPAN_QUAD& quad,
+			_In_	const Texture&		 texture,
+			_In_	const PFE_SPAN_CLIP& clip) noexcept;
+
+		//~ source over with Texture::GetPremultiplied, needs BuildPremultiplied first
+		static void DrawTextureBlended(
+			_Inout_ PEImageBuffer&		 target,
+			_In_	const PFE_SPAN_QUAD& quad,
+			_In_	const Texture&		 texture,
+			_In_	uint8_t				 opacity,
+			_In_	const PFE_SPAN_CLIP& clip) noexcept;
+
+		static void DrawColor(
+			_Inout_ PEImageBuffer&				  target,
+			_In_	const PFE_SPAN_QUAD&		  quad,
+			_In_	const PFE_FORMAT_R8G8B8_UINT& color,
+			_In_	const PFE_SPAN_CLIP&		  clip) noexcept;
+	};
+} // namespace pixel_engine
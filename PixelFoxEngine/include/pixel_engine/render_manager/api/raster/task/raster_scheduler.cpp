@@ -2,6 +2,11 @@
 #include "raster_scheduler.h"
 
 pixel_engine::RasterizeScheduler::~RasterizeScheduler()
+{
+    Shutdown();
+}
+
+void pixel_engine::RasterizeScheduler::Shutdown()
 {
     {
         std::lock_guard<std::mutex> lock(m_QueueMutex);
@@ -18,8 +23,10 @@ pixel_engine::RasterizeScheduler::~RasterizeScheduler()
     {
         std::lock_guard<std::mutex> lock(m_QueueMutex);
         m_TaskQueue.clear();
+        m_JobQueue.clear();
         m_ActiveTasks = 0;
     }
+    m_WorkerThreads.clear();
 }
 
 void pixel_engine::RasterizeScheduler::Initialize(std::uint32_t workerCount)
@@ -68,17 +75,35 @@ void pixel_engine::RasterizeScheduler::Enqueue(PERasterizeTask&& task)
     m_Condition.notify_one();
 }
 
+void pixel_engine::RasterizeScheduler::Enqueue(const PFE_JOB& job)
+{
+    if (!job.Execute) return;
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        if (m_Stop)
+            return;
+
+        m_JobQueue.push_back(job);
+        ++m_ActiveTasks;
+    }
+    m_Condition.notify_one();
+}
+
 void pixel_engine::RasterizeScheduler::Dispatch()
 {
     MasterWork();
 }
 
+void pixel_engine::RasterizeScheduler::Submit()
+{
+}
+
 void pixel_engine::RasterizeScheduler::Wait()
 {
     std::unique_lock<std::mutex> lock(m_QueueMutex);
     m_Condition.wait(lock, [this]()
     {
-        return (m_TaskQueue.empty() && (m_ActiveTasks.load() == 0));
+        return (m_TaskQueue.empty() && m_JobQueue.empty() && (m_ActiveTasks.load() == 0));
     });
 }
 
@@ -87,22 +112,23 @@ void pixel_engine::RasterizeScheduler::WorkerLoop(std::uint32_t workerIndex)
     for (;;)
     {
         PERasterizeTask task;
+        PFE_JOB         job{};
 
         {
             std::unique_lock<std::mutex> lock(m_QueueMutex);
             m_Condition.wait(lock, [this]()
                 {
-                    return m_Stop || !m_TaskQueue.empty();
+                    return m_Stop || !m_TaskQueue.empty() || !m_JobQueue.empty();
                 });
 
-            if (m_Stop && m_TaskQueue.empty())
+            if (m_Stop && m_TaskQueue.empty() && m_JobQueue.empty())
                 return;
 
-            task = std::move(m_TaskQueue.back());
-            m_TaskQueue.pop_back();
+            PopWork(task, job);
         }
 
-        task.Execute();
+        if (job.Execute) job.Execute(job.Context);
+        else             task.Execute();
 
         {
             std::lock_guard<std::mutex> lock(m_QueueMutex);
@@ -119,17 +145,18 @@ void pixel_engine::RasterizeScheduler::MasterWork()
     for (;;)
     {
         PERasterizeTask task;
+        PFE_JOB         job{};
 
         {
             std::lock_guard<std::mutex> lock(m_QueueMutex);
-            if (m_TaskQueue.empty() || m_Stop)
+            if ((m_TaskQueue.empty() && m_JobQueue.empty()) || m_Stop)
                 break;
 
-            task = std::move(m_TaskQueue.back());
-            m_TaskQueue.pop_back();
+            PopWork(task, job);
         }
 
-        task.Execute();
+        if (job.Execute) job.Execute(job.Context);
+        else             task.Execute();
 
         {
             std::lock_guard<std::mutex> lock(m_QueueMutex);
@@ -140,3 +167,16 @@ void pixel_engine::RasterizeScheduler::MasterWork()
         }
     }
 }
+
+void pixel_engine::RasterizeScheduler::PopWork(PERasterizeTask& task, PFE_JOB& job)
+{
+    if (!m_JobQueue.empty())
+    {
+        job = m_JobQueue.back();
+        m_JobQueue.pop_back();
+        return;
+    }
+
+    task = std::move(m_TaskQueue.back());
+    m_TaskQueue.pop_back();
+}
@@ -3,6 +3,8 @@
 #include "PixelFoxEngineAPI.h"
 #include "raster_task.h"
 
+#include "pixel_engine/core/jobs/job.h"
+
 #include <thread>
 #include <vector>
 #include <atomic>
@@ -12,31 +14,65 @@
 
 namespace pixel_engine
 {
-	class PFE_API RasterizeScheduler
+	enum class ERasterScheduler : uint8_t
+	{
+		SharedQueue,  // one locked queue and condition variable (old path)
+		WorkStealing  // per worker Chase-Lev deques and a completion latch
+	};
+
+	//~ Enqueue a batch, Dispatch runs it with the caller helping, Submit
+	//~ starts it without the caller so it can do other work until Wait,
+	//~ Wait returns once every task of it finished; jobs are any other work
+	//~ for the raster workers (frame graph stages) and must not use the
+	//~ scheduler that runs them
+	class PFE_API IRasterScheduler
+	{
+	public:
+		virtual ~IRasterScheduler() = default;
+
+		virtual void Initialize(std::uint32_t workerCount) = 0;
+		virtual void Shutdown  () = 0;
+
+		virtual void Enqueue(const PERasterizeTask& task) = 0;
+		virtual void Enqueue(PERasterizeTask&& task)	  = 0;
+		virtual void Enqueue(const PFE_JOB& job)		  = 0;
+
+		virtual void Dispatch() = 0;
+		virtual void Submit	 () = 0;
+		virtual void Wait	 () = 0;
+	};
+
+	class PFE_API RasterizeScheduler final : public IRasterScheduler
 	{
 	public:
 		RasterizeScheduler() noexcept = default;
-		~RasterizeScheduler();
+		~RasterizeScheduler() override;
 
 		//~ Initialization & shutdown
-		void Initialize(std::uint32_t workerCount = std::thread::hardware_concurrency());
-		void Shutdown();
+		void Initialize(std::uint32_t workerCount = std::thread::hardware_concurrency()) override;
+		void Shutdown() override;
 
 		//~ Job submission
-		void Enqueue(const PERasterizeTask& task);
-		void Enqueue(PERasterizeTask&& task);
+		void Enqueue(const PERasterizeTask& task) override;
+		void Enqueue(PERasterizeTask&& task) override;
+		void Enqueue(const PFE_JOB& job) override;
 
 		//~ Execution control
-		void Dispatch();   // Divide work (Master logic)
-		void Wait();
+		void Dispatch() override;   // Divide work (Master logic)
+		void Submit() override;		// workers already picked it up at Enqueue
+		void Wait() override;
 
 	private:
 		void WorkerLoop(std::uint32_t workerIndex);
 		void MasterWork();
 
+		//~ caller holds m_QueueMutex, jobs go first, job.Execute stays null for a task
+		void PopWork(PERasterizeTask& task, PFE_JOB& job);
+
 	private:
 		std::vector<std::thread> m_WorkerThreads;
 		std::vector<PERasterizeTask> m_TaskQueue;
+		std::vector<PFE_JOB> m_JobQueue;
 
 		std::mutex m_QueueMutex;
 		std::condition_variable m_Condition;
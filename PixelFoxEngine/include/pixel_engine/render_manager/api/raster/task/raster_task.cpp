@@ -38,6 +38,7 @@ PERasterizeTask::PERasterizeTask(PERasterizeTask&& other) noexcept
 	other.m_descTask.totalRows		 = 0;
 	other.m_descTask.TexWidth		 = 0;
 	other.m_descTask.TexHeight		 = 0;
+	other.m_descTask.binner			 = nullptr;
 }
 
 _Use_decl_annotations_
@@ -56,11 +57,22 @@ PERasterizeTask& PERasterizeTask::operator=(PERasterizeTask&& other) noexcept
 		other.m_descTask.totalRows		 = 0;
 		other.m_descTask.TexWidth		 = 0;
 		other.m_descTask.TexHeight		 = 0;
+		other.m_descTask.binner			 = nullptr;
 	}
 	return *this;
 }
 
 void PERasterizeTask::Execute() noexcept
+{
+	switch (m_descTask.kind)
+	{
+	case ERasterTaskKind::TileBin: ExecuteTileBin(); break;
+	case ERasterTaskKind::Quad:
+	default:					   ExecuteQuad();	 break;
+	}
+}
+
+void PERasterizeTask::ExecuteQuad() noexcept
 {
 	const auto& d = m_descTask;
 
@@ -86,8 +98,12 @@ void PERasterizeTask::Execute() noexcept
 			if (static_cast<unsigned>(iAbs) >= static_cast<unsigned>(d.totalColumns))
 				continue;
 
-			if (static_cast<unsigned>(ix) >= static_cast<unsigned>(d.totalColumns) ||
-				static_cast<unsigned>(iy) >= static_cast<unsigned>(d.totalRows))
+			if (static_cast<unsigned>(ix) >= d.target->Width() ||
+				static_cast<unsigned>(iy) >= d.target->Height())
+				continue;
+
+			if (ix < d.clip.minX || ix >= d.clip.maxX ||
+				iy < d.clip.minY || iy >= d.clip.maxY)
 				continue;
 
 			d.target->WriteAt(iy, ix, d.sampledTexture->GetPixel(iAbs, jAbs));
@@ -95,10 +111,106 @@ void PERasterizeTask::Execute() noexcept
 	}
 }
 
+void PERasterizeTask::ExecuteTileBin() noexcept
+{
+	const auto& d = m_descTask;
+	if (!d.binner || !d.target) return;
+
+	const auto& bins	 = d.binner->GetBins();
+	const auto& commands = d.binner->GetCommands();
+	if (static_cast<size_t>(d.binIndex) >= bins.size()) return;
+
+	const auto& bin = bins[d.binIndex];
+
+	//~ one pixel of slack, a texel belongs to the tile its rounded position lands in
+	const float rx0 = static_cast<float>(bin.minX) - 1.0f;
+	const float ry0 = static_cast<float>(bin.minY) - 1.0f;
+	const float rx1 = static_cast<float>(bin.maxX) + 1.0f;
+	const float ry1 = static_cast<float>(bin.maxY) + 1.0f;
+
+	const PFE_SPAN_CLIP tileClip{ bin.minX, bin.minY, bin.maxX, bin.maxY };
+
+	for (const uint32_t index : bin.commands)
+	{
+		const PFE_RASTER_BIN_CMD& c = commands[index];
+
+		if (c.blendMode == EBlendMode::PremultipliedAlpha)
+		{
+			PESpanRasterizer::DrawTextureBlended(*d.target, c.span, *c.sampledTexture, c.opacity, tileClip);
+			continue;
+		}
+
+		if (c.kernel == ERasterKernel::InverseSpan)
+		{
+			PESpanRasterizer::DrawTexture(*d.target, c.span, *c.sampledTexture, tileClip);
+			continue;
+		}
+
+		auto toI = [&c](float px, float py) { return c.m00 * (px - c.startBase.x) + c.m01 * (py - c.startBase.y); };
+		auto toJ = [&c](float px, float py) { return c.m10 * (px - c.startBase.x) + c.m11 * (py - c.startBase.y); };
+
+		const float i00 = toI(rx0, ry0), i10 = toI(rx1, ry0), i01 = toI(rx0, ry1), i11 = toI(rx1, ry1);
+		const float j00 = toJ(rx0, ry0), j10 = toJ(rx1, ry0), j01 = toJ(rx0, ry1), j11 = toJ(rx1, ry1);
+
+		const float iMin = std::min(std::min(i00, i10), std::min(i01, i11));
+		const float iMax = std::max(std::max(i00, i10), std::max(i01, i11));
+		const float jMin = std::min(std::min(j00, j10), std::min(j01, j11));
+		const float jMax = std::max(std::max(j00, j10), std::max(j01, j11));
+
+		const int i0 = std::max(0,				static_cast<int>(std::floor(iMin)));
+		const int i1 = std::min(c.totalColumns, static_cast<int>(std::ceil (iMax)) + 1);
+		const int j0 = std::max(0,				static_cast<int>(std::floor(jMin)));
+		const int j1 = std::min(c.totalRows,	static_cast<int>(std::ceil (jMax)) + 1);
+
+		if (i0 >= i1 || j0 >= j1) continue;
+
+		//~ step the same way DrawQuadTile does so rounding matches the serial path
+		FVector2D rowStart = c.startBase;
+		for (int j = 0; j < j0; ++j)
+		{
+			rowStart.x += c.deltaAxisV.x;
+			rowStart.y += c.deltaAxisV.y;
+		}
+
+		for (int j = j0; j < j1; ++j)
+		{
+			FVector2D p = rowStart;
+			for (int i = 0; i < i0; ++i)
+			{
+				p.x += c.deltaAxisU.x;
+				p.y += c.deltaAxisU.y;
+			}
+
+			for (int i = i0; i < i1; ++i)
+			{
+				const int ix = static_cast<int>(std::lround(p.x));
+				const int iy = static_cast<int>(std::lround(p.y));
+
+				if (ix >= bin.minX && ix < bin.maxX &&
+					iy >= bin.minY && iy < bin.maxY)
+				{
+					const auto color = c.sampledTexture->GetPixel(i, j);
+					if (!color.IsBlack())
+					{
+						d.target->WriteAt(iy, ix, color);
+					}
+				}
+
+				p.x += c.deltaAxisU.x;
+				p.y += c.deltaAxisU.y;
+			}
+			rowStart.x += c.deltaAxisV.x;
+			rowStart.y += c.deltaAxisV.y;
+		}
+	}
+}
+
 _Use_decl_annotations_
 bool PERasterizeTask::IsValid() const noexcept
 {
 	const auto& d = m_descTask;
+	if (d.kind == ERasterTaskKind::TileBin)
+		return (d.target != nullptr) && (d.binner != nullptr) && (d.binIndex >= 0);
 
 	const bool validPtr = (d.target != nullptr)		    &&
 						  (d.sampledTexture != nullptr);
@@ -121,6 +233,14 @@ bool PERasterizeTask::IsValid() const noexcept
 _Use_decl_annotations_
 std::size_t PERasterizeTask::EstimatedCost() const noexcept
 {
+	if (m_descTask.kind == ERasterTaskKind::TileBin && m_descTask.binner)
+	{
+		const auto& bins = m_descTask.binner->GetBins();
+		return static_cast<size_t>(m_descTask.binIndex) < bins.size()
+			? bins[m_descTask.binIndex].commands.size()
+			: 0u;
+	}
+
 	const int cols = std::max(0, m_descTask.columneEndAt - m_descTask.columnStartFrom);
 	const int rows = std::max(0, m_descTask.rowEndAt     - m_descTask.rowStartFrom);
 	
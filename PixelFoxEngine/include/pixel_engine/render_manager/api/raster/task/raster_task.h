@@ -17,11 +17,22 @@
 
 #include "pixel_engine/render_manager/components/texture/resource/texture.h"
 #include "pixel_engine/render_manager/api/buffer/image.h"
+#include "pixel_engine/render_manager/api/raster/bin/tile_binner.h"
+
+#include <climits>
 
 namespace pixel_engine
 {
+	enum class ERasterTaskKind : uint8_t
+	{
+		Quad,	 // rows of a single quad (background)
+		TileBin	 // every command binned into one screen tile
+	};
+
 	typedef struct _RASTERIZE_TASK_DESC
 	{
+		_In_ ERasterTaskKind kind = ERasterTaskKind::Quad;
+
 		_Inout_ PEImageBuffer* target		  = nullptr;
 		_Inout_	const Texture* sampledTexture = nullptr;
 
@@ -39,6 +50,13 @@ namespace pixel_engine
 		_In_ int TexWidth		 = 0;
 		_In_ int TexHeight		 = 0;
 
+		//~ quad tasks only write pixels inside, the damaged rect on partial frames
+		_In_ PFE_SPAN_CLIP clip{ 0, 0, INT_MAX, INT_MAX };
+
+		//~ tile bin tasks
+		_In_ const PETileBinner* binner	  = nullptr;
+		_In_ int				 binIndex = 0;
+
 	} RASTERIZE_TASK_DESC;
 
 	class PFE_API PERasterizeTask
@@ -67,6 +85,10 @@ namespace pixel_engine
 		_NODISCARD _Check_return_
 		const RASTERIZE_TASK_DESC& GetDesc() const noexcept { return m_descTask; }
 
+	private:
+		void ExecuteQuad   () noexcept;
+		void ExecuteTileBin() noexcept;
+
 	private:
 		RASTERIZE_TASK_DESC m_descTask{};
 	};
@@ -0,0 +1,93 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "work_stealing_scheduler.h"
+
+#include <utility>
+
+using namespace pixel_engine;
+
+PEWorkStealingScheduler::~PEWorkStealingScheduler()
+{
+    Shutdown();
+}
+
+_Use_decl_annotations_
+void PEWorkStealingScheduler::Initialize(std::uint32_t workerCount)
+{
+    m_pool.Initialize(workerCount);
+}
+
+void PEWorkStealingScheduler::Shutdown()
+{
+    m_pool.Shutdown();
+    m_pending.clear();
+    m_tasks  .clear();
+    m_jobs   .clear();
+}
+
+_Use_decl_annotations_
+void PEWorkStealingScheduler::Enqueue(const PERasterizeTask& task)
+{
+    m_pending.push_back(task);
+}
+
+_Use_decl_annotations_
+void PEWorkStealingScheduler::Enqueue(PERasterizeTask&& task)
+{
+    m_pending.emplace_back(std::move(task));
+}
+
+_Use_decl_annotations_
+void PEWorkStealingScheduler::Enqueue(const PFE_JOB& job)
+{
+    m_jobs.push_back(job);
+}
+
+void PEWorkStealingScheduler::Dispatch()
+{
+    Publish(true);
+}
+
+void PEWorkStealingScheduler::Submit()
+{
+    Publish(false);
+}
+
+void PEWorkStealingScheduler::Wait()
+{
+    m_pool.Wait();
+}
+
+_Use_decl_annotations_
+void PEWorkStealingScheduler::Publish(bool callerShare)
+{
+    //~ the running batch owns m_tasks until it is done
+    m_pool.Wait();
+
+    //~ swapped so both vectors keep their capacity from frame to frame
+    m_tasks.swap(m_pending);
+    m_pending.clear();
+
+    for (auto& task : m_tasks) m_pool.Enqueue(PFE_JOB{ &RunTask, &task });
+    for (const auto& job : m_jobs) m_pool.Enqueue(job);
+    m_jobs.clear();
+
+    if (callerShare) m_pool.Dispatch();
+    else             m_pool.Submit  ();
+}
+
+_Use_decl_annotations_
+void PEWorkStealingScheduler::RunTask(void* context)
+{
+    static_cast<PERasterizeTask*>(context)->Execute();
+}
@@ -0,0 +1,64 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+#include "raster_scheduler.h"
+
+#include "pixel_engine/core/jobs/job_pool.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace pixel_engine
+{
+	/// <summary>
+	/// Raster front of PEJobPool. Tasks wait in a pending batch until
+	/// Dispatch or Submit hands each one to the pool as a job, the pool
+	/// spreads them over per worker deques and the caller steals along
+	/// until Wait sees the completion latch drop to zero.
+	/// </summary>
+	class PFE_API PEWorkStealingScheduler final : public IRasterScheduler
+	{
+	public:
+		PEWorkStealingScheduler() noexcept = default;
+		~PEWorkStealingScheduler() override;
+
+		void Initialize(_In_ std::uint32_t workerCount) override;
+		void Shutdown  () override;
+
+		//~ not visible to the workers until Dispatch
+		void Enqueue(_In_	 const PERasterizeTask& task) override;
+		void Enqueue(_Inout_ PERasterizeTask&& task)	  override;
+		void Enqueue(_In_	 const PFE_JOB& job)		  override;
+
+		//~ waits for a batch still running before publishing the next one
+		void Dispatch() override;
+		void Submit	 () override;
+
+		//~ the caller steals from the workers until the batch is done
+		void Wait	 () override;
+
+	private:
+		//~ moves the pending tasks into the running batch and hands them out
+		void Publish(_In_ bool callerShare);
+
+		static void RunTask(_Inout_ void* context);
+
+	private:
+		PEJobPool m_pool{};
+
+		std::vector<PERasterizeTask> m_pending{}; // filled by Enqueue
+		std::vector<PERasterizeTask> m_tasks  {}; // running batch, jobs point into it
+		std::vector<PFE_JOB>		 m_jobs	  {}; // enqueued as they are
+	};
+} // namespace pixel_engine
@@ -70,9 +70,12 @@ DWORD pixel_engine::PERenderAPI::Execute()
     logger::info("[RenderThread] Start Event received: render loop begin.");
 
     const HANDLE waits[2] = { m_handleExitEvent, m_handlePresentEvent };
+#if defined(DEBUG) || defined(_DEBUG)
+    //~ stage timings in debug builds only, shipping builds stay quiet
     using clock = std::chrono::steady_clock;
     auto lastReport = clock::now();
     uint64_t framesSinceReport = 0;
+#endif
 
     m_pClock->ResetTime();
     while (true)
@@ -117,12 +120,20 @@ DWORD pixel_engine::PERenderAPI::Execute()
             return 0u;
         }
 
-        CleanFrame();
-        WriteFrame();
-
-        PresentFrame();
+        m_frameGraph.Execute(m_pRaster2D->GetScheduler());
         SetEvent(m_handlePresentDoneEvent);
 
+#if defined(DEBUG) || defined(_DEBUG)
+        ++framesSinceReport;
+        if (clock::now() - lastReport >= std::chrono::seconds(5))
+        {
+            logger::info("[RenderThread] {} frames since the last stage report", framesSinceReport);
+            ReportStages();
+            lastReport        = clock::now();
+            framesSinceReport = 0;
+        }
+#endif
+
         //const DWORD flag = WaitForMultipleObjects(2, waits, FALSE, INFINITE);
         //if (flag == WAIT_OBJECT_0) // exit
         //{
@@ -161,14 +172,14 @@ void pixel_engine::PERenderAPI::CleanFrame()
     const float clear[4] = { 1.f, 1.0f, 1.0f, 1.0f };
     m_pDeviceContext->ClearRenderTargetView(m_pRTV.Get(), clear);
 
-    if (m_pRaster2D) m_pRaster2D->Clear({ 237, 237, 199 });
+    //~ the raster target is cleared by the render queue once it knows
+    //~ which tiles were damaged, see PERaster2D::ClearDamage
 }
 
 void pixel_engine::PERenderAPI::WriteFrame()
 {
-    PERenderQueue::Instance().Update();
-    PERenderQueue::Instance().Render(m_pRaster2D.get());
-
+    //~ the raster frame itself is drawn by the frame graph stages, this
+    //~ only puts the uploaded buffer on the back buffer
     m_pDeviceContext->VSSetShader(m_pVertexShader.Get(), nullptr, 0u);
     m_pDeviceContext->PSSetShader(m_pPixelShader.Get(), nullptr, 0u);
     m_pDeviceContext->Draw(3, 0);
@@ -176,10 +187,32 @@ void pixel_engine::PERenderAPI::WriteFrame()
 
 void pixel_engine::PERenderAPI::PresentFrame()
 {
-    m_pRaster2D->Present(m_pDeviceContext.Get(), m_pCpuImageBuffer.Get());
+    m_pRaster2D->Present(m_pPresentTarget.get());
+    WriteFrame();
     m_pSwapchain->Present(0u, 0u);
 }
 
+void pixel_engine::PERenderAPI::UploadFrame()
+{
+    //~ nothing rendered yet on the very first frame
+    if (!m_bFrameRendered) return;
+
+    CleanFrame();
+    PresentFrame();
+    m_bFrameRendered = false;
+}
+
+void pixel_engine::PERenderAPI::ReportStages()
+{
+    std::string line{};
+    for (const auto& timing : m_frameGraph.GetTimings())
+    {
+        line += std::format(" {} {:.3f}", timing.Name, timing.AverageMs);
+    }
+    logger::info("[FrameGraph] average ms per stage:{}", line);
+    m_frameGraph.ResetTimings();
+}
+
 _Use_decl_annotations_
 bool pixel_engine::PERenderAPI::InitializeDirectX(const INIT_RENDER_API_DESC* desc)
 {
@@ -410,13 +443,17 @@ bool pixel_engine::PERenderAPI::CreatePixelShader(const INIT_RENDER_API_DESC* de
     {
         int px = clamp(int(i.pos.x), 0, WIDTH-1);
         int py = clamp(int(i.pos.y), 0, HEIGHT-1);
-        uint pixelIndex = py * WIDTH + px;
 
-        uint offset = pixelIndex * 3;
+        uint offset = py * ROW_PITCH + px * PIXEL_BYTES;
+
+        uint data;
+#if PIXEL_BYTES == 4
+        // 32 bit target, one aligned load per pixel
+        data = buf.Load(offset) & 0x00FFFFFF;
+#else
         uint inner = offset & 3;
         uint base  = offset & ~3;
 
-        uint data;
         if (inner == 0)
         {
             data = buf.Load(base) & 0x00FFFFFF;
@@ -427,6 +464,7 @@ bool pixel_engine::PERenderAPI::CreatePixelShader(const INIT_RENDER_API_DESC* de
             uint hi = buf.Load(base + 4);
             data = ((lo >> (inner * 8)) | (hi << ((4 - inner) * 8))) & 0x00FFFFFF;
         }
+#endif
 
         float r = ( data        & 0xFF) / 255.0;
         float g = ((data >>  8) & 0xFF) / 255.0;
@@ -435,12 +473,20 @@ bool pixel_engine::PERenderAPI::CreatePixelShader(const INIT_RENDER_API_DESC* de
     }
 )";
 
-    std::string wStr = std::to_string(desc->Width);
-    std::string hStr = std::to_string(desc->Height);
+    //~ same layout as PEImageBuffer, rows are padded to 4 bytes
+    const size_t pixelBytes = PixelFormatSize(m_eTargetFormat);
+    const size_t rowPitch   = (static_cast<size_t>(desc->Width) * pixelBytes + 3u) & ~size_t{ 3u };
+
+    std::string wStr     = std::to_string(desc->Width);
+    std::string hStr     = std::to_string(desc->Height);
+    std::string pitchStr = std::to_string(rowPitch);
+    std::string bytesStr = std::to_string(pixelBytes);
     D3D_SHADER_MACRO macros[] = 
     {
-        { "WIDTH",  wStr.c_str() },
-        { "HEIGHT", hStr.c_str() },
+        { "WIDTH",       wStr.c_str()     },
+        { "HEIGHT",      hStr.c_str()     },
+        { "ROW_PITCH",   pitchStr.c_str() },
+        { "PIXEL_BYTES", bytesStr.c_str() },
         { nullptr, nullptr }
     };
 
@@ -491,12 +537,8 @@ bool pixel_engine::PERenderAPI::CreatePixelShader(const INIT_RENDER_API_DESC* de
     logger::success(pixel_engine::logger_config::LogCategory::Render,
         "Created Pixel Shader!");
 
-    //~ configure backbuffer as a texture
-    const size_t dataSize =
-        static_cast<size_t>(desc->Width) *
-        static_cast<size_t>(desc->Height) * 3u;
-
-    m_PaddedDataSize = ((dataSize + 3u) / 4u) * 4u;
+    //~ configure backbuffer as a texture, Present copies the raster target as is
+    m_PaddedDataSize = rowPitch * static_cast<size_t>(desc->Height);
 
     D3D11_BUFFER_DESC bdesc{};
     bdesc.ByteWidth = static_cast<UINT>(m_PaddedDataSize);
@@ -536,6 +578,9 @@ bool pixel_engine::PERenderAPI::CreatePixelShader(const INIT_RENDER_API_DESC* de
         return false;
     }
 
+    m_pPresentTarget = std::make_unique<PED3D11PresentTarget>(
+        m_pDeviceContext.Get(), m_pCpuImageBuffer.Get());
+
     //~ Bind PS and SRV
     m_pDeviceContext->PSSetShader(m_pPixelShader.Get(), nullptr, 0u);
 
@@ -573,6 +618,7 @@ bool pixel_engine::PERenderAPI::InitializeRenderAPI(const INIT_RENDER_API_DESC*
 {
     if (not InitializeRaster2D(desc))    return false;
     if (not InitializeRenderQueue(desc)) return false;
+    if (not InitializeFrameGraph(desc))  return false;
     return true;
 }
 
@@ -581,6 +627,8 @@ bool pixel_engine::PERenderAPI::InitializeRaster2D(const INIT_RENDER_API_DESC* d
 {
     PFE_RASTER_CONSTRUCT_DESC rasterDesc{};
     rasterDesc.EnableBoundCheck = true;
+    rasterDesc.TargetFormat     = m_eTargetFormat;
+    rasterDesc.ClearColor       = { 237, 237, 199 };
     rasterDesc.Viewport = 
     {
         0,
@@ -609,3 +657,58 @@ bool pixel_engine::PERenderAPI::InitializeRenderQueue(const INIT_RENDER_API_DESC
     PERenderQueue::Init(renderDesc);
     return true;
 }
+
+_Use_decl_annotations_
+bool pixel_engine::PERenderAPI::InitializeFrameGraph(const INIT_RENDER_API_DESC* desc)
+{
+    (void)desc;
+    m_frameGraph.Clear();
+
+    //~ upload of the last frame overlaps the cull of this one, everything
+    //~ after touches the raster and waits for both. The sprites come from
+    //~ the snapshot the logic thread published, see PERenderQueue::Update
+    const FrameStageId upload = m_frameGraph.AddStage({
+        .Name    = "Upload",
+        .Lane    = EFrameStageLane::RenderThread,
+        .Execute = [this]() { UploadFrame(); } });
+
+    const FrameStageId cull = m_frameGraph.AddStage({
+        .Name    = "Cull",
+        .Lane    = EFrameStageLane::Worker,
+        .Execute = []() { PERenderQueue::Instance().CullSprites(); } });
+
+    const FrameStageId layoutFonts = m_frameGraph.AddStage({
+        .Name    = "LayoutFonts",
+        .Lane    = EFrameStageLane::Worker,
+        .Execute = []() { PERenderQueue::Instance().LayoutFonts(); } });
+
+    const FrameStageId prepare = m_frameGraph.AddStage({
+        .Name      = "PrepareTarget",
+        .Lane      = EFrameStageLane::RenderThread,
+        .Execute   = [this]() { PERenderQueue::Instance().PrepareTarget(m_pRaster2D.get()); },
+        .DependsOn = { upload, cull, layoutFonts } });
+
+    const FrameStageId bin = m_frameGraph.AddStage({
+        .Name      = "Bin",
+        .Lane      = EFrameStageLane::RenderThread,
+        .Execute   = [this]() { PERenderQueue::Instance().BinSprites(m_pRaster2D.get()); },
+        .DependsOn = { prepare } });
+
+    const FrameStageId rasterize = m_frameGraph.AddStage({
+        .Name      = "Rasterize",
+        .Lane      = EFrameStageLane::RenderThread,
+        .Execute   = [this]() { PERenderQueue::Instance().RasterizeSprites(m_pRaster2D.get()); },
+        .DependsOn = { bin } });
+
+    (void)m_frameGraph.AddStage({
+        .Name      = "Fonts",
+        .Lane      = EFrameStageLane::RenderThread,
+        .Execute   = [this]()
+        {
+            PERenderQueue::Instance().RenderFont(m_pRaster2D.get());
+            m_bFrameRendered = true;
+        },
+        .DependsOn = { rasterize } });
+
+    return true;
+}
@@ -24,6 +24,8 @@
 #include "pixel_engine/render_manager/components/camera/camera.h"
 
 #include "raster/raster.h"
+#include "present/d3d11_present.h"
+#include "graph/frame_graph.h"
 
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxgi.lib")
@@ -79,6 +81,11 @@ namespace pixel_engine
 		void WriteFrame();
 		void PresentFrame();
 
+		//~ upload stage of the frame graph, presents the frame rendered by
+		//~ the previous Execute while the workers sort and cull the next one
+		void UploadFrame();
+		void ReportStages(); // debug builds, every 5 seconds
+
 		//~ DirectX Creation
 		_NODISCARD _Check_return_
 		bool InitializeDirectX			 (_In_ const INIT_RENDER_API_DESC* desc);
@@ -102,6 +109,8 @@ namespace pixel_engine
 		bool InitializeRaster2D   (_In_ const INIT_RENDER_API_DESC* desc);
 		_NODISCARD _Check_return_
 		bool InitializeRenderQueue(_In_ const INIT_RENDER_API_DESC* desc);
+		_NODISCARD _Check_return_
+		bool InitializeFrameGraph (_In_ const INIT_RENDER_API_DESC* desc);
 
 	private:
 		//~ Core
@@ -115,6 +124,10 @@ namespace pixel_engine
 		std::unique_ptr<GameClock> m_pClock{ nullptr };
 		
 		std::unique_ptr<PERaster2D>  m_pRaster2D { nullptr };
+		std::unique_ptr<PED3D11PresentTarget> m_pPresentTarget{ nullptr };
+
+		PEFrameGraph m_frameGraph	 {};
+		bool		 m_bFrameRendered{ false }; // waiting for the next upload stage
 
 		//~ Thread Members
 		HANDLE m_handleStartEvent      { nullptr }; // render manager will own it
@@ -126,6 +139,7 @@ namespace pixel_engine
 		//~ Render Members
 		D3D11_VIEWPORT m_Viewport	   {};
 		size_t		   m_PaddedDataSize{ 0u };
+		EPixelFormat   m_eTargetFormat { EPixelFormat::R8G8B8A8 }; // matches the swapchain
 
 		Microsoft::WRL::ComPtr<ID3D11Device>			 m_pDevice		  { nullptr };
 		Microsoft::WRL::ComPtr<ID3D11DeviceContext>		 m_pDeviceContext { nullptr };
@@ -48,6 +48,9 @@ pixel_engine::Texture* pixel_engine::TextureResource::LoadTexture(
         if (!texture)
             THROW_MSG(("Failed to load PNG texture: " + path).c_str());
 
+        //~ once per source, every scale of it samples from these
+        if (m_bBuildMips) texture->BuildMips();
+
         Texture* raw = texture.get();
         m_cacheTextures[path] = std::move(texture);
         return raw;
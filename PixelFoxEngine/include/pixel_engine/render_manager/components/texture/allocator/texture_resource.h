@@ -35,7 +35,15 @@ namespace pixel_engine
 		_NODISCARD _Check_return_ _Success_(return != nullptr)
 		Texture* LoadTexture(_In_ const std::string& path);
 
+		//~ on unless changed, textures loaded afterwards get a mip pyramid
+		//~ the sampler starts its resamples from
+		void SetBuildMips(_In_ bool build) noexcept { m_bBuildMips = build; }
+
+		_NODISCARD _Check_return_
+		bool IsBuildMips() const noexcept { return m_bBuildMips; }
+
 	private:
 		fox::unordered_map<std::string, std::unique_ptr<Texture>> m_cacheTextures{};
+		bool m_bBuildMips{ true };
 	};
 } // pixel_engine
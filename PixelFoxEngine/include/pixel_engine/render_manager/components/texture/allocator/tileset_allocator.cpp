@@ -1,29 +1,36 @@
 #include "pch.h"
 #include "tileset_allocator.h"
-#include <sstream>
 
 #include "texture_resource.h"
 
-_Use_decl_annotations_
-std::string pixel_engine::_PFE_CREATE_TILE_SET_FROM_SLICE::GetHashKey() const
+#include <cmath>
+
+pixel_engine::PFE_TILE_SET_KEY
+pixel_engine::_PFE_CREATE_TILE_SET_FROM_SLICE::GetKey() const noexcept
 {
-    std::ostringstream oss;
-    oss << tileFilePath
-        << '(' << tileSize << ')'
-        << '(' << scaledBy.x << ',' << scaledBy.y << ')'
-        << '(' << sliceWidth << ',' << sliceHeight << ')'
-        << '(' << margin << ',' << spacing;
-    return oss.str();
+    PFE_TILE_SET_KEY key{};
+    key.pathHash    = Hash64(tileFilePath);
+    key.tileSize    = tileSize;
+    key.scaleX      = static_cast<int32_t>(std::lround(scaledBy.x * kTileSetScaleSteps));
+    key.scaleY      = static_cast<int32_t>(std::lround(scaledBy.y * kTileSetScaleSteps));
+    key.sliceWidth  = sliceWidth;
+    key.sliceHeight = sliceHeight;
+    key.margin      = margin;
+    key.spacing     = spacing;
+    return key;
 }
 
 _Use_decl_annotations_
 pixel_engine::TileSet* pixel_engine::TileSetAllocator::
 BuildTexture(const PFE_CREATE_TILE_SET_FROM_SLICE& desc)
 {
-    auto key = desc.GetHashKey();
-    if (m_cachedTileSets.contains(key))
+    const PFE_TILE_SET_KEY key = desc.GetKey();
+    if (const auto* cached = m_cachedTileSets.find(key))
     {
-        return m_cachedTileSets[key].get();
+        if (cached->path == desc.tileFilePath) return cached->tileSet.get();
+
+        logger::error("Tile set {} collides with {}, not cached",
+            desc.tileFilePath, cached->path);
     }
 
     auto texture = TextureResource::Instance().LoadTexture(desc.tileFilePath);
@@ -47,7 +54,15 @@ BuildTexture(const PFE_CREATE_TILE_SET_FROM_SLICE& desc)
         logger::error("Failed to slice {} tileset", desc.tileFilePath);
         return nullptr;
     }
-    m_cachedTileSets[key] = std::move(tileSet);
+    //~ a colliding path is handed out uncached rather than replacing the other
+    if (m_cachedTileSets.contains(key))
+    {
+        m_uncachedTileSets.push_back(std::move(tileSet));
+        return m_uncachedTileSets.back().get();
+    }
 
-    return m_cachedTileSets[key].get();
+    TILE_SET_ENTRY& entry = m_cachedTileSets[key];
+    entry.path    = desc.tileFilePath;
+    entry.tileSet = std::move(tileSet);
+    return entry.tileSet.get();
 }
@@ -17,9 +17,45 @@
 
 #include "pixel_engine/core/interface/interface_singleton.h"
 #include "pixel_engine/render_manager/components/texture/resource/tileset.h"
+#include "pixel_engine/utilities/hash_type.h"
 
 namespace pixel_engine
 {
+	//~ scales are keyed in 1/1024 steps, anything closer shares a tile set
+	inline constexpr float kTileSetScaleSteps = 1024.0f;
+
+	//~ the path is only hashed, the cache compares it on a hit
+	typedef struct _PFE_TILE_SET_KEY
+	{
+		uint64_t pathHash   { 0u };
+		int32_t	 tileSize   { 0 };
+		int32_t	 scaleX	    { 0 }; // scale * kTileSetScaleSteps, rounded
+		int32_t	 scaleY	    { 0 };
+		int32_t	 sliceWidth { 0 };
+		int32_t	 sliceHeight{ 0 };
+		int32_t	 margin	    { 0 };
+		int32_t	 spacing    { 0 };
+
+		bool operator==(_In_ const _PFE_TILE_SET_KEY& other) const noexcept = default;
+	} PFE_TILE_SET_KEY;
+
+	struct PFE_TILE_SET_KEY_HASH
+	{
+		_NODISCARD
+		size_t operator()(_In_ const PFE_TILE_SET_KEY& key) const noexcept
+		{
+			uint64_t hash = key.pathHash;
+			hash = HashCombine(hash, static_cast<uint32_t>(key.tileSize));
+			hash = HashCombine(hash, static_cast<uint64_t>(static_cast<uint32_t>(key.scaleX)) << 32 |
+									 static_cast<uint32_t>(key.scaleY));
+			hash = HashCombine(hash, static_cast<uint64_t>(static_cast<uint32_t>(key.sliceWidth)) << 32 |
+									 static_cast<uint32_t>(key.sliceHeight));
+			hash = HashCombine(hash, static_cast<uint64_t>(static_cast<uint32_t>(key.margin)) << 32 |
+									 static_cast<uint32_t>(key.spacing));
+			return static_cast<size_t>(hash);
+		}
+	};
+
 	typedef struct _PFE_CREATE_TILE_SET_FROM_SLICE
 	{
 		_In_ std::string tileFilePath;
@@ -42,8 +78,9 @@ namespace pixel_engine
 					sliceWidth   == other.sliceWidth;
 		}
 
+		//~ cache key, hashes the path in place without copying it
 		_NODISCARD _Check_return_
-		std::string GetHashKey() const;
+		PFE_TILE_SET_KEY GetKey() const noexcept;
 
 	} PFE_CREATE_TILE_SET_FROM_SLICE;
 
@@ -60,7 +97,14 @@ namespace pixel_engine
 		TileSet* BuildTexture(_In_ const PFE_CREATE_TILE_SET_FROM_SLICE& desc);
 
 	private:
-		fox::unordered_map<std::string,
-			std::unique_ptr<TileSet>> m_cachedTileSets{};
+		typedef struct _TILE_SET_ENTRY
+		{
+			std::string				 path   {}; // tells two paths with one hash apart
+			std::unique_ptr<TileSet> tileSet{ nullptr };
+		} TILE_SET_ENTRY;
+
+		fox::unordered_map<PFE_TILE_SET_KEY, TILE_SET_ENTRY,
+			PFE_TILE_SET_KEY_HASH> m_cachedTileSets{};
+		fox::vector<std::unique_ptr<TileSet>> m_uncachedTileSets{};
 	};
 } // pixel_engine
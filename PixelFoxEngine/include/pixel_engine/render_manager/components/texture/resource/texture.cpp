@@ -13,6 +13,80 @@
 #include "texture.h"
 #include <algorithm>
 
+namespace
+{
+	//~ rounded c * a / 255, the same division the blend kernels use
+	inline uint8_t MulDiv255(uint32_t c, uint32_t a) noexcept
+	{
+		const uint32_t t = c * a + 128u;
+		return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+	}
+
+	//~ next mip level, 2x2 box over the texels that are not keyed out. A
+	//~ footprint that is mostly key stays key so the level keeps its shape
+	std::unique_ptr<pixel_engine::Texture> DownsampleMip(
+		const pixel_engine::Texture& src,
+		uint32_t					 level)
+	{
+		using namespace pixel_engine;
+
+		const uint32_t srcW = src.GetWidth ();
+		const uint32_t srcH = src.GetHeight();
+		const uint32_t dstW = std::max(1u, srcW / 2u);
+		const uint32_t dstH = std::max(1u, srcH / 2u);
+		const uint32_t bpp	= src.BytesPerPixel();
+		const uint32_t srcStride = src.GetRowStride();
+		const uint32_t dstStride = dstW * bpp;
+
+		fox::vector<unsigned char> data{};
+		data.assign(static_cast<size_t>(dstStride) * dstH, 0u);
+
+		const uint8_t* base = src.GetRaw().data();
+		for (uint32_t y = 0; y < dstH; ++y)
+		{
+			const uint32_t y0 = std::min(y * 2u,	  srcH - 1u);
+			const uint32_t y1 = std::min(y * 2u + 1u, srcH - 1u);
+			uint8_t*	   out = data.data() + static_cast<size_t>(y) * dstStride;
+
+			for (uint32_t x = 0; x < dstW; ++x, out += bpp)
+			{
+				const uint32_t x0 = std::min(x * 2u,	  srcW - 1u);
+				const uint32_t x1 = std::min(x * 2u + 1u, srcW - 1u);
+				const uint32_t xs[4]{ x0, x1, x0, x1 };
+				const uint32_t ys[4]{ y0, y0, y1, y1 };
+
+				uint32_t sum[4]{};
+				uint32_t visible = 0u;
+				for (int t = 0; t < 4; ++t)
+				{
+					if (src.GetPixel(xs[t], ys[t]).IsBlack()) continue;
+
+					const uint8_t* texel = base + static_cast<size_t>(ys[t]) * srcStride +
+												  static_cast<size_t>(xs[t]) * bpp;
+					for (uint32_t c = 0; c < bpp; ++c) sum[c] += texel[c];
+					++visible;
+				}
+
+				if (visible < 2u) continue;
+				for (uint32_t c = 0; c < bpp; ++c)
+				{
+					out[c] = static_cast<uint8_t>((sum[c] + visible / 2u) / visible);
+				}
+			}
+		}
+
+		return std::make_unique<Texture>(
+			src.GetFilePath() + "_mip" + std::to_string(level),
+			dstW,
+			dstH,
+			src.GetFormat(),
+			src.GetColorSpace(),
+			std::move(data),
+			dstStride,
+			src.GetOrigin(),
+			src.IsPremultipliedAlpha());
+	}
+} // namespace
 
 _Use_decl_annotations_
 pixel_engine::Texture::Texture(
@@ -185,6 +259,139 @@ void pixel_engine::Texture::Release()
 	m_ppByteColors.clear();
 	m_ppByteColors.shrink_to_fit();
 	m_nWidth = m_nHeight = m_nRowStride = 0u;
+
+	m_eCoverage = TextureCoverage::Unknown;
+	m_coverageRuns.clear();
+	m_coverageRowStart.clear();
+
+	m_premultiplied.clear();
+	m_premultiplied.shrink_to_fit();
+
+	m_mips.clear();
+}
+
+void pixel_engine::Texture::BuildCoverage()
+{
+	m_coverageRuns.clear();
+	m_coverageRowStart.clear();
+	m_eCoverage = TextureCoverage::Unknown;
+
+	if (IsEmpty()) return;
+
+	m_coverageRowStart.reserve(static_cast<size_t>(m_nHeight) + 1u);
+
+	size_t visible = 0u;
+	for (uint32_t y = 0; y < m_nHeight; ++y)
+	{
+		m_coverageRowStart.push_back(static_cast<uint32_t>(m_coverageRuns.size()));
+
+		uint32_t x = 0u;
+		while (x < m_nWidth)
+		{
+			//~ same key the rasterizer uses, black means transparent
+			while (x < m_nWidth && GetPixel(x, y).IsBlack()) ++x;
+			if (x == m_nWidth) break;
+
+			PFE_COVERAGE_RUN run{};
+			run.begin = x;
+			while (x < m_nWidth && !GetPixel(x, y).IsBlack()) ++x;
+			run.end = x;
+
+			visible += run.end - run.begin;
+			m_coverageRuns.push_back(run);
+		}
+	}
+	m_coverageRowStart.push_back(static_cast<uint32_t>(m_coverageRuns.size()));
+
+	const size_t total = static_cast<size_t>(m_nWidth) * m_nHeight;
+	if		(visible == 0u)	   m_eCoverage = TextureCoverage::Transparent;
+	else if (visible == total) m_eCoverage = TextureCoverage::Opaque;
+	else					   m_eCoverage = TextureCoverage::Mixed;
+}
+
+void pixel_engine::Texture::BuildPremultiplied()
+{
+	m_premultiplied.clear();
+	if (IsEmpty()) return;
+
+	m_premultiplied.resize(static_cast<size_t>(m_nWidth) * m_nHeight * 4u);
+
+	const uint32_t bpp = BytesPerPixel();
+	uint8_t*	   out = m_premultiplied.data();
+
+	for (uint32_t y = 0; y < m_nHeight; ++y)
+	{
+		const uint8_t* row = m_ppByteColors.data() + static_cast<size_t>(y) * m_nRowStride;
+		for (uint32_t x = 0; x < m_nWidth; ++x, out += 4)
+		{
+			const PFE_FORMAT_R8G8B8_UINT color = GetPixel(x, y);
+			const uint32_t alpha = (m_Format == TextureFormat::RGBA8) ? row[x * bpp + 3u] : 255u;
+
+			if (m_bPremultipliedAlpha || alpha == 255u)
+			{
+				out[0] = color.R.Value;
+				out[1] = color.G.Value;
+				out[2] = color.B.Value;
+			}
+			else
+			{
+				out[0] = MulDiv255(color.R.Value, alpha);
+				out[1] = MulDiv255(color.G.Value, alpha);
+				out[2] = MulDiv255(color.B.Value, alpha);
+			}
+			out[3] = static_cast<uint8_t>(alpha);
+		}
+	}
+}
+
+void pixel_engine::Texture::BuildMips()
+{
+	m_mips.clear();
+	if (IsEmpty()) return;
+
+	const Texture* level = this;
+	while (level->GetWidth() > 1u || level->GetHeight() > 1u)
+	{
+		auto next = DownsampleMip(*level, static_cast<uint32_t>(m_mips.size()) + 1u);
+		level = next.get();
+		m_mips.push_back(std::move(next));
+	}
+}
+
+_Use_decl_annotations_
+const pixel_engine::Texture* pixel_engine::Texture::GetMip(uint32_t level) const noexcept
+{
+	if (level == 0u || m_mips.empty()) return this;
+
+	const size_t index = std::min<size_t>(level, m_mips.size()) - 1u;
+	return m_mips[index].get();
+}
+
+_Use_decl_annotations_
+const pixel_engine::Texture* pixel_engine::Texture::SelectMip(
+	uint32_t outWidth,
+	uint32_t outHeight) const noexcept
+{
+	const Texture* selected = this;
+	for (const auto& mip : m_mips)
+	{
+		if (mip->GetWidth() < outWidth || mip->GetHeight() < outHeight) break;
+		selected = mip.get();
+	}
+	return selected;
+}
+
+_Use_decl_annotations_
+const pixel_engine::PFE_COVERAGE_RUN* pixel_engine::Texture::GetCoverageRuns(
+	uint32_t  y,
+	uint32_t& count) const noexcept
+{
+	count = 0u;
+	if (!HasCoverage() || y >= m_nHeight) return nullptr;
+
+	const uint32_t first = m_coverageRowStart[y];
+	count = m_coverageRowStart[static_cast<size_t>(y) + 1u] - first;
+	return count ? m_coverageRuns.data() + first : nullptr;
 }
 
 _Use_decl_annotations_
@@ -20,6 +20,7 @@
 
 #include <string>
 #include <cstdint>
+#include <memory>
 
 namespace pixel_engine
 {
@@ -92,6 +93,21 @@ namespace pixel_engine
 		}
 	};
 
+	enum class TextureCoverage : uint8_t
+	{
+		Unknown,	 // BuildCoverage was never called
+		Transparent, // every texel is keyed out
+		Opaque,		 // no texel is keyed out
+		Mixed
+	};
+
+	//~ run of visible (not black keyed) texels [begin, end) on one row
+	typedef struct _PFE_COVERAGE_RUN
+	{
+		uint32_t begin{ 0u };
+		uint32_t end  { 0u };
+	} PFE_COVERAGE_RUN;
+
 	class PFE_API Texture
 	{
 	public:
@@ -141,6 +157,44 @@ namespace pixel_engine
 
 		void Release();
 
+		//~ Coverage, rebuild after editing texels through Data() / Row()
+		void BuildCoverage();
+
+		_NODISCARD _Check_return_ bool			  HasCoverage() const noexcept { return m_eCoverage != TextureCoverage::Unknown; }
+		_NODISCARD _Check_return_ TextureCoverage GetCoverage() const noexcept { return m_eCoverage; }
+
+		//~ visible runs of a row, count is 0 for fully keyed rows
+		_NODISCARD _Check_return_ _Ret_maybenull_
+		const PFE_COVERAGE_RUN* GetCoverageRuns(
+			_In_  uint32_t  y,
+			_Out_ uint32_t& count) const noexcept;
+
+		//~ Premultiplied RGBA8 copy (width * 4 bytes per row) for the alpha
+		//~ blended raster path, rebuild after editing texels as well
+		void BuildPremultiplied();
+
+		_NODISCARD _Check_return_ bool HasPremultiplied() const noexcept { return !m_premultiplied.empty(); }
+		_NODISCARD _Check_return_ const fox::vector<uint8_t>& GetPremultiplied() const noexcept { return m_premultiplied; }
+
+		//~ Mip pyramid, level 0 is this texture and every level halves both
+		//~ sides down to 1x1. Keyed (black) texels stay out of the average
+		//~ so silhouettes keep their edge instead of fading into the key
+		void BuildMips();
+
+		_NODISCARD _Check_return_ bool	   HasMips	  () const noexcept { return !m_mips.empty(); }
+		_NODISCARD _Check_return_ uint32_t GetMipCount() const noexcept { return 1u + static_cast<uint32_t>(m_mips.size()); }
+
+		//~ clamped to the last level
+		_NODISCARD _Check_return_ _Ret_notnull_
+		const Texture* GetMip(_In_ uint32_t level) const noexcept;
+
+		//~ smallest level still covering the output, so a resample from it
+		//~ never shrinks by more than 2x; this texture when there are no mips
+		_NODISCARD _Check_return_ _Ret_notnull_
+		const Texture* SelectMip(
+			_In_ uint32_t outWidth,
+			_In_ uint32_t outHeight) const noexcept;
+
 		//~ Helpers
 		_NODISCARD _Check_return_ uint32_t ChannelCount () const noexcept;
 		_NODISCARD _Check_return_ uint32_t BytesPerPixel() const noexcept;
@@ -155,6 +209,14 @@ namespace pixel_engine
 		bool					   m_bPremultipliedAlpha{		false			};
 		std::string				   m_szSourcePath		{		"Unknown"		};
 		fox::vector<uint8_t>	   m_ppByteColors		{};
+
+		TextureCoverage			   m_eCoverage			{ TextureCoverage::Unknown };
+		fox::vector<PFE_COVERAGE_RUN> m_coverageRuns	{};
+		fox::vector<uint32_t>	   m_coverageRowStart	{}; // height + 1 offsets into m_coverageRuns
+
+		fox::vector<uint8_t>	   m_premultiplied		{};
+
+		fox::vector<std::unique_ptr<Texture>> m_mips	{}; // level 1 onwards
 	};
 
 } // namespace pixel_engine
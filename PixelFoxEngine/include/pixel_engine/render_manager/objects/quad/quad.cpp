@@ -18,6 +18,11 @@
 
 using namespace pixel_engine;
 
+QuadObject::QuadObject()
+{
+    SetLayer(ELayer::Obstacles);
+}
+
 _Use_decl_annotations_
 std::string QuadObject::GetObjectName() const
 {
@@ -51,7 +56,7 @@ void QuadObject::SetTransform(const FTransform2D& t)
 }
 
 _Use_decl_annotations_
-const FTransform2D& QuadObject::GetTransform() const
+FTransform2D QuadObject::GetTransform() const
 {
     return m_pRigidBody2D->GetTransform();
 }
@@ -85,17 +90,14 @@ void QuadObject::SetRotation(float radians)
 _Use_decl_annotations_
 void QuadObject::SetScale(float sx, float sy)
 {
-    m_scale.x = sx;
-    m_scale.y = sy;
-    m_pRigidBody2D->m_transform.Scale = m_scale;
+    m_pRigidBody2D->SetScale({ sx, sy });
     m_bResampleNeeded = true;
     MarkDirty(true);
 }
 
 void pixel_engine::QuadObject::SetScale(const FVector2D& scale)
 {
-    m_scale = scale;
-    m_pRigidBody2D->m_transform.Scale = m_scale;
+    m_pRigidBody2D->SetScale(scale);
     m_bResampleNeeded = true;
     MarkDirty(true);
 }
@@ -103,8 +105,8 @@ void pixel_engine::QuadObject::SetScale(const FVector2D& scale)
 _Use_decl_annotations_
 void QuadObject::SetPivot(float px, float py)
 {
-    // TODO: Create a pivot
-    // MarkDirty(true);
+    m_pRigidBody2D->SetPivot({ px, py });
+    MarkDirty(true);
 }
 
 _Use_decl_annotations_
@@ -143,13 +145,13 @@ float QuadObject::GetRotation() const
 _Use_decl_annotations_
 fox_math::Vector2D<float> QuadObject::GetScale() const
 {
-    return m_scale;
+    return m_pRigidBody2D->GetScale();
 }
 
 _Use_decl_annotations_
 fox_math::Vector2D<float> QuadObject::GetPivot() const
 {
-    return {0 ,0};
+    return m_pRigidBody2D->GetPivot();
 }
 
 _Use_decl_annotations_
@@ -167,13 +169,15 @@ bool QuadObject::IsVisible() const
 _Use_decl_annotations_
 void QuadObject::SetLayer(ELayer l)
 {
-    m_layer = l;
+    auto& store = PETransformStore::Instance();
+    store.Columns().Layer[store.Index(GetTransformHandle())] = static_cast<uint8_t>(l);
 }
 
 _Use_decl_annotations_
 ELayer QuadObject::GetLayer() const
 {
-    return m_layer;
+    const auto& store = PETransformStore::Instance();
+    return static_cast<ELayer>(store.Columns().Layer[store.Index(GetTransformHandle())]);
 }
 
 _Use_decl_annotations_
@@ -185,52 +189,31 @@ Texture* pixel_engine::QuadObject::GetTexture() const
 _Use_decl_annotations_
 FVector2D pixel_engine::QuadObject::GetUAxisRelativeToCamera() const noexcept
 {
-    return m_ObjectCameraAxisU;
+    const auto&  store = PETransformStore::Instance();
+    const size_t i     = store.Index(GetTransformHandle());
+    return { store.Columns().ViewUX[i], store.Columns().ViewUY[i] };
 }
 
 _Use_decl_annotations_
 FVector2D pixel_engine::QuadObject::GetVAxisRelativeToCamera() const noexcept
 {
-    return m_ObjectCameraAxisV;
+    const auto&  store = PETransformStore::Instance();
+    const size_t i     = store.Index(GetTransformHandle());
+    return { store.Columns().ViewVX[i], store.Columns().ViewVY[i] };
 }
 
 _Use_decl_annotations_
 FVector2D pixel_engine::QuadObject::GetPositionRelativeToCamera() const noexcept
 {
-    return m_ObjectCameraViewPosition;
+    const auto&  store = PETransformStore::Instance();
+    const size_t i     = store.Index(GetTransformHandle());
+    return { store.Columns().ViewX[i], store.Columns().ViewY[i] };
 }
 
 _Use_decl_annotations_
 void pixel_engine::QuadObject::UpdateObjectToCameraSpace(const PFE_WORLD_SPACE_DESC& cameraView)
 {
-    FVector2D CamUx
-    {
-        cameraView.X1.x - cameraView.Origin.x,
-        cameraView.X1.y - cameraView.Origin.y
-    };
-    FVector2D CamUy{
-        cameraView.Y1.x - cameraView.Origin.x,
-        cameraView.Y1.y - cameraView.Origin.y
-    };
-
-    auto matrix = m_pRigidBody2D->GetTransform().ToMatrix().matrix;
-    const float a  = matrix[0][0];
-    const float b  = matrix[0][1];
-    const float tx = matrix[0][2];
-    const float c  = matrix[1][0];
-    const float d  = matrix[1][1];
-    const float ty = matrix[1][2];
-
-    const FVector2D u_local{ a, c };
-    const FVector2D v_local{ b, d };
-    const FVector2D center_local{ tx, ty };
-
-    m_ObjectCameraAxisU.x = u_local.x * CamUx.x + u_local.y * CamUy.x;
-    m_ObjectCameraAxisU.y = u_local.x * CamUx.y + u_local.y * CamUy.y;
-
-    m_ObjectCameraAxisV.x = v_local.x * CamUx.x + v_local.y * CamUy.x;
-    m_ObjectCameraAxisV.y = v_local.x * CamUx.y + v_local.y * CamUy.y;
-
-    m_ObjectCameraViewPosition.x = cameraView.Origin.x + center_local.x * CamUx.x + center_local.y * CamUy.x;
-    m_ObjectCameraViewPosition.y = cameraView.Origin.y + center_local.x * CamUx.y + center_local.y * CamUy.y;
+    //~ the physics queue does this for all of its sprites in one sweep
+    PETransformStore::Instance().UpdateCameraSpace(
+        GetTransformHandle(), cameraView.Origin, cameraView.X1, cameraView.Y1);
 }
@@ -19,7 +19,7 @@ namespace pixel_engine
     class PFE_API QuadObject final : public PEISprite
     {
     public:
-         QuadObject()          = default;
+         QuadObject();
         ~QuadObject() override = default;
 
         _NODISCARD _Check_return_
@@ -36,7 +36,7 @@ namespace pixel_engine
         void SetTransform(_In_ const FTransform2D& t) override;
         
         _NODISCARD _Check_return_
-        const FTransform2D& GetTransform() const override;
+        FTransform2D GetTransform() const override;
 
         _NODISCARD _Check_return_
         FMatrix2DAffine GetAffineMatrix () const override;
@@ -82,15 +82,9 @@ namespace pixel_engine
         void UpdateObjectToCameraSpace(_In_ const PFE_WORLD_SPACE_DESC& space);
 
     private:
+        //~ scale, layer and the camera space axes live in the transform store
         std::string  m_szTexturePath{};
         Texture*     m_pTexture     { nullptr };
         bool         m_visible      { true };
-        ELayer       m_layer        { ELayer::Obstacles };
-        FVector2D    m_scale{ 1.f, 1.f };
-
-        //~ relative to the camera
-        FVector2D m_ObjectCameraAxisU       {};
-        FVector2D m_ObjectCameraAxisV       {};
-        FVector2D m_ObjectCameraViewPosition{};
     };
 } // namespace pixel_engine
@@ -13,8 +13,11 @@
 #include "render_manager.h"
 
 #include "pixel_engine/core/event/event_windows.h"
+#include "pixel_engine/core/jobs/job_system.h"
 #include "pixel_engine/utilities/logger/logger.h"
 #include "pixel_engine/physics_manager/physics_queue.h"
+#include "pixel_engine/render_manager/render_queue/render_queue.h"
+#include "pixel_engine/render_manager/render_queue/sampler/sample_allocator.h"
 
 _Use_decl_annotations_
 pixel_engine::PERenderManager::PERenderManager(
@@ -67,6 +70,12 @@ bool pixel_engine::PERenderManager::Release()
     SafeCloseEvent_(m_handleStartEvent);
     SafeCloseEvent_(m_handleEndEvent);
 
+    //~ the sampler worker reads source textures, stop it before they go
+    Sampler::Instance().Shutdown();
+
+    //~ render thread and sampler worker stopped, join the job workers too
+    if (auto* jobs = PEJobSystem::TryGet()) jobs->Shutdown();
+
     m_pRenderAPI.reset();
 	return true;
 }
@@ -83,6 +92,9 @@ void pixel_engine::PERenderManager::OnFrameEnd()
     PhysicsQueue::Instance().FrameEnd();
     m_pCamera->OnFrameEnd();
 
+    //~ the sprites are final for this frame, hand the render thread a copy
+    PERenderQueue::Instance().Update();
+
     if (m_pRenderAPI)
     {
         // TODO: Try something else for syncing
@@ -0,0 +1,122 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/utilities/id_allocator.h"
+
+#include "core/vector.h"
+
+namespace pixel_engine
+{
+	/// <summary>
+	/// Items kept sorted by instance id. Ids are handed out in increasing
+	/// order so an insert is almost always an append, the rest pay a binary
+	/// search and a short shift. Erase leaves a hole with the id still in
+	/// place so the search stays valid, holes are squeezed out once they
+	/// make up half the bucket.
+	/// </summary>
+	template<typename T>
+	class PEOrderedBucket
+	{
+	public:
+		typedef struct _ENTRY
+		{
+			UniqueId id  { 0u };
+			T*		 item{ nullptr }; // nullptr once erased
+		} ENTRY;
+
+		void Insert(_In_ UniqueId id, _In_ T* item)
+		{
+			if (!item) return;
+
+			if (m_entries.empty() || m_entries.back().id < id)
+			{
+				m_entries.push_back({ id, item });
+				return;
+			}
+
+			const size_t at = LowerBound(id);
+			if (at < m_entries.size() && m_entries[at].id == id)
+			{
+				if (!m_entries[at].item) --m_nHoles;
+				m_entries[at].item = item;
+				return;
+			}
+			(void)m_entries.insert(m_entries.begin() + at, ENTRY{ id, item });
+		}
+
+		bool Erase(_In_ UniqueId id)
+		{
+			const size_t at = LowerBound(id);
+			if (at >= m_entries.size() || m_entries[at].id != id || !m_entries[at].item) return false;
+
+			m_entries[at].item = nullptr;
+			if (++m_nHoles * 2u > m_entries.size()) Compact();
+			return true;
+		}
+
+		void Clear() noexcept
+		{
+			m_entries.clear();
+			m_nHoles = 0u;
+		}
+
+		_NODISCARD _Check_return_
+		bool Contains(_In_ UniqueId id) const noexcept
+		{
+			const size_t at = LowerBound(id);
+			return at < m_entries.size() && m_entries[at].id == id && m_entries[at].item;
+		}
+
+		//~ in id order, erased entries have a null item
+		_NODISCARD _Check_return_
+		const fox::vector<ENTRY>& Entries() const noexcept { return m_entries; }
+
+		_NODISCARD _Check_return_
+		size_t Size() const noexcept { return m_entries.size() - m_nHoles; }
+
+		_NODISCARD _Check_return_
+		bool Empty() const noexcept { return Size() == 0u; }
+
+	private:
+		_NODISCARD _Check_return_
+		size_t LowerBound(_In_ UniqueId id) const noexcept
+		{
+			size_t lo = 0u;
+			size_t hi = m_entries.size();
+			while (lo < hi)
+			{
+				const size_t mid = lo + (hi - lo) / 2u;
+				if (m_entries[mid].id < id) lo = mid + 1u;
+				else						hi = mid;
+			}
+			return lo;
+		}
+
+		void Compact()
+		{
+			size_t write = 0u;
+			for (size_t read = 0u; read < m_entries.size(); ++read)
+			{
+				if (m_entries[read].item) m_entries[write++] = m_entries[read];
+			}
+			(void)m_entries.erase(m_entries.begin() + write, m_entries.end());
+			m_nHoles = 0u;
+		}
+
+	private:
+		fox::vector<ENTRY> m_entries{};
+		size_t			   m_nHoles { 0u };
+	};
+} // namespace pixel_engine
@@ -13,13 +13,111 @@
 #include "render_queue.h"
 
 #include "pixel_engine/render_manager/api/raster/raster.h"
+#include "pixel_engine/physics_manager/physics_api/store/transform_store.h"
 #include "sampler/sample_allocator.h"
 #include "pixel_engine/utilities/logger/logger.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace pixel_engine;
 
+namespace
+{
+    //~ static layer cull cells, in tiles
+    constexpr int kCullCellTiles = 4;
+
+    //~ the sprite would produce the same pixels as last frame
+    bool SameDraw(const PFE_SPRITE_DRAW& a, const PFE_SPRITE_DRAW& b) noexcept
+    {
+        return a.grid.RowStart   == b.grid.RowStart   &&
+               a.grid.deltaAxisU == b.grid.deltaAxisU &&
+               a.grid.deltaAxisV == b.grid.deltaAxisV &&
+               a.grid.cols       == b.grid.cols       &&
+               a.grid.rows       == b.grid.rows       &&
+               a.sampledTexture  == b.sampledTexture  &&
+               a.blendMode       == b.blendMode       &&
+               a.opacity         == b.opacity         &&
+               a.background      == b.background;
+    }
+
+    bool SameGlyphs(const fox::vector<FONT_POSITION>& a, const fox::vector<FONT_POSITION>& b) noexcept
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].sampledTexture != b[i].sampledTexture ||
+                !(a[i].startPosition == b[i].startPosition)) return false;
+        }
+        return true;
+    }
+
+    size_t LayerIndex(ELayer layer) noexcept
+    {
+        return std::min(static_cast<size_t>(layer), static_cast<size_t>(ELayer::Font));
+    }
+
+    //~ layer is the bucket it was published from, a sprite that just moved
+    //~ keeps its old place for this one frame
+    PFE_SPRITE_SNAPSHOT MakeSnapshot(UniqueId id, const PEISprite* sprite, Texture* sampled, ELayer layer, bool cacheable)
+    {
+        PFE_SPRITE_SNAPSHOT record{};
+        record.id             = id;
+        record.center         = sprite->GetPositionRelativeToCamera();
+        record.axisU          = sprite->GetUAxisRelativeToCamera();
+        record.axisV          = sprite->GetVAxisRelativeToCamera();
+        record.sampledTexture = sampled;
+        record.blendMode      = sprite->GetBlendMode();
+        record.opacity        = sprite->GetOpacity();
+        record.layer          = layer;
+        record.background     = sprite->GetLayer() == ELayer::Background;
+        record.cacheable      = cacheable;
+        return record;
+    }
+
+    PFE_STATIC_SPRITE_KEY MakeStaticKey(
+        const PETransformStore& store,
+        UniqueId                id,
+        const PEISprite*        sprite,
+        const Texture*          sampled,
+        ELayer                  layer)
+    {
+        const auto&  c = store.Columns();
+        const size_t i = store.Index(sprite->GetTransformHandle());
+
+        PFE_STATIC_SPRITE_KEY key{};
+        key.id         = id;
+        key.texture    = sampled;
+        key.x          = c.PositionX[i];
+        key.y          = c.PositionY[i];
+        key.rotation   = c.Rotation [i];
+        key.scaleX     = c.ScaleX   [i];
+        key.scaleY     = c.ScaleY   [i];
+        key.layer      = layer;
+        key.background = sprite->GetLayer() == ELayer::Background;
+        return key;
+    }
+
+    bool SameStaticKeys(const fox::vector<PFE_STATIC_SPRITE_KEY>& a, const fox::vector<PFE_STATIC_SPRITE_KEY>& b) noexcept
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].id       != b[i].id       ||
+                a[i].texture  != b[i].texture  ||
+                a[i].x        != b[i].x        ||
+                a[i].y        != b[i].y        ||
+                a[i].rotation != b[i].rotation ||
+                a[i].scaleX   != b[i].scaleX   ||
+                a[i].scaleY   != b[i].scaleY   ||
+                a[i].layer    != b[i].layer    ||
+                a[i].background != b[i].background) return false;
+        }
+        return true;
+    }
+} // namespace
+
 _Use_decl_annotations_
 PERenderQueue::PERenderQueue(const PFE_RENDER_QUEUE_CONSTRUCT_DESC& desc)
     : m_nScreenHeight(desc.ScreenHeight),
@@ -29,7 +127,6 @@ PERenderQueue::PERenderQueue(const PFE_RENDER_QUEUE_CONSTRUCT_DESC& desc)
 {
     m_nTileStep = 1.f / static_cast<float>(m_nTilePx);
     CreateCulling2D(desc);
-    m_bDirtySprite.store(true, std::memory_order_release);
 }
 
 _Use_decl_annotations_
@@ -38,45 +135,143 @@ Camera2D* PERenderQueue::GetCamera() const { return m_pCamera; }
 _Use_decl_annotations_
 void PERenderQueue::Update()
 {
-    bool rebuilt = false;
+    PublishSprites();
+}
 
-    if (m_bDirtyFont.exchange(false, std::memory_order_acq_rel)) 
+_Use_decl_annotations_
+void PERenderQueue::Render(PERaster2D* pRaster)
+{
+    if (!pRaster) return;
+
+    CullSprites     ();
+    LayoutFonts     ();
+    PrepareTarget   (pRaster);
+    BinSprites      (pRaster);
+    RasterizeSprites(pRaster);
+    RenderFont      (pRaster);
+}
+
+void PERenderQueue::PublishSprites()
+{
+    std::lock_guard<std::mutex> lock(m_spriteMutex);
+
+    PFE_RENDER_SNAPSHOT& snapshot = m_snapshots.BeginWrite();
+    if (m_pCamera)
     {
-        BuildFontsInOrder();
-        rebuilt = true;
+        snapshot.camera    = m_pCamera->GetTransform();
+        snapshot.hasCamera = true;
     }
 
-    if (m_bDirtySprite.exchange(false, std::memory_order_acq_rel))
+    const auto& store = PETransformStore::Instance();
+    m_frameStaticKeys.clear();
+    m_frameStatics   .clear();
+
+    for (size_t layer = 0; layer < kLayerCount; ++layer)
     {
-        BuildSpriteInOrder();
-        rebuilt = true;
+        for (const auto& entry : m_spriteLayers[layer].Entries())
+        {
+            PEISprite* sprite = entry.item;
+            if (!sprite) continue;
+
+            //~ published from the old bucket this frame, moved below
+            const ELayer now = sprite->GetLayer();
+            if (LayerIndex(now) != layer)
+            {
+                m_layerMoves.push_back({ entry.id, sprite, static_cast<ELayer>(layer) });
+            }
+
+            if (!sprite->IsVisible()) continue;
+
+            Texture* sampled = sprite->GetSampledTexture();
+            if (!sampled) continue;
+
+            //~ the static layer is only keyed here, its records are copied
+            //~ when the key no longer matches
+            const ELayer bucket = static_cast<ELayer>(layer);
+            if (IsStaticLayer(sprite))
+            {
+                m_frameStaticKeys.push_back(MakeStaticKey(store, entry.id, sprite, sampled, bucket));
+                m_frameStatics   .push_back(sprite);
+                continue;
+            }
+            snapshot.sprites.push_back(MakeSnapshot(entry.id, sprite, sampled, bucket, false));
+        }
     }
 
-    if (rebuilt) {
-        m_bDirtySprite.store(false, std::memory_order_release);
-        m_bDirtyFont.store(false, std::memory_order_release);
+    for (const auto& move : m_layerMoves)
+    {
+        if (!m_spriteLayers[LayerIndex(move.from)].Erase(move.id)) continue;
+        m_spriteLayers[LayerIndex(move.sprite->GetLayer())].Insert(move.id, move.sprite);
     }
+    m_layerMoves.clear();
+
+    PublishStatics();
+    snapshot.statics      = m_pStatics;
+    snapshot.staticScroll = store.GetViewOrigin() - m_pStatics->origin;
+
+    m_snapshots.Publish();
+}
+
+void PERenderQueue::PublishStatics()
+{
+    const auto& store = PETransformStore::Instance();
+
+    //~ a pan keeps the axes, zoom or rotation remaps every static sprite
+    const bool sameView = m_pStatics                            &&
+                          store.GetViewAxisU() == m_staticAxisU &&
+                          store.GetViewAxisV() == m_staticAxisV;
+    if (sameView && SameStaticKeys(m_frameStaticKeys, m_staticKeys)) return;
+
+    auto statics = std::make_shared<PFE_STATIC_SPRITES>();
+    statics->origin   = store.GetViewOrigin();
+    statics->revision = ++m_nStaticRevision;
+
+    for (size_t i = 0; i < m_frameStatics.size(); ++i)
+    {
+        const PFE_STATIC_SPRITE_KEY& key    = m_frameStaticKeys[i];
+        const PEISprite*             sprite = m_frameStatics[i];
+        statics->sprites.push_back(MakeSnapshot(
+            key.id, sprite, sprite->GetSampledTexture(), key.layer, true));
+    }
+
+    m_staticKeys.swap(m_frameStaticKeys);
+    m_staticAxisU = store.GetViewAxisU();
+    m_staticAxisV = store.GetViewAxisV();
+    m_pStatics    = std::move(statics);
 }
 
 _Use_decl_annotations_
-void PERenderQueue::Render(PERaster2D* pRaster)
+void PERenderQueue::PrepareTarget(PERaster2D* pRaster)
 {
-    if (m_bDirtySprite.exchange(false, std::memory_order_acq_rel))
-        BuildSpriteInOrder();
-    if (m_bDirtyFont.exchange(false, std::memory_order_acq_rel))
-        BuildFontsInOrder();
+    if (!pRaster) return;
+
+    const bool layered = UpdateLayerCache(pRaster);
+    TrackDamage(pRaster);
 
-    RenderSprite(pRaster);
-    RenderFont(pRaster);
+    if (layered) pRaster->CompositeLayerCache(m_nLayerScrollX, m_nLayerScrollY);
+    else         pRaster->ClearDamage();
+}
+
+_Use_decl_annotations_
+void PERenderQueue::RasterizeSprites(PERaster2D* pRaster)
+{
+    if (pRaster) pRaster->FlushTileBins();
 }
 
 _Use_decl_annotations_
 bool PERenderQueue::AddSprite(PEISprite* sprite)
 {
     if (!sprite) return false;
-    std::lock_guard<std::mutex> lock(m_renderMutex);
-    m_mapSprites[sprite->GetInstanceID()] = sprite;
-    m_bDirtySprite.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_spriteMutex);
+
+    //~ added again after a layer change, drop the old entry
+    const UniqueId id    = sprite->GetInstanceID();
+    const size_t   layer = LayerIndex(sprite->GetLayer());
+    for (size_t i = 0; i < kLayerCount; ++i)
+    {
+        if (i != layer) (void)m_spriteLayers[i].Erase(id);
+    }
+    m_spriteLayers[layer].Insert(id, sprite);
     return true;
 }
 
@@ -89,9 +284,8 @@ bool PERenderQueue::RemoveSprite(PEISprite* sprite)
 _Use_decl_annotations_
 bool PERenderQueue::RemoveSprite(UniqueId id)
 {
-    std::lock_guard<std::mutex> lock(m_renderMutex);
-    m_mapSprites.erase(id);
-    m_bDirtySprite.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_spriteMutex);
+    for (auto& bucket : m_spriteLayers) (void)bucket.Erase(id);
     return true;
 }
 
@@ -99,9 +293,8 @@ _Use_decl_annotations_
 bool pixel_engine::PERenderQueue::AddFont(PEFont* font)
 {
     if (!font) return false;
-    std::lock_guard<std::mutex> lock(m_renderMutex);
-    m_mapFonts[font->GetInstanceID()] = font;
-    m_bDirtyFont.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_fontMutex);
+    m_fonts.Insert(font->GetInstanceID(), font);
     return true;
 }
 
@@ -114,9 +307,8 @@ bool pixel_engine::PERenderQueue::RemoveFont(PEFont* font)
 _Use_decl_annotations_
 bool pixel_engine::PERenderQueue::RemoveFont(UniqueId id)
 {
-    std::lock_guard<std::mutex> lock(m_renderMutex);
-    m_mapFonts.erase(id);
-    m_bDirtyFont.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_fontMutex);
+    (void)m_fonts.Erase(id);
     return true;
 }
 
@@ -134,116 +326,403 @@ void PERenderQueue::CreateCulling2D(const PFE_RENDER_QUEUE_CONSTRUCT_DESC& desc)
 }
 
 _Use_decl_annotations_
-void PERenderQueue::BuildDiscreteGrid(
-    PEISprite*          sprite,
-    Texture*            sampledTexture,
-    int                 tilePx,
-    PFE_SAMPLE_GRID_2D& out)
-{
-    const FVector2D center = sprite->GetPositionRelativeToCamera();
-    const FVector2D axisU  = sprite->GetUAxisRelativeToCamera   ();
-    const FVector2D axisV  = sprite->GetVAxisRelativeToCamera   ();
-    int cols = 0, rows = 0;
-    if (sampledTexture)
+void PERenderQueue::BuildDiscreteGrid(const PFE_SPRITE_SNAPSHOT& sprite, PFE_SAMPLE_GRID_2D& out) const noexcept
+{
+    //~ only sprites with a sampled texture are published
+    const int cols = std::max(1, static_cast<int>(sprite.sampledTexture->GetWidth()));
+    const int rows = std::max(1, static_cast<int>(sprite.sampledTexture->GetHeight()));
+
+    out.deltaAxisU = sprite.axisU / static_cast<float>(cols);
+    out.deltaAxisV = sprite.axisV / static_cast<float>(rows);
+
+    out.RowStart = sprite.center - sprite.axisU * 0.5f - sprite.axisV * 0.5f;
+
+    out.cols = cols;
+    out.rows = rows;
+}
+
+void PERenderQueue::CullSprites()
+{
+    //~ the ring hands this frame its own copy, nothing here is shared with
+    //~ the logic thread. Taking it releases the last frame's snapshot, its
+    //~ textures may be freed from here on: the static set is switched to
+    //~ the new one below and the layer cache only draws quads set from it
+    m_pSnapshot = &m_snapshots.Acquire();
+    m_frameSprites.clear();
+
+    const PFE_STATIC_SPRITES* statics = m_pSnapshot->statics.get();
+    if (!statics)
     {
-        cols = static_cast<int>(sampledTexture->GetWidth());
-        rows = static_cast<int>(sampledTexture->GetHeight());
+        m_pStaticSet.reset();
+        m_staticGrids.clear();
+        m_staticLayer.clear();
+        m_pCulling2D->ClearStaticIndex();
     }
-    else
+    else if (statics != m_pStaticSet.get())
     {
-        const auto s = sprite->GetScale();
-        cols = std::max(1, static_cast<int>(std::lround(s.x * tilePx)));
-        rows = std::max(1, static_cast<int>(std::lround(s.y * tilePx)));
+        RebuildStaticLayer(*statics);
+        m_pStaticSet = m_pSnapshot->statics;
     }
 
-    out.deltaAxisU = axisU / static_cast<float>(cols);
-    out.deltaAxisV = axisV / static_cast<float>(rows);
+    //~ only the static sprites whose cells the view touches, the rest of
+    //~ the level is not looked at
+    const FVector2D scroll = m_pSnapshot->staticScroll;
+    m_pCulling2D->QueryStatic(scroll, m_staticCandidates);
 
-    out.RowStart = center - axisU * 0.5f - axisV * 0.5f;
+    size_t next = 0;
+    auto pushStatics = [&](ELayer upTo)
+    {
+        for (; next < m_staticCandidates.size(); ++next)
+        {
+            const uint32_t index = m_staticCandidates[next];
+            const PFE_SPRITE_SNAPSHOT& sprite = statics->sprites[index];
+            if (sprite.layer > upTo) return;
 
-    out.cols = cols;
-    out.rows = rows;
+            PFE_SAMPLE_GRID_2D grid = m_staticGrids[index];
+            grid.RowStart += scroll;
+            PushDraw(sprite, grid);
+        }
+    };
+
+    PFE_SAMPLE_GRID_2D grid{};
+    for (const PFE_SPRITE_SNAPSHOT& sprite : m_pSnapshot->sprites)
+    {
+        //~ the static part of a layer is under the rest of it, as the cache draws it
+        pushStatics(sprite.layer);
+
+        BuildDiscreteGrid(sprite, grid);
+        grid.RowStart += FVector2D(m_nScreenWidth / 2, m_nScreenHeight / 2);
+        PushDraw(sprite, grid);
+    }
+    pushStatics(ELayer::Font);
 }
 
 _Use_decl_annotations_
-void PERenderQueue::RenderSprite(PERaster2D* pRaster)
+void PERenderQueue::RebuildStaticLayer(const PFE_STATIC_SPRITES& statics)
 {
-    std::lock_guard<std::mutex> lock(m_renderMutex);
+    m_staticGrids.clear();
+    m_staticLayer.clear();
 
+    fox::vector<PFE_AABB2D> bounds{};
     PFE_SAMPLE_GRID_2D grid{};
-    for (auto* sprite : m_ppSortedSprites)
+    for (const PFE_SPRITE_SNAPSHOT& sprite : statics.sprites)
     {
-        if (!sprite || !sprite->IsVisible()) continue;
+        BuildDiscreteGrid(sprite, grid);
+        grid.RowStart += FVector2D(m_nScreenWidth / 2, m_nScreenHeight / 2);
+        m_staticGrids.push_back(grid);
+        bounds.push_back(m_pCulling2D->ComputeQuadAABB(grid));
+
+        //~ the static layer keeps off screen sprites too, scrolling reveals them
+        PFE_LAYER_QUAD quad{};
+        quad.startBase      = grid.RowStart;
+        quad.deltaAxisU     = grid.deltaAxisU;
+        quad.deltaAxisV     = grid.deltaAxisV;
+        quad.totalColumns   = grid.cols;
+        quad.totalRows      = grid.rows;
+        quad.sampledTexture = sprite.sampledTexture;
+        quad.opaque         = sprite.background;
+        m_staticLayer.push_back(quad);
+    }
 
-        Texture* sampled = sprite->GetSampledTexture();
-        if (!sampled) continue;
+    m_pCulling2D->BuildStaticIndex(bounds, static_cast<float>(m_nTilePx * kCullCellTiles));
+}
 
-        BuildDiscreteGrid(sprite, sampled, m_nTilePx, grid);
-        grid.RowStart += FVector2D(m_nScreenWidth / 2, m_nScreenHeight / 2);
+_Use_decl_annotations_
+void PERenderQueue::PushDraw(const PFE_SPRITE_SNAPSHOT& sprite, const PFE_SAMPLE_GRID_2D& grid)
+{
+    if (m_pCulling2D->ShouldCullQuad(grid)) return;
+
+    PFE_CLIPPED_GRID cg{};
+    if (!ClipGridToViewport(grid, m_nScreenWidth, m_nScreenHeight, cg)) return;
+
+    PFE_SPRITE_DRAW draw{};
+    draw.id             = sprite.id;
+    draw.grid           = grid;
+    draw.clipped        = cg;
+    draw.sampledTexture = sprite.sampledTexture;
+    draw.blendMode      = sprite.blendMode;
+    draw.opacity        = sprite.opacity;
+    draw.background     = sprite.background;
+    draw.cacheable      = sprite.cacheable;
+    draw.bounds         = DamageBounds(grid);
+    m_frameSprites.push_back(draw);
+}
 
-        if (m_pCulling2D->ShouldCullQuad(grid)) continue;
+_Use_decl_annotations_
+void PERenderQueue::TrackDamage(PERaster2D* pRaster)
+{
+    ++m_nDamageFrame;
 
-        PFE_CLIPPED_GRID cg;
-        if (!ClipGridToViewport(grid, m_nScreenWidth, m_nScreenHeight, cg)) continue;
+    //~ a moving camera shifts every sprite, no point diffing them one by one,
+    //~ switching the static layer source can move it by a sub pixel
+    const bool moved = m_pSnapshot && CameraMoved(*m_pSnapshot);
+    pRaster->BeginDamage(moved || m_bLayerSwitched);
 
-        PFE_RASTER_DRAW_CMD cmd
+    TrackSpriteDamage(pRaster);
+    TrackFontDamage  (pRaster);
+
+    pRaster->EndDamage();
+}
+
+_Use_decl_annotations_
+void PERenderQueue::TrackSpriteDamage(PERaster2D* pRaster)
+{
+    //~ a changed sprite dirties where it was and where it is now
+    for (const auto& draw : m_frameSprites)
+    {
+        PFE_SPRITE_DAMAGE_RECORD& record = m_mapSpriteDamage[draw.id];
+        if (record.frame == 0u)
         {
-            .startBase = grid.RowStart,
-            .deltaAxisU = grid.deltaAxisU,
-            .deltaAxisV = grid.deltaAxisV,
-            .columnStartFrom = cg.columnStartFrom,
-            .columneEndAt = cg.columneEndAt,
-            .rowStartFrom = cg.j0,
-            .rowEndAt = cg.j1,
-            .totalColumns = grid.cols,
-            .totalRows = grid.rows,
-            .sampledTexture = sampled,
-            .color = {100, 100, 100},
-        };
+            pRaster->AddDamage(draw.bounds);
+        }
+        else if (!SameDraw(record.draw, draw))
+        {
+            pRaster->AddDamage(record.draw.bounds);
+            pRaster->AddDamage(draw.bounds);
+        }
+        record.draw  = draw;
+        record.frame = m_nDamageFrame;
+    }
 
-        if (sprite->GetLayer() == ELayer::Background)
-            pRaster->DrawQuadBackground(cmd);
-        else
-            pRaster->DrawQuadTile(cmd);
+    //~ removed, hidden or culled since last frame
+    m_staleDamage.clear();
+    for (const auto& kv : m_mapSpriteDamage)
+    {
+        if (kv.second.frame == m_nDamageFrame) continue;
+
+        pRaster->AddDamage(kv.second.draw.bounds);
+        m_staleDamage.push_back(kv.first);
     }
+    for (const UniqueId id : m_staleDamage) m_mapSpriteDamage.erase(id);
 }
 
-void PERenderQueue::BuildSpriteInOrder()
+void PERenderQueue::LayoutFonts()
 {
-    std::lock_guard<std::mutex> lock(m_renderMutex);
+    std::lock_guard<std::mutex> lock(m_fontMutex);
+    ++m_nFontFrame;
+    m_fontDamage.clear();
+
+    //~ the record keeps a copy of the glyphs, RenderFont draws that copy
+    for (const auto& entry : m_fonts.Entries())
+    {
+        PEFont* font = entry.item;
+        if (!font) continue;
 
-    fox::vector<PEISprite*> local;
-    local.reserve(m_mapSprites.size());
-    for (const auto& kv : m_mapSprites)
-        if (kv.second) local.push_back(kv.second);
+        const auto& glyphs = font->GetFontTextures();
 
-    std::stable_sort(local.begin(), local.end(),
-        [](const PEISprite* a, const PEISprite* b)
+        PFE_FONT_DAMAGE_RECORD& record = m_mapFontDamage[font->GetInstanceID()];
+        if (record.frame == 0u || !SameGlyphs(record.glyphs, glyphs))
         {
-            const uint32_t la = static_cast<uint32_t>(a->GetLayer());
-            const uint32_t lb = static_cast<uint32_t>(b->GetLayer());
-            if (la != lb) return la < lb;
-            return a->GetInstanceID() < b->GetInstanceID();
-        });
-
-    m_ppSortedSprites.swap(local);
-    m_bDirtySprite.store(false, std::memory_order_release);
+            if (record.frame != 0u) m_fontDamage.push_back(record.bounds);
+
+            record.glyphs = glyphs;
+            record.bounds =
+            {
+                std::numeric_limits<float>::max(),  std::numeric_limits<float>::max(),
+                -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()
+            };
+
+            for (const auto& glyph : record.glyphs)
+            {
+                if (!glyph.sampledTexture) continue;
+
+                PFE_SAMPLE_GRID_2D grid{};
+                grid.RowStart   = glyph.startPosition;
+                grid.deltaAxisU = FVector2D(1, 0);
+                grid.deltaAxisV = FVector2D(0, 1);
+                grid.cols       = static_cast<int>(glyph.sampledTexture->GetWidth());
+                grid.rows       = static_cast<int>(glyph.sampledTexture->GetHeight());
+
+                const PFE_AABB2D box = DamageBounds(grid);
+                record.bounds.minX = std::min(record.bounds.minX, box.minX);
+                record.bounds.minY = std::min(record.bounds.minY, box.minY);
+                record.bounds.maxX = std::max(record.bounds.maxX, box.maxX);
+                record.bounds.maxY = std::max(record.bounds.maxY, box.maxY);
+            }
+            m_fontDamage.push_back(record.bounds);
+        }
+        record.frame = m_nFontFrame;
+    }
+
+    m_staleFonts.clear();
+    for (const auto& kv : m_mapFontDamage)
+    {
+        if (kv.second.frame == m_nFontFrame) continue;
+
+        m_fontDamage.push_back(kv.second.bounds);
+        m_staleFonts.push_back(kv.first);
+    }
+    for (const UniqueId id : m_staleFonts) m_mapFontDamage.erase(id);
+}
+
+_Use_decl_annotations_
+void PERenderQueue::TrackFontDamage(PERaster2D* pRaster)
+{
+    std::lock_guard<std::mutex> lock(m_fontMutex);
+
+    //~ worked out by LayoutFonts, off the render thread
+    for (const PFE_AABB2D& rect : m_fontDamage) pRaster->AddDamage(rect);
+    m_fontDamage.clear();
+}
+
+_Use_decl_annotations_
+bool PERenderQueue::UpdateLayerCache(PERaster2D* pRaster)
+{
+    PELayerCache* cache     = pRaster->GetLayerCache();
+    const bool    wasActive = m_bLayerActive;
+    bool          committed = false;
+    m_bLayerActive = false;
+
+    const uint64_t revision = m_pStaticSet ? m_pStaticSet->revision : 0u;
+    if (!cache || m_staticLayer.empty())
+    {
+        m_nLayerRevision  = 0u;
+        m_bLayerCommitted = false;
+    }
+    else if (m_nLayerRevision != revision)
+    {
+        //~ changed set is drawn directly, cached once it holds for a frame
+        m_nLayerRevision  = revision;
+        m_bLayerCommitted = false;
+    }
+    else
+    {
+        if (!m_bLayerCommitted)
+        {
+            cache->SetQuads(m_staticLayer);
+            m_bLayerCommitted = true;
+            committed         = true;
+        }
+
+        //~ the set only ever moves as a whole, by the camera origin
+        const FVector2D scroll = m_pSnapshot ? m_pSnapshot->staticScroll : FVector2D(0, 0);
+
+        //~ the layer snaps to whole pixels, at most half a pixel off
+        m_nLayerScrollX = static_cast<int>(std::lround(scroll.x));
+        m_nLayerScrollY = static_cast<int>(std::lround(scroll.y));
+        m_bLayerActive  = true;
+    }
+
+    m_bLayerSwitched = committed || wasActive != m_bLayerActive;
+    return m_bLayerActive;
+}
+
+_Use_decl_annotations_
+bool PERenderQueue::IsStaticLayer(const PEISprite* sprite) noexcept
+{
+    if (sprite->GetBlendMode() != EBlendMode::ColorKey) return false;
+    if (sprite->GetLayer() == ELayer::Background)       return true;
+    if (sprite->GetLayer() != ELayer::Obstacles)        return false;
+
+    const BoxCollider* collider = sprite->GetCollider();
+    return collider && collider->GetColliderType() == ColliderType::Static;
+}
+
+_Use_decl_annotations_
+bool PERenderQueue::CameraMoved(const PFE_RENDER_SNAPSHOT& snapshot) noexcept
+{
+    //~ the camera the sprites were published against, the live one may
+    //~ already be a logic frame ahead
+    if (!snapshot.hasCamera) return false;
+
+    const FTransform2D& now = snapshot.camera;
+    const bool moved = !m_bHasLastCamera                        ||
+                       !(now.Position == m_lastCamera.Position) ||
+                       !(now.Scale    == m_lastCamera.Scale)    ||
+                       now.Rotation   != m_lastCamera.Rotation;
+
+    m_lastCamera     = now;
+    m_bHasLastCamera = true;
+    return moved;
+}
+
+_Use_decl_annotations_
+PFE_AABB2D PERenderQueue::DamageBounds(const PFE_SAMPLE_GRID_2D& grid) const noexcept
+{
+    //~ texel footprints reach half a texel past the lattice, plus the
+    //~ same pixel of slack the tile binner uses
+    PFE_SAMPLE_GRID_2D outer = grid;
+    outer.RowStart = grid.RowStart - (grid.deltaAxisU + grid.deltaAxisV) * 0.5f;
+
+    PFE_AABB2D box = m_pCulling2D->ComputeQuadAABB(outer);
+    box.minX -= 1.0f;
+    box.minY -= 1.0f;
+    box.maxX += 1.0f;
+    box.maxY += 1.0f;
+    return box;
+}
+
+_Use_decl_annotations_
+void PERenderQueue::BinSprites(PERaster2D* pRaster)
+{
+    if (!pRaster) return;
+
+    //~ non background sprites are binned into screen tiles and drawn once
+    //~ by RasterizeSprites on the raster workers, backgrounds keep their own path
+    bool hasBinned = false;
+    pRaster->BeginTileBinning();
+
+    for (const auto& draw : m_frameSprites)
+    {
+        //~ already composited from the layer cache
+        if (m_bLayerActive && draw.cacheable) continue;
+
+        //~ read only here, the Sampler built its premultiplied copy with it
+        const Texture* sampled = draw.sampledTexture;
+
+        PFE_RASTER_DRAW_CMD cmd
+        {
+            .startBase = draw.grid.RowStart,
+            .deltaAxisU = draw.grid.deltaAxisU,
+            .deltaAxisV = draw.grid.deltaAxisV,
+            .columnStartFrom = draw.clipped.columnStartFrom,
+            .columneEndAt = draw.clipped.columneEndAt,
+            .rowStartFrom = draw.clipped.j0,
+            .rowEndAt = draw.clipped.j1,
+            .totalColumns = draw.grid.cols,
+            .totalRows = draw.grid.rows,
+            .sampledTexture = sampled,
+            .color = {100, 100, 100},
+            .blendMode = draw.blendMode,
+            .opacity = draw.opacity,
+        };
+
+        if (draw.background)
+        {
+            //~ keep layer order if a background ever follows binned sprites
+            if (hasBinned)
+            {
+                pRaster->FlushTileBins();
+                hasBinned = false;
+            }
+            pRaster->DrawQuadBackground(cmd);
+        }
+        else
+        {
+            pRaster->SubmitQuadTile(cmd);
+            hasBinned = true;
+        }
+    }
 }
 
 _Use_decl_annotations_
 void pixel_engine::PERenderQueue::RenderFont(PERaster2D* pRaster)
 {
     if (!pRaster) return;
-    std::lock_guard<std::mutex> lock(m_renderMutex);
+    std::lock_guard<std::mutex> lock(m_fontMutex);
+
+    //~ binned like sprites so glyphs outside the damaged tiles are skipped
+    pRaster->BeginTileBinning();
 
-    for (auto* font : m_ppFontsToRender)
+    for (const auto& entry : m_fonts.Entries())
     {
+        PEFont* font = entry.item;
         if (!font) continue;
 
-        const auto& fontTextures = font->GetFontTextures();
-        if (fontTextures.empty()) continue;
+        const PFE_FONT_DAMAGE_RECORD* record = m_mapFontDamage.find(font->GetInstanceID());
+        if (!record || record->glyphs.empty()) continue;
 
-        for (const auto& glyph : fontTextures)
+        for (const auto& glyph : record->glyphs)
         {
             Texture* tex = glyph.sampledTexture;
             if (!tex) continue;
@@ -266,28 +745,11 @@ void pixel_engine::PERenderQueue::RenderFont(PERaster2D* pRaster)
                 .sampledTexture = tex,
                 .color = {255, 255, 255},
             };
-            pRaster->DrawQuadTile(cmd);
+            pRaster->SubmitQuadTile(cmd);
         }
     }
-}
-
-void pixel_engine::PERenderQueue::BuildFontsInOrder()
-{
-    std::lock_guard<std::mutex> lock(m_renderMutex);
-
-    fox::vector<PEFont*> local;
-    local.reserve(m_mapFonts.size());
-    for (const auto& kv : m_mapFonts)
-        if (kv.second) local.push_back(kv.second);
-
-    std::stable_sort(local.begin(), local.end(),
-        [](const PEFont* a, const PEFont* b)
-        {
-            return a->GetInstanceID() < b->GetInstanceID();
-        });
 
-    m_ppFontsToRender.swap(local);
-    m_bDirtyFont.store(false, std::memory_order_release);
+    pRaster->FlushTileBins();
 }
 
 _Use_decl_annotations_
@@ -19,6 +19,9 @@
 #include "pixel_engine/utilities/id_allocator.h"
 #include "pixel_engine/core/interface/interface_sprite.h"
 #include "pixel_engine/render_manager/api/culling/culling.h"
+#include "pixel_engine/render_manager/api/raster/cache/layer_cache.h"
+#include "pixel_engine/render_manager/render_queue/ordered_bucket.h"
+#include "pixel_engine/render_manager/render_queue/render_snapshot.h"
 #include "pixel_engine/core/types.h"
 
 #include "core/unordered_map.h"
@@ -26,6 +29,7 @@
 
 #include <shared_mutex>
 #include <atomic>
+#include <array>
 
 namespace pixel_engine
 {
@@ -41,6 +45,57 @@ namespace pixel_engine
 		_In_ int j1;
 	} PFE_CLIPPED_GRID;
 
+	//~ everything a visible sprite needs to be drawn this frame, also what
+	//~ the damage tracker compares against the previous frame
+	typedef struct _PFE_SPRITE_DRAW
+	{
+		UniqueId		   id		  { 0u };
+		PFE_SAMPLE_GRID_2D grid		  {};
+		PFE_CLIPPED_GRID   clipped	  {};
+		Texture*		   sampledTexture{ nullptr };
+		EBlendMode		   blendMode  { EBlendMode::ColorKey };
+		uint8_t			   opacity	  { 255u };
+		bool			   background { false };
+		bool			   cacheable  { false }; // part of the static layer
+		PFE_AABB2D		   bounds	  {}; // screen pixels the quad can touch
+	} PFE_SPRITE_DRAW;
+
+	typedef struct _PFE_SPRITE_DAMAGE_RECORD
+	{
+		PFE_SPRITE_DRAW draw {};
+		uint64_t		frame{ 0u };
+	} PFE_SPRITE_DAMAGE_RECORD;
+
+	typedef struct _PFE_FONT_DAMAGE_RECORD
+	{
+		fox::vector<FONT_POSITION> glyphs{};
+		PFE_AABB2D				   bounds{};
+		uint64_t				   frame { 0u };
+	} PFE_FONT_DAMAGE_RECORD;
+
+	//~ what the static layer was built from, any difference rebuilds it,
+	//~ opacity is left out as colour keyed draws never read it
+	typedef struct _PFE_STATIC_SPRITE_KEY
+	{
+		UniqueId	   id	  { 0u };
+		const Texture* texture{ nullptr };
+		float		   x	  { 0.0f }; // world transform
+		float		   y	  { 0.0f };
+		float		   rotation{ 0.0f };
+		float		   scaleX { 0.0f };
+		float		   scaleY { 0.0f };
+		ELayer		   layer  { ELayer::Background }; // bucket
+		bool		   background{ false };
+	} PFE_STATIC_SPRITE_KEY;
+
+	//~ a sprite published from the bucket of a layer it has since left
+	typedef struct _PFE_SPRITE_LAYER_MOVE
+	{
+		UniqueId   id	 { 0u };
+		PEISprite* sprite{ nullptr };
+		ELayer	   from	 { ELayer::Background };
+	} PFE_SPRITE_LAYER_MOVE;
+
 	typedef struct _PFE_RENDER_QUEUE_CONSTRUCT_DESC
 	{
 		_In_ UINT	   ScreenWidth;
@@ -58,9 +113,34 @@ namespace pixel_engine
 		_NODISCARD _Check_return_ _Success_(return != nullptr)
 		Camera2D* GetCamera() const;
 
+		//~ logic thread, once the sprites are done for the frame
 		void Update();
 		void Render(_Inout_ PERaster2D* pRaster);
 
+		//~ copies every drawable sprite into the snapshot ring, moves sprites
+		//~ whose layer changed, add and remove keep the order
+		void PublishSprites();
+
+		//~ logic thread, snapshots published so far and the newest one the
+		//~ render thread gave up, a texture dropped after a publish is only
+		//~ freed once that publish has been released
+		_NODISCARD _Check_return_
+		uint64_t GetPublishedFrame() const noexcept { return m_snapshots.GetPublishedFrame(); }
+
+		_NODISCARD _Check_return_
+		uint64_t GetReleasedFrame() const noexcept { return m_snapshots.GetReleasedFrame(); }
+
+		//~ frame stages, Render runs them in this order and the render thread
+		//~ runs them as a frame graph. Cull and font layout never touch the
+		//~ raster so they may run on a worker while it is uploading
+		void CullSprites(); // reads the latest published snapshot, not the sprites
+		void LayoutFonts();
+
+		void PrepareTarget	 (_Inout_ PERaster2D* pRaster); // layer cache, damage and clear
+		void BinSprites		 (_Inout_ PERaster2D* pRaster);
+		void RasterizeSprites(_Inout_ PERaster2D* pRaster);
+		void RenderFont		 (_Inout_ PERaster2D* pRaster);
+
 		bool AddSprite   (_Inout_ PEISprite* sprite);
 		bool RemoveSprite(_Inout_ PEISprite* sprite);
 		bool RemoveSprite(_In_ UniqueId id);
@@ -86,19 +166,43 @@ namespace pixel_engine
 
 		//~ Render Sprite
 		void CreateCulling2D(_In_ const PFE_RENDER_QUEUE_CONSTRUCT_DESC& desc);
-		
-		void BuildDiscreteGrid(
-			_Inout_ PEISprite*			sprite,
-			_Inout_ Texture*			sampledTexture,
-			_In_    int				    tilePx,
-			_Out_   PFE_SAMPLE_GRID_2D& out);
 
-		void RenderSprite	   (_Inout_ PERaster2D* pRaster);
-		void BuildSpriteInOrder();
+		//~ logic thread, hands out a new static set when m_frameStaticKeys
+		//~ no longer matches the one it was built from
+		void PublishStatics();
 
-		//~ Render Font
-		void RenderFont(_Inout_ PERaster2D* pRaster);
-		void BuildFontsInOrder();
+		//~ render thread, grids, layer quads and the cull index of a new set
+		void RebuildStaticLayer(_In_ const PFE_STATIC_SPRITES& statics);
+
+		//~ cull, clip and append to this frame's draws
+		void PushDraw(
+			_In_ const PFE_SPRITE_SNAPSHOT& sprite,
+			_In_ const PFE_SAMPLE_GRID_2D&	grid);
+
+		//~ CullSprites and LayoutFonts snapshot this frame's draws, these mark
+		//~ what changed on the raster, the draw pass only reads the snapshots
+		void TrackDamage	  (_Inout_ PERaster2D* pRaster);
+		void TrackSpriteDamage(_Inout_ PERaster2D* pRaster);
+		void TrackFontDamage  (_Inout_ PERaster2D* pRaster);
+
+		//~ true if the static layer comes from the raster layer cache this
+		//~ frame, the cached set has to stay the same for a frame to be kept
+		_NODISCARD _Check_return_
+		bool UpdateLayerCache(_Inout_ PERaster2D* pRaster);
+
+		//~ background or static obstacle drawn with the colour key
+		_NODISCARD _Check_return_
+		static bool IsStaticLayer(_In_ const PEISprite* sprite) noexcept;
+
+		_NODISCARD _Check_return_
+		bool CameraMoved(_In_ const PFE_RENDER_SNAPSHOT& snapshot) noexcept;
+
+		_NODISCARD _Check_return_
+		PFE_AABB2D DamageBounds(_In_ const PFE_SAMPLE_GRID_2D& grid) const noexcept;
+		
+		void BuildDiscreteGrid(
+			_In_  const PFE_SPRITE_SNAPSHOT& sprite,
+			_Out_ PFE_SAMPLE_GRID_2D&		 out) const noexcept;
 
 		//~ Helpers
 		float Det2(
@@ -122,7 +226,10 @@ namespace pixel_engine
 			_Out_ PFE_CLIPPED_GRID&			out) const;
 
 	private:
-		mutable std::mutex m_renderMutex;
+		//~ split so the sprite and font stages can run side by side, the
+		//~ sprite one only guards the buckets on the logic thread
+		mutable std::mutex m_spriteMutex;
+		mutable std::mutex m_fontMutex;
 
 		bool	  m_bShowFPS	{ false };
 		FVector2D m_fpsPosition	{34, 10};
@@ -135,19 +242,55 @@ namespace pixel_engine
 		int   m_nTilePx  {};
 		float m_nTileStep{};
 
-		//~ Render Sprite
-		fox::unordered_map<UniqueId, PEISprite*> m_mapSprites{};
-		fox::vector<PEISprite*>					 m_ppSortedSprites{};
-		
-		std::atomic<bool> m_bDirtySprite { true };
+		//~ Render Sprite, one bucket per layer drawn in layer order
+		static constexpr size_t kLayerCount = static_cast<size_t>(ELayer::Font) + 1u;
+
+		std::array<PEOrderedBucket<PEISprite>, kLayerCount> m_spriteLayers{};
+		fox::vector<PFE_SPRITE_LAYER_MOVE>					m_layerMoves  {}; // found by PublishSprites
+		PERenderSnapshotRing								m_snapshots   {};
+		const PFE_RENDER_SNAPSHOT*							m_pSnapshot   { nullptr }; // acquired by CullSprites
+
+		//~ Static layer, logic side
+		fox::vector<PFE_STATIC_SPRITE_KEY>		  m_staticKeys	   {}; // the published set
+		fox::vector<PFE_STATIC_SPRITE_KEY>		  m_frameStaticKeys{}; // this publish
+		fox::vector<PEISprite*>					  m_frameStatics   {};
+		std::shared_ptr<const PFE_STATIC_SPRITES> m_pStatics	   { nullptr };
+		FVector2D								  m_staticAxisU	   {};
+		FVector2D								  m_staticAxisV	   {};
+		uint64_t								  m_nStaticRevision{ 0u };
+
+		//~ Static layer, render side, screen space when the set was built
+		std::shared_ptr<const PFE_STATIC_SPRITES> m_pStaticSet		{ nullptr };
+		fox::vector<PFE_SAMPLE_GRID_2D>			  m_staticGrids		{};
+		fox::vector<PFE_LAYER_QUAD>				  m_staticLayer		{};
+		fox::vector<uint32_t>					  m_staticCandidates{};
+
 		UINT			  m_nScreenWidth { 0u };
 		UINT			  m_nScreenHeight{ 0u };
 		Camera2D*		  m_pCamera		 { nullptr };
 
+		//~ Damage tracking
+		fox::vector<PFE_SPRITE_DRAW>						m_frameSprites{};
+		fox::unordered_map<UniqueId, PFE_SPRITE_DAMAGE_RECORD> m_mapSpriteDamage{};
+		fox::unordered_map<UniqueId, PFE_FONT_DAMAGE_RECORD>   m_mapFontDamage  {};
+		fox::vector<UniqueId>								m_staleDamage {};
+		fox::vector<UniqueId>								m_staleFonts  {};
+		fox::vector<PFE_AABB2D>								m_fontDamage  {}; // from LayoutFonts
+		uint64_t											m_nFontFrame  { 0u };
+		uint64_t											m_nDamageFrame{ 0u };
+		FTransform2D										m_lastCamera  {};
+		bool												m_bHasLastCamera{ false };
+
+		//~ Static layer cache, quads in layer space = screen space when recorded
+		uint64_t					m_nLayerRevision{ 0u }; // static set the cache was recorded from
+		bool						m_bLayerCommitted{ false }; // recorded set lives in the raster cache
+		bool						m_bLayerActive { false };
+		bool						m_bLayerSwitched{ false };
+		int							m_nLayerScrollX{ 0 };
+		int							m_nLayerScrollY{ 0 };
+
 		//~ Render Font
-		std::atomic<bool> m_bDirtyFont{ true };
-		fox::unordered_map<UniqueId, PEFont*> m_mapFonts{};
-		fox::vector<PEFont*> m_ppFontsToRender{};
+		PEOrderedBucket<PEFont> m_fonts{};
 
 		//~ manage adding sprite
 		fox::vector<PEISprite*> m_pendingAdd{};
@@ -0,0 +1,51 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#include "pch.h"
+#include "render_snapshot.h"
+
+using namespace pixel_engine;
+
+_Use_decl_annotations_
+PFE_RENDER_SNAPSHOT& PERenderSnapshotRing::BeginWrite() noexcept
+{
+    PFE_RENDER_SNAPSHOT& frame = m_frames[m_nWrite];
+    frame.sprites.clear();
+    frame.hasCamera = false;
+    return frame;
+}
+
+void PERenderSnapshotRing::Publish() noexcept
+{
+    m_frames[m_nWrite].frame = ++m_nPublished;
+
+    //~ the release hands the filled frame over, the acquire takes back the
+    //~ one the consumer gave up, whatever it last wrote in there is done
+    const uint32_t previous = m_ready.exchange(m_nWrite | kFresh, std::memory_order_acq_rel);
+    m_nWrite = previous & kIndexMask;
+}
+
+_Use_decl_annotations_
+const PFE_RENDER_SNAPSHOT& PERenderSnapshotRing::Acquire() noexcept
+{
+    //~ only the producer sets kFresh, so a stale read just keeps the
+    //~ current frame one more time
+    if (m_ready.load(std::memory_order_relaxed) & kFresh)
+    {
+        //~ done with the frame it held, every read of it came before this
+        const uint64_t released = m_frames[m_nRead].frame;
+
+        const uint32_t previous = m_ready.exchange(m_nRead, std::memory_order_acq_rel);
+        m_nRead = previous & kIndexMask;
+        m_nReleased.store(released, std::memory_order_release);
+    }
+    return m_frames[m_nRead];
+}
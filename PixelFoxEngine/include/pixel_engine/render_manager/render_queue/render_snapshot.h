@@ -0,0 +1,119 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+/*
+ *  -----------------------------------------------------------------------------
+ *  Project   : PixelFox (WMG Warwick - Module 1)
+ *  Author    : Niffoxic (a.k.a Harsh Dubey)
+ *  License   : MIT
+ *  -----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "PixelFoxEngineAPI.h"
+
+#include "pixel_engine/utilities/id_allocator.h"
+#include "pixel_engine/render_manager/components/texture/resource/texture.h"
+#include "pixel_engine/core/interface/interface_sprite.h"
+#include "pixel_engine/core/types.h"
+
+#include "fox_math/transform.h"
+#include "core/vector.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace pixel_engine
+{
+	//~ what the render thread needs of a sprite, copied on the logic thread
+	//~ so the draw never calls back into a sprite that is being updated
+	typedef struct _PFE_SPRITE_SNAPSHOT
+	{
+		UniqueId   id			 { 0u };
+		FVector2D  center		 {}; // camera space, like GetPositionRelativeToCamera
+		FVector2D  axisU		 {};
+		FVector2D  axisV		 {};
+		Texture*   sampledTexture{ nullptr };
+		EBlendMode blendMode	 { EBlendMode::ColorKey };
+		uint8_t	   opacity		 { 255u };
+		bool	   background	 { false };
+		bool	   cacheable	 { false }; // part of the static layer
+		ELayer	   layer		 { ELayer::Background }; // bucket, statics draw first within it
+	} PFE_SPRITE_SNAPSHOT;
+
+	//~ the static layer as one immutable set, published again only when a
+	//~ sprite in it changes, the camera panning just moves it as a whole
+	typedef struct _PFE_STATIC_SPRITES
+	{
+		fox::vector<PFE_SPRITE_SNAPSHOT> sprites {}; // draw order
+		FVector2D						 origin	 {}; // camera origin they were mapped with
+		uint64_t						 revision{ 0u };
+	} PFE_STATIC_SPRITES;
+
+	//~ one logic frame, visible sprites with a sampled texture in draw order
+	typedef struct _PFE_RENDER_SNAPSHOT
+	{
+		fox::vector<PFE_SPRITE_SNAPSHOT>		  sprites	  {}; // everything but the static layer
+		std::shared_ptr<const PFE_STATIC_SPRITES> statics	  {};
+		FVector2D								  staticScroll{}; // camera space = statics + scroll
+		FTransform2D							  camera	  {};
+		bool									  hasCamera	  { false };
+		uint64_t								  frame		  { 0u }; // 0 until the first publish
+	} PFE_RENDER_SNAPSHOT;
+
+	/// <summary>
+	/// Triple buffered snapshots between one producer (the logic thread)
+	/// and one consumer (the render frame). The producer fills its own
+	/// frame and swaps it with the ready slot, the consumer swaps its frame
+	/// with the ready slot only when a newer one was published. Neither side
+	/// ever waits and the frames keep their capacity, so a steady scene
+	/// publishes without allocating.
+	/// </summary>
+	class PFE_API PERenderSnapshotRing
+	{
+	public:
+		PERenderSnapshotRing() = default;
+		~PERenderSnapshotRing() = default;
+
+		PERenderSnapshotRing(_In_ const PERenderSnapshotRing&) = delete;
+		PERenderSnapshotRing(_Inout_ PERenderSnapshotRing&&)   = delete;
+
+		PERenderSnapshotRing& operator=(_In_ const PERenderSnapshotRing&) = delete;
+		PERenderSnapshotRing& operator=(_Inout_ PERenderSnapshotRing&&)   = delete;
+
+		//~ producer, the frame to fill, already cleared
+		_NODISCARD _Check_return_
+		PFE_RENDER_SNAPSHOT& BeginWrite() noexcept;
+
+		//~ producer, hands the frame from BeginWrite to the consumer
+		void Publish() noexcept;
+
+		//~ consumer, latest published frame, valid until the next Acquire;
+		//~ taking a newer one releases the frame it held before
+		_NODISCARD _Check_return_
+		const PFE_RENDER_SNAPSHOT& Acquire() noexcept;
+
+		//~ producer, frames published so far
+		_NODISCARD _Check_return_
+		uint64_t GetPublishedFrame() const noexcept { return m_nPublished; }
+
+		//~ any thread, newest frame the consumer has given up, 0 before the
+		//~ first; it never reads that frame or any older one again
+		_NODISCARD _Check_return_
+		uint64_t GetReleasedFrame() const noexcept { return m_nReleased.load(std::memory_order_acquire); }
+
+	private:
+		static constexpr uint32_t kFresh	 = 4u; // ready slot not seen by the consumer yet
+		static constexpr uint32_t kIndexMask = 3u;
+
+		std::array<PFE_RENDER_SNAPSHOT, 3> m_frames{};
+
+		uint32_t			  m_nWrite	   { 0u }; // producer only
+		uint32_t			  m_nRead	   { 1u }; // consumer only
+		std::atomic<uint32_t> m_ready	   { 2u }; // index | kFresh
+		uint64_t			  m_nPublished { 0u };
+		std::atomic<uint64_t> m_nReleased  { 0u }; // written by the consumer
+	};
+} // namespace pixel_engine
@@ -12,10 +12,182 @@
 #include "pch.h"
 #include "bilinear_sampler.h"
 
+#include "pixel_engine/core/jobs/job_system.h"
+
 #include <cmath>
 #include <algorithm>
 #include <limits>
 #include <cassert>
+#include <cstring>
+#include <emmintrin.h>
+
+namespace
+{
+    //~ bands smaller than this cost more to hand out than to run
+    constexpr uint32_t kMinBandRows = 16u;
+    constexpr uint32_t kMaxBands    = 16u;
+
+    //~ weights are 8 bit fractions, 0 takes the first texel and 256 the second
+    constexpr uint32_t kWeightOne = 256u;
+
+    typedef struct _SAMPLE_TAP
+    {
+        uint32_t offset; // first texel, bytes into the filtered row
+        uint32_t weight; // of the texel after it
+    } SAMPLE_TAP;
+
+    typedef struct _SAMPLE_ROW
+    {
+        const uint8_t* top;
+        const uint8_t* bottom;
+        uint32_t       weight; // of the bottom row
+    } SAMPLE_ROW;
+
+    typedef struct _SAMPLE_JOB
+    {
+        uint32_t          channels;
+        uint32_t          srcW;
+        uint32_t          outWidth;
+        size_t            rowBytes;  // srcW texels
+        const SAMPLE_TAP* columns;
+        const SAMPLE_ROW* rows;
+        uint8_t*          dst;
+        size_t            dstStride;
+    } SAMPLE_JOB;
+
+    typedef struct _SAMPLE_BAND
+    {
+        const SAMPLE_JOB* job;
+        uint32_t          begin;
+        uint32_t          end;
+    } SAMPLE_BAND;
+
+    inline uint32_t ToWeight(float fraction) noexcept
+    {
+        const int w = static_cast<int>(fraction * static_cast<float>(kWeightOne) + 0.5f);
+        return static_cast<uint32_t>(std::clamp(w, 0, static_cast<int>(kWeightOne)));
+    }
+
+    inline uint8_t Lerp8Fixed(uint32_t a, uint32_t b, uint32_t w) noexcept
+    {
+        return static_cast<uint8_t>((a * (kWeightOne - w) + b * w + 128u) >> 8);
+    }
+
+    //~ blends the two source rows into one, channels do not matter here
+    //~ so every format shares it, 16 bytes per step in 16 bit lanes
+    void FilterRows(const uint8_t* top, const uint8_t* bottom, uint32_t w, uint8_t* out, size_t bytes) noexcept
+    {
+        if (w == 0u)
+        {
+            std::memcpy(out, top, bytes);
+            return;
+        }
+
+        size_t i = 0;
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i wTop = _mm_set1_epi16(static_cast<short>(kWeightOne - w));
+        const __m128i wBot = _mm_set1_epi16(static_cast<short>(w));
+        const __m128i half = _mm_set1_epi16(128);
+
+        for (; i + 16u <= bytes; i += 16u)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top	  + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + i));
+
+            //~ 255 * 256 + 128 still fits the unsigned 16 bit lane
+            __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), wTop),
+                                       _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), wBot));
+            __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), wTop),
+                                       _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), wBot));
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, half), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, half), 8);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+        }
+
+        for (; i < bytes; ++i) out[i] = Lerp8Fixed(top[i], bottom[i], w);
+    }
+
+    //~ C channels per texel, the row holds one spare texel past the end so
+    //~ the second tap never needs a bounds check
+    template<uint32_t C>
+    void FilterColumns(const uint8_t* row, const SAMPLE_TAP* taps, uint32_t count, uint8_t* out) noexcept
+    {
+        for (uint32_t x = 0; x < count; ++x, out += C)
+        {
+            const uint8_t* p = row + taps[x].offset;
+            const uint32_t w = taps[x].weight;
+            for (uint32_t c = 0; c < C; ++c) out[c] = Lerp8Fixed(p[c], p[C + c], w);
+        }
+    }
+
+    //~ RGBA8, two output texels per step, each tap pair is one 8 byte load
+    template<>
+    void FilterColumns<4u>(const uint8_t* row, const SAMPLE_TAP* taps, uint32_t count, uint8_t* out) noexcept
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i half = _mm_set1_epi16(128);
+
+        const auto tap = [&](const SAMPLE_TAP& t)
+        {
+            const __m128i px = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + t.offset)), zero);
+            const short   w1 = static_cast<short>(t.weight);
+            const short   w0 = static_cast<short>(kWeightOne - t.weight);
+            const __m128i m  = _mm_mullo_epi16(px, _mm_setr_epi16(w0, w0, w0, w0, w1, w1, w1, w1));
+            return _mm_add_epi16(m, _mm_srli_si128(m, 8));
+        };
+
+        uint32_t x = 0;
+        for (; x + 2u <= count; x += 2u, out += 8)
+        {
+            __m128i v = _mm_unpacklo_epi64(tap(taps[x]), tap(taps[x + 1u]));
+            v = _mm_srli_epi16(_mm_add_epi16(v, half), 8);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(v, v));
+        }
+
+        for (; x < count; ++x, out += 4)
+        {
+            const uint8_t* p = row + taps[x].offset;
+            const uint32_t w = taps[x].weight;
+            for (uint32_t c = 0; c < 4u; ++c) out[c] = Lerp8Fixed(p[c], p[4u + c], w);
+        }
+    }
+
+    template<uint32_t C>
+    void RunRowsFor(const SAMPLE_JOB& job, uint32_t begin, uint32_t end, uint8_t* filtered) noexcept
+    {
+        for (uint32_t y = begin; y < end; ++y)
+        {
+            const SAMPLE_ROW& row = job.rows[y];
+            FilterRows(row.top, row.bottom, row.weight, filtered, job.rowBytes);
+            std::memcpy(filtered + job.rowBytes, filtered + job.rowBytes - C, C);
+
+            FilterColumns<C>(filtered, job.columns, job.outWidth, job.dst + job.dstStride * y);
+        }
+    }
+
+    void RunRows(const SAMPLE_JOB& job, uint32_t begin, uint32_t end)
+    {
+        //~ one filtered source row plus the spare texel and slack for the 8 byte loads
+        fox::vector<uint8_t> filtered{};
+        filtered.resize(job.rowBytes + job.channels + 8u);
+
+        switch (job.channels)
+        {
+        case 1u: RunRowsFor<1u>(job, begin, end, filtered.data()); break;
+        case 2u: RunRowsFor<2u>(job, begin, end, filtered.data()); break;
+        case 3u: RunRowsFor<3u>(job, begin, end, filtered.data()); break;
+        case 4u: RunRowsFor<4u>(job, begin, end, filtered.data()); break;
+        default: break;
+        }
+    }
+
+    void RunBand(void* context)
+    {
+        const auto* band = static_cast<const SAMPLE_BAND*>(context);
+        RunRows(*band->job, band->begin, band->end);
+    }
+} // namespace
 
 _Use_decl_annotations_
 std::unique_ptr<pixel_engine::Texture> 
@@ -46,10 +218,14 @@ pixel_engine::BilinearSampler::SampleToSize(
 {
     if (!rawImage || outWidth == 0 || outHeight == 0) return nullptr;
 
+    //~ starts from the smallest mip still covering the output, a large
+    //~ downscale reads a box filtered level instead of skipping texels
+    const Texture* source = rawImage->SelectMip(outWidth, outHeight);
+
     return SampleRegionToSize(
-        rawImage, 0, 0,
-        rawImage->GetWidth(),
-        rawImage->GetHeight(),
+        source, 0, 0,
+        source->GetWidth(),
+        source->GetHeight(),
         outWidth,
         outHeight);
 }
@@ -73,16 +249,49 @@ pixel_engine::BilinearSampler::SampleRegionToSize(
     // Source info
     const auto fmt           = rawImage->GetFormat();
     const auto cs            = rawImage->GetColorSpace();
-    const auto origin        = rawImage->GetOrigin();
     const uint32_t bpp       = rawImage->BytesPerPixel();
-    const uint32_t srcStride = rawImage->GetRowStride();
-    const uint8_t* srcBase   = rawImage->Data().data;
 
     // Prepare destination buffer
     const uint32_t dstStride = outWidth * bpp;
     fox::vector<uint8_t> dstBytes;
     dstBytes.resize(static_cast<size_t>(dstStride) * outHeight, 0u);
 
+    if (GetKernel() == ESampleKernel::FloatPerPixel)
+        SampleFloatPerPixel(rawImage, srcX, srcY, srcW, srcH, outWidth, outHeight, dstBytes.data());
+    else
+        SampleFixedPoint   (rawImage, srcX, srcY, srcW, srcH, outWidth, outHeight, dstBytes.data());
+
+    return std::make_unique<Texture>(
+        rawImage->GetFilePath(),
+        outWidth, outHeight,
+        fmt,
+        cs,
+        std::move(dstBytes),
+        dstStride,
+        Origin::TopLeft,
+        false
+    );
+}
+
+_Use_decl_annotations_
+void pixel_engine::BilinearSampler::SampleFloatPerPixel(
+    const Texture* rawImage,
+          uint32_t srcX,
+          uint32_t srcY,
+          uint32_t srcW,
+          uint32_t srcH,
+          uint32_t outWidth,
+          uint32_t outHeight,
+          uint8_t* dst) const noexcept
+{
+    // Source info
+    const auto fmt           = rawImage->GetFormat();
+    const auto origin        = rawImage->GetOrigin();
+    const uint32_t bpp       = rawImage->BytesPerPixel();
+    const uint32_t srcStride = rawImage->GetRowStride();
+    const uint8_t* srcBase   = rawImage->Data().data;
+    const uint32_t dstStride = outWidth * bpp;
+
     // Normalized sampling map output pixel
     const float scaleX = (srcW > 1) ? (static_cast<float>(srcW) / static_cast<float>(outWidth)) : 0.0f;
     const float scaleY = (srcH > 1) ? (static_cast<float>(srcH) / static_cast<float>(outHeight)) : 0.0f;
@@ -155,38 +364,113 @@ pixel_engine::BilinearSampler::SampleRegionToSize(
             switch (fmt)
             {
             case TextureFormat::R8:
-                dstBytes[dstOff + 0] = r; break;
+                dst[dstOff + 0] = r; break;
             case TextureFormat::RG8:
-                dstBytes[dstOff + 0] = r;
-                dstBytes[dstOff + 1] = g;
+                dst[dstOff + 0] = r;
+                dst[dstOff + 1] = g;
                 break;
             case TextureFormat::RGB8:
-                dstBytes[dstOff + 0] = r;
-                dstBytes[dstOff + 1] = g;
-                dstBytes[dstOff + 2] = b;
+                dst[dstOff + 0] = r;
+                dst[dstOff + 1] = g;
+                dst[dstOff + 2] = b;
                 break;
             case TextureFormat::RGBA8:
-                dstBytes[dstOff + 0] = r;
-                dstBytes[dstOff + 1] = g;
-                dstBytes[dstOff + 2] = b;
-                dstBytes[dstOff + 3] = a;
+                dst[dstOff + 0] = r;
+                dst[dstOff + 1] = g;
+                dst[dstOff + 2] = b;
+                dst[dstOff + 3] = a;
                 break;
             default:
                 break;
             }
         }
     }
+}
 
-    return std::make_unique<Texture>(
-        rawImage->GetFilePath(),
-        outWidth, outHeight,
-        fmt,
-        cs,
-        std::move(dstBytes),
-        dstStride,
-        Origin::TopLeft,
-        false
-    );
+_Use_decl_annotations_
+void pixel_engine::BilinearSampler::SampleFixedPoint(
+    const Texture* rawImage,
+          uint32_t srcX,
+          uint32_t srcY,
+          uint32_t srcW,
+          uint32_t srcH,
+          uint32_t outWidth,
+          uint32_t outHeight,
+          uint8_t* dst) const
+{
+    const uint32_t bpp       = rawImage->BytesPerPixel();
+    const uint32_t srcStride = rawImage->GetRowStride();
+    const uint8_t* srcBase   = rawImage->Data().data;
+
+    SAMPLE_JOB job{};
+    job.channels  = bpp;
+    job.srcW      = srcW;
+    job.outWidth  = outWidth;
+    job.dst       = dst;
+    job.dstStride = static_cast<size_t>(outWidth) * bpp;
+    job.rowBytes  = static_cast<size_t>(srcW) * bpp;
+
+    //~ same pixel centre mapping as the float path, worked out once per
+    //~ column and row instead of once per texel
+    const float scaleX = (srcW > 1) ? (static_cast<float>(srcW) / static_cast<float>(outWidth))  : 0.0f;
+    const float scaleY = (srcH > 1) ? (static_cast<float>(srcH) / static_cast<float>(outHeight)) : 0.0f;
+
+    fox::vector<SAMPLE_TAP> columns{};
+    columns.reserve(outWidth);
+    for (uint32_t x = 0; x < outWidth; ++x)
+    {
+        const float sxf = (static_cast<float>(x) + 0.5f) * scaleX - 0.5f;
+        const int   x0  = static_cast<int>(std::floor(sxf));
+        const int   rel = ClampIndex(x0, static_cast<int>(srcW));
+
+        SAMPLE_TAP tap{};
+        tap.offset = static_cast<uint32_t>(rel) * bpp;
+        tap.weight = (ClampIndex(x0 + 1, static_cast<int>(srcW)) == rel) ? 0u : ToWeight(sxf - static_cast<float>(x0));
+        columns.push_back(tap);
+    }
+
+    fox::vector<SAMPLE_ROW> rows{};
+    rows.reserve(outHeight);
+    for (uint32_t y = 0; y < outHeight; ++y)
+    {
+        const float syf = (static_cast<float>(y) + 0.5f) * scaleY - 0.5f;
+        const int   y0  = static_cast<int>(std::floor(syf));
+        const int   rel0 = ClampIndex(y0,     static_cast<int>(srcH));
+        const int   rel1 = ClampIndex(y0 + 1, static_cast<int>(srcH));
+
+        const int mem0 = MapYToMemory(static_cast<int>(srcY) + rel0, rawImage->GetHeight(), rawImage->GetOrigin());
+        const int mem1 = MapYToMemory(static_cast<int>(srcY) + rel1, rawImage->GetHeight(), rawImage->GetOrigin());
+
+        SAMPLE_ROW row{};
+        row.top    = srcBase + static_cast<size_t>(mem0) * srcStride + static_cast<size_t>(srcX) * bpp;
+        row.bottom = srcBase + static_cast<size_t>(mem1) * srcStride + static_cast<size_t>(srcX) * bpp;
+        row.weight = (rel0 == rel1) ? 0u : ToWeight(syf - static_cast<float>(y0));
+        rows.push_back(row);
+    }
+
+    job.columns = columns.data();
+    job.rows    = rows.data();
+
+    const uint64_t texels    = static_cast<uint64_t>(outWidth) * outHeight;
+    const uint32_t threshold = m_nParallelTexels.load(std::memory_order_relaxed);
+    if (threshold == 0u || texels < threshold || outHeight < 2u * kMinBandRows)
+    {
+        RunRows(job, 0u, outHeight);
+        return;
+    }
+
+    //~ the job system runs the bands itself when another caller has the pool
+    const uint32_t bandCount = std::min(kMaxBands, outHeight / kMinBandRows);
+    SAMPLE_BAND bands[kMaxBands]{};
+    PFE_JOB     jobs [kMaxBands]{};
+    for (uint32_t i = 0; i < bandCount; ++i)
+    {
+        bands[i].job   = &job;
+        bands[i].begin = static_cast<uint32_t>(static_cast<uint64_t>(outHeight) *  i       / bandCount);
+        bands[i].end   = static_cast<uint32_t>(static_cast<uint64_t>(outHeight) * (i + 1u) / bandCount);
+        jobs [i]       = PFE_JOB{ &RunBand, &bands[i] };
+    }
+    PEJobSystem::Instance().Run(jobs, bandCount);
 }
 
 _Use_decl_annotations_
@@ -18,8 +18,17 @@
 
 #include "fox_math/vector.h"
 
+#include <atomic>
+#include <memory>
+
 namespace pixel_engine
 {
+	enum class ESampleKernel : uint8_t
+	{
+		FloatPerPixel, // float weights and a format switch per texel (old path)
+		FixedPoint	   // 8 bit weights, one kernel per format, SSE2 lanes
+	};
+
 	/// <summary>
 	/// Takes Image Texture resource and creates another texture
 	/// of size PixelUnit(32x32) * Scale(x, y) and 
@@ -31,6 +40,16 @@ namespace pixel_engine
 	public:
 		BilinearSampler() = default;
 
+		//~ FixedPoint unless changed, FloatPerPixel kept for comparison
+		void SetKernel(_In_ ESampleKernel kernel) noexcept { m_eKernel.store(kernel, std::memory_order_relaxed); }
+
+		_NODISCARD _Check_return_
+		ESampleKernel GetKernel() const noexcept { return m_eKernel.load(std::memory_order_relaxed); }
+
+		//~ outputs with at least this many texels split their rows across
+		//~ the sampler workers, zero keeps every resample on the caller
+		void SetParallelTexels(_In_ uint32_t texels) noexcept { m_nParallelTexels.store(texels, std::memory_order_relaxed); }
+
 		// Given a tile size lets say 32x32 and scale it returns
 		// the image scaled to the tile size of fast rendering
 		// Example: tile=32, scale=(2,2) => 64x64 result.
@@ -41,7 +60,8 @@ namespace pixel_engine
 			_In_ const FVector2D& scale
 		) const;
 
-		//~ same but based on width and height instead of pixels
+		//~ same but based on width and height instead of pixels, reads the
+		//~ closest mip level of rawImage when it has them
 		_NODISCARD _Check_return_ _Success_(return != nullptr)
 		std::unique_ptr<Texture> SampleToSize(
 			_In_ const Texture* rawImage,
@@ -112,5 +132,30 @@ namespace pixel_engine
 			_In_ uint8_t a,
 			_In_ uint8_t b,
 			_In_ float	 t) const noexcept;
+
+	private:
+		void SampleFloatPerPixel(
+			_In_  const Texture* rawImage,
+			_In_  uint32_t		 srcX,
+			_In_  uint32_t		 srcY,
+			_In_  uint32_t		 srcW,
+			_In_  uint32_t		 srcH,
+			_In_  uint32_t		 outWidth,
+			_In_  uint32_t		 outHeight,
+			_Out_ uint8_t*		 dst) const noexcept;
+
+		void SampleFixedPoint(
+			_In_  const Texture* rawImage,
+			_In_  uint32_t		 srcX,
+			_In_  uint32_t		 srcY,
+			_In_  uint32_t		 srcW,
+			_In_  uint32_t		 srcH,
+			_In_  uint32_t		 outWidth,
+			_In_  uint32_t		 outHeight,
+			_Out_ uint8_t*		 dst) const;
+
+	private:
+		std::atomic<ESampleKernel> m_eKernel		{ ESampleKernel::FixedPoint };
+		std::atomic<uint32_t>	   m_nParallelTexels{ 128u * 128u };
 	};
 } // namespace pixel_engine
@@ -15,18 +15,43 @@
 #include "bilinear/bilinear_sampler.h"
 #include "pixel_engine/utilities/logger/logger.h"
 
-#include <sstream>
+#include <algorithm>
+#include <cmath>
 
-_Use_decl_annotations_
-std::string pixel_engine::_PFE_CREATE_SAMPLE_TEXTURE::GetHashKey() const
+namespace
+{
+    //~ log ratio so 1x against 2x is as far as 2x against 4x
+    float ScaleDistance(const FVector2D& a, const FVector2D& b)
+    {
+        constexpr float kMin = 1e-4f;
+        const float dx = std::log(std::max(std::abs(a.x), kMin) / std::max(std::abs(b.x), kMin));
+        const float dy = std::log(std::max(std::abs(a.y), kMin) / std::max(std::abs(b.y), kMin));
+        return std::abs(dx) + std::abs(dy);
+    }
+} // namespace
+
+pixel_engine::Sampler::~Sampler()
+{
+    Shutdown();
+}
+
+pixel_engine::PFE_SAMPLE_KEY
+pixel_engine::_PFE_CREATE_SAMPLE_TEXTURE::GetKey() const noexcept
 {
-    if (not texture) return "eos";
-    std::ostringstream oss;
-    oss << texture->GetFilePath()
-        << '(' << tileSize << ')'
-        << '(' << scaledBy.x << ',' << scaledBy.y << ')';
+    //~ same rounding as BilinearSampler::GetSampledImage
+    PFE_SAMPLE_KEY key = GetSourceKey();
+    key.width  = std::max(1, static_cast<int32_t>(std::lround(scaledBy.x * tileSize)));
+    key.height = std::max(1, static_cast<int32_t>(std::lround(scaledBy.y * tileSize)));
+    return key;
+}
 
-    return oss.str();
+pixel_engine::PFE_SAMPLE_KEY
+pixel_engine::_PFE_CREATE_SAMPLE_TEXTURE::GetSourceKey() const noexcept
+{
+    PFE_SAMPLE_KEY key{};
+    key.texture  = texture;
+    key.tileSize = tileSize;
+    return key;
 }
 
 _Use_decl_annotations_
@@ -47,16 +72,15 @@ _Use_decl_annotations_
 pixel_engine::Texture* pixel_engine::Sampler::BuildTexture(
     const PFE_CREATE_SAMPLE_TEXTURE& desc)
 {
-    auto hashKey = desc.GetHashKey();
-    if (m_sampledTextures.contains(hashKey))
+    const PFE_SAMPLE_KEY hashKey = desc.GetKey();
+    if (const auto* cached = m_sampledTextures.find(hashKey))
     {
-        return m_sampledTextures[hashKey].get();
+        //~ the caller keeps the pointer, a requested texture must stay now
+        Pin(desc, hashKey);
+        return cached->get();
     }
 
-    auto sampled = BilinearSampler::Instance().GetSampledImage(
-        desc.texture, desc.tileSize, desc.scaledBy
-    );
-
+    auto sampled = Resample(desc);
     if (not sampled)
     {
         logger::error("Failed to sample {}!",
@@ -64,6 +88,306 @@ pixel_engine::Texture* pixel_engine::Sampler::BuildTexture(
         return nullptr;
     }
 
-    m_sampledTextures[hashKey] = std::move(sampled);
-    return m_sampledTextures[hashKey].get();
+    return Insert(desc, hashKey, std::move(sampled), true);
+}
+
+_Use_decl_annotations_
+pixel_engine::ESampleRequest pixel_engine::Sampler::RequestTexture(
+    const PFE_CREATE_SAMPLE_TEXTURE& desc,
+    Texture*&                        texture)
+{
+    texture = nullptr;
+    if (not desc.texture) return ESampleRequest::Failed;
+
+    const PFE_SAMPLE_KEY hashKey = desc.GetKey();
+    if (const auto* cached = m_sampledTextures.find(hashKey))
+    {
+        texture = cached->get();
+        return ESampleRequest::Ready;
+    }
+
+    if (const auto* request = m_requests.find(hashKey))
+    {
+        const bool retry = request->state == ESampleRequest::Failed &&
+                           m_nFrame - request->frame >= kRetryAfterFrames;
+        if (not retry) return request->state;
+
+        m_requests.erase(hashKey);
+    }
+
+    if (not m_bAsync || not StartWorker())
+    {
+        //~ built inline but still a requested texture, it may be evicted
+        auto sampled = Resample(desc);
+        if (not sampled)
+        {
+            logger::error("Failed to sample {}!",
+                desc.texture->GetFilePath());
+            return ESampleRequest::Failed;
+        }
+
+        texture = Insert(desc, hashKey, std::move(sampled), false);
+        return ESampleRequest::Ready;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_jobs.push_back(SAMPLE_JOB{ desc, hashKey });
+    }
+    m_jobSignal.notify_one();
+
+    m_requests[hashKey] = SAMPLE_REQUEST{ ESampleRequest::Pending, m_nFrame };
+    return ESampleRequest::Pending;
+}
+
+_Use_decl_annotations_
+pixel_engine::Texture* pixel_engine::Sampler::FindNearestScale(
+    const PFE_CREATE_SAMPLE_TEXTURE& desc) const
+{
+    if (not desc.texture) return nullptr;
+
+    const auto* scales = m_scalesBySource.find(desc.GetSourceKey());
+    if (not scales) return nullptr;
+
+    Texture* nearest  = nullptr;
+    float    distance = 0.0f;
+    for (const SAMPLED_SCALE& entry : *scales)
+    {
+        const float d = ScaleDistance(entry.scale, desc.scaledBy);
+        if (not nearest || d < distance)
+        {
+            nearest  = entry.texture;
+            distance = d;
+        }
+    }
+    return nearest;
+}
+
+void pixel_engine::Sampler::PublishCompleted()
+{
+    ++m_nFrame;
+
+    fox::vector<SAMPLE_RESULT> completed{};
+    {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        if (m_completed.empty()) return;
+        completed.swap(m_completed);
+    }
+
+    for (auto& result : completed)
+    {
+        if (not result.texture)
+        {
+            logger::error("Failed to sample {}!",
+                result.desc.texture->GetFilePath());
+            m_requests[result.key] = SAMPLE_REQUEST{ ESampleRequest::Failed, m_nFrame };
+            continue;
+        }
+
+        m_requests.erase(result.key);
+
+        //~ an inline build of the same key may have landed first
+        if (m_sampledTextures.contains(result.key)) continue;
+        Insert(result.desc, result.key, std::move(result.texture), false);
+    }
+}
+
+_Use_decl_annotations_
+void pixel_engine::Sampler::SetSnapshotFrames(uint64_t published, uint64_t released)
+{
+    m_nPublishedFrame = published;
+    m_nReleasedFrame  = released;
+
+    for (size_t i = 0; i < m_retired.size();)
+    {
+        if (m_retired[i].frame > released) { ++i; continue; }
+
+        m_retired[i] = std::move(m_retired.back());
+        m_retired.pop_back();
+    }
+}
+
+_Use_decl_annotations_
+void pixel_engine::Sampler::MarkUsed(const Texture* texture)
+{
+    if (not texture) return;
+    if (auto* lastUsed = m_lastUsed.find(texture)) *lastUsed = m_nFrame;
+}
+
+void pixel_engine::Sampler::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_bStop = true;
+        m_jobs.clear();
+    }
+    m_jobSignal.notify_all();
+
+    if (m_worker.joinable()) m_worker.join();
+
+    std::lock_guard<std::mutex> lock(m_completedMutex);
+    m_completed.clear();
+    m_requests.clear();
+
+    //~ the render thread is stopped before the sampler
+    m_retired.clear();
+}
+
+_Use_decl_annotations_
+std::unique_ptr<pixel_engine::Texture> pixel_engine::Sampler::Resample(
+    const PFE_CREATE_SAMPLE_TEXTURE& desc)
+{
+    auto sampled = BilinearSampler::Instance().GetSampledImage(
+        desc.texture, desc.tileSize, desc.scaledBy
+    );
+    if (not sampled) return nullptr;
+
+    //~ tile set slices come through here as well; both blend modes are
+    //~ ready before the texture is published, the render thread only reads
+    sampled->BuildCoverage();
+    sampled->BuildPremultiplied();
+    return sampled;
+}
+
+_Use_decl_annotations_
+pixel_engine::Texture* pixel_engine::Sampler::Insert(
+    const PFE_CREATE_SAMPLE_TEXTURE& desc,
+    const PFE_SAMPLE_KEY&            key,
+    std::unique_ptr<Texture>&&       texture,
+    bool                             pinned)
+{
+    Texture* raw = texture.get();
+    m_sampledTextures[key] = std::move(texture);
+    m_scalesBySource[desc.GetSourceKey()].push_back(SAMPLED_SCALE{ desc.scaledBy, raw, key, pinned });
+    if (pinned) return raw;
+
+    m_lastUsed[raw] = m_nFrame;
+    EvictOverCap(desc.GetSourceKey());
+    return raw;
+}
+
+_Use_decl_annotations_
+void pixel_engine::Sampler::Pin(const PFE_CREATE_SAMPLE_TEXTURE& desc, const PFE_SAMPLE_KEY& key)
+{
+    auto* scales = m_scalesBySource.find(desc.GetSourceKey());
+    if (not scales) return;
+
+    for (SAMPLED_SCALE& entry : *scales)
+    {
+        if (entry.key != key || entry.pinned) continue;
+
+        entry.pinned = true;
+        m_lastUsed.erase(entry.texture);
+        return;
+    }
+}
+
+_Use_decl_annotations_
+void pixel_engine::Sampler::EvictOverCap(const PFE_SAMPLE_KEY& sourceKey)
+{
+    auto* scales = m_scalesBySource.find(sourceKey);
+    if (not scales) return;
+
+    size_t unpinned = 0u;
+    for (const SAMPLED_SCALE& entry : *scales) if (not entry.pinned) ++unpinned;
+
+    //~ every scale still drawn keeps the source over the cap until it goes idle
+    while (unpinned > kMaxScalesPerSource)
+    {
+        size_t   oldest   = scales->size();
+        uint64_t oldestAt = 0u;
+        for (size_t i = 0; i < scales->size(); ++i)
+        {
+            const SAMPLED_SCALE& entry = (*scales)[i];
+            if (entry.pinned) continue;
+
+            const uint64_t* lastUsed = m_lastUsed.find(entry.texture);
+            const uint64_t  at       = lastUsed ? *lastUsed : 0u;
+            if (m_nFrame - at < kEvictAfterFrames) continue;
+
+            if (oldest == scales->size() || at < oldestAt)
+            {
+                oldest   = i;
+                oldestAt = at;
+            }
+        }
+        if (oldest == scales->size()) return;
+
+        const SAMPLED_SCALE victim = (*scales)[oldest];
+        (*scales)[oldest] = scales->back();
+        scales->pop_back();
+
+        m_lastUsed.erase(victim.texture);
+        if (auto* owned = m_sampledTextures.find(victim.key)) Retire(std::move(*owned));
+        m_sampledTextures.erase(victim.key);
+        --unpinned;
+    }
+}
+
+_Use_decl_annotations_
+void pixel_engine::Sampler::Retire(std::unique_ptr<Texture>&& texture)
+{
+    //~ every snapshot that may draw it is released already
+    if (m_nReleasedFrame >= m_nPublishedFrame)
+    {
+        texture.reset();
+        return;
+    }
+    m_retired.push_back(RETIRED_TEXTURE{ std::move(texture), m_nPublishedFrame });
+}
+
+bool pixel_engine::Sampler::StartWorker()
+{
+    if (m_worker.joinable()) return true;
+    if (m_bWorkerFailed)     return false;
+
+    try
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_jobMutex);
+            m_bStop = false;
+        }
+        m_worker = std::thread(&Sampler::WorkerLoop, this);
+    }
+    catch (const std::exception& e)
+    {
+        //~ no thread, every request builds on its caller from now on
+        logger::error("Sampler: failed to start the worker ({}), building inline", e.what());
+        m_bWorkerFailed = true;
+        return false;
+    }
+    return true;
+}
+
+void pixel_engine::Sampler::WorkerLoop()
+{
+    fox::vector<SAMPLE_JOB> jobs{};
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_jobMutex);
+            m_jobSignal.wait(lock, [this] { return m_bStop || not m_jobs.empty(); });
+            if (m_bStop) return;
+            jobs.swap(m_jobs);
+        }
+
+        for (const SAMPLE_JOB& job : jobs)
+        {
+            SAMPLE_RESULT result{};
+            result.desc = job.desc;
+            result.key  = job.key;
+            try
+            {
+                result.texture = Resample(job.desc);
+            }
+            catch (...)
+            {
+                result.texture.reset();
+            }
+
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            m_completed.push_back(std::move(result));
+        }
+        jobs.clear();
+    }
 }
@@ -13,13 +13,44 @@
 #include "PixelFoxEngineAPI.h"
 
 #include "core/unordered_map.h"
+#include "core/vector.h"
 #include "fox_math/vector.h"
 
 #include "pixel_engine/core/interface/interface_singleton.h"
+#include "pixel_engine/utilities/hash_type.h"
 #include "pixel_engine/render_manager/components/texture/resource/texture.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace pixel_engine
 {
+	//~ keyed by the sampled size, every scale that rounds to the same
+	//~ pixels shares one texture so an animated scale keeps a bounded set
+	typedef struct _PFE_SAMPLE_KEY
+	{
+		const Texture* texture { nullptr };
+		int32_t		   tileSize{ 0 };
+		int32_t		   width   { 0 }; // what GetSampledImage produces
+		int32_t		   height  { 0 };
+
+		bool operator==(_In_ const _PFE_SAMPLE_KEY& other) const noexcept = default;
+	} PFE_SAMPLE_KEY;
+
+	struct PFE_SAMPLE_KEY_HASH
+	{
+		_NODISCARD
+		size_t operator()(_In_ const PFE_SAMPLE_KEY& key) const noexcept
+		{
+			uint64_t hash = HashCombine(0u, reinterpret_cast<uintptr_t>(key.texture));
+			hash = HashCombine(hash, static_cast<uint32_t>(key.tileSize));
+			hash = HashCombine(hash, static_cast<uint64_t>(static_cast<uint32_t>(key.width)) << 32 |
+									 static_cast<uint32_t>(key.height));
+			return static_cast<size_t>(hash);
+		}
+	};
+
 	typedef struct _PFE_CREATE_SAMPLE_TEXTURE
 	{
 		_In_ Texture*  texture;
@@ -34,20 +65,41 @@ namespace pixel_engine
 					scaledBy == other.scaledBy;
 		}
 
-		//~ since my fox::unorederd map dont support std::hash XD
+		//~ cache key, built on the stack for every lookup
+		_NODISCARD _Check_return_
+		PFE_SAMPLE_KEY GetKey() const noexcept;
+
+		//~ same key without the scale, every scale of one source shares it
 		_NODISCARD _Check_return_
-		std::string GetHashKey() const;
+		PFE_SAMPLE_KEY GetSourceKey() const noexcept;
 
 	} PFE_CREATE_SAMPLE_TEXTURE;
 
+	enum class ESampleRequest : uint8_t
+	{
+		Ready,	 // in the cache, the texture is returned
+		Pending, // queued or building on the sampler worker
+		Failed	 // the resample failed, queued again after a while
+	};
+
 	/// <summary>
-	/// Builds and caches sampled textures
+	/// Builds and caches sampled textures. BuildTexture resamples on the
+	/// caller, RequestTexture queues the resample on a background worker
+	/// and the finished texture only enters the cache in PublishCompleted,
+	/// so a frame sees either none of it or all of it.
+	/// BuildTexture results are kept for good, their owners hold on to the
+	/// pointer. Requested textures are capped per source: past the cap the
+	/// scale no sprite has marked for the longest is evicted once it has
+	/// been idle for a few frames. The render thread may lag any number of
+	/// snapshots behind, so an evicted texture is retired and only freed
+	/// after every snapshot published before the eviction was released.
 	/// </summary>
 	class PFE_API Sampler final : public ISingleton<Sampler>
 	{
 		friend class ISingleton<Sampler>;
 	public:
 		Sampler() = default;
+		~Sampler();
 
 		_NODISCARD _Check_return_ _Success_(return != nullptr)
 		Texture* BuildTexture(
@@ -58,7 +110,160 @@ namespace pixel_engine
 		_NODISCARD _Check_return_ _Success_(return != nullptr)
 		Texture* BuildTexture(_In_ const PFE_CREATE_SAMPLE_TEXTURE& desc);
 
+		//~ cached texture or a queued build, never resamples on the caller
+		//~ unless async builds are off or the worker failed to start
+		_NODISCARD _Check_return_
+		ESampleRequest RequestTexture(
+			_In_  const PFE_CREATE_SAMPLE_TEXTURE& desc,
+			_Out_ Texture*&						   texture);
+
+		//~ cached texture of the same source and tile size with the closest
+		//~ scale, drawn while the requested one builds, nullptr if none
+		_NODISCARD _Check_return_
+		Texture* FindNearestScale(_In_ const PFE_CREATE_SAMPLE_TEXTURE& desc) const;
+
+		//~ moves the finished builds into the cache, once per logic frame
+		void PublishCompleted();
+
+		//~ logic thread, before PublishCompleted: snapshots published so far
+		//~ and the newest one the render thread released. Frees the retired
+		//~ textures no snapshot in flight can draw; left at 0 without a
+		//~ render thread, evicted textures are then freed at once
+		void SetSnapshotFrames(_In_ uint64_t published, _In_ uint64_t released);
+
+		//~ the texture is still drawn this frame, requested textures that
+		//~ are not marked become candidates for eviction
+		void MarkUsed(_In_opt_ const Texture* texture);
+
+		//~ on unless changed, off makes RequestTexture build inline
+		void SetAsyncBuilds(_In_ bool async) noexcept { m_bAsync = async; }
+
+		_NODISCARD _Check_return_
+		bool IsAsyncBuilds() const noexcept { return m_bAsync; }
+
+		//~ requests not yet published, failed ones waiting for a retry included
+		_NODISCARD _Check_return_
+		size_t GetPendingCount() const noexcept { return m_requests.size(); }
+
+		_NODISCARD _Check_return_
+		size_t GetCachedCount() const noexcept { return m_sampledTextures.size(); }
+
+		//~ evicted, waiting for the render thread to release their snapshots
+		_NODISCARD _Check_return_
+		size_t GetRetiredCount() const noexcept { return m_retired.size(); }
+
+		//~ requested scales kept per source before the idle ones are freed
+		static constexpr size_t kMaxScalesPerSource = 8u;
+
+		//~ frames a requested texture stays cached after its last mark, a
+		//~ scale left for a moment is not built again; freeing it waits
+		//~ for the render thread, see SetSnapshotFrames
+		static constexpr uint64_t kEvictAfterFrames = 4u;
+
+		//~ frames before a failed request is queued again
+		static constexpr uint64_t kRetryAfterFrames = 120u;
+
+		//~ joins the worker, queued builds are dropped
+		void Shutdown();
+
+	private:
+		typedef struct _SAMPLE_JOB
+		{
+			PFE_CREATE_SAMPLE_TEXTURE desc{};
+			PFE_SAMPLE_KEY			  key {};
+		} SAMPLE_JOB;
+
+		typedef struct _SAMPLE_RESULT
+		{
+			PFE_CREATE_SAMPLE_TEXTURE desc	 {};
+			PFE_SAMPLE_KEY			  key	 {};
+			std::unique_ptr<Texture>  texture{ nullptr }; // nullptr if the resample failed
+		} SAMPLE_RESULT;
+
+		typedef struct _SAMPLED_SCALE
+		{
+			FVector2D	   scale  {};
+			Texture*	   texture{ nullptr };
+			PFE_SAMPLE_KEY key	  {};
+			bool		   pinned { false }; // handed out by BuildTexture, never evicted
+		} SAMPLED_SCALE;
+
+		typedef struct _SAMPLE_REQUEST
+		{
+			ESampleRequest state{ ESampleRequest::Pending };
+			uint64_t	   frame{ 0u }; // when it failed
+		} SAMPLE_REQUEST;
+
+		typedef struct _RETIRED_TEXTURE
+		{
+			std::unique_ptr<Texture> texture{ nullptr };
+			uint64_t				 frame	{ 0u }; // snapshots published when it was evicted
+		} RETIRED_TEXTURE;
+
+		struct TexturePtrHash
+		{
+			_NODISCARD
+			size_t operator()(_In_ const Texture* texture) const noexcept
+			{
+				return static_cast<size_t>(HashMix64(reinterpret_cast<uintptr_t>(texture)));
+			}
+		};
+
+		//~ resample, coverage and the premultiplied copy, shared by the inline
+		//~ and the worker path so a published texture is never written again
+		_NODISCARD _Check_return_
+		static std::unique_ptr<Texture> Resample(_In_ const PFE_CREATE_SAMPLE_TEXTURE& desc);
+
+		Texture* Insert(
+			_In_	const PFE_CREATE_SAMPLE_TEXTURE& desc,
+			_In_	const PFE_SAMPLE_KEY&			 key,
+			_Inout_ std::unique_ptr<Texture>&&		 texture,
+			_In_	bool							 pinned);
+
+		//~ a requested texture goes back to being kept for good
+		void Pin(
+			_In_ const PFE_CREATE_SAMPLE_TEXTURE& desc,
+			_In_ const PFE_SAMPLE_KEY&			  key);
+
+		//~ drops the idle unpinned scales of a source over the cap
+		void EvictOverCap(_In_ const PFE_SAMPLE_KEY& sourceKey);
+
+		//~ frees now if no snapshot in flight can draw it, retires otherwise
+		void Retire(_Inout_ std::unique_ptr<Texture>&& texture);
+
+		_NODISCARD _Check_return_
+		bool StartWorker();
+		void WorkerLoop();
+
 	private:
-		fox::unordered_map<std::string, std::unique_ptr<Texture>> m_sampledTextures{};
+		//~ logic thread only
+		template<typename T>
+		using KeyedBy = fox::unordered_map<PFE_SAMPLE_KEY, T, PFE_SAMPLE_KEY_HASH>;
+
+		KeyedBy<std::unique_ptr<Texture>>  m_sampledTextures{};
+		KeyedBy<fox::vector<SAMPLED_SCALE>> m_scalesBySource {};
+		KeyedBy<SAMPLE_REQUEST>			   m_requests		{};
+		bool m_bAsync		{ true };
+		bool m_bWorkerFailed{ false };
+
+		//~ unpinned textures only, frame of the last MarkUsed
+		fox::unordered_map<const Texture*, uint64_t, TexturePtrHash> m_lastUsed{};
+		uint64_t m_nFrame{ 0u }; // PublishCompleted calls
+
+		//~ evicted textures a lagging render thread may still draw
+		fox::vector<RETIRED_TEXTURE> m_retired		  {};
+		uint64_t					 m_nPublishedFrame{ 0u };
+		uint64_t					 m_nReleasedFrame { 0u };
+
+		//~ one worker thread takes the queued scales, a large resample splits
+		//~ its rows across the engine PEJobSystem from there
+		std::thread				   m_worker	  {};
+		std::mutex				   m_jobMutex {};
+		std::condition_variable	   m_jobSignal{};
+		fox::vector<SAMPLE_JOB>	   m_jobs	  {};
+		bool					   m_bStop	  { false };
+
+		std::mutex				   m_completedMutex{};
+		fox::vector<SAMPLE_RESULT> m_completed	   {};
 	};
 } // pixel_engine
@@ -24,6 +24,20 @@ inline constexpr uint64_t PFE_API Hash64(std::string_view str) noexcept
     return hash;
 }
 
+//~ splitmix64 finalizer, every input bit reaches the low bits buckets use
+inline constexpr uint64_t PFE_API HashMix64(uint64_t value) noexcept
+{
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+//~ folds one more value into a running hash, for keys made of a few fields
+inline constexpr uint64_t PFE_API HashCombine(uint64_t seed, uint64_t value) noexcept
+{
+    return seed ^ (HashMix64(value) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+}
+
 //~ Unique Compile Time Hash Type
 template<typename T>
 constexpr uint64_t TypeHash() noexcept
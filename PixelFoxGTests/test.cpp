@@ -1,2 +1,14 @@
 #include "pch.h"
 
+#include "test_blit_kernels.h"
+#include "test_work_stealing.h"
+#include "test_ordered_bucket.h"
+#include "test_render_snapshot.h"
+#include "test_cull_grid.h"
+#include "test_raster_golden.h"
+#include "test_layer_cache.h"
+#include "test_sample_key.h"
+#include "test_sampler_cache.h"
+#include "test_broadphase.h"
+#include "test_contact_solver.h"
+#include "test_transform_store.h"
@@ -0,0 +1,130 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/render_manager/api/raster/blit/blit_kernels.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using pixel_engine::EBlitPath;
+using pixel_engine::PEBlitKernels;
+
+namespace {
+
+    // spans up to this long cover the 16 pixel SIMD bodies and every tail length
+    constexpr int kBlitMaxSpan = 80;
+    constexpr int kBlitSpans   = 600;
+
+    // bytes past the span that no kernel may touch
+    constexpr size_t kBlitGuard = 32u;
+
+    enum class BlitOp { Keyed, Opaque, Blend };
+
+    // a third of the texels sit around the keyed threshold so both sides of it are hit
+    std::vector<uint8_t> MakeBlitSource(std::mt19937& rng, int count, bool premultiplied) {
+        std::vector<uint8_t> src(static_cast<size_t>(count) * 4u);
+        for (size_t i = 0; i < src.size(); i += 4u) {
+            const bool nearBlack = rng() % 3u == 0u;
+            for (size_t c = 0; c < 4u; ++c) {
+                src[i + c] = nearBlack ? static_cast<uint8_t>(rng() % 12u) : static_cast<uint8_t>(rng() & 255u);
+            }
+            if (premultiplied) {
+                // colour never exceeds alpha for premultiplied texels
+                for (size_t c = 0; c < 3u; ++c) src[i + c] = static_cast<uint8_t>(src[i + c] * src[i + 3] / 255u);
+            }
+        }
+        return src;
+    }
+
+    void RunBlit(BlitOp op, bool rgba32, EBlitPath path, uint8_t* dst, const uint8_t* src, int count, uint8_t opacity) {
+        switch (op) {
+        case BlitOp::Keyed:
+            rgba32 ? PEBlitKernels::BlitKeyedRGBA32(path, dst, src, count) : PEBlitKernels::BlitKeyedRGBA(path, dst, src, count);
+            break;
+        case BlitOp::Opaque:
+            rgba32 ? PEBlitKernels::BlitOpaqueRGBA32(path, dst, src, count) : PEBlitKernels::BlitOpaqueRGBA(path, dst, src, count);
+            break;
+        case BlitOp::Blend:
+            rgba32 ? PEBlitKernels::BlendPremultipliedRGBA32(path, dst, src, count, opacity)
+                   : PEBlitKernels::BlendPremultipliedRGBA(path, dst, src, count, opacity);
+            break;
+        }
+    }
+
+    // counts spans where the path wrote something different from the scalar kernel
+    int CountBlitMismatches(BlitOp op, bool rgba32, EBlitPath path) {
+        std::mt19937 rng(1337u);
+        const size_t bpp = rgba32 ? 4u : 3u;
+
+        int mismatches = 0;
+        for (int span = 0; span < kBlitSpans; ++span) {
+            const int count = static_cast<int>(rng() % (kBlitMaxSpan + 1));
+            const uint8_t opacity = span % 4 == 0 ? 255u : static_cast<uint8_t>(rng() & 255u);
+            const auto src = MakeBlitSource(rng, count, op == BlitOp::Blend);
+
+            std::vector<uint8_t> expected(count * bpp + kBlitGuard);
+            for (auto& b : expected) b = static_cast<uint8_t>(rng() & 255u);
+            if (rgba32) {
+                // the 32 bit target is cleared and drawn opaque, only the colour is blended
+                for (int p = 0; p < count; ++p) expected[static_cast<size_t>(p) * 4u + 3u] = 255u;
+            }
+            std::vector<uint8_t> actual = expected;
+
+            RunBlit(op, rgba32, EBlitPath::Scalar, expected.data(), src.data(), count, opacity);
+            RunBlit(op, rgba32, path, actual.data(), src.data(), count, opacity);
+            if (actual != expected) ++mismatches;
+        }
+        return mismatches;
+    }
+
+} // namespace
+
+// -------------------- SIMD PATHS AGAINST SCALAR --------------------
+
+TEST(BlitKernels, ScalarIsAlwaysSupported) {
+    EXPECT_TRUE(PEBlitKernels::IsSupported(EBlitPath::Scalar));
+    EXPECT_TRUE(PEBlitKernels::IsSupported(PEBlitKernels::GetBestPath()));
+}
+
+TEST(BlitKernels, SimdPathsMatchScalar24) {
+    for (const EBlitPath path : { EBlitPath::SSSE3, EBlitPath::AVX2 }) {
+        if (!PEBlitKernels::IsSupported(path)) continue;
+        SCOPED_TRACE(PEBlitKernels::ToString(path));
+
+        EXPECT_EQ(CountBlitMismatches(BlitOp::Keyed,  false, path), 0);
+        EXPECT_EQ(CountBlitMismatches(BlitOp::Opaque, false, path), 0);
+        EXPECT_EQ(CountBlitMismatches(BlitOp::Blend,  false, path), 0);
+    }
+}
+
+TEST(BlitKernels, SimdPathsMatchScalar32) {
+    for (const EBlitPath path : { EBlitPath::SSSE3, EBlitPath::AVX2 }) {
+        if (!PEBlitKernels::IsSupported(path)) continue;
+        SCOPED_TRACE(PEBlitKernels::ToString(path));
+
+        EXPECT_EQ(CountBlitMismatches(BlitOp::Keyed,  true, path), 0);
+        EXPECT_EQ(CountBlitMismatches(BlitOp::Opaque, true, path), 0);
+        EXPECT_EQ(CountBlitMismatches(BlitOp::Blend,  true, path), 0);
+    }
+}
+
+TEST(BlitKernels, KeyedSkipsNearBlackTexels) {
+    const uint8_t src[8] = { 10, 10, 10, 255,   11, 0, 0, 255 };
+    uint8_t dst[6] = { 1, 2, 3, 4, 5, 6 };
+
+    PEBlitKernels::BlitKeyedRGBA(EBlitPath::Scalar, dst, src, 2);
+    EXPECT_EQ(dst[0], 1); EXPECT_EQ(dst[1], 2); EXPECT_EQ(dst[2], 3);
+    EXPECT_EQ(dst[3], 11); EXPECT_EQ(dst[4], 0); EXPECT_EQ(dst[5], 0);
+}
+
+TEST(BlitKernels, UnsupportedPathFallsBackToBest) {
+    const EBlitPath previous = PEBlitKernels::GetActivePath();
+
+    for (size_t p = 0; p < static_cast<size_t>(EBlitPath::Count); ++p) {
+        const auto path = static_cast<EBlitPath>(p);
+        PEBlitKernels::SetActivePath(path);
+        EXPECT_EQ(PEBlitKernels::GetActivePath(),
+                  PEBlitKernels::IsSupported(path) ? path : PEBlitKernels::GetBestPath());
+    }
+    PEBlitKernels::SetActivePath(previous);
+}
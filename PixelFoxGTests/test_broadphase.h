@@ -0,0 +1,204 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/physics_manager/physics_api/broadphase/broadphase.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using pixel_engine::EBroadphase;
+using pixel_engine::PEBroadphase;
+using pixel_engine::PFE_BROADPHASE_FILTER;
+using pixel_engine::PFE_BROADPHASE_PAIR;
+using pixel_engine::TagMask;
+
+namespace {
+
+    using BroadphasePairs = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    // four layers, each box on one of them and ignoring a random set of the others
+    struct BroadphaseScene {
+        fox::vector<pixel_engine::PFE_AABB2D> bounds{};
+        fox::vector<PFE_BROADPHASE_FILTER>    filters{};
+
+        void Add(const pixel_engine::PFE_AABB2D& box, TagMask layers = 1u, TagMask ignores = 0u) {
+            bounds.push_back(box);
+            filters.push_back({ layers, ignores });
+        }
+    };
+
+    BroadphaseScene MakeBroadphaseScene(std::mt19937& rng, int count, float world, float maxSize) {
+        std::uniform_real_distribution<float> pos (0.0f, world);
+        std::uniform_real_distribution<float> size(0.0f, maxSize);
+
+        // the matrix is symmetric, draw the upper half and mirror it
+        TagMask ignores[4]{};
+        for (int a = 0; a < 4; ++a) {
+            for (int b = a; b < 4; ++b) {
+                if (rng() % 4u != 0u) continue;
+                ignores[a] |= TagMask{ 1u } << b;
+                ignores[b] |= TagMask{ 1u } << a;
+            }
+        }
+
+        BroadphaseScene scene;
+        for (int i = 0; i < count; ++i) {
+            pixel_engine::PFE_AABB2D box{};
+            box.minX = pos(rng);
+            box.minY = pos(rng);
+            box.maxX = box.minX + size(rng);
+            box.maxY = box.minY + size(rng);
+
+            const int layer = static_cast<int>(rng() % 4u);
+            scene.Add(box, TagMask{ 1u } << layer, ignores[layer]);
+        }
+        return scene;
+    }
+
+    // the O(n^2) loop the hash replaces: strict overlap, no empty boxes, layers applied
+    BroadphasePairs BroadphaseBruteForce(const BroadphaseScene& scene) {
+        BroadphasePairs pairs;
+        const auto& b = scene.bounds;
+        for (uint32_t i = 0; i < b.size(); ++i) {
+            for (uint32_t j = i + 1u; j < b.size(); ++j) {
+                if (b[i].maxX <= b[i].minX || b[i].maxY <= b[i].minY) continue;
+                if (b[j].maxX <= b[j].minX || b[j].maxY <= b[j].minY) continue;
+                if (scene.filters[i].ignores & scene.filters[j].layers) continue;
+                if (b[i].minX < b[j].maxX && b[j].minX < b[i].maxX &&
+                    b[i].minY < b[j].maxY && b[j].minY < b[i].maxY) {
+                    pairs.emplace_back(i, j);
+                }
+            }
+        }
+        return pairs;
+    }
+
+    BroadphasePairs FindBroadphasePairs(PEBroadphase& broadphase, const BroadphaseScene& scene) {
+        fox::vector<PFE_BROADPHASE_PAIR> out{};
+        broadphase.FindPairs(scene.bounds, scene.filters, out);
+
+        BroadphasePairs pairs;
+        for (const auto& pair : out) pairs.emplace_back(pair.a, pair.b);
+        return pairs;
+    }
+
+    PEBroadphase MakeHashedBroadphase(float cellSize) {
+        PEBroadphase broadphase;
+        broadphase.SetMode(EBroadphase::SpatialHash);
+        broadphase.SetCellSize(cellSize);
+        return broadphase;
+    }
+
+} // namespace
+
+// -------------------- OWNERSHIP --------------------
+
+TEST(Broadphase, PairSharingManyCellsIsReportedOnce) {
+    // both boxes cover the same 6 x 6 cells, only the top left one owns the pair
+    BroadphaseScene scene;
+    scene.Add({ 0.5f, 0.5f, 6.5f, 6.5f });
+    scene.Add({ 0.2f, 0.2f, 6.2f, 6.2f });
+
+    auto broadphase = MakeHashedBroadphase(1.0f);
+    EXPECT_EQ(FindBroadphasePairs(broadphase, scene), (BroadphasePairs{ { 0u, 1u } }));
+}
+
+TEST(Broadphase, OverlapStartingInALaterCellIsStillFound) {
+    // the overlap starts in cell (3, 2), neither box starts there
+    BroadphaseScene scene;
+    scene.Add({ 0.5f, 2.5f, 3.5f, 4.5f });
+    scene.Add({ 3.2f, 0.5f, 5.5f, 2.8f });
+
+    auto broadphase = MakeHashedBroadphase(1.0f);
+    EXPECT_EQ(FindBroadphasePairs(broadphase, scene), (BroadphasePairs{ { 0u, 1u } }));
+}
+
+TEST(Broadphase, TouchingAndEmptyBoxesNeverPair) {
+    BroadphaseScene scene;
+    scene.Add({ 0.0f, 0.0f, 1.0f, 1.0f });
+    scene.Add({ 1.0f, 0.0f, 2.0f, 1.0f }); // shares an edge with 0
+    scene.Add({ 0.5f, 0.5f, 0.5f, 0.9f }); // zero width, inside 0
+
+    auto broadphase = MakeHashedBroadphase(1.0f);
+    EXPECT_TRUE(FindBroadphasePairs(broadphase, scene).empty());
+}
+
+// -------------------- LARGE BOXES --------------------
+
+TEST(Broadphase, LargeBoxesPairWithSmallAndLargeOnes) {
+    // 0 and 1 reach far over 64 cells and skip the hash
+    BroadphaseScene scene;
+    scene.Add({ 0.0f,  0.0f,  40.0f, 40.0f });
+    scene.Add({ 30.0f, 30.0f, 90.0f, 90.0f });
+    scene.Add({ 10.0f, 10.0f, 11.0f, 11.0f }); // inside 0 only
+    scene.Add({ 35.0f, 35.0f, 36.0f, 36.0f }); // inside both
+    scene.Add({ 95.0f, 95.0f, 96.0f, 96.0f }); // outside both
+
+    auto broadphase = MakeHashedBroadphase(1.0f);
+    EXPECT_EQ(FindBroadphasePairs(broadphase, scene),
+              (BroadphasePairs{ { 0u, 1u }, { 0u, 2u }, { 0u, 3u }, { 1u, 3u } }));
+}
+
+TEST(Broadphase, LayersTheMatrixIgnoresNeverPair) {
+    // layer 1 ignores layer 2, both boxes overlap everything
+    BroadphaseScene scene;
+    scene.Add({ 0.0f, 0.0f, 4.0f,   4.0f   }, 1u, 2u);
+    scene.Add({ 1.0f, 1.0f, 3.0f,   3.0f   }, 2u, 1u);
+    scene.Add({ 0.0f, 0.0f, 200.0f, 200.0f }, 2u, 1u); // large
+    scene.Add({ 2.0f, 2.0f, 2.5f,   2.5f   }, 4u, 0u);
+
+    auto broadphase = MakeHashedBroadphase(1.0f);
+    EXPECT_EQ(FindBroadphasePairs(broadphase, scene),
+              (BroadphasePairs{ { 0u, 3u }, { 1u, 2u }, { 1u, 3u }, { 2u, 3u } }));
+}
+
+// -------------------- AGAINST BRUTE FORCE --------------------
+
+TEST(Broadphase, MatchesBruteForce) {
+    std::mt19937 rng(21u);
+    for (const float cell : { 0.25f, 1.0f, 4.0f, 64.0f }) {
+        SCOPED_TRACE(cell);
+        // sizes up to 12 units, at a quarter unit cell many boxes go to the large list
+        const auto scene = MakeBroadphaseScene(rng, 1500, 100.0f, 12.0f);
+        auto broadphase  = MakeHashedBroadphase(cell);
+        EXPECT_EQ(FindBroadphasePairs(broadphase, scene), BroadphaseBruteForce(scene));
+    }
+}
+
+TEST(Broadphase, OutputIsSortedWithoutRepeats) {
+    std::mt19937 rng(5u);
+    const auto scene = MakeBroadphaseScene(rng, 800, 30.0f, 9.0f);
+    auto broadphase  = MakeHashedBroadphase(0.5f);
+
+    const auto pairs = FindBroadphasePairs(broadphase, scene);
+    ASSERT_FALSE(pairs.empty());
+    for (const auto& pair : pairs) EXPECT_LT(pair.first, pair.second);
+    EXPECT_TRUE(std::adjacent_find(pairs.begin(), pairs.end(),
+                                   [](const auto& l, const auto& r) { return !(l < r); }) == pairs.end());
+}
+
+TEST(Broadphase, HashIsTheOverlappingSubsetOfAllPairs) {
+    std::mt19937 rng(77u);
+    const auto scene = MakeBroadphaseScene(rng, 300, 50.0f, 8.0f);
+
+    PEBroadphase all;
+    all.SetMode(EBroadphase::AllPairs);
+    const auto every = FindBroadphasePairs(all, scene);
+    for (const auto& pair : every) EXPECT_FALSE(scene.filters[pair.first].ignores & scene.filters[pair.second].layers);
+
+    auto broadphase = MakeHashedBroadphase(1.0f);
+    const auto hashed = FindBroadphasePairs(broadphase, scene);
+    EXPECT_TRUE(std::includes(every.begin(), every.end(), hashed.begin(), hashed.end()));
+    EXPECT_EQ(hashed, BroadphaseBruteForce(scene));
+}
+
+TEST(Broadphase, FarAwayBoxesDoNotOverflowCells) {
+    BroadphaseScene scene;
+    scene.Add({ 1e12f,  1e12f,  1e12f + 1e6f, 1e12f + 1e6f });
+    scene.Add({ -1e12f, -1e12f, 2e12f,        2e12f        });
+    scene.Add({ 0.0f,   0.0f,   1.0f,         1.0f         });
+
+    auto broadphase = MakeHashedBroadphase(1.0f);
+    EXPECT_EQ(FindBroadphasePairs(broadphase, scene), BroadphaseBruteForce(scene));
+}
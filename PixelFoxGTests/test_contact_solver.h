@@ -0,0 +1,239 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/physics_manager/physics_api/resolver/contact_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using pixel_engine::BoxCollider;
+using pixel_engine::ColliderType;
+using pixel_engine::Contact;
+using pixel_engine::EContactSolver;
+using pixel_engine::PEContactSolver;
+using pixel_engine::RigidBody2D;
+
+namespace {
+
+    // unit boxes unless sized otherwise, the collider reads its body from the transform store
+    struct SolverBox {
+        RigidBody2D body{};
+        BoxCollider collider{ &body };
+    };
+
+    using SolverBoxes = std::vector<std::unique_ptr<SolverBox>>;
+
+    SolverBox& AddSolverBox(SolverBoxes& boxes, FVector2D position, ColliderType type,
+                            FVector2D size = { 1.0f, 1.0f }) {
+        auto& box = *boxes.emplace_back(std::make_unique<SolverBox>());
+        box.body.SetPosition(position);
+        box.body.SetMass(1.0f);
+        box.collider.SetScale(size);
+        box.collider.SetColliderType(type);
+        return box;
+    }
+
+    // a to b in list order, the way the narrowphase hands them over
+    void AddSolverContact(fox::vector<Contact>& contacts, SolverBox& a, SolverBox& b) {
+        Contact contact{};
+        if (!a.collider.TestCollision(&b.collider, contact)) return;
+        contact.A = &a.collider;
+        contact.B = &b.collider;
+        contacts.push_back(contact);
+    }
+
+    float SolverDepth(const SolverBox& a, const SolverBox& b) {
+        Contact contact{};
+        return a.collider.TestCollision(&b.collider, contact) ? contact.Penetration : 0.0f;
+    }
+
+    // a wall on the left and a row of boxes walking into it, every frame
+    // starts from the same overlap so the contacts repeat frame to frame
+    struct SolverCrowd {
+        SolverBoxes boxes{};
+        static constexpr int kCount = 6;
+
+        SolverCrowd() {
+            AddSolverBox(boxes, { -0.5f, 0.0f }, ColliderType::Static);
+            for (int i = 0; i < kCount; ++i) {
+                AddSolverBox(boxes, { 0.45f + 0.95f * static_cast<float>(i), 0.0f }, ColliderType::Dynamic);
+            }
+        }
+
+        // largest speed left into the wall, zero once the crowd is held
+        float Step(PEContactSolver& solver) {
+            fox::vector<Contact> contacts{};
+            for (int i = 0; i < kCount; ++i) {
+                SolverBox& box = *boxes[i + 1];
+                box.body.SetPosition({ 0.45f + 0.95f * static_cast<float>(i), 0.0f });
+                box.body.SetVelocity({ -1.0f, 0.0f });
+                AddSolverContact(contacts, *boxes[i], box);
+            }
+            solver.Solve(contacts, 1.0f / 60.0f);
+
+            float residual = 0.0f;
+            for (int i = 1; i <= kCount; ++i) {
+                residual = std::max(residual, -boxes[i]->body.GetVelocity().x);
+            }
+            return residual;
+        }
+    };
+
+    constexpr float kSolverTolerance = 1e-3f;
+
+} // namespace
+
+// -------------------- POSITION --------------------
+
+TEST(ContactSolver, DynamicBoxLeavesStaticBoxCompletely) {
+    SolverBoxes boxes;
+    auto& wall = AddSolverBox(boxes, { 0.0f, 0.0f }, ColliderType::Static);
+    auto& box  = AddSolverBox(boxes, { 0.5f, 0.0f }, ColliderType::Dynamic);
+
+    fox::vector<Contact> contacts{};
+    AddSolverContact(contacts, wall, box);
+    ASSERT_EQ(contacts.size(), 1u);
+
+    PEContactSolver solver;
+    solver.Solve(contacts, 1.0f / 60.0f);
+
+    // no slop and no percent against a static side
+    EXPECT_LE(SolverDepth(wall, box), 1e-4f);
+    EXPECT_FLOAT_EQ(wall.body.GetPosition().x, 0.0f);
+    EXPECT_NEAR(box.body.GetPosition().x, 1.0f, 1e-4f);
+}
+
+TEST(ContactSolver, SqueezedBodyEndsOutsideTheWall) {
+    // the pusher drives the middle box into the wall during the passes
+    SolverBoxes boxes;
+    auto& wall   = AddSolverBox(boxes, { -0.5f, 0.0f }, ColliderType::Static);
+    auto& middle = AddSolverBox(boxes, { 0.3f,  0.0f }, ColliderType::Dynamic);
+    auto& pusher = AddSolverBox(boxes, { 0.8f,  0.0f }, ColliderType::Dynamic);
+    pusher.body.SetMass(20.0f);
+
+    fox::vector<Contact> contacts{};
+    AddSolverContact(contacts, wall, middle);
+    AddSolverContact(contacts, middle, pusher);
+    ASSERT_EQ(contacts.size(), 2u);
+
+    PEContactSolver solver;
+    solver.SetIterations(1u, 1u);
+    solver.Solve(contacts, 1.0f / 60.0f);
+
+    // the wall wins, whatever is left of the pair waits for the next frame
+    EXPECT_LE(SolverDepth(wall, middle), 1e-4f);
+    EXPECT_GT(pusher.body.GetPosition().x, 0.8f);
+}
+
+TEST(ContactSolver, MovingPairKeepsTheSlop) {
+    SolverBoxes boxes;
+    auto& a = AddSolverBox(boxes, { 0.0f, 0.0f }, ColliderType::Dynamic);
+    auto& b = AddSolverBox(boxes, { 0.5f, 0.0f }, ColliderType::Dynamic);
+
+    fox::vector<Contact> contacts{};
+    AddSolverContact(contacts, a, b);
+
+    PEContactSolver solver;
+    solver.SetIterations(1u, 1u);
+    solver.Solve(contacts, 1.0f / 60.0f);
+
+    // one pass takes 80% of the depth above the slop, split by mass
+    EXPECT_NEAR(SolverDepth(a, b), 0.01f + 0.49f * 0.2f, 1e-4f);
+    EXPECT_NEAR(a.body.GetPosition().x + b.body.GetPosition().x, 0.5f, 1e-5f);
+}
+
+TEST(ContactSolver, TriggersAndStaticPairsAreLeftAlone) {
+    SolverBoxes boxes;
+    auto& wall    = AddSolverBox(boxes, { 0.0f, 0.0f }, ColliderType::Static);
+    auto& floor   = AddSolverBox(boxes, { 0.5f, 0.0f }, ColliderType::Static);
+    auto& trigger = AddSolverBox(boxes, { 0.2f, 0.0f }, ColliderType::Trigger);
+
+    fox::vector<Contact> contacts{};
+    AddSolverContact(contacts, wall, floor);
+    AddSolverContact(contacts, wall, trigger);
+    ASSERT_EQ(contacts.size(), 2u);
+
+    PEContactSolver solver;
+    solver.Solve(contacts, 1.0f / 60.0f);
+
+    EXPECT_EQ(solver.GetIslandCount(), 0u);
+    EXPECT_FLOAT_EQ(floor.body.GetPosition().x, 0.5f);
+    EXPECT_FLOAT_EQ(trigger.body.GetPosition().x, 0.2f);
+}
+
+// -------------------- ISLANDS --------------------
+
+TEST(ContactSolver, StaticColliderDoesNotJoinIslands) {
+    // one wall, a pair on each side of it
+    SolverBoxes boxes;
+    auto& wall = AddSolverBox(boxes, { 0.0f, 0.0f }, ColliderType::Static);
+    auto& l0   = AddSolverBox(boxes, { -0.9f, 0.0f }, ColliderType::Dynamic);
+    auto& l1   = AddSolverBox(boxes, { -1.8f, 0.0f }, ColliderType::Dynamic);
+    auto& r0   = AddSolverBox(boxes, { 0.9f,  0.0f }, ColliderType::Dynamic);
+    auto& r1   = AddSolverBox(boxes, { 1.8f,  0.0f }, ColliderType::Dynamic);
+
+    fox::vector<Contact> contacts{};
+    AddSolverContact(contacts, wall, l0);
+    AddSolverContact(contacts, l0, l1);
+    AddSolverContact(contacts, wall, r0);
+    AddSolverContact(contacts, r0, r1);
+    ASSERT_EQ(contacts.size(), 4u);
+
+    PEContactSolver solver;
+    solver.Solve(contacts, 1.0f / 60.0f);
+    EXPECT_EQ(solver.GetIslandCount(), 2u);
+
+    solver.SetMode(EContactSolver::SinglePass);
+    solver.Solve(contacts, 1.0f / 60.0f);
+    EXPECT_EQ(solver.GetIslandCount(), 0u);
+}
+
+// -------------------- WARM STARTING --------------------
+
+TEST(ContactSolver, WarmStartingConvergesInFewerIterations) {
+    // cold, the crowd needs this many passes in a single frame to be held
+    uint32_t coldIterations = 0u;
+    for (uint32_t iterations = 1u; iterations <= 256u; ++iterations) {
+        SolverCrowd crowd;
+        PEContactSolver solver;
+        solver.SetWarmStarting(false);
+        solver.SetIterations(iterations, 1u);
+        if (crowd.Step(solver) < kSolverTolerance) {
+            coldIterations = iterations;
+            break;
+        }
+    }
+    ASSERT_GT(coldIterations, 2u);
+
+    // warm, the same scene frame after frame with two passes a frame
+    SolverCrowd crowd;
+    PEContactSolver solver;
+    solver.SetIterations(2u, 1u);
+    const float first = crowd.Step(solver);
+    float last = first;
+    for (int frame = 1; frame < 60; ++frame) last = crowd.Step(solver);
+
+    EXPECT_GT(first, kSolverTolerance);
+    EXPECT_LT(last,  kSolverTolerance);
+
+    // the same two passes without the cache never get there
+    SolverCrowd coldCrowd;
+    PEContactSolver cold;
+    cold.SetWarmStarting(false);
+    cold.SetIterations(2u, 1u);
+    float coldLast = 0.0f;
+    for (int frame = 0; frame < 60; ++frame) coldLast = coldCrowd.Step(cold);
+    EXPECT_GT(coldLast, kSolverTolerance);
+}
+
+TEST(ContactSolver, ResetForgetsCachedImpulses) {
+    SolverCrowd crowd;
+    PEContactSolver solver;
+    solver.SetIterations(2u, 1u);
+    const float first = crowd.Step(solver);
+    for (int frame = 1; frame < 60; ++frame) crowd.Step(solver);
+
+    solver.Reset();
+    EXPECT_FLOAT_EQ(crowd.Step(solver), first);
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/core/spatial/cull_grid.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using pixel_engine::PECullGrid;
+using pixel_engine::PFE_AABB2D;
+
+namespace {
+
+    PFE_AABB2D MakeCullBox(std::mt19937& rng, float world, float maxSize) {
+        std::uniform_real_distribution<float> pos (-world, world);
+        std::uniform_real_distribution<float> size(0.0f, maxSize);
+        PFE_AABB2D box{};
+        box.minX = pos(rng);
+        box.minY = pos(rng);
+        box.maxX = box.minX + size(rng);
+        box.maxY = box.minY + size(rng);
+        return box;
+    }
+
+    bool CullBoxesTouch(const PFE_AABB2D& a, const PFE_AABB2D& b) {
+        return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+    }
+
+    std::vector<uint32_t> CullQuery(PECullGrid& grid, const PFE_AABB2D& rect) {
+        fox::vector<uint32_t> out{};
+        grid.Query(rect, out);
+        return { out.begin(), out.end() };
+    }
+
+    // every box the brute force finds must be in the result, and the result
+    // must be ascending without repeats; returns the queries that broke either
+    int CountCullMismatches(PECullGrid& grid, const fox::vector<PFE_AABB2D>& boxes,
+                            std::mt19937& rng, float world, int queries) {
+        int mismatches = 0;
+        for (int q = 0; q < queries; ++q) {
+            const PFE_AABB2D rect = MakeCullBox(rng, world * 1.2f, world);
+            const auto found = CullQuery(grid, rect);
+
+            bool ok = std::adjacent_find(found.begin(), found.end(),
+                                         [](uint32_t a, uint32_t b) { return a >= b; }) == found.end();
+            for (uint32_t i = 0; i < boxes.size() && ok; ++i) {
+                if (CullBoxesTouch(boxes[i], rect)) ok = std::binary_search(found.begin(), found.end(), i);
+            }
+            if (!ok) ++mismatches;
+        }
+        return mismatches;
+    }
+
+} // namespace
+
+// -------------------- EDGES --------------------
+
+TEST(CullGrid, EmptyBuildFindsNothing) {
+    PECullGrid grid;
+    grid.Build({}, 32.0f);
+    EXPECT_TRUE(grid.Empty());
+    EXPECT_TRUE(CullQuery(grid, { -100.0f, -100.0f, 100.0f, 100.0f }).empty());
+}
+
+TEST(CullGrid, RectOutsideTheWorldFindsNothing) {
+    fox::vector<PFE_AABB2D> boxes{};
+    boxes.push_back({ 0.0f, 0.0f, 10.0f, 10.0f });
+    boxes.push_back({ 50.0f, 50.0f, 60.0f, 60.0f });
+
+    PECullGrid grid;
+    grid.Build(boxes, 16.0f);
+    EXPECT_TRUE(CullQuery(grid, { -500.0f, -500.0f, -400.0f, -400.0f }).empty());
+    EXPECT_TRUE(CullQuery(grid, { 1e30f, 1e30f, 2e30f, 2e30f }).empty());
+}
+
+TEST(CullGrid, ItemSpanningManyCellsComesBackOnce) {
+    fox::vector<PFE_AABB2D> boxes{};
+    boxes.push_back({ 0.0f, 0.0f, 1000.0f, 1000.0f });
+    boxes.push_back({ 5.0f, 5.0f, 6.0f, 6.0f });
+
+    PECullGrid grid;
+    grid.Build(boxes, 8.0f);
+    EXPECT_EQ(CullQuery(grid, { -1.0f, -1.0f, 2000.0f, 2000.0f }), (std::vector<uint32_t>{ 0u, 1u }));
+    EXPECT_EQ(CullQuery(grid, { 500.0f, 500.0f, 501.0f, 501.0f }), (std::vector<uint32_t>{ 0u }));
+}
+
+// -------------------- AGAINST BRUTE FORCE --------------------
+
+TEST(CullGrid, MatchesBruteForce) {
+    std::mt19937 rng(42u);
+    for (const float cell : { 4.0f, 32.0f, 256.0f }) {
+        SCOPED_TRACE(cell);
+        fox::vector<PFE_AABB2D> boxes{};
+        for (int i = 0; i < 2000; ++i) boxes.push_back(MakeCullBox(rng, 1000.0f, 60.0f));
+
+        PECullGrid grid;
+        grid.Build(boxes, cell);
+        EXPECT_EQ(CountCullMismatches(grid, boxes, rng, 1000.0f, 300), 0);
+    }
+}
+
+TEST(CullGrid, HugeWorldClampsCellCount) {
+    // 256 cells per axis at most, the cells grow to cover the world instead
+    std::mt19937 rng(9u);
+    fox::vector<PFE_AABB2D> boxes{};
+    for (int i = 0; i < 1500; ++i) boxes.push_back(MakeCullBox(rng, 1e6f, 5000.0f));
+
+    PECullGrid grid;
+    grid.Build(boxes, 1.0f);
+    EXPECT_EQ(CountCullMismatches(grid, boxes, rng, 1e6f, 300), 0);
+}
+
+TEST(CullGrid, RebuildDropsOldItems) {
+    std::mt19937 rng(3u);
+    fox::vector<PFE_AABB2D> first{};
+    for (int i = 0; i < 500; ++i) first.push_back(MakeCullBox(rng, 200.0f, 20.0f));
+
+    PECullGrid grid;
+    grid.Build(first, 16.0f);
+    (void)CullQuery(grid, { -200.0f, -200.0f, 200.0f, 200.0f });
+
+    fox::vector<PFE_AABB2D> second{};
+    for (int i = 0; i < 50; ++i) second.push_back(MakeCullBox(rng, 200.0f, 20.0f));
+    grid.Build(second, 16.0f);
+
+    const auto all = CullQuery(grid, { -1000.0f, -1000.0f, 1000.0f, 1000.0f });
+    ASSERT_EQ(all.size(), 50u);
+    EXPECT_EQ(all.back(), 49u);
+    EXPECT_EQ(CountCullMismatches(grid, second, rng, 200.0f, 200), 0);
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/render_manager/api/raster/cache/layer_cache.h"
+#include "test_texture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using pixel_engine::PELayerCache;
+using pixel_engine::PESpanRasterizer;
+using pixel_engine::PFE_LAYER_CACHE_DESC;
+using pixel_engine::PFE_LAYER_QUAD;
+using pixel_engine::PFE_SPAN_CLIP;
+using pixel_engine::PFE_SPAN_QUAD;
+
+namespace {
+
+    // view 64 x 48 with a 16 px margin, the ring is 96 x 80 layer pixels
+    constexpr int kLayerViewWidth  = 64;
+    constexpr int kLayerViewHeight = 48;
+    constexpr int kLayerMargin     = 16;
+
+    constexpr pixel_engine::PFE_FORMAT_R8G8B8_UINT kLayerClear{ 12u, 34u, 56u };
+
+    // static tiles and props over a layer several rings wide, keyed and opaque,
+    // axis aligned, magnified and rotated so strips cut through every kind
+    struct LayerScene {
+        std::vector<std::unique_ptr<pixel_engine::Texture>> textures{};
+        fox::vector<PFE_LAYER_QUAD>                         quads{};
+    };
+
+    LayerScene MakeLayerScene(uint32_t seed) {
+        std::mt19937 rng(seed);
+        LayerScene scene;
+
+        for (int t = 0; t < 6; ++t) {
+            const int size = 6 + t * 2;
+            scene.textures.push_back(MakeTestTexture("layer_cache_test", size, size,
+                [&rng](int x, int y, unsigned char* texel) {
+                    // a black checker cell every few texels, keyed quads let it through
+                    const bool hole = ((x / 3 + y / 3) % 4) == 0;
+                    for (int c = 0; c < 3; ++c) texel[c] = hole ? 0u : static_cast<unsigned char>(16u + rng() % 230u);
+                }));
+        }
+
+        for (int i = 0; i < 120; ++i) {
+            const auto* texture = scene.textures[rng() % scene.textures.size()].get();
+            const float angle   = (i % 3 == 0) ? static_cast<float>(rng() % 628u) * 0.01f : 0.0f;
+            const float scale   = 1.0f + static_cast<float>(rng() % 3u);
+
+            PFE_LAYER_QUAD quad{};
+            quad.startBase    = { -150.0f + static_cast<float>(rng() % 600u) + 0.25f * static_cast<float>(rng() % 4u),
+                                  -120.0f + static_cast<float>(rng() % 480u) + 0.25f * static_cast<float>(rng() % 4u) };
+            quad.deltaAxisU   = {  std::cos(angle) * scale, std::sin(angle) * scale };
+            quad.deltaAxisV   = { -std::sin(angle) * scale, std::cos(angle) * scale };
+            quad.totalColumns = static_cast<int>(texture->GetWidth());
+            quad.totalRows    = static_cast<int>(texture->GetHeight());
+            quad.sampledTexture = texture;
+            quad.opaque       = i % 5 == 0;
+            scene.quads.push_back(quad);
+        }
+        return scene;
+    }
+
+    std::unique_ptr<pixel_engine::PEImageBuffer> MakeLayerTarget() {
+        pixel_engine::PE_IMAGE_BUFFER_DESC desc{};
+        desc.Width  = static_cast<UINT>(kLayerViewWidth);
+        desc.Height = static_cast<UINT>(kLayerViewHeight);
+        desc.Format = pixel_engine::EPixelFormat::R8G8B8A8;
+        return std::make_unique<pixel_engine::PEImageBuffer>(desc);
+    }
+
+    // the frame drawn straight onto the target, no ring: every quad moved
+    // by the scroll the same whole pixel way the cache moves its strips
+    void DrawLayerDirect(pixel_engine::PEImageBuffer& target, const LayerScene& scene, int scrollX, int scrollY) {
+        target.ClearImageBuffer(kLayerClear);
+        const PFE_SPAN_CLIP clip{ 0, 0, kLayerViewWidth, kLayerViewHeight };
+
+        for (const auto& q : scene.quads) {
+            PFE_SPAN_QUAD span{};
+            if (!PESpanRasterizer::Setup(q.startBase, q.deltaAxisU, q.deltaAxisV, q.totalColumns, q.totalRows, span)) continue;
+
+            span.u0   -= span.dudx * scrollX + span.dudy * scrollY;
+            span.v0   -= span.dvdx * scrollX + span.dvdy * scrollY;
+            span.minY += scrollY;
+            span.maxY += scrollY;
+
+            if (q.opaque) PESpanRasterizer::DrawTextureOpaque(target, span, *q.sampledTexture, clip);
+            else          PESpanRasterizer::DrawTexture      (target, span, *q.sampledTexture, clip);
+        }
+    }
+
+    // first differing pixel as "x, y", empty when the frames are identical
+    std::string LayerMismatch(const pixel_engine::PEImageBuffer& a, const pixel_engine::PEImageBuffer& b) {
+        const size_t rowBytes = static_cast<size_t>(kLayerViewWidth) * a.PixelSize();
+        for (int y = 0; y < kLayerViewHeight; ++y) {
+            const unsigned char* ra = a.Data() + static_cast<size_t>(y) * a.RowPitch();
+            const unsigned char* rb = b.Data() + static_cast<size_t>(y) * b.RowPitch();
+            for (size_t i = 0; i < rowBytes; ++i) {
+                if (ra[i] != rb[i]) return std::to_string(i / a.PixelSize()) + ", " + std::to_string(y);
+            }
+        }
+        return {};
+    }
+
+} // namespace
+
+// -------------------- RING SCROLL --------------------
+
+TEST(LayerCache, ScrolledCompositeMatchesDirectRedraw) {
+    const LayerScene scene = MakeLayerScene(8u);
+
+    PFE_LAYER_CACHE_DESC desc{};
+    desc.ViewWidth  = static_cast<UINT>(kLayerViewWidth);
+    desc.ViewHeight = static_cast<UINT>(kLayerViewHeight);
+    desc.Margin     = kLayerMargin;
+    desc.ClearColor = kLayerClear;
+
+    PELayerCache cache;
+    cache.Init(desc);
+    cache.SetQuads(scene.quads);
+
+    auto cached = MakeLayerTarget();
+    auto direct = MakeLayerTarget();
+    const PFE_SPAN_CLIP screen{ 0, 0, kLayerViewWidth, kLayerViewHeight };
+
+    // right and down past three rings, back up and left past two, a few
+    // frames standing still and steps inside the margin; the camera moves
+    // against the layer so the scroll is its negative
+    struct Step { int dx; int dy; int frames; };
+    const Step path[] = {
+        {  0,  0,  2 }, {  5,  3, 60 }, { 1,  0, 10 }, {  0, 1, 10 },
+        { -7, -4, 50 }, { 13, -9, 12 }, { 0,  0,  3 }, { -3, 11, 15 },
+    };
+
+    const size_t ringPixels = static_cast<size_t>(kLayerViewWidth + 2 * kLayerMargin) *
+                              static_cast<size_t>(kLayerViewHeight + 2 * kLayerMargin);
+
+    int  cameraX = 0, cameraY = 0;
+    int  minX = 0, maxX = 0, minY = 0, maxY = 0;
+    int  frame = 0, copiedOnly = 0, strips = 0, full = 0;
+    for (const Step& step : path) {
+        for (int f = 0; f < step.frames; ++f, ++frame) {
+            cameraX += step.dx;
+            cameraY += step.dy;
+            minX = std::min(minX, cameraX); maxX = std::max(maxX, cameraX);
+            minY = std::min(minY, cameraY); maxY = std::max(maxY, cameraY);
+
+            cached->ClearImageBuffer({ 255u, 0u, 255u });
+            cache.Composite(*cached, -cameraX, -cameraY, &screen, 1u);
+            DrawLayerDirect(*direct, scene, -cameraX, -cameraY);
+
+            const size_t redrawn = cache.GetRedrawnPixels();
+            if (redrawn == 0u) ++copiedOnly;
+            else if (redrawn < ringPixels) ++strips;
+            else                           ++full;
+
+            const std::string mismatch = LayerMismatch(*cached, *direct);
+            ASSERT_TRUE(mismatch.empty()) << "frame " << frame << " camera " << cameraX << ", " << cameraY
+                                          << " first differing pixel " << mismatch;
+        }
+    }
+
+    // the path really wrapped the ring both ways, only the first frame drew
+    // the whole ring and every later one copied or redrew strips
+    EXPECT_GT(maxX - minX, 2 * (kLayerViewWidth  + 2 * kLayerMargin));
+    EXPECT_GT(maxY - minY, 2 * (kLayerViewHeight + 2 * kLayerMargin));
+    EXPECT_EQ(full, 1);
+    EXPECT_GT(copiedOnly, 0);
+    EXPECT_GT(strips, 0);
+}
+
+TEST(LayerCache, InvalidatedCacheRedrawsTheWholeRing) {
+    const LayerScene scene = MakeLayerScene(21u);
+
+    PFE_LAYER_CACHE_DESC desc{};
+    desc.ViewWidth  = static_cast<UINT>(kLayerViewWidth);
+    desc.ViewHeight = static_cast<UINT>(kLayerViewHeight);
+    desc.Margin     = kLayerMargin;
+    desc.ClearColor = kLayerClear;
+
+    PELayerCache cache;
+    cache.Init(desc);
+    cache.SetQuads(scene.quads);
+
+    auto cached = MakeLayerTarget();
+    auto direct = MakeLayerTarget();
+    const PFE_SPAN_CLIP screen{ 0, 0, kLayerViewWidth, kLayerViewHeight };
+
+    cache.Composite(*cached, 40, -25, &screen, 1u);
+    cache.Composite(*cached, 38, -24, &screen, 1u);
+    EXPECT_EQ(cache.GetRedrawnPixels(), 0u);
+
+    // a new clear colour drops the ring, the next frame draws all of it
+    const pixel_engine::PFE_FORMAT_R8G8B8_UINT other{ 90u, 10u, 10u };
+    cache.SetClearColor(other);
+    cache.Composite(*cached, 38, -24, &screen, 1u);
+    EXPECT_EQ(cache.GetRedrawnPixels(), static_cast<size_t>(kLayerViewWidth + 2 * kLayerMargin) *
+                                        static_cast<size_t>(kLayerViewHeight + 2 * kLayerMargin));
+
+    cache.SetClearColor(kLayerClear);
+    cache.Composite(*cached, 38, -24, &screen, 1u);
+    DrawLayerDirect(*direct, scene, 38, -24);
+    EXPECT_TRUE(LayerMismatch(*cached, *direct).empty());
+}
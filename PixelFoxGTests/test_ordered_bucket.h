@@ -0,0 +1,130 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/render_manager/render_queue/ordered_bucket.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+using pixel_engine::PEOrderedBucket;
+using pixel_engine::UniqueId;
+
+namespace {
+
+    struct BucketItem { int value{ 0 }; };
+
+    // live entries of the bucket in the order a renderer walks them
+    std::vector<std::pair<UniqueId, BucketItem*>> LiveEntries(const PEOrderedBucket<BucketItem>& bucket) {
+        std::vector<std::pair<UniqueId, BucketItem*>> live;
+        for (const auto& entry : bucket.Entries()) {
+            if (entry.item) live.emplace_back(entry.id, entry.item);
+        }
+        return live;
+    }
+
+    std::vector<std::pair<UniqueId, BucketItem*>> LiveEntries(const std::map<UniqueId, BucketItem*>& model) {
+        return { model.begin(), model.end() };
+    }
+
+} // namespace
+
+// -------------------- BASICS --------------------
+
+TEST(OrderedBucket, OutOfOrderInsertStaysSorted) {
+    BucketItem items[4]{};
+    PEOrderedBucket<BucketItem> bucket;
+    bucket.Insert(30u, &items[0]);
+    bucket.Insert(10u, &items[1]);
+    bucket.Insert(40u, &items[2]);
+    bucket.Insert(20u, &items[3]);
+
+    const auto live = LiveEntries(bucket);
+    ASSERT_EQ(live.size(), 4u);
+    EXPECT_EQ(live[0].first, 10u);
+    EXPECT_EQ(live[1].first, 20u);
+    EXPECT_EQ(live[2].first, 30u);
+    EXPECT_EQ(live[3].first, 40u);
+}
+
+TEST(OrderedBucket, EraseLeavesHoleThenReinsertFillsIt) {
+    BucketItem a{}, b{}, c{};
+    PEOrderedBucket<BucketItem> bucket;
+    bucket.Insert(1u, &a);
+    bucket.Insert(2u, &b);
+    bucket.Insert(3u, &c);
+
+    EXPECT_TRUE(bucket.Erase(2u));
+    EXPECT_FALSE(bucket.Erase(2u));
+    EXPECT_FALSE(bucket.Contains(2u));
+    EXPECT_EQ(bucket.Size(), 2u);
+    EXPECT_EQ(bucket.Entries().size(), 3u); // hole kept, one of three is below half
+
+    bucket.Insert(2u, &b);
+    EXPECT_TRUE(bucket.Contains(2u));
+    EXPECT_EQ(bucket.Size(), 3u);
+    EXPECT_EQ(bucket.Entries().size(), 3u);
+}
+
+TEST(OrderedBucket, CompactsOnceHalfAreHoles) {
+    BucketItem items[4]{};
+    PEOrderedBucket<BucketItem> bucket;
+    for (UniqueId id = 0u; id < 4u; ++id) bucket.Insert(id + 1u, &items[id]);
+
+    EXPECT_TRUE(bucket.Erase(1u));
+    EXPECT_TRUE(bucket.Erase(3u));
+    EXPECT_TRUE(bucket.Erase(4u)); // three holes out of four squeezes them out
+    EXPECT_EQ(bucket.Entries().size(), 1u);
+    EXPECT_EQ(bucket.Entries()[0].id, 2u);
+    EXPECT_TRUE(bucket.Contains(2u));
+}
+
+TEST(OrderedBucket, NullItemIsIgnored) {
+    PEOrderedBucket<BucketItem> bucket;
+    bucket.Insert(5u, nullptr);
+    EXPECT_TRUE(bucket.Empty());
+    EXPECT_FALSE(bucket.Contains(5u));
+}
+
+// -------------------- AGAINST std::map --------------------
+
+TEST(OrderedBucket, MatchesSortedMapUnderRandomEdits) {
+    std::vector<BucketItem> items(512);
+    PEOrderedBucket<BucketItem>     bucket;
+    std::map<UniqueId, BucketItem*> model;
+
+    // mostly appends of the next id like the id allocator, with reinserts
+    // of old ids, erases and the odd clear mixed in
+    std::mt19937 rng(2024u);
+    UniqueId next = 1u;
+    for (int step = 0; step < 20000; ++step) {
+        const uint32_t op = rng() % 100u;
+        if (op < 50u && next < items.size()) {
+            BucketItem* item = &items[next];
+            bucket.Insert(next, item);
+            model[next] = item;
+            ++next;
+        }
+        else if (op < 65u) {
+            const UniqueId id = 1u + rng() % next;
+            BucketItem* item = &items[id % items.size()];
+            bucket.Insert(id, item);
+            model[id] = item;
+        }
+        else if (op < 99u) {
+            const UniqueId id = 1u + rng() % next;
+            EXPECT_EQ(bucket.Erase(id), model.erase(id) == 1u);
+        }
+        else {
+            bucket.Clear();
+            model.clear();
+        }
+
+        ASSERT_EQ(bucket.Size(), model.size()) << "step " << step;
+        if (step % 64 == 0) ASSERT_EQ(LiveEntries(bucket), LiveEntries(model)) << "step " << step;
+    }
+    EXPECT_EQ(LiveEntries(bucket), LiveEntries(model));
+
+    for (UniqueId id = 0u; id <= next; ++id) {
+        EXPECT_EQ(bucket.Contains(id), model.count(id) == 1u);
+    }
+}
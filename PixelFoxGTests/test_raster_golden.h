@@ -0,0 +1,328 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/render_manager/api/raster/raster.h"
+#include "pixel_engine/render_manager/api/present/headless_present.h"
+#include "test_texture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+
+using pixel_engine::EBlendMode;
+using pixel_engine::EPixelFormat;
+using pixel_engine::PEHeadlessPresentTarget;
+using pixel_engine::PERaster2D;
+using pixel_engine::PFE_HEADLESS_IMAGE;
+
+namespace {
+
+    // scripted scenes rendered through a private raster into the headless target,
+    // the last frame has to match golden/<name>.ppm next to this file
+    struct GoldenScene {
+        const char*  name         { "scene" };
+        unsigned     targetWidth  { 320u };
+        unsigned     targetHeight { 240u };
+        int          spriteSize   { 32 };
+        int          spriteCount  { 64 };
+        int          frames       { 8 };
+        float        rotation     { 0.0f };  // radians at the first frame
+        float        rotationStep { 0.0f };  // radians added every frame
+        float        drift        { 1.5f };  // pixels every sprite moves per frame
+        bool         blended      { false }; // premultiplied alpha sprites instead of colour keyed
+        const char*  text         { nullptr };
+        uint32_t     seed         { 1337u };
+        EPixelFormat targetFormat { EPixelFormat::R8G8B8A8 };
+    };
+
+    // sin, cos and sampling rounding differ a little between compilers, so a
+    // channel may be off by a few steps and a few edge texels may land on the
+    // neighbour; anything past that is a real change in the raster
+    constexpr uint8_t kGoldenTolerance     = 8u;
+    constexpr size_t  kGoldenMaxMismatched = 64u; // of 76800 pixels
+
+    // never produced by the scene textures, a hole shows up as magenta
+    constexpr pixel_engine::PFE_FORMAT_R8G8B8_UINT kGoldenClear{ 255u, 0u, 255u };
+
+    constexpr int kGlyphWidth  = 8;
+    constexpr int kGlyphHeight = 12;
+
+    struct GoldenSprite {
+        FVector2D centre  {};
+        FVector2D velocity{};
+        float     phase   { 0.0f };
+    };
+
+    struct GoldenQuad {
+        FVector2D start{};
+        FVector2D axisU{};
+        FVector2D axisV{};
+    };
+
+    // the std distributions differ between standard libraries, these do not
+    float GoldenUniform(std::mt19937& rng, float lo, float hi) {
+        return lo + (hi - lo) * static_cast<float>(rng() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    unsigned char GoldenChannel(std::mt19937& rng) {
+        return static_cast<unsigned char>(11u + rng() % 240u);
+    }
+
+    // a disc of colour on black, keyed sprites lose the black and blended ones fade out to the rim
+    std::unique_ptr<pixel_engine::Texture> MakeGoldenSpriteTexture(int size, bool blended, std::mt19937& rng) {
+        const float centre = 0.5f * static_cast<float>(size - 1);
+        const float radius = 0.45f * static_cast<float>(size);
+
+        auto texture = MakeTestTexture("raster_golden", size, size,
+            [&](int x, int y, unsigned char* texel) {
+                const float dx = static_cast<float>(x) - centre;
+                const float dy = static_cast<float>(y) - centre;
+                const float r  = std::sqrt(dx * dx + dy * dy) / radius;
+                const bool outside = r > 1.0f;
+
+                for (int c = 0; c < 3; ++c) {
+                    const unsigned char value = GoldenChannel(rng);
+                    texel[c] = outside ? 0u : value;
+                }
+                texel[3] = blended
+                    ? static_cast<unsigned char>(outside ? 0 : 255 - static_cast<int>(r * 200.0f))
+                    : 255u;
+            }, pixel_engine::ColorSpace::sRGB);
+        if (blended) texture->BuildPremultiplied();
+        else         texture->BuildCoverage();
+        return texture;
+    }
+
+    // stand in for a font atlas glyph, a fixed bit pattern per character
+    std::unique_ptr<pixel_engine::Texture> MakeGoldenGlyph(char glyph) {
+        uint32_t bits = 2166136261u ^ static_cast<uint8_t>(glyph);
+        auto texture = MakeTestTexture("raster_golden_glyph", kGlyphWidth, kGlyphHeight,
+            [&bits](int x, int y, unsigned char* texel) {
+                bits = bits * 1664525u + 1013904223u;
+
+                const bool border = x == 0 || y == 0 || x == kGlyphWidth - 1 || y == kGlyphHeight - 1;
+                const bool ink    = !border && (bits >> 28) >= 7u;
+                texel[0] = texel[1] = texel[2] = ink ? 255u : 0u;
+            }, pixel_engine::ColorSpace::sRGB);
+        texture->BuildCoverage();
+        return texture;
+    }
+
+    fox::vector<GoldenSprite> MakeGoldenSprites(const GoldenScene& scene, std::mt19937& rng) {
+        fox::vector<GoldenSprite> sprites{};
+        for (int i = 0; i < scene.spriteCount; ++i) {
+            GoldenSprite sprite{};
+            sprite.centre.x = GoldenUniform(rng, 0.0f, static_cast<float>(scene.targetWidth));
+            sprite.centre.y = GoldenUniform(rng, 0.0f, static_cast<float>(scene.targetHeight));
+
+            const float heading = GoldenUniform(rng, 0.0f, 6.2831853f);
+            sprite.velocity = { std::cos(heading) * scene.drift, std::sin(heading) * scene.drift };
+            sprite.phase    = scene.rotationStep != 0.0f ? GoldenUniform(rng, 0.0f, 6.2831853f) : 0.0f;
+            sprites.push_back(sprite);
+        }
+        return sprites;
+    }
+
+    // quad of the sprite at a frame, turned around its centre
+    GoldenQuad GoldenSpriteQuad(const GoldenSprite& sprite, const GoldenScene& scene, int frame) {
+        const float t     = static_cast<float>(frame);
+        const float angle = scene.rotation + sprite.phase + scene.rotationStep * t;
+        const float c     = std::cos(angle);
+        const float s     = std::sin(angle);
+        const float half  = 0.5f * static_cast<float>(scene.spriteSize - 1);
+
+        GoldenQuad quad{};
+        quad.axisU = {  c, s };
+        quad.axisV = { -s, c };
+        quad.start = {
+            sprite.centre.x + sprite.velocity.x * t - (quad.axisU.x + quad.axisV.x) * half,
+            sprite.centre.y + sprite.velocity.y * t - (quad.axisU.y + quad.axisV.y) * half
+        };
+        return quad;
+    }
+
+    // texel footprint plus a pixel of slack, as the render queue marks it
+    pixel_engine::PFE_AABB2D GoldenQuadBounds(const GoldenQuad& quad, int size) {
+        const float n = static_cast<float>(size);
+        const FVector2D a{ quad.start.x - 0.5f * (quad.axisU.x + quad.axisV.x),
+                           quad.start.y - 0.5f * (quad.axisU.y + quad.axisV.y) };
+        const FVector2D b{ a.x + quad.axisU.x * n, a.y + quad.axisU.y * n };
+        const FVector2D c{ a.x + quad.axisV.x * n, a.y + quad.axisV.y * n };
+        const FVector2D d{ b.x + quad.axisV.x * n, b.y + quad.axisV.y * n };
+
+        pixel_engine::PFE_AABB2D box{};
+        box.minX = std::min(std::min(a.x, b.x), std::min(c.x, d.x)) - 1.0f;
+        box.maxX = std::max(std::max(a.x, b.x), std::max(c.x, d.x)) + 1.0f;
+        box.minY = std::min(std::min(a.y, b.y), std::min(c.y, d.y)) - 1.0f;
+        box.maxY = std::max(std::max(a.y, b.y), std::max(c.y, d.y)) + 1.0f;
+        return box;
+    }
+
+    void SubmitGoldenQuad(PERaster2D& raster, const GoldenQuad& quad,
+                          const pixel_engine::Texture& texture, EBlendMode blendMode) {
+        const int width  = static_cast<int>(texture.GetWidth());
+        const int height = static_cast<int>(texture.GetHeight());
+
+        pixel_engine::PFE_RASTER_DRAW_CMD cmd{
+            .startBase       = quad.start,
+            .deltaAxisU      = quad.axisU,
+            .deltaAxisV      = quad.axisV,
+            .columnStartFrom = 0,
+            .columneEndAt    = width,
+            .rowStartFrom    = 0,
+            .rowEndAt        = height,
+            .totalColumns    = width,
+            .totalRows       = height,
+            .sampledTexture  = &texture,
+            .color           = kGoldenClear,
+            .blendMode       = blendMode,
+        };
+        raster.SubmitQuadTile(cmd);
+    }
+
+    // every frame of the scene into the target, false if the raster failed to start
+    bool RenderGoldenScene(const GoldenScene& scene, bool damageTracking, PEHeadlessPresentTarget& target) {
+        target.Reset();
+
+        pixel_engine::PFE_RASTER_CONSTRUCT_DESC construct{};
+        construct.Viewport         = { 0u, 0u, scene.targetWidth, scene.targetHeight };
+        construct.EnableBoundCheck = true;
+        construct.TargetFormat     = scene.targetFormat;
+        construct.ClearColor       = kGoldenClear;
+
+        PERaster2D raster{ &construct };
+
+        pixel_engine::PFE_RASTER_INIT_DESC init{};
+        init.EnableTileBinning    = true;
+        init.EnableDamageTracking = damageTracking;
+        init.EnableLayerCache     = false;
+        if (!raster.Init(&init)) return false;
+
+        std::mt19937 rng{ scene.seed };
+        const auto texture = MakeGoldenSpriteTexture(scene.spriteSize, scene.blended, rng);
+        const auto sprites = MakeGoldenSprites(scene, rng);
+        const auto blend   = scene.blended ? EBlendMode::PremultipliedAlpha : EBlendMode::ColorKey;
+
+        // text sits along the bottom edge and never moves, like the fps counter
+        fox::vector<std::unique_ptr<pixel_engine::Texture>> glyphs{};
+        fox::vector<GoldenQuad>                             glyphQuads{};
+        if (scene.text) {
+            const float baseline = static_cast<float>(scene.targetHeight) - static_cast<float>(kGlyphHeight) - 4.0f;
+            float pen = 4.0f;
+            for (const char* c = scene.text; *c; ++c, pen += static_cast<float>(kGlyphWidth)) {
+                if (*c == ' ') continue;
+
+                GoldenQuad quad{};
+                quad.start = { pen, baseline };
+                quad.axisU = { 1.0f, 0.0f };
+                quad.axisV = { 0.0f, 1.0f };
+                glyphs    .push_back(MakeGoldenGlyph(*c));
+                glyphQuads.push_back(quad);
+            }
+        }
+
+        fox::vector<GoldenQuad> quads{};
+        fox::vector<GoldenQuad> previous{};
+        for (int frame = 0; frame < scene.frames; ++frame) {
+            quads.clear();
+            for (const auto& sprite : sprites) quads.push_back(GoldenSpriteQuad(sprite, scene, frame));
+
+            if (damageTracking) {
+                raster.BeginDamage(frame == 0);
+                for (size_t i = 0; frame > 0 && i < quads.size(); ++i) {
+                    raster.AddDamage(GoldenQuadBounds(previous[i], scene.spriteSize));
+                    raster.AddDamage(GoldenQuadBounds(quads[i],    scene.spriteSize));
+                }
+                raster.EndDamage();
+                raster.ClearDamage();
+            }
+            else raster.Clear(kGoldenClear);
+
+            raster.BeginTileBinning();
+            for (const auto& quad : quads) SubmitGoldenQuad(raster, quad, *texture, blend);
+            for (size_t i = 0; i < glyphQuads.size(); ++i) {
+                SubmitGoldenQuad(raster, glyphQuads[i], *glyphs[i], EBlendMode::ColorKey);
+            }
+            raster.FlushTileBins();
+            raster.Present(&target);
+
+            quads.swap(previous);
+        }
+        return true;
+    }
+
+    std::filesystem::path GoldenPath(const char* name, const char* suffix) {
+        return std::filesystem::path(__FILE__).parent_path() / "golden" / (std::string(name) + suffix);
+    }
+
+    // the damage tracked run has to equal a full redraw exactly and the golden
+    // image within the tolerance; a failing frame is written to
+    // golden/<name>.actual.ppm for a look, the golden itself is never touched
+    void CheckGoldenScene(const GoldenScene& scene) {
+        PEHeadlessPresentTarget reference{};
+        PEHeadlessPresentTarget tracked{};
+        ASSERT_TRUE(RenderGoldenScene(scene, false, reference));
+        ASSERT_TRUE(RenderGoldenScene(scene, true,  tracked));
+
+        EXPECT_EQ(PEHeadlessPresentTarget::CountMismatched(tracked.GetFrame(), reference.GetFrame(), 0u), 0u)
+            << "damage tracking left stale pixels";
+
+        PFE_HEADLESS_IMAGE golden{};
+        const bool found = PEHeadlessPresentTarget::ReadPPM(GoldenPath(scene.name, ".ppm").string(), golden);
+        const size_t mismatched = found
+            ? PEHeadlessPresentTarget::CountMismatched(tracked.GetFrame(), golden, kGoldenTolerance)
+            : 0u;
+
+        EXPECT_TRUE(found) << "missing " << GoldenPath(scene.name, ".ppm").string();
+        EXPECT_LE(mismatched, kGoldenMaxMismatched) << "pixels more than " << int(kGoldenTolerance) << " off golden";
+
+        if (!found || mismatched > kGoldenMaxMismatched) {
+            (void)tracked.WritePPM(GoldenPath(scene.name, ".actual.ppm").string());
+        }
+    }
+
+} // namespace
+
+// -------------------- SCENES --------------------
+
+TEST(RasterGolden, KeyedAxisAligned) {
+    GoldenScene scene{};
+    scene.name = "keyed_axis_aligned";
+    CheckGoldenScene(scene);
+}
+
+TEST(RasterGolden, KeyedRotated) {
+    GoldenScene scene{};
+    scene.name         = "keyed_rotated";
+    scene.rotation     = 0.5236f;
+    scene.rotationStep = 0.05f;
+    CheckGoldenScene(scene);
+}
+
+TEST(RasterGolden, BlendedRotated) {
+    GoldenScene scene{};
+    scene.name         = "blended_rotated";
+    scene.blended      = true;
+    scene.rotation     = 0.3f;
+    scene.rotationStep = 0.02f;
+    CheckGoldenScene(scene);
+}
+
+TEST(RasterGolden, TextOverSprites) {
+    GoldenScene scene{};
+    scene.name        = "text_over_sprites";
+    scene.spriteCount = 48;
+    scene.text        = "PIXELFOX 0123456789 FPS";
+    CheckGoldenScene(scene);
+}
+
+TEST(RasterGolden, KeyedRotated24Bit) {
+    GoldenScene scene{};
+    scene.name         = "keyed_rotated_24bit";
+    scene.rotation     = 0.5236f;
+    scene.rotationStep = 0.05f;
+    scene.targetFormat = EPixelFormat::R8G8B8;
+    CheckGoldenScene(scene);
+}
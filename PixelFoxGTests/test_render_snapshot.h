@@ -0,0 +1,151 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/render_manager/render_queue/render_snapshot.h"
+
+#include <atomic>
+#include <thread>
+
+using pixel_engine::PERenderSnapshotRing;
+using pixel_engine::PFE_RENDER_SNAPSHOT;
+using pixel_engine::PFE_SPRITE_SNAPSHOT;
+using pixel_engine::UniqueId;
+
+namespace {
+
+    // every frame carries its own number in each sprite and a size derived from it,
+    // so a torn or mixed up frame shows on the reader side
+    size_t SnapshotSpriteCount(uint64_t frame) { return 1u + static_cast<size_t>(frame % 37u); }
+
+    void FillSnapshot(PFE_RENDER_SNAPSHOT& snapshot, uint64_t frame) {
+        const size_t count = SnapshotSpriteCount(frame);
+        for (size_t i = 0; i < count; ++i) {
+            PFE_SPRITE_SNAPSHOT sprite{};
+            sprite.id      = static_cast<UniqueId>(frame);
+            sprite.opacity = static_cast<uint8_t>(count);
+            snapshot.sprites.push_back(sprite);
+        }
+    }
+
+    bool SnapshotIsWhole(const PFE_RENDER_SNAPSHOT& snapshot) {
+        if (snapshot.frame == 0u) return snapshot.sprites.empty();
+        if (snapshot.sprites.size() != SnapshotSpriteCount(snapshot.frame)) return false;
+        for (const auto& sprite : snapshot.sprites) {
+            if (sprite.id != static_cast<UniqueId>(snapshot.frame)) return false;
+            if (sprite.opacity != snapshot.sprites.size()) return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+// -------------------- SINGLE THREAD --------------------
+
+TEST(RenderSnapshotRing, NothingPublishedReadsEmptyFrame) {
+    PERenderSnapshotRing ring;
+    const auto& snapshot = ring.Acquire();
+    EXPECT_EQ(snapshot.frame, 0u);
+    EXPECT_TRUE(snapshot.sprites.empty());
+}
+
+TEST(RenderSnapshotRing, AcquireReturnsLatestPublish) {
+    PERenderSnapshotRing ring;
+    for (uint64_t frame = 1u; frame <= 3u; ++frame) {
+        FillSnapshot(ring.BeginWrite(), frame);
+        ring.Publish();
+    }
+
+    const auto& snapshot = ring.Acquire();
+    EXPECT_EQ(snapshot.frame, 3u);
+    EXPECT_TRUE(SnapshotIsWhole(snapshot));
+}
+
+TEST(RenderSnapshotRing, AcquireKeepsFrameUntilNextPublish) {
+    PERenderSnapshotRing ring;
+    FillSnapshot(ring.BeginWrite(), 1u);
+    ring.Publish();
+
+    const PFE_RENDER_SNAPSHOT* first = &ring.Acquire();
+    EXPECT_EQ(first->frame, 1u);
+    EXPECT_EQ(&ring.Acquire(), first); // nothing new, same slot again
+
+    // the producer may fill two frames while the consumer holds the first
+    FillSnapshot(ring.BeginWrite(), 2u);
+    ring.Publish();
+    FillSnapshot(ring.BeginWrite(), 3u);
+    ring.Publish();
+    EXPECT_EQ(first->frame, 1u);
+    EXPECT_TRUE(SnapshotIsWhole(*first));
+
+    const auto& latest = ring.Acquire();
+    EXPECT_EQ(latest.frame, 3u);
+    EXPECT_TRUE(SnapshotIsWhole(latest));
+}
+
+TEST(RenderSnapshotRing, BeginWriteHandsOutClearedFrame) {
+    PERenderSnapshotRing ring;
+    for (uint64_t frame = 1u; frame <= 6u; ++frame) {
+        auto& snapshot = ring.BeginWrite();
+        EXPECT_TRUE(snapshot.sprites.empty());
+        EXPECT_FALSE(snapshot.hasCamera);
+        FillSnapshot(snapshot, frame);
+        snapshot.hasCamera = true;
+        ring.Publish();
+        if (frame % 2u == 0u) (void)ring.Acquire();
+    }
+}
+
+TEST(RenderSnapshotRing, ReleasedFrameTrailsTheConsumer) {
+    PERenderSnapshotRing ring;
+    EXPECT_EQ(ring.GetReleasedFrame(), 0u);
+
+    FillSnapshot(ring.BeginWrite(), 1u);
+    ring.Publish();
+    EXPECT_EQ(ring.Acquire().frame, 1u);
+    EXPECT_EQ(ring.GetReleasedFrame(), 0u);
+
+    // the producer runs ahead while the consumer holds frame 1
+    for (uint64_t frame = 2u; frame <= 5u; ++frame) {
+        FillSnapshot(ring.BeginWrite(), frame);
+        ring.Publish();
+    }
+    EXPECT_EQ(ring.GetPublishedFrame(), 5u);
+    EXPECT_EQ(ring.GetReleasedFrame(), 0u);
+
+    // taking frame 5 gives up frame 1, the frames it skipped were never held
+    EXPECT_EQ(ring.Acquire().frame, 5u);
+    EXPECT_EQ(ring.GetReleasedFrame(), 1u);
+
+    (void)ring.Acquire(); // nothing new, frame 5 stays held
+    EXPECT_EQ(ring.GetReleasedFrame(), 1u);
+}
+
+// -------------------- PRODUCER AND CONSUMER --------------------
+
+TEST(RenderSnapshotRing, ConsumerNeverSeesTornOrOlderFrame) {
+    constexpr uint64_t kFrames = 100000u;
+    PERenderSnapshotRing ring;
+    std::atomic<bool> done{ false };
+
+    std::thread producer([&]() {
+        for (uint64_t frame = 1u; frame <= kFrames; ++frame) {
+            FillSnapshot(ring.BeginWrite(), frame);
+            ring.Publish();
+        }
+        done.store(true);
+    });
+
+    uint64_t last  = 0u;
+    int      torn  = 0;
+    int      older = 0;
+    while (!done.load() || last < kFrames) {
+        const auto& snapshot = ring.Acquire();
+        if (snapshot.frame < last) ++older;
+        if (!SnapshotIsWhole(snapshot)) ++torn;
+        last = snapshot.frame;
+    }
+    producer.join();
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(older, 0);
+    EXPECT_EQ(last, kFrames);
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/render_manager/render_queue/sampler/sample_allocator.h"
+#include "pixel_engine/render_manager/render_queue/sampler/bilinear/bilinear_sampler.h"
+#include "test_texture.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+using pixel_engine::BilinearSampler;
+using pixel_engine::PFE_CREATE_SAMPLE_TEXTURE;
+using pixel_engine::PFE_SAMPLE_KEY;
+using pixel_engine::PFE_SAMPLE_KEY_HASH;
+
+namespace {
+
+    std::unique_ptr<pixel_engine::Texture> MakeSampleKeyTexture(int size) {
+        return MakeTestTexture("sample_key_test", size, size,
+            [size](int x, int y, unsigned char* texel) {
+                const int i = y * size + x;
+                texel[0] = static_cast<unsigned char>(i * 7);
+                texel[1] = static_cast<unsigned char>(i * 13);
+                texel[2] = static_cast<unsigned char>(i * 29);
+            });
+    }
+
+    PFE_CREATE_SAMPLE_TEXTURE MakeSampleDesc(pixel_engine::Texture* texture, int tileSize, float sx, float sy) {
+        PFE_CREATE_SAMPLE_TEXTURE desc{};
+        desc.texture  = texture;
+        desc.tileSize = tileSize;
+        desc.scaledBy = { sx, sy };
+        return desc;
+    }
+
+    // keys for a spread of fake texture addresses, tile sizes and sampled sizes,
+    // laid out like the texture pool hands them out
+    std::vector<PFE_SAMPLE_KEY> MakeKeyGrid() {
+        std::vector<PFE_SAMPLE_KEY> keys;
+        for (uintptr_t t = 0; t < 16u; ++t) {
+            for (const int32_t tile : { 16, 32 }) {
+                for (int32_t w = 1; w <= 16; ++w) {
+                    for (int32_t h = 1; h <= 8; ++h) {
+                        PFE_SAMPLE_KEY key{};
+                        key.texture  = reinterpret_cast<const pixel_engine::Texture*>(0x10000u + t * 0x140u);
+                        key.tileSize = tile;
+                        key.width    = w * tile / 4;
+                        key.height   = h * tile / 4;
+                        keys.push_back(key);
+                    }
+                }
+            }
+        }
+        return keys;
+    }
+
+} // namespace
+
+// -------------------- KEY --------------------
+
+TEST(SampleKey, ScalesRoundingToTheSameSizeShareAKey) {
+    auto texture = MakeSampleKeyTexture(4);
+    const auto a = MakeSampleDesc(texture.get(), 32, 1.0f,   2.0f);
+    const auto b = MakeSampleDesc(texture.get(), 32, 1.01f,  1.99f); // 32.3 x 63.7
+    const auto c = MakeSampleDesc(texture.get(), 32, 1.02f,  2.0f);  // 32.6 rounds up
+
+    EXPECT_EQ(a.GetKey(), b.GetKey());
+    EXPECT_NE(a.GetKey(), c.GetKey());
+    EXPECT_EQ(PFE_SAMPLE_KEY_HASH{}(a.GetKey()), PFE_SAMPLE_KEY_HASH{}(b.GetKey()));
+    EXPECT_EQ(a.GetSourceKey(), c.GetSourceKey());
+}
+
+TEST(SampleKey, SourceAndTileSizeAreAlwaysPartOfTheKey) {
+    auto first  = MakeSampleKeyTexture(4);
+    auto second = MakeSampleKeyTexture(4);
+
+    const auto base = MakeSampleDesc(first.get(), 32, 1.0f, 1.0f);
+    EXPECT_NE(base.GetKey(), MakeSampleDesc(second.get(), 32, 1.0f, 1.0f).GetKey());
+    EXPECT_NE(base.GetKey(), MakeSampleDesc(first.get(),  16, 2.0f, 2.0f).GetKey()); // same 32 x 32 output
+    EXPECT_NE(base.GetSourceKey(), MakeSampleDesc(second.get(), 32, 1.0f, 1.0f).GetSourceKey());
+}
+
+TEST(SampleKey, SizeMatchesTheSampledImage) {
+    auto texture = MakeSampleKeyTexture(8);
+    std::mt19937 rng(19u);
+    for (int i = 0; i < 200; ++i) {
+        const int   tile = 1 + static_cast<int>(rng() % 48u);
+        const float sx   = 0.01f + static_cast<float>(rng() % 4000u) / 1000.0f;
+        const float sy   = 0.01f + static_cast<float>(rng() % 4000u) / 1000.0f;
+        const auto desc  = MakeSampleDesc(texture.get(), tile, sx, sy);
+
+        const auto sampled = BilinearSampler::Instance().GetSampledImage(texture.get(), tile, desc.scaledBy);
+        ASSERT_TRUE(sampled);
+
+        const PFE_SAMPLE_KEY key = desc.GetKey();
+        EXPECT_EQ(static_cast<uint32_t>(key.width),  sampled->GetWidth())  << tile << " " << sx;
+        EXPECT_EQ(static_cast<uint32_t>(key.height), sampled->GetHeight()) << tile << " " << sy;
+    }
+}
+
+// -------------------- HASH --------------------
+
+TEST(SampleKey, HashSeparatesEveryKeyOfTheGrid) {
+    const auto keys = MakeKeyGrid();
+    std::set<size_t> hashes;
+    for (const auto& key : keys) hashes.insert(PFE_SAMPLE_KEY_HASH{}(key));
+    EXPECT_EQ(hashes.size(), keys.size());
+}
+
+TEST(SampleKey, HashSpreadsOverLowBits) {
+    // 4096 keys into 1024 buckets fill about 1005 when the low bits are random
+    const auto keys = MakeKeyGrid();
+    ASSERT_EQ(keys.size(), 4096u);
+
+    std::vector<int> buckets(1024, 0);
+    for (const auto& key : keys) ++buckets[PFE_SAMPLE_KEY_HASH{}(key) & 1023u];
+
+    int used = 0, largest = 0;
+    for (const int count : buckets) {
+        if (count) ++used;
+        largest = std::max(largest, count);
+    }
+    EXPECT_GT(used, 960);
+    EXPECT_LT(largest, 16);
+}
+
+TEST(SampleKey, HashCombineDependsOnOrder) {
+    EXPECT_NE(HashCombine(HashCombine(0u, 1u), 2u), HashCombine(HashCombine(0u, 2u), 1u));
+    EXPECT_NE(HashCombine(0u, 0u), HashCombine(HashCombine(0u, 0u), 0u));
+    static_assert(HashCombine(7u, 9u) == HashCombine(7u, 9u), "usable in constant expressions");
+}
+
+TEST(SampleKey, MapFindsEveryKeyBack) {
+    const auto keys = MakeKeyGrid();
+    fox::unordered_map<PFE_SAMPLE_KEY, int, PFE_SAMPLE_KEY_HASH> map{};
+    for (size_t i = 0; i < keys.size(); ++i) map[keys[i]] = static_cast<int>(i);
+
+    EXPECT_EQ(map.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const int* found = map.find(keys[i]);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, static_cast<int>(i));
+    }
+
+    PFE_SAMPLE_KEY missing = keys.front();
+    missing.width += 1000;
+    EXPECT_EQ(map.find(missing), nullptr);
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/render_manager/render_queue/sampler/sample_allocator.h"
+#include "pixel_engine/render_manager/render_queue/render_snapshot.h"
+#include "test_texture.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using pixel_engine::ESampleRequest;
+using pixel_engine::PERenderSnapshotRing;
+using pixel_engine::PFE_RENDER_SNAPSHOT;
+using pixel_engine::Sampler;
+
+namespace {
+
+    // the cache keys by source address, sources outlive every test so a
+    // new one never lands on the entries of an old one
+    pixel_engine::Texture* MakeCacheSource() {
+        static std::vector<std::unique_ptr<pixel_engine::Texture>> sources;
+
+        sources.push_back(MakeTestTexture("sampler_cache_test", 8, 8,
+            [](int x, int y, unsigned char* texel) {
+                for (int c = 0; c < 3; ++c) texel[c] = static_cast<unsigned char>(40 + y * 8 + x + c);
+            }));
+        return sources.back().get();
+    }
+
+    // every step a different sampled size, 32 px tiles step one pixel per 1/32 of scale
+    pixel_engine::PFE_CREATE_SAMPLE_TEXTURE MakeCacheDesc(pixel_engine::Texture* source, int step) {
+        pixel_engine::PFE_CREATE_SAMPLE_TEXTURE desc{};
+        desc.texture  = source;
+        desc.tileSize = 32;
+        desc.scaledBy = { 1.0f + static_cast<float>(step) / 32.0f, 1.0f };
+        return desc;
+    }
+
+    pixel_engine::Texture* RequestInline(Sampler& sampler, const pixel_engine::PFE_CREATE_SAMPLE_TEXTURE& desc) {
+        pixel_engine::Texture* texture = nullptr;
+        EXPECT_EQ(sampler.RequestTexture(desc, texture), ESampleRequest::Ready);
+        return texture;
+    }
+
+    void IdleFrames(Sampler& sampler, uint64_t frames) {
+        for (uint64_t f = 0; f < frames; ++f) sampler.PublishCompleted();
+    }
+
+    // one logic frame the way the physics queue runs it, requests go
+    // between the two halves and the snapshot draws one texture or none
+    void BeginSnapshotFrame(Sampler& sampler, const PERenderSnapshotRing& ring) {
+        sampler.SetSnapshotFrames(ring.GetPublishedFrame(), ring.GetReleasedFrame());
+        sampler.PublishCompleted();
+    }
+
+    void EndSnapshotFrame(Sampler& sampler, PERenderSnapshotRing& ring, pixel_engine::Texture* drawn) {
+        PFE_RENDER_SNAPSHOT& snapshot = ring.BeginWrite();
+        if (drawn) {
+            sampler.MarkUsed(drawn);
+            pixel_engine::PFE_SPRITE_SNAPSHOT sprite{};
+            sprite.sampledTexture = drawn;
+            snapshot.sprites.push_back(sprite);
+        }
+        ring.Publish();
+    }
+
+} // namespace
+
+// -------------------- EVICTION --------------------
+
+TEST(SamplerCache, IdleScalesAreCappedPerSource) {
+    auto& sampler = Sampler::Instance();
+    sampler.SetAsyncBuilds(false);
+    auto* source = MakeCacheSource();
+
+    const size_t before = sampler.GetCachedCount();
+    for (int step = 0; step < 20; ++step) {
+        (void)RequestInline(sampler, MakeCacheDesc(source, step));
+        IdleFrames(sampler, Sampler::kEvictAfterFrames);
+    }
+    EXPECT_EQ(sampler.GetCachedCount() - before, Sampler::kMaxScalesPerSource);
+
+    sampler.SetAsyncBuilds(true);
+}
+
+TEST(SamplerCache, MarkedScalesStayUntilIdle) {
+    auto& sampler = Sampler::Instance();
+    sampler.SetAsyncBuilds(false);
+    auto* source = MakeCacheSource();
+
+    // every scale still drawn, the cap has to wait
+    const size_t before = sampler.GetCachedCount();
+    std::vector<pixel_engine::Texture*> drawn;
+    for (int step = 0; step < 12; ++step) {
+        drawn.push_back(RequestInline(sampler, MakeCacheDesc(source, step)));
+        for (int f = 0; f < 2; ++f) {
+            sampler.PublishCompleted();
+            for (auto* texture : drawn) sampler.MarkUsed(texture);
+        }
+    }
+    EXPECT_EQ(sampler.GetCachedCount() - before, 12u);
+
+    // the newest four keep being drawn, the rest go once the next scale lands
+    for (uint64_t f = 0; f < Sampler::kEvictAfterFrames; ++f) {
+        sampler.PublishCompleted();
+        for (size_t i = 8; i < drawn.size(); ++i) sampler.MarkUsed(drawn[i]);
+    }
+    (void)RequestInline(sampler, MakeCacheDesc(source, 12));
+    EXPECT_EQ(sampler.GetCachedCount() - before, Sampler::kMaxScalesPerSource);
+
+    for (size_t i = 8; i < drawn.size(); ++i) {
+        pixel_engine::Texture* again = nullptr;
+        EXPECT_EQ(sampler.RequestTexture(MakeCacheDesc(source, static_cast<int>(i)), again), ESampleRequest::Ready);
+        EXPECT_EQ(again, drawn[i]);
+    }
+
+    sampler.SetAsyncBuilds(true);
+}
+
+TEST(SamplerCache, BuiltTexturesAreNeverEvicted) {
+    auto& sampler = Sampler::Instance();
+    sampler.SetAsyncBuilds(false);
+    auto* source = MakeCacheSource();
+
+    // an animation frame holds on to this one without marking it
+    pixel_engine::Texture* built = sampler.BuildTexture(MakeCacheDesc(source, 0));
+    ASSERT_NE(built, nullptr);
+
+    for (int step = 1; step < 30; ++step) {
+        (void)RequestInline(sampler, MakeCacheDesc(source, step));
+        IdleFrames(sampler, Sampler::kEvictAfterFrames);
+    }
+    EXPECT_EQ(sampler.BuildTexture(MakeCacheDesc(source, 0)), built);
+
+    sampler.SetAsyncBuilds(true);
+}
+
+// -------------------- LAGGING RENDER THREAD --------------------
+
+TEST(SamplerCache, EvictedScalesOutliveSnapshotsStillHeld) {
+    auto& sampler = Sampler::Instance();
+    sampler.SetAsyncBuilds(false);
+    auto* source = MakeCacheSource();
+    PERenderSnapshotRing ring;
+    ASSERT_EQ(sampler.GetRetiredCount(), 0u);
+
+    // every scale is drawn for one frame and then left idle, the render
+    // thread takes the snapshot with the first one and stalls on it
+    const size_t before = sampler.GetCachedCount();
+    const PFE_RENDER_SNAPSHOT* held = nullptr;
+    for (int step = 0; step < 20; ++step) {
+        BeginSnapshotFrame(sampler, ring);
+        EndSnapshotFrame(sampler, ring, RequestInline(sampler, MakeCacheDesc(source, step)));
+        if (!held) held = &ring.Acquire();
+
+        for (uint64_t f = 0; f < Sampler::kEvictAfterFrames; ++f) {
+            BeginSnapshotFrame(sampler, ring);
+            EndSnapshotFrame(sampler, ring, nullptr);
+        }
+    }
+    const size_t evicted = 20u - Sampler::kMaxScalesPerSource;
+    EXPECT_EQ(sampler.GetCachedCount() - before, Sampler::kMaxScalesPerSource);
+    EXPECT_EQ(sampler.GetRetiredCount(), evicted);
+
+    // evicted first, still readable through the snapshot being drawn
+    ASSERT_EQ(held->sprites.size(), 1u);
+    const pixel_engine::Texture* first = held->sprites[0].sampledTexture;
+    EXPECT_EQ(static_cast<int32_t>(first->GetWidth()), MakeCacheDesc(source, 0).GetKey().width);
+    EXPECT_TRUE(first->HasCoverage());
+
+    // the frame it gives up predates every eviction, nothing goes yet
+    (void)ring.Acquire();
+    BeginSnapshotFrame(sampler, ring);
+    EndSnapshotFrame(sampler, ring, nullptr);
+    EXPECT_EQ(sampler.GetRetiredCount(), evicted);
+
+    // once a snapshot published after them is given up they are freed
+    (void)ring.Acquire();
+    BeginSnapshotFrame(sampler, ring);
+    EXPECT_EQ(sampler.GetRetiredCount(), 0u);
+
+    // no render thread in the tests after this one
+    sampler.SetSnapshotFrames(0u, 0u);
+    sampler.SetAsyncBuilds(true);
+}
+
+// -------------------- PUBLISHED TEXTURES --------------------
+
+TEST(SamplerCache, WorkerBuildsBothBlendModesBeforePublishing) {
+    auto& sampler = Sampler::Instance();
+    sampler.SetAsyncBuilds(true);
+    auto* source = MakeCacheSource();
+    const auto desc = MakeCacheDesc(source, 3);
+
+    // the render thread only reads what comes out of PublishCompleted
+    pixel_engine::Texture* texture = nullptr;
+    ESampleRequest state = sampler.RequestTexture(desc, texture);
+    for (int wait = 0; state == ESampleRequest::Pending && wait < 2000; ++wait) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        sampler.PublishCompleted();
+        state = sampler.RequestTexture(desc, texture);
+    }
+    ASSERT_EQ(state, ESampleRequest::Ready);
+    ASSERT_NE(texture, nullptr);
+    EXPECT_TRUE(texture->HasCoverage());
+    EXPECT_TRUE(texture->HasPremultiplied());
+
+    pixel_engine::Texture* built = sampler.BuildTexture(MakeCacheDesc(source, 4));
+    ASSERT_NE(built, nullptr);
+    EXPECT_TRUE(built->HasPremultiplied());
+}
+
+// -------------------- FAILED REQUESTS --------------------
+
+TEST(SamplerCache, FailedRequestIsRetried) {
+    auto& sampler = Sampler::Instance();
+    sampler.SetAsyncBuilds(true);
+    auto* source = MakeCacheSource();
+
+    // no tile size, the worker cannot resample it
+    auto desc = MakeCacheDesc(source, 0);
+    desc.tileSize = 0;
+
+    pixel_engine::Texture* texture = nullptr;
+    ESampleRequest state = sampler.RequestTexture(desc, texture);
+    for (int wait = 0; state == ESampleRequest::Pending && wait < 2000; ++wait) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        sampler.PublishCompleted();
+        state = sampler.RequestTexture(desc, texture);
+    }
+    ASSERT_EQ(state, ESampleRequest::Failed);
+
+    // not queued again straight away, a broken source would spin the worker
+    IdleFrames(sampler, Sampler::kRetryAfterFrames - 1u);
+    EXPECT_EQ(sampler.RequestTexture(desc, texture), ESampleRequest::Failed);
+
+    IdleFrames(sampler, 1u);
+    EXPECT_EQ(sampler.RequestTexture(desc, texture), ESampleRequest::Pending);
+
+    sampler.Shutdown();
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/render_manager/components/texture/resource/texture.h"
+
+#include <memory>
+
+namespace {
+
+    // an RGBA8 texture filled texel by texel in row order, fill(x, y, rgba)
+    // starts from opaque black; shared by every test that needs a source image
+    template<typename Fill>
+    std::unique_ptr<pixel_engine::Texture> MakeTestTexture(const char* name, int width, int height, Fill&& fill,
+                                                           pixel_engine::ColorSpace colorSpace = pixel_engine::ColorSpace::Linear) {
+        fox::vector<unsigned char> data{};
+        data.assign(static_cast<size_t>(width) * height * 4u, 0u);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                unsigned char* texel = &data[(static_cast<size_t>(y) * width + x) * 4u];
+                texel[3] = 255u;
+                fill(x, y, texel);
+            }
+        }
+        return std::make_unique<pixel_engine::Texture>(
+            name,
+            static_cast<uint32_t>(width),
+            static_cast<uint32_t>(height),
+            pixel_engine::TextureFormat::RGBA8,
+            colorSpace,
+            std::move(data));
+    }
+
+} // namespace
@@ -0,0 +1,125 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/physics_manager/physics_api/store/transform_store.h"
+#include "fox_math/transform.h"
+
+#include <algorithm>
+#include <vector>
+
+using pixel_engine::PETransformStore;
+using pixel_engine::TransformHandle;
+
+namespace {
+
+    // a value per column that only this handle has
+    void FillTransformRow(PETransformStore& store, TransformHandle handle) {
+        auto& c = store.Columns();
+        const size_t i = store.Index(handle);
+        const float  v = static_cast<float>(handle);
+
+        c.PositionX  [i] = 10.0f + v;
+        c.PositionY  [i] = 20.0f + v;
+        c.Rotation   [i] = 0.1f * v;
+        c.VelocityX  [i] = 30.0f + v;
+        c.InverseMass[i] = 1.0f / (1.0f + v);
+        c.HalfExtentY[i] = 40.0f + v;
+        c.Layer      [i] = static_cast<uint8_t>(handle + 1u);
+    }
+
+    void ExpectTransformRow(const PETransformStore& store, TransformHandle handle) {
+        SCOPED_TRACE(handle);
+        const auto& c = store.Columns();
+        const size_t i = store.Index(handle);
+        const float  v = static_cast<float>(handle);
+
+        ASSERT_LT(i, store.Size());
+        EXPECT_EQ(c.Owner[i], handle);
+        EXPECT_FLOAT_EQ(c.PositionX  [i], 10.0f + v);
+        EXPECT_FLOAT_EQ(c.PositionY  [i], 20.0f + v);
+        EXPECT_FLOAT_EQ(c.Rotation   [i], 0.1f * v);
+        EXPECT_FLOAT_EQ(c.VelocityX  [i], 30.0f + v);
+        EXPECT_FLOAT_EQ(c.InverseMass[i], 1.0f / (1.0f + v));
+        EXPECT_FLOAT_EQ(c.HalfExtentY[i], 40.0f + v);
+        EXPECT_EQ(c.Layer[i], static_cast<uint8_t>(handle + 1u));
+    }
+
+} // namespace
+
+// -------------------- HANDLES --------------------
+
+TEST(TransformStore, HandlesSurviveSwapRemove) {
+    PETransformStore store;
+    std::vector<TransformHandle> alive;
+    for (int i = 0; i < 6; ++i) {
+        alive.push_back(store.Create());
+        FillTransformRow(store, alive.back());
+    }
+
+    // from the middle, the last row moves into the hole
+    const TransformHandle middle = alive[2];
+    store.Destroy(middle);
+    alive.erase(alive.begin() + 2);
+
+    // the row now at the end, nothing moves
+    const TransformHandle last = store.Columns().Owner[store.Size() - 1u];
+    store.Destroy(last);
+    alive.erase(std::find(alive.begin(), alive.end(), last));
+
+    ASSERT_EQ(store.Size(), alive.size());
+    for (const TransformHandle handle : alive) ExpectTransformRow(store, handle);
+
+    // a freed handle comes back with the defaults, the others are untouched
+    const TransformHandle reused = store.Create();
+    EXPECT_TRUE(reused == middle || reused == last);
+    EXPECT_EQ(store.Index(reused), store.Size() - 1u);
+    EXPECT_FLOAT_EQ(store.Columns().PositionX[store.Index(reused)], 0.0f);
+    EXPECT_FLOAT_EQ(store.Columns().InverseMass[store.Index(reused)], 1.0f);
+    for (const TransformHandle handle : alive) ExpectTransformRow(store, handle);
+}
+
+// -------------------- CAMERA SPACE --------------------
+
+TEST(TransformStore, CameraSpaceMatchesComposedMatrix) {
+    PETransformStore store;
+    const TransformHandle handle = store.Create();
+    (void)store.Create(); // a neighbour the sweep must not mix in
+
+    const FTransform2D body({ 12.5f, -3.0f }, 0.7f, { 2.0f, 0.5f }, { 0.25f, -1.5f });
+    auto& c = store.Columns();
+    const size_t i = store.Index(handle);
+    c.PositionX[i] = body.Position.x;
+    c.PositionY[i] = body.Position.y;
+    c.Rotation [i] = body.Rotation;
+    c.ScaleX   [i] = body.Scale.x;
+    c.ScaleY   [i] = body.Scale.y;
+    c.PivotX   [i] = body.Pivot.x;
+    c.PivotY   [i] = body.Pivot.y;
+
+    // the camera hands the store where the world origin and unit axes land
+    const FTransform2D camera({ 320.0f, 240.0f }, -0.3f, { 32.0f, -24.0f }, { 4.0f, 2.0f });
+    const auto view     = camera.ToMatrix();
+    const auto expected = view * body.ToMatrix();
+
+    const auto check = [&] {
+        EXPECT_NEAR(c.ViewUX[i], expected.matrix[0][0], 1e-3f);
+        EXPECT_NEAR(c.ViewUY[i], expected.matrix[1][0], 1e-3f);
+        EXPECT_NEAR(c.ViewVX[i], expected.matrix[0][1], 1e-3f);
+        EXPECT_NEAR(c.ViewVY[i], expected.matrix[1][1], 1e-3f);
+        EXPECT_NEAR(c.ViewX [i], expected.matrix[0][2], 1e-3f);
+        EXPECT_NEAR(c.ViewY [i], expected.matrix[1][2], 1e-3f);
+    };
+
+    const FVector2D origin = view.TransformPoint({ 0.0f, 0.0f });
+    const FVector2D x1     = view.TransformPoint({ 1.0f, 0.0f });
+    const FVector2D y1     = view.TransformPoint({ 0.0f, 1.0f });
+
+    store.UpdateCameraSpace(handle, origin, x1, y1);
+    check();
+
+    // the sweep writes the same for simulated bodies
+    c.ViewX[i] = c.ViewY[i] = c.ViewUX[i] = c.ViewUY[i] = c.ViewVX[i] = c.ViewVY[i] = 0.0f;
+    store.ClearSimulate();
+    store.SetSimulate(handle);
+    store.UpdateCameraSpace(origin, x1, y1);
+    check();
+}
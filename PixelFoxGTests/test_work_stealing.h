@@ -0,0 +1,312 @@
+#pragma once
+#include "pch.h"
+#include "pixel_engine/core/jobs/job_system.h"
+#include "pixel_engine/core/jobs/work_steal_deque.h"
+#include "pixel_engine/render_manager/api/raster/task/work_stealing_scheduler.h"
+#include "test_texture.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using pixel_engine::IRasterScheduler;
+using pixel_engine::PEJobSystem;
+using pixel_engine::PFE_JOB;
+using pixel_engine::PEImageBuffer;
+using pixel_engine::PERasterizeTask;
+using pixel_engine::PEWorkStealDeque;
+using pixel_engine::PEWorkStealingScheduler;
+using pixel_engine::RasterizeScheduler;
+
+namespace {
+
+    constexpr int kSchedTexWidth  = 64;
+    constexpr int kSchedTexHeight = 128;
+
+    std::unique_ptr<pixel_engine::Texture> MakeSchedulerTexture() {
+        std::mt19937 rng(7u);
+        return MakeTestTexture("scheduler_test", kSchedTexWidth, kSchedTexHeight,
+            [&rng](int, int, unsigned char* texel) {
+                for (int c = 0; c < 3; ++c) texel[c] = static_cast<unsigned char>(20u + rng() % 200u);
+            });
+    }
+
+    // one texture row copied 1:1 into the same target row
+    PERasterizeTask MakeRowTask(PEImageBuffer* target, const pixel_engine::Texture* texture, int row) {
+        pixel_engine::RASTERIZE_TASK_DESC desc{};
+        desc.target          = target;
+        desc.sampledTexture  = texture;
+        desc.deltaAxisU      = { 1.0f, 0.0f };
+        desc.deltaAxisV      = { 0.0f, 1.0f };
+        desc.columnStartFrom = 0;
+        desc.columneEndAt    = kSchedTexWidth;
+        desc.rowStartFrom    = row;
+        desc.rowEndAt        = row + 1;
+        desc.totalColumns    = kSchedTexWidth;
+        desc.totalRows       = kSchedTexHeight;
+        desc.TexWidth        = kSchedTexWidth;
+        desc.TexHeight       = kSchedTexHeight;
+        return PERasterizeTask{ desc };
+    }
+
+    pixel_engine::PE_IMAGE_BUFFER_DESC MakeSchedulerTarget() {
+        pixel_engine::PE_IMAGE_BUFFER_DESC desc{};
+        desc.Width  = kSchedTexWidth;
+        desc.Height = kSchedTexHeight;
+        desc.Format = pixel_engine::EPixelFormat::R8G8B8A8;
+        return desc;
+    }
+
+    // random batches through the scheduler, every one compared with the
+    // same tasks run in order on the calling thread; returns the mismatches
+    int CountSchedulerMismatches(IRasterScheduler& scheduler, uint32_t seed, int batches) {
+        const auto texture = MakeSchedulerTexture();
+        PEImageBuffer actual  { MakeSchedulerTarget() };
+        PEImageBuffer expected{ MakeSchedulerTarget() };
+
+        std::mt19937 rng(seed);
+        int mismatches = 0;
+        for (int b = 0; b < batches; ++b) {
+            std::memset(actual.Data(),   0, actual.ImageSize());
+            std::memset(expected.Data(), 0, expected.ImageSize());
+
+            // distinct rows only, tasks of one batch never share target pixels
+            std::vector<int> rows(kSchedTexHeight);
+            std::iota(rows.begin(), rows.end(), 0);
+            std::shuffle(rows.begin(), rows.end(), rng);
+
+            const int count = rng() % 10u == 0u ? kSchedTexHeight : static_cast<int>(rng() % 40u);
+            for (int k = 0; k < count; ++k) {
+                scheduler.Enqueue(MakeRowTask(&actual, texture.get(), rows[k]));
+                MakeRowTask(&expected, texture.get(), rows[k]).Execute();
+            }
+
+            switch (rng() % 3u) {
+            case 0u: scheduler.Dispatch(); scheduler.Wait(); break;
+            case 1u: scheduler.Dispatch(); scheduler.Dispatch(); scheduler.Wait(); break; // empty second batch
+            default: scheduler.Submit(); std::this_thread::yield(); scheduler.Wait(); break;
+            }
+
+            if (std::memcmp(actual.Data(), expected.Data(), actual.ImageSize()) != 0) ++mismatches;
+        }
+        return mismatches;
+    }
+
+    void CountJobRun(void* context) {
+        static_cast<std::atomic<int>*>(context)->fetch_add(1);
+    }
+
+    // a job that runs a batch of its own through the job system
+    struct NestedJobs {
+        std::vector<std::atomic<int>> inner = std::vector<std::atomic<int>>(8);
+    };
+
+    void RunNestedJobs(void* context) {
+        auto* nested = static_cast<NestedJobs*>(context);
+        std::vector<PFE_JOB> jobs;
+        for (auto& count : nested->inner) jobs.push_back({ &CountJobRun, &count });
+        PEJobSystem::Instance().Run(jobs.data(), static_cast<uint32_t>(jobs.size()));
+    }
+
+    int CountJobsNotRunOnce(const std::vector<std::atomic<int>>& runs) {
+        return static_cast<int>(std::count_if(runs.begin(), runs.end(),
+                                              [](const std::atomic<int>& r) { return r.load() != 1; }));
+    }
+
+} // namespace
+
+// -------------------- DEQUE --------------------
+
+TEST(WorkStealDeque, OwnerPopsNewestThiefStealsOldest) {
+    PEWorkStealDeque<uint32_t> deque(4);
+    for (uint32_t i = 0; i < 3u; ++i) deque.Push(i);
+
+    uint32_t value = 0u;
+    ASSERT_TRUE(deque.Steal(value));
+    EXPECT_EQ(value, 0u);
+    ASSERT_TRUE(deque.Pop(value));
+    EXPECT_EQ(value, 2u);
+    ASSERT_TRUE(deque.Pop(value));
+    EXPECT_EQ(value, 1u);
+
+    EXPECT_TRUE(deque.Empty());
+    EXPECT_FALSE(deque.Pop(value));
+    EXPECT_FALSE(deque.Steal(value));
+}
+
+TEST(WorkStealDeque, GrowKeepsEveryItem) {
+    PEWorkStealDeque<uint32_t> deque(4);
+    for (uint32_t i = 0; i < 1000u; ++i) deque.Push(i);
+
+    uint32_t value = 0u;
+    for (uint32_t i = 1000u; i > 0u; --i) {
+        ASSERT_TRUE(deque.Pop(value));
+        EXPECT_EQ(value, i - 1u);
+    }
+    EXPECT_TRUE(deque.Empty());
+}
+
+TEST(WorkStealDeque, EveryItemTakenOnceUnderContention) {
+    constexpr uint32_t kItems = 200000u;
+    std::vector<std::atomic<int>> taken(kItems);
+    for (auto& t : taken) t.store(0);
+
+    PEWorkStealDeque<uint32_t> deque(4);
+    std::atomic<bool> done{ false };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&]() {
+            uint32_t value = 0u;
+            while (!done.load() || !deque.Empty()) {
+                if (deque.Steal(value)) taken[value].fetch_add(1);
+            }
+        });
+    }
+
+    // the owner pushes bursts and pops some back, so the last item races the thieves often
+    std::mt19937 rng(1u);
+    uint32_t next  = 0u;
+    uint32_t value = 0u;
+    while (next < kItems) {
+        const uint32_t burst = 1u + rng() % 300u;
+        for (uint32_t i = 0; i < burst && next < kItems; ++i) deque.Push(next++);
+
+        const uint32_t pops = rng() % 200u;
+        for (uint32_t i = 0; i < pops; ++i) {
+            if (deque.Pop(value)) taken[value].fetch_add(1);
+        }
+    }
+    while (deque.Pop(value)) taken[value].fetch_add(1);
+
+    done.store(true);
+    for (auto& t : thieves) t.join();
+
+    int wrong = 0;
+    for (auto& t : taken) if (t.load() != 1) ++wrong;
+    EXPECT_EQ(wrong, 0);
+}
+
+// -------------------- SCHEDULERS --------------------
+
+TEST(WorkStealingScheduler, MatchesSerialExecution) {
+    for (const uint32_t workers : { 1u, 3u, 7u }) {
+        SCOPED_TRACE(workers);
+        PEWorkStealingScheduler scheduler;
+        scheduler.Initialize(workers);
+        EXPECT_EQ(CountSchedulerMismatches(scheduler, 11u + workers, 400), 0);
+        scheduler.Shutdown();
+    }
+}
+
+TEST(WorkStealingScheduler, MatchesSharedQueue) {
+    PEWorkStealingScheduler stealing;
+    RasterizeScheduler      shared;
+    stealing.Initialize(3u);
+    shared  .Initialize(3u);
+
+    // same seed, same batches, both must leave the same pixels as the serial run
+    EXPECT_EQ(CountSchedulerMismatches(shared,   5u, 300), 0);
+    EXPECT_EQ(CountSchedulerMismatches(stealing, 5u, 300), 0);
+
+    stealing.Shutdown();
+    shared  .Shutdown();
+}
+
+TEST(WorkStealingScheduler, WaitWithoutBatchReturns) {
+    PEWorkStealingScheduler scheduler;
+    scheduler.Initialize(2u);
+    scheduler.Wait();
+    scheduler.Dispatch();
+    scheduler.Wait();
+    scheduler.Shutdown();
+    SUCCEED();
+}
+
+TEST(WorkStealingScheduler, JobsRunOnceNextToTasks) {
+    PEWorkStealingScheduler stealing;
+    RasterizeScheduler      shared;
+    stealing.Initialize(3u);
+    shared  .Initialize(3u);
+
+    const auto texture = MakeSchedulerTexture();
+    PEImageBuffer target{ MakeSchedulerTarget() };
+
+    for (IRasterScheduler* scheduler : { static_cast<IRasterScheduler*>(&stealing), static_cast<IRasterScheduler*>(&shared) }) {
+        std::vector<std::atomic<int>> runs(500);
+        for (int b = 0; b < 5; ++b) {
+            for (int i = 0; i < 100; ++i) {
+                scheduler->Enqueue(PFE_JOB{ &CountJobRun, &runs[b * 100 + i] });
+                if (i < kSchedTexHeight) scheduler->Enqueue(MakeRowTask(&target, texture.get(), i));
+            }
+            if (b % 2 == 0) scheduler->Dispatch();
+            else            scheduler->Submit();
+            scheduler->Wait();
+        }
+        EXPECT_EQ(CountJobsNotRunOnce(runs), 0);
+    }
+
+    stealing.Shutdown();
+    shared  .Shutdown();
+}
+
+// -------------------- JOB SYSTEM --------------------
+
+TEST(JobSystem, RunsEveryJobOnce) {
+    for (const uint32_t count : { 1u, 2u, 17u, 1000u }) {
+        SCOPED_TRACE(count);
+        std::vector<std::atomic<int>> runs(count);
+        std::vector<PFE_JOB> jobs;
+        for (auto& r : runs) jobs.push_back({ &CountJobRun, &r });
+
+        PEJobSystem::Instance().Run(jobs.data(), count);
+        EXPECT_EQ(CountJobsNotRunOnce(runs), 0);
+    }
+}
+
+TEST(JobSystem, NestedRunStaysOnItsThread) {
+    std::vector<NestedJobs> nested(6);
+    std::vector<PFE_JOB> jobs;
+    for (auto& n : nested) jobs.push_back({ &RunNestedJobs, &n });
+
+    PEJobSystem::Instance().Run(jobs.data(), static_cast<uint32_t>(jobs.size()));
+    for (const auto& n : nested) EXPECT_EQ(CountJobsNotRunOnce(n.inner), 0);
+}
+
+TEST(JobSystem, ConcurrentCallersAllFinish) {
+    // one caller gets the pool, the others run their own jobs meanwhile
+    constexpr int kCallers = 4;
+    std::vector<std::vector<std::atomic<int>>> runs;
+    for (int c = 0; c < kCallers; ++c) runs.emplace_back(200);
+
+    std::vector<std::thread> callers;
+    for (int c = 0; c < kCallers; ++c) {
+        callers.emplace_back([&runs, c]() {
+            for (int round = 0; round < 50; ++round) {
+                std::vector<PFE_JOB> jobs;
+                for (int i = 0; i < 4; ++i) jobs.push_back({ &CountJobRun, &runs[c][round * 4 + i] });
+                PEJobSystem::Instance().Run(jobs.data(), static_cast<uint32_t>(jobs.size()));
+            }
+        });
+    }
+    for (auto& t : callers) t.join();
+
+    for (const auto& r : runs) EXPECT_EQ(CountJobsNotRunOnce(r), 0);
+}
+
+TEST(JobSystem, RunAfterShutdownStartsAgain) {
+    PEJobSystem::Instance().Shutdown();
+
+    std::vector<std::atomic<int>> runs(64);
+    std::vector<PFE_JOB> jobs;
+    for (auto& r : runs) jobs.push_back({ &CountJobRun, &r });
+    PEJobSystem::Instance().Run(jobs.data(), static_cast<uint32_t>(jobs.size()));
+    EXPECT_EQ(CountJobsNotRunOnce(runs), 0);
+
+    PEJobSystem::Instance().Shutdown();
+}